@@ -2,7 +2,8 @@
 // Hardware Calculator IP - Top Level Module
 // ============================================================================
 // Top-level wrapper for hardware-accelerated floating-point calculator
-// Integrates Avalon-MM interface, register file, computation core, and LED display
+// Integrates Avalon-MM interface, register file, computation core, LED display,
+// price buffer, HFT operations and the auto-compute result FIFO
 // ============================================================================
 // Author: Claude Code
 // Date: 2026-01-16
@@ -15,7 +16,7 @@ module calculator (
     input  wire        reset_n,
 
     // Avalon-MM Slave Interface
-    input  wire [5:0]  avs_s0_address,     // Extended to 6 bits (64 bytes) for HFT
+    input  wire [6:0]  avs_s0_address,     // Extended to 7 bits (128 bytes) for HFT
     input  wire        avs_s0_read,
     input  wire        avs_s0_write,
     input  wire [31:0] avs_s0_writedata,
@@ -32,7 +33,7 @@ module calculator (
 // ============================================================================
 // Internal Signals - Register Interface
 // ============================================================================
-wire [3:0]  reg_address;        // Extended to 4 bits (16 registers)
+wire [4:0]  reg_address;        // Extended to 5 bits (32 registers)
 wire        reg_write;
 wire        reg_read;
 wire [31:0] reg_writedata;
@@ -50,27 +51,65 @@ wire        calc_busy;
 wire        calc_done;
 wire        calc_error;
 
+// Operations 0-3 run in the core, 4-15 in the HFT operations module
+wire        calc_hft_op = (calc_operation >= 4'd4);
+reg         result_from_hft;    // Source of the most recently started operation
+
+wire [31:0] core_result;
+wire        core_busy;
+wire        core_done;
+wire        core_error;
+
 // ============================================================================
 // Internal Signals - Price Buffer
 // ============================================================================
 wire [31:0] buffer_price_write;
 wire        buffer_write_enable;
+wire [15:0] buffer_write_seq;
 wire        buffer_reset;
 wire [15:0] buffer_window_size;
 wire [15:0] buffer_count;
 wire        buffer_full;
 
-// Price buffer outputs (21 most recent prices)
-wire [31:0] price_0, price_1, price_2, price_3, price_4;
-wire [31:0] price_5, price_6, price_7, price_8, price_9;
-wire [31:0] price_10, price_11, price_12, price_13, price_14;
-wire [31:0] price_15, price_16, price_17, price_18, price_19;
-wire [31:0] price_20;
+// Running sum of the window (signed fixed point, 24 fraction bits)
+wire [63:0] buffer_window_sum;
+wire        buffer_window_sum_valid;
 
 // ============================================================================
 // Internal Signals - HFT Operations
 // ============================================================================
 wire [31:0] ema_alpha;
+wire [31:0] hft_result;
+wire        hft_result_valid;
+wire        hft_error;
+wire        hft_busy;
+
+// Compute-all results
+wire [31:0] stats_sma;
+wire [31:0] stats_std_dev;
+wire [31:0] stats_min;
+wire [31:0] stats_max;
+wire [31:0] stats_boll_upper;
+wire [31:0] stats_boll_lower;
+
+// ============================================================================
+// Internal Signals - Auto-Compute and Result FIFO
+// ============================================================================
+wire [15:0] auto_ops;
+wire [31:0] auto_result;
+wire        auto_result_valid;
+wire        auto_error;
+wire [3:0]  auto_op;
+wire [15:0] auto_seq;
+wire        auto_lost;
+
+wire [52:0] fifo_head;
+wire        fifo_empty;
+wire [6:0]  fifo_count;
+wire        fifo_overflow;
+wire        fifo_pop;
+wire        fifo_flush;
+wire        fifo_clear_overflow;
 
 // ============================================================================
 // Avalon-MM Slave Interface
@@ -122,6 +161,7 @@ calculator_registers register_file (
     // Buffer Interface
     .buffer_price_write   (buffer_price_write),
     .buffer_write_enable  (buffer_write_enable),
+    .buffer_write_seq     (buffer_write_seq),
     .buffer_reset         (buffer_reset),
     .buffer_window_size   (buffer_window_size),
     .buffer_count         (buffer_count),
@@ -130,6 +170,24 @@ calculator_registers register_file (
     // HFT Parameters
     .ema_alpha         (ema_alpha),
 
+    // Auto-Compute and Result FIFO
+    .auto_ops            (auto_ops),
+    .fifo_head           (fifo_head),
+    .fifo_empty          (fifo_empty),
+    .fifo_count          (fifo_count),
+    .fifo_overflow       (fifo_overflow),
+    .fifo_pop            (fifo_pop),
+    .fifo_flush          (fifo_flush),
+    .fifo_clear_overflow (fifo_clear_overflow),
+
+    // Compute-All Results
+    .stats_sma           (stats_sma),
+    .stats_std_dev       (stats_std_dev),
+    .stats_min           (stats_min),
+    .stats_max           (stats_max),
+    .stats_boll_upper    (stats_boll_upper),
+    .stats_boll_lower    (stats_boll_lower),
+
     // Interrupt Output
     .calc_interrupt    (ins_irq_irq)
 );
@@ -145,13 +203,13 @@ calculator_core core (
     .operation         (calc_operation),
     .operand_a         (calc_operand_a),
     .operand_b         (calc_operand_b),
-    .start             (calc_start),
+    .start             (calc_start && !calc_hft_op),
 
     // Status and Result
-    .result            (calc_result),
-    .busy              (calc_busy),
-    .done              (calc_done),
-    .error             (calc_error)
+    .result            (core_result),
+    .busy              (core_busy),
+    .done              (core_done),
+    .error             (core_error)
 );
 
 // ============================================================================
@@ -180,28 +238,9 @@ calculator_price_buffer price_buffer (
     // Configuration
     .window_size       (buffer_window_size),
 
-    // Price Outputs (21 most recent prices)
-    .price_out_0       (price_0),
-    .price_out_1       (price_1),
-    .price_out_2       (price_2),
-    .price_out_3       (price_3),
-    .price_out_4       (price_4),
-    .price_out_5       (price_5),
-    .price_out_6       (price_6),
-    .price_out_7       (price_7),
-    .price_out_8       (price_8),
-    .price_out_9       (price_9),
-    .price_out_10      (price_10),
-    .price_out_11      (price_11),
-    .price_out_12      (price_12),
-    .price_out_13      (price_13),
-    .price_out_14      (price_14),
-    .price_out_15      (price_15),
-    .price_out_16      (price_16),
-    .price_out_17      (price_17),
-    .price_out_18      (price_18),
-    .price_out_19      (price_19),
-    .price_out_20      (price_20),
+    // Running Sum
+    .window_sum        (buffer_window_sum),
+    .window_sum_valid  (buffer_window_sum_valid),
 
     // Status Outputs
     .count             (buffer_count),
@@ -209,17 +248,90 @@ calculator_price_buffer price_buffer (
 );
 
 // ============================================================================
-// HFT Operations Module (Future Extension)
+// HFT Operations Module
 // ============================================================================
-// Note: HFT operations module will be instantiated here when implemented
-// It will receive:
-//   - operation (calc_operation)
-//   - price buffer outputs (price_0 through price_20)
-//   - window_size (buffer_window_size)
-//   - ema_alpha
-//   - buffer_count
-// And will provide:
-//   - HFT result output (to be muxed with calc_result)
-//   - HFT done/error signals
+calculator_hft_ops hft_ops (
+    .clk               (clk),
+    .reset_n           (reset_n),
+
+    // Operation Control
+    .operation         (calc_operation),
+    .window_operand    (calc_operand_b),
+    .start             (calc_start && calc_hft_op),
+
+    // Auto-Compute
+    .auto_ops          (auto_ops),
+    .tick              (buffer_write_enable),
+    .tick_seq          (buffer_write_seq),
+
+    // Price Buffer Interface
+    .window_size       (buffer_window_size),
+    .window_sum        (buffer_window_sum),
+    .window_sum_valid  (buffer_window_sum_valid),
+    .buffer_count      (buffer_count),
+    .price_in          (buffer_price_write),
+
+    // Result
+    .result            (hft_result),
+    .result_valid      (hft_result_valid),
+    .error             (hft_error),
+    .busy              (hft_busy),
+
+    // Compute-All Results
+    .stats_sma         (stats_sma),
+    .stats_std_dev     (stats_std_dev),
+    .stats_min         (stats_min),
+    .stats_max         (stats_max),
+    .stats_boll_upper  (stats_boll_upper),
+    .stats_boll_lower  (stats_boll_lower),
+
+    // Auto-Compute Result
+    .auto_result       (auto_result),
+    .auto_result_valid (auto_result_valid),
+    .auto_error        (auto_error),
+    .auto_op           (auto_op),
+    .auto_seq          (auto_seq),
+    .auto_lost         (auto_lost)
+);
+
+// ============================================================================
+// Result FIFO (Auto-Compute)
+// ============================================================================
+calculator_result_fifo result_fifo (
+    .clk               (clk),
+    .reset_n           (reset_n),
+
+    // Write Side
+    .push              (auto_result_valid),
+    .push_data         ({auto_error, auto_op, auto_seq, auto_result}),
+    .lost              (auto_lost),
+
+    // Read Side
+    .pop               (fifo_pop),
+    .flush             (fifo_flush),
+    .clear_overflow    (fifo_clear_overflow),
+    .head              (fifo_head),
+    .empty             (fifo_empty),
+    .count             (fifo_count),
+    .overflow          (fifo_overflow)
+);
+
+// ============================================================================
+// Result Multiplexer
+// ============================================================================
+// RESULT and STATUS.error follow the unit that ran the last started
+// operation; the driver runs one operation at a time
+always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+        result_from_hft <= 1'b0;
+    end else if (calc_start) begin
+        result_from_hft <= calc_hft_op;
+    end
+end
+
+assign calc_result = result_from_hft ? hft_result : core_result;
+assign calc_error  = result_from_hft ? hft_error  : core_error;
+assign calc_busy   = core_busy | hft_busy;
+assign calc_done   = core_done | hft_result_valid;
 
 endmodule
@@ -11,7 +11,7 @@ module calculator_avalon_mm (
     input  wire        reset_n,
 
     // Avalon-MM Slave Interface
-    input  wire [5:0]  avs_address,        // Byte address (6 bits = 64 bytes = 16 registers)
+    input  wire [6:0]  avs_address,        // Byte address (7 bits = 128 bytes = 32 registers)
     input  wire        avs_read,           // Read request
     input  wire        avs_write,          // Write request
     input  wire [31:0] avs_writedata,      // Write data
@@ -19,7 +19,7 @@ module calculator_avalon_mm (
     output wire        avs_waitrequest,    // Wait request (not used - zero wait states)
 
     // Calculator Register Interface
-    output wire [3:0]  reg_address,        // Register address (word aligned)
+    output wire [4:0]  reg_address,        // Register address (word aligned)
     output wire        reg_write,          // Register write enable
     output wire        reg_read,           // Register read enable
     output wire [31:0] reg_writedata,      // Data to write to register
@@ -30,8 +30,8 @@ module calculator_avalon_mm (
 // Address Decoding
 // ============================================================================
 // Convert byte address to word address (divide by 4)
-// avs_address[5:2] selects register (0-15)
-assign reg_address = avs_address[5:2];
+// avs_address[6:2] selects register (0-31)
+assign reg_address = avs_address[6:2];
 
 // ============================================================================
 // Control Signals
@@ -60,10 +60,15 @@ assign avs_waitrequest = 1'b0;
 // 0x1C           | BUFFER_WRITE     | W      | Write price to buffer
 // 0x20           | BUFFER_COUNT     | R      | Current buffer count
 // 0x24           | EMA_ALPHA        | R/W    | EMA alpha parameter (float)
-// 0x28           | CONFIG_FLAGS     | R/W    | Configuration bits
+// 0x28           | CONFIG_FLAGS     | R/W    | [0]=auto-compute, [31:16]=op mask
 // 0x2C           | ERROR_CODE       | R      | Detailed error info
-// 0x30-0x38      | Reserved         | -      | Future use
+// 0x30           | RESULT_FIFO_STAT | R/W    | [6:0]=count, [31]=overflow
+// 0x34           | RESULT_FIFO_TAG  | R      | Head tag (valid, error, op, seq)
+// 0x38           | RESULT_FIFO_DATA | R      | Head result, read pops
 // 0x3C           | VERSION          | R      | IP version
+// 0x40-0x54      | STATS_*          | R      | Compute-all results: SMA, STD_DEV,
+//                |                  |        | MIN, MAX, BOLL_UP, BOLL_DN (float)
+// 0x58-0x7C      | Reserved         | -      | Future use
 // ============================================================================
 
 endmodule
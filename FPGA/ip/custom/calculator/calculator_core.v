@@ -31,14 +31,6 @@ localparam STATE_COMPUTING  = 2'b01;
 localparam STATE_DONE       = 2'b10;
 
 reg [1:0]   state, next_state;
-reg [3:0]   cycle_counter;                 // Count cycles through pipeline
-reg [3:0]   pipeline_depth;                // Pipeline depth for current operation
-
-// Operation pipeline depths (cycles)
-localparam PIPELINE_ADD = 4'd7;
-localparam PIPELINE_SUB = 4'd7;
-localparam PIPELINE_MUL = 4'd5;
-localparam PIPELINE_DIV = 4'd6;
 
 // ============================================================================
 // Floating Point Operations Module
@@ -59,39 +51,14 @@ calculator_float_ops fp_ops (
     .error         (fp_error)
 );
 
-// ============================================================================
-// Pipeline Depth Selection
-// ============================================================================
-// Determine pipeline depth based on operation
-always @(*) begin
-    case (operation[1:0])  // Basic operations use lower 2 bits
-        2'b00:   pipeline_depth = PIPELINE_ADD;   // ADD
-        2'b01:   pipeline_depth = PIPELINE_SUB;   // SUB
-        2'b10:   pipeline_depth = PIPELINE_MUL;   // MUL
-        2'b11:   pipeline_depth = PIPELINE_DIV;   // DIV
-        default: pipeline_depth = PIPELINE_ADD;
-    endcase
-    // Note: HFT operations (4-15) will use separate pipeline tracking
-end
-
 // ============================================================================
 // State Machine - Sequential Logic
 // ============================================================================
 always @(posedge clk or negedge reset_n) begin
     if (!reset_n) begin
         state <= STATE_IDLE;
-        cycle_counter <= 4'h0;
     end else begin
         state <= next_state;
-
-        // Cycle counter for pipeline tracking
-        if (state == STATE_COMPUTING) begin
-            if (cycle_counter < pipeline_depth) begin
-                cycle_counter <= cycle_counter + 1'b1;
-            end
-        end else begin
-            cycle_counter <= 4'h0;
-        end
     end
 end
 
@@ -109,8 +76,11 @@ always @(*) begin
         end
 
         STATE_COMPUTING: begin
-            // Wait for pipeline to complete
-            if (cycle_counter >= pipeline_depth) begin
+            // Wait for the result. calculator_float_ops takes every
+            // operation from the end of its 7-stage tracking pipeline, so
+            // counting the multiplier's or divider's own depth finishes
+            // before the result has been captured
+            if (fp_result_valid) begin
                 next_state = STATE_DONE;
             end
         end
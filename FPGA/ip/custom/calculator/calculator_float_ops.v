@@ -176,7 +176,10 @@ endmodule
 // ============================================================================
 // These will be replaced by Intel IP Catalog generated modules
 // For simulation/synthesis without Intel tools, these provide a basic structure
+// Co-simulation defines CALCULATOR_BEHAVIORAL_FP and supplies behavioral
+// models with the same ports (HPS/drivers/calculator_cosim/altfp_behavioral.v)
 // ============================================================================
+`ifndef CALCULATOR_BEHAVIORAL_FP
 
 module altfp_add_sub32 (
     input  wire        clock,
@@ -235,3 +238,26 @@ module altfp_div32 (
         division_by_zero <= 1'b0;
     end
 endmodule
+
+// ALTFP_SQRT, single precision, pipeline depth = 16 (calculator_window_stats)
+// SIMULATION ONLY: returns zero, so STD_DEV and the Bollinger bands of
+// compute-all would be wrong. It is hidden from synthesis; generate the
+// ALTFP_SQRT megafunction as altfp_sqrt32.v next to this file instead
+// (calculator_hw.tcl refuses to generate the component without it).
+// synthesis translate_off
+module altfp_sqrt32 (
+    input  wire        clock,
+    input  wire [31:0] data,
+    output reg  [31:0] result,
+    output reg         overflow,
+    output reg         nan
+);
+    always @(posedge clock) begin
+        result <= 32'h0;
+        overflow <= 1'b0;
+        nan <= 1'b0;
+    end
+endmodule
+// synthesis translate_on
+
+`endif // CALCULATOR_BEHAVIORAL_FP
@@ -2,7 +2,29 @@
 // Calculator HFT Operations Module
 // ============================================================================
 // Implements High-Frequency Trading calculations using price buffer
-// Uses calculator_float_ops for basic arithmetic operations
+//
+// SMA reads the running window sum that calculator_price_buffer keeps up
+// to date on every tick, converts it from fixed point to float and
+// multiplies it by a precomputed reciprocal of the window length instead
+// of dividing. Every operation takes the same PIPE_LATENCY cycles from
+// start to result_valid, for any window length, and a new one can start
+// on every clock; results come out in start order.
+//
+// Compute-all (15) runs the SMA pipeline, then hands the mean to
+// calculator_window_stats for one pass over the window that fills the
+// STD_DEV, MIN, MAX and Bollinger results alongside SMA. It completes
+// after the pass (about window + 56 cycles); RESULT holds the SMA.
+//
+// Other window operations are not implemented in hardware yet: they pass
+// through the same pipeline and complete with the error flag set.
+//
+// Auto-compute: on every tick (price write) the operations selected in
+// auto_ops are queued and issued one per cycle, lowest code first, over the
+// configured window. A manual start takes the issue slot first. Auto
+// results leave on the auto_* outputs tagged with the tick's sequence
+// number and operation; they never touch result, error or busy. A tick
+// that arrives before the previous tick's operations have all issued
+// drops the rest and pulses auto_lost.
 // ============================================================================
 
 module calculator_hft_ops (
@@ -11,39 +33,43 @@ module calculator_hft_ops (
     input  wire        reset_n,
 
     // Operation Control
-    input  wire [3:0]  operation,           // 4=SMA, 5=EMA, 6-15=other HFT ops
-    input  wire [15:0] window_size,         // Number of periods
-    input  wire [31:0] ema_alpha,           // EMA smoothing factor (float)
+    input  wire [3:0]  operation,           // 4=SMA, 5=EMA, 6-14=other HFT ops, 15=all
+    input  wire [31:0] window_operand,      // Window length as a float (OPERAND_B)
     input  wire        start,               // Start operation (pulse)
 
+    // Auto-Compute
+    input  wire [15:0] auto_ops,            // Bit n runs operation n on each tick
+    input  wire        tick,                // Price written to the buffer (pulse)
+    input  wire [15:0] tick_seq,            // Sequence number of that price
+
     // Price Buffer Interface (from calculator_price_buffer)
-    input  wire [31:0] price_0,             // Most recent price
-    input  wire [31:0] price_1,
-    input  wire [31:0] price_2,
-    input  wire [31:0] price_3,
-    input  wire [31:0] price_4,
-    input  wire [31:0] price_5,
-    input  wire [31:0] price_6,
-    input  wire [31:0] price_7,
-    input  wire [31:0] price_8,
-    input  wire [31:0] price_9,
-    input  wire [31:0] price_10,
-    input  wire [31:0] price_11,
-    input  wire [31:0] price_12,
-    input  wire [31:0] price_13,
-    input  wire [31:0] price_14,
-    input  wire [31:0] price_15,
-    input  wire [31:0] price_16,
-    input  wire [31:0] price_17,
-    input  wire [31:0] price_18,
-    input  wire [31:0] price_19,
-    input  wire [31:0] price_20,
+    input  wire [15:0] window_size,         // Window the running sum covers
+    input  wire [63:0] window_sum,          // Signed fixed point, 24 fraction bits
+    input  wire        window_sum_valid,    // Sum is exact for window_size
     input  wire [15:0] buffer_count,        // Current buffer fill
+    input  wire [31:0] price_in,            // Price written on tick
 
     // Result
     output reg  [31:0] result,              // Calculation result (IEEE 754 float)
     output reg         result_valid,        // Result is valid (pulse)
-    output reg         error                // Error flag
+    output reg         error,               // Error flag
+    output wire        busy,                // Manual operations in flight
+
+    // Compute-All Results (updated when a compute-all succeeds)
+    output wire [31:0] stats_sma,
+    output wire [31:0] stats_std_dev,
+    output wire [31:0] stats_min,
+    output wire [31:0] stats_max,
+    output wire [31:0] stats_boll_upper,
+    output wire [31:0] stats_boll_lower,
+
+    // Auto-Compute Result (to calculator_result_fifo)
+    output reg  [31:0] auto_result,
+    output reg         auto_result_valid,   // Pulse
+    output reg         auto_error,
+    output reg  [3:0]  auto_op,
+    output reg  [15:0] auto_seq,
+    output reg         auto_lost            // Queued operations were dropped (pulse)
 );
 
 // ============================================================================
@@ -60,227 +86,558 @@ localparam OP_BOLL_DN    = 4'd11;  // Bollinger Lower Band
 localparam OP_MIN        = 4'd12;  // Minimum
 localparam OP_MAX        = 4'd13;  // Maximum
 localparam OP_RANGE      = 4'd14;  // Range (Max - Min)
+localparam OP_ALL        = 4'd15;  // SMA, STD_DEV, MIN, MAX, Bollinger
 
 // ============================================================================
-// State Machine
+// Pipeline Geometry
 // ============================================================================
-localparam STATE_IDLE        = 3'b000;
-localparam STATE_SMA_SUM     = 3'b001;
-localparam STATE_SMA_DIV     = 3'b010;
-localparam STATE_WAIT_FP     = 3'b011;
-localparam STATE_DONE        = 3'b100;
+localparam CONVERT_LATENCY = 2;                         // Fixed point to float
+localparam MULT_LATENCY    = 5;                         // altfp_mult32
 
-reg [2:0] state, next_state;
-reg [7:0] price_index;              // Current price being processed
-reg [31:0] accumulator;             // Accumulator for sum
-reg [3:0] fp_wait_counter;          // Wait counter for FP operations
+// Start to result_valid: input register, conversion, multiplier, output register
+localparam PIPE_LATENCY  = 1 + CONVERT_LATENCY + MULT_LATENCY + 1;   // 9 cycles
+localparam PIPE_DEPTH    = PIPE_LATENCY - 1;            // Sideband stages
 
 // ============================================================================
-// Floating Point Unit Interface
+// Window Length
 // ============================================================================
-// We'll reuse the basic calculator_float_ops for ADD and DIV
-wire [31:0] fp_result;
-wire        fp_result_valid;
-wire        fp_error;
-reg  [1:0]  fp_operation;           // 0=ADD, 3=DIV
-reg  [31:0] fp_operand_a;
-reg  [31:0] fp_operand_b;
-reg         fp_start;
-
-calculator_float_ops fp_unit (
-    .clk           (clk),
-    .reset_n       (reset_n),
-    .operation     (fp_operation),
-    .operand_a     (fp_operand_a),
-    .operand_b     (fp_operand_b),
-    .start         (fp_start),
-    .result        (fp_result),
-    .result_valid  (fp_result_valid),
-    .error         (fp_error)
-);
+// calculator_window_operation() passes the length in OPERAND_B as a float.
+// It is truncated to an integer like the software model does. Negative
+// values, values below 1 or of 512 and above, NaN and infinity give 0.
+// SMA needs the length to equal the buffer's window (the driver contract
+// for calculator_sma()) and the buffer to hold that many prices.
+wire        window_sign = window_operand[31];
+wire [7:0]  window_exp  = window_operand[30:23];
+wire [23:0] window_int  = {1'b1, window_operand[22:0]} >> (8'd150 - window_exp);
+wire        window_in_range = !window_sign && (window_exp >= 8'd127) && (window_exp <= 8'd135);
+wire [8:0]  window_length   = window_in_range ? window_int[8:0] : 9'd0;   // < 512
 
 // ============================================================================
-// Price Selector - Mux to select current price from buffer
+// Auto-Compute Sequencer
 // ============================================================================
-reg [31:0] current_price;
-
-always @(*) begin
-    case (price_index)
-        8'd0:  current_price = price_0;
-        8'd1:  current_price = price_1;
-        8'd2:  current_price = price_2;
-        8'd3:  current_price = price_3;
-        8'd4:  current_price = price_4;
-        8'd5:  current_price = price_5;
-        8'd6:  current_price = price_6;
-        8'd7:  current_price = price_7;
-        8'd8:  current_price = price_8;
-        8'd9:  current_price = price_9;
-        8'd10: current_price = price_10;
-        8'd11: current_price = price_11;
-        8'd12: current_price = price_12;
-        8'd13: current_price = price_13;
-        8'd14: current_price = price_14;
-        8'd15: current_price = price_15;
-        8'd16: current_price = price_16;
-        8'd17: current_price = price_17;
-        8'd18: current_price = price_18;
-        8'd19: current_price = price_19;
-        8'd20: current_price = price_20;
-        default: current_price = 32'h0;
-    endcase
-end
+// The buffer updates its sum on the tick edge, so an operation issued the
+// cycle after the tick sees the new price
+reg  [15:0] pending_ops;
+reg  [15:0] pending_seq;
+
+// Lowest pending operation code
+function [3:0] lowest_op;
+    input [15:0] ops;
+    integer b;
+    begin
+        lowest_op = 4'd0;
+        for (b = 15; b >= 0; b = b - 1) begin
+            if (ops[b]) begin
+                lowest_op = b[3:0];
+            end
+        end
+    end
+endfunction
+
+wire        auto_issue   = !start && (pending_ops != 16'h0);
+wire [3:0]  pending_op   = lowest_op(pending_ops);
+wire [15:0] pending_left = auto_issue ? (pending_ops & ~(16'h1 << pending_op)) : pending_ops;
 
-// ============================================================================
-// State Machine - Sequential Logic
-// ============================================================================
 always @(posedge clk or negedge reset_n) begin
     if (!reset_n) begin
-        state <= STATE_IDLE;
-        price_index <= 8'h0;
-        accumulator <= 32'h0;
-        fp_wait_counter <= 4'h0;
-        result <= 32'h0;
-        result_valid <= 1'b0;
-        error <= 1'b0;
-        fp_start <= 1'b0;
+        pending_ops <= 16'h0;
+        pending_seq <= 16'h0;
+        auto_lost   <= 1'b0;
     end else begin
-        state <= next_state;
-
-        // Default: fp_start is a pulse
-        fp_start <= 1'b0;
-
-        case (state)
-            STATE_IDLE: begin
-                result_valid <= 1'b0;
-                error <= 1'b0;
-                price_index <= 8'h0;
-                accumulator <= 32'h0;
-                fp_wait_counter <= 4'h0;
-            end
+        auto_lost <= tick && (pending_left != 16'h0);
 
-            STATE_SMA_SUM: begin
-                // Sum prices iteratively
-                if (price_index == 8'h0) begin
-                    // First price: initialize accumulator
-                    accumulator <= current_price;
-                    price_index <= price_index + 1'b1;
-                end else if (price_index < window_size) begin
-                    // Add next price using FP unit
-                    fp_operation <= 2'b00;  // ADD
-                    fp_operand_a <= accumulator;
-                    fp_operand_b <= current_price;
-                    fp_start <= 1'b1;
-                    state <= STATE_WAIT_FP;
-                end
-            end
+        if (tick) begin
+            pending_ops <= auto_ops;
+            pending_seq <= tick_seq;
+        end else begin
+            pending_ops <= pending_left;
+        end
+    end
+end
 
-            STATE_WAIT_FP: begin
-                // Wait for FP operation to complete
-                if (fp_result_valid) begin
-                    if (next_state == STATE_SMA_SUM) begin
-                        // Store sum result and continue
-                        accumulator <= fp_result;
-                        price_index <= price_index + 1'b1;
-                    end else if (next_state == STATE_DONE) begin
-                        // Final result ready
-                        result <= fp_result;
-                        result_valid <= 1'b1;
-                        error <= fp_error;
-                    end
-                end
-            end
+// ============================================================================
+// Issue
+// ============================================================================
+// Auto operations run over the configured window instead of OPERAND_B
+wire        issue        = start || auto_issue;
+wire [3:0]  issue_op     = start ? operation : pending_op;
+wire [8:0]  issue_length = start ? window_length : window_size[8:0];
 
-            STATE_SMA_DIV: begin
-                // Divide sum by window_size
-                // Convert window_size (uint16) to float for division
-                // For now, simplified: assume window_size as float bits
-                fp_operation <= 2'b11;  // DIV
-                fp_operand_a <= accumulator;  // sum
-                fp_operand_b <= {16'h0, window_size};  // FIXME: Need uint to float conversion
-                fp_start <= 1'b1;
-                state <= STATE_WAIT_FP;
-            end
+wire window_ok = (issue_length != 9'd0) &&
+                 ({7'h0, issue_length} == window_size) &&
+                 (buffer_count >= window_size) &&
+                 window_sum_valid;
 
-            STATE_DONE: begin
-                result_valid <= 1'b1;
-                state <= STATE_IDLE;
-            end
+// Compute-all is manual only, one at a time
+wire all_start = start && (operation == OP_ALL);
+wire stats_busy;
+wire stats_done;
+wire stats_error;
+
+wire issue_ok = window_ok &&
+                ((issue_op == OP_SMA) || (all_start && !stats_busy));
+
+// Reciprocal of the window length (IEEE 754, round to nearest)
+function [31:0] window_reciprocal;
+    input [8:0] length;
+    begin
+        case (length)
+            9'd1:    window_reciprocal = 32'h3F800000;
+            9'd2:    window_reciprocal = 32'h3F000000;
+            9'd3:    window_reciprocal = 32'h3EAAAAAB;
+            9'd4:    window_reciprocal = 32'h3E800000;
+            9'd5:    window_reciprocal = 32'h3E4CCCCD;
+            9'd6:    window_reciprocal = 32'h3E2AAAAB;
+            9'd7:    window_reciprocal = 32'h3E124925;
+            9'd8:    window_reciprocal = 32'h3E000000;
+            9'd9:    window_reciprocal = 32'h3DE38E39;
+            9'd10:   window_reciprocal = 32'h3DCCCCCD;
+            9'd11:   window_reciprocal = 32'h3DBA2E8C;
+            9'd12:   window_reciprocal = 32'h3DAAAAAB;
+            9'd13:   window_reciprocal = 32'h3D9D89D9;
+            9'd14:   window_reciprocal = 32'h3D924925;
+            9'd15:   window_reciprocal = 32'h3D888889;
+            9'd16:   window_reciprocal = 32'h3D800000;
+            9'd17:   window_reciprocal = 32'h3D70F0F1;
+            9'd18:   window_reciprocal = 32'h3D638E39;
+            9'd19:   window_reciprocal = 32'h3D579436;
+            9'd20:   window_reciprocal = 32'h3D4CCCCD;
+            9'd21:   window_reciprocal = 32'h3D430C31;
+            9'd22:   window_reciprocal = 32'h3D3A2E8C;
+            9'd23:   window_reciprocal = 32'h3D321643;
+            9'd24:   window_reciprocal = 32'h3D2AAAAB;
+            9'd25:   window_reciprocal = 32'h3D23D70A;
+            9'd26:   window_reciprocal = 32'h3D1D89D9;
+            9'd27:   window_reciprocal = 32'h3D17B426;
+            9'd28:   window_reciprocal = 32'h3D124925;
+            9'd29:   window_reciprocal = 32'h3D0D3DCB;
+            9'd30:   window_reciprocal = 32'h3D088889;
+            9'd31:   window_reciprocal = 32'h3D042108;
+            9'd32:   window_reciprocal = 32'h3D000000;
+            9'd33:   window_reciprocal = 32'h3CF83E10;
+            9'd34:   window_reciprocal = 32'h3CF0F0F1;
+            9'd35:   window_reciprocal = 32'h3CEA0EA1;
+            9'd36:   window_reciprocal = 32'h3CE38E39;
+            9'd37:   window_reciprocal = 32'h3CDD67C9;
+            9'd38:   window_reciprocal = 32'h3CD79436;
+            9'd39:   window_reciprocal = 32'h3CD20D21;
+            9'd40:   window_reciprocal = 32'h3CCCCCCD;
+            9'd41:   window_reciprocal = 32'h3CC7CE0C;
+            9'd42:   window_reciprocal = 32'h3CC30C31;
+            9'd43:   window_reciprocal = 32'h3CBE82FA;
+            9'd44:   window_reciprocal = 32'h3CBA2E8C;
+            9'd45:   window_reciprocal = 32'h3CB60B61;
+            9'd46:   window_reciprocal = 32'h3CB21643;
+            9'd47:   window_reciprocal = 32'h3CAE4C41;
+            9'd48:   window_reciprocal = 32'h3CAAAAAB;
+            9'd49:   window_reciprocal = 32'h3CA72F05;
+            9'd50:   window_reciprocal = 32'h3CA3D70A;
+            9'd51:   window_reciprocal = 32'h3CA0A0A1;
+            9'd52:   window_reciprocal = 32'h3C9D89D9;
+            9'd53:   window_reciprocal = 32'h3C9A90E8;
+            9'd54:   window_reciprocal = 32'h3C97B426;
+            9'd55:   window_reciprocal = 32'h3C94F209;
+            9'd56:   window_reciprocal = 32'h3C924925;
+            9'd57:   window_reciprocal = 32'h3C8FB824;
+            9'd58:   window_reciprocal = 32'h3C8D3DCB;
+            9'd59:   window_reciprocal = 32'h3C8AD8F3;
+            9'd60:   window_reciprocal = 32'h3C888889;
+            9'd61:   window_reciprocal = 32'h3C864B8A;
+            9'd62:   window_reciprocal = 32'h3C842108;
+            9'd63:   window_reciprocal = 32'h3C820821;
+            9'd64:   window_reciprocal = 32'h3C800000;
+            9'd65:   window_reciprocal = 32'h3C7C0FC1;
+            9'd66:   window_reciprocal = 32'h3C783E10;
+            9'd67:   window_reciprocal = 32'h3C74898D;
+            9'd68:   window_reciprocal = 32'h3C70F0F1;
+            9'd69:   window_reciprocal = 32'h3C6D7304;
+            9'd70:   window_reciprocal = 32'h3C6A0EA1;
+            9'd71:   window_reciprocal = 32'h3C66C2B4;
+            9'd72:   window_reciprocal = 32'h3C638E39;
+            9'd73:   window_reciprocal = 32'h3C607038;
+            9'd74:   window_reciprocal = 32'h3C5D67C9;
+            9'd75:   window_reciprocal = 32'h3C5A740E;
+            9'd76:   window_reciprocal = 32'h3C579436;
+            9'd77:   window_reciprocal = 32'h3C54C77B;
+            9'd78:   window_reciprocal = 32'h3C520D21;
+            9'd79:   window_reciprocal = 32'h3C4F6475;
+            9'd80:   window_reciprocal = 32'h3C4CCCCD;
+            9'd81:   window_reciprocal = 32'h3C4A4588;
+            9'd82:   window_reciprocal = 32'h3C47CE0C;
+            9'd83:   window_reciprocal = 32'h3C4565C8;
+            9'd84:   window_reciprocal = 32'h3C430C31;
+            9'd85:   window_reciprocal = 32'h3C40C0C1;
+            9'd86:   window_reciprocal = 32'h3C3E82FA;
+            9'd87:   window_reciprocal = 32'h3C3C5264;
+            9'd88:   window_reciprocal = 32'h3C3A2E8C;
+            9'd89:   window_reciprocal = 32'h3C381703;
+            9'd90:   window_reciprocal = 32'h3C360B61;
+            9'd91:   window_reciprocal = 32'h3C340B41;
+            9'd92:   window_reciprocal = 32'h3C321643;
+            9'd93:   window_reciprocal = 32'h3C302C0B;
+            9'd94:   window_reciprocal = 32'h3C2E4C41;
+            9'd95:   window_reciprocal = 32'h3C2C7692;
+            9'd96:   window_reciprocal = 32'h3C2AAAAB;
+            9'd97:   window_reciprocal = 32'h3C28E83F;
+            9'd98:   window_reciprocal = 32'h3C272F05;
+            9'd99:   window_reciprocal = 32'h3C257EB5;
+            9'd100:  window_reciprocal = 32'h3C23D70A;
+            9'd101:  window_reciprocal = 32'h3C2237C3;
+            9'd102:  window_reciprocal = 32'h3C20A0A1;
+            9'd103:  window_reciprocal = 32'h3C1F1166;
+            9'd104:  window_reciprocal = 32'h3C1D89D9;
+            9'd105:  window_reciprocal = 32'h3C1C09C1;
+            9'd106:  window_reciprocal = 32'h3C1A90E8;
+            9'd107:  window_reciprocal = 32'h3C191F1A;
+            9'd108:  window_reciprocal = 32'h3C17B426;
+            9'd109:  window_reciprocal = 32'h3C164FDA;
+            9'd110:  window_reciprocal = 32'h3C14F209;
+            9'd111:  window_reciprocal = 32'h3C139A86;
+            9'd112:  window_reciprocal = 32'h3C124925;
+            9'd113:  window_reciprocal = 32'h3C10FDBC;
+            9'd114:  window_reciprocal = 32'h3C0FB824;
+            9'd115:  window_reciprocal = 32'h3C0E7835;
+            9'd116:  window_reciprocal = 32'h3C0D3DCB;
+            9'd117:  window_reciprocal = 32'h3C0C08C1;
+            9'd118:  window_reciprocal = 32'h3C0AD8F3;
+            9'd119:  window_reciprocal = 32'h3C09AE41;
+            9'd120:  window_reciprocal = 32'h3C088889;
+            9'd121:  window_reciprocal = 32'h3C0767AB;
+            9'd122:  window_reciprocal = 32'h3C064B8A;
+            9'd123:  window_reciprocal = 32'h3C053408;
+            9'd124:  window_reciprocal = 32'h3C042108;
+            9'd125:  window_reciprocal = 32'h3C03126F;
+            9'd126:  window_reciprocal = 32'h3C020821;
+            9'd127:  window_reciprocal = 32'h3C010204;
+            9'd128:  window_reciprocal = 32'h3C000000;
+            9'd129:  window_reciprocal = 32'h3BFE03F8;
+            9'd130:  window_reciprocal = 32'h3BFC0FC1;
+            9'd131:  window_reciprocal = 32'h3BFA232D;
+            9'd132:  window_reciprocal = 32'h3BF83E10;
+            9'd133:  window_reciprocal = 32'h3BF6603E;
+            9'd134:  window_reciprocal = 32'h3BF4898D;
+            9'd135:  window_reciprocal = 32'h3BF2B9D6;
+            9'd136:  window_reciprocal = 32'h3BF0F0F1;
+            9'd137:  window_reciprocal = 32'h3BEF2EB7;
+            9'd138:  window_reciprocal = 32'h3BED7304;
+            9'd139:  window_reciprocal = 32'h3BEBBDB3;
+            9'd140:  window_reciprocal = 32'h3BEA0EA1;
+            9'd141:  window_reciprocal = 32'h3BE865AC;
+            9'd142:  window_reciprocal = 32'h3BE6C2B4;
+            9'd143:  window_reciprocal = 32'h3BE52598;
+            9'd144:  window_reciprocal = 32'h3BE38E39;
+            9'd145:  window_reciprocal = 32'h3BE1FC78;
+            9'd146:  window_reciprocal = 32'h3BE07038;
+            9'd147:  window_reciprocal = 32'h3BDEE95C;
+            9'd148:  window_reciprocal = 32'h3BDD67C9;
+            9'd149:  window_reciprocal = 32'h3BDBEB62;
+            9'd150:  window_reciprocal = 32'h3BDA740E;
+            9'd151:  window_reciprocal = 32'h3BD901B2;
+            9'd152:  window_reciprocal = 32'h3BD79436;
+            9'd153:  window_reciprocal = 32'h3BD62B81;
+            9'd154:  window_reciprocal = 32'h3BD4C77B;
+            9'd155:  window_reciprocal = 32'h3BD3680D;
+            9'd156:  window_reciprocal = 32'h3BD20D21;
+            9'd157:  window_reciprocal = 32'h3BD0B6A0;
+            9'd158:  window_reciprocal = 32'h3BCF6475;
+            9'd159:  window_reciprocal = 32'h3BCE168A;
+            9'd160:  window_reciprocal = 32'h3BCCCCCD;
+            9'd161:  window_reciprocal = 32'h3BCB8728;
+            9'd162:  window_reciprocal = 32'h3BCA4588;
+            9'd163:  window_reciprocal = 32'h3BC907DA;
+            9'd164:  window_reciprocal = 32'h3BC7CE0C;
+            9'd165:  window_reciprocal = 32'h3BC6980C;
+            9'd166:  window_reciprocal = 32'h3BC565C8;
+            9'd167:  window_reciprocal = 32'h3BC43730;
+            9'd168:  window_reciprocal = 32'h3BC30C31;
+            9'd169:  window_reciprocal = 32'h3BC1E4BC;
+            9'd170:  window_reciprocal = 32'h3BC0C0C1;
+            9'd171:  window_reciprocal = 32'h3BBFA030;
+            9'd172:  window_reciprocal = 32'h3BBE82FA;
+            9'd173:  window_reciprocal = 32'h3BBD6910;
+            9'd174:  window_reciprocal = 32'h3BBC5264;
+            9'd175:  window_reciprocal = 32'h3BBB3EE7;
+            9'd176:  window_reciprocal = 32'h3BBA2E8C;
+            9'd177:  window_reciprocal = 32'h3BB92144;
+            9'd178:  window_reciprocal = 32'h3BB81703;
+            9'd179:  window_reciprocal = 32'h3BB70FBB;
+            9'd180:  window_reciprocal = 32'h3BB60B61;
+            9'd181:  window_reciprocal = 32'h3BB509E7;
+            9'd182:  window_reciprocal = 32'h3BB40B41;
+            9'd183:  window_reciprocal = 32'h3BB30F63;
+            9'd184:  window_reciprocal = 32'h3BB21643;
+            9'd185:  window_reciprocal = 32'h3BB11FD4;
+            9'd186:  window_reciprocal = 32'h3BB02C0B;
+            9'd187:  window_reciprocal = 32'h3BAF3ADE;
+            9'd188:  window_reciprocal = 32'h3BAE4C41;
+            9'd189:  window_reciprocal = 32'h3BAD602B;
+            9'd190:  window_reciprocal = 32'h3BAC7692;
+            9'd191:  window_reciprocal = 32'h3BAB8F6A;
+            9'd192:  window_reciprocal = 32'h3BAAAAAB;
+            9'd193:  window_reciprocal = 32'h3BA9C84A;
+            9'd194:  window_reciprocal = 32'h3BA8E83F;
+            9'd195:  window_reciprocal = 32'h3BA80A81;
+            9'd196:  window_reciprocal = 32'h3BA72F05;
+            9'd197:  window_reciprocal = 32'h3BA655C4;
+            9'd198:  window_reciprocal = 32'h3BA57EB5;
+            9'd199:  window_reciprocal = 32'h3BA4A9CF;
+            9'd200:  window_reciprocal = 32'h3BA3D70A;
+            9'd201:  window_reciprocal = 32'h3BA3065E;
+            9'd202:  window_reciprocal = 32'h3BA237C3;
+            9'd203:  window_reciprocal = 32'h3BA16B31;
+            9'd204:  window_reciprocal = 32'h3BA0A0A1;
+            9'd205:  window_reciprocal = 32'h3B9FD80A;
+            9'd206:  window_reciprocal = 32'h3B9F1166;
+            9'd207:  window_reciprocal = 32'h3B9E4CAD;
+            9'd208:  window_reciprocal = 32'h3B9D89D9;
+            9'd209:  window_reciprocal = 32'h3B9CC8E1;
+            9'd210:  window_reciprocal = 32'h3B9C09C1;
+            9'd211:  window_reciprocal = 32'h3B9B4C70;
+            9'd212:  window_reciprocal = 32'h3B9A90E8;
+            9'd213:  window_reciprocal = 32'h3B99D723;
+            9'd214:  window_reciprocal = 32'h3B991F1A;
+            9'd215:  window_reciprocal = 32'h3B9868C8;
+            9'd216:  window_reciprocal = 32'h3B97B426;
+            9'd217:  window_reciprocal = 32'h3B97012E;
+            9'd218:  window_reciprocal = 32'h3B964FDA;
+            9'd219:  window_reciprocal = 32'h3B95A025;
+            9'd220:  window_reciprocal = 32'h3B94F209;
+            9'd221:  window_reciprocal = 32'h3B944581;
+            9'd222:  window_reciprocal = 32'h3B939A86;
+            9'd223:  window_reciprocal = 32'h3B92F114;
+            9'd224:  window_reciprocal = 32'h3B924925;
+            9'd225:  window_reciprocal = 32'h3B91A2B4;
+            9'd226:  window_reciprocal = 32'h3B90FDBC;
+            9'd227:  window_reciprocal = 32'h3B905A38;
+            9'd228:  window_reciprocal = 32'h3B8FB824;
+            9'd229:  window_reciprocal = 32'h3B8F177A;
+            9'd230:  window_reciprocal = 32'h3B8E7835;
+            9'd231:  window_reciprocal = 32'h3B8DDA52;
+            9'd232:  window_reciprocal = 32'h3B8D3DCB;
+            9'd233:  window_reciprocal = 32'h3B8CA29C;
+            9'd234:  window_reciprocal = 32'h3B8C08C1;
+            9'd235:  window_reciprocal = 32'h3B8B7034;
+            9'd236:  window_reciprocal = 32'h3B8AD8F3;
+            9'd237:  window_reciprocal = 32'h3B8A42F8;
+            9'd238:  window_reciprocal = 32'h3B89AE41;
+            9'd239:  window_reciprocal = 32'h3B891AC7;
+            9'd240:  window_reciprocal = 32'h3B888889;
+            9'd241:  window_reciprocal = 32'h3B87F781;
+            9'd242:  window_reciprocal = 32'h3B8767AB;
+            9'd243:  window_reciprocal = 32'h3B86D905;
+            9'd244:  window_reciprocal = 32'h3B864B8A;
+            9'd245:  window_reciprocal = 32'h3B85BF37;
+            9'd246:  window_reciprocal = 32'h3B853408;
+            9'd247:  window_reciprocal = 32'h3B84A9FA;
+            9'd248:  window_reciprocal = 32'h3B842108;
+            9'd249:  window_reciprocal = 32'h3B839930;
+            9'd250:  window_reciprocal = 32'h3B83126F;
+            9'd251:  window_reciprocal = 32'h3B828CC0;
+            9'd252:  window_reciprocal = 32'h3B820821;
+            9'd253:  window_reciprocal = 32'h3B81848E;
+            9'd254:  window_reciprocal = 32'h3B810204;
+            9'd255:  window_reciprocal = 32'h3B808081;
+            9'd256:  window_reciprocal = 32'h3B800000;
+            default: window_reciprocal = 32'h00000000;
         endcase
     end
+endfunction
+
+// Index of the most significant set bit
+function [5:0] msb_index;
+    input [63:0] value;
+    integer b;
+    begin
+        msb_index = 6'd0;
+        for (b = 0; b < 64; b = b + 1) begin
+            if (value[b]) begin
+                msb_index = b[5:0];
+            end
+        end
+    end
+endfunction
+
+// ============================================================================
+// Input Stage
+// ============================================================================
+reg [63:0] sum_in;
+
+always @(posedge clk) begin
+    if (issue) begin
+        sum_in <= window_sum;
+    end
 end
 
 // ============================================================================
-// State Machine - Combinational Logic
+// Fixed Point to Float (CONVERT_LATENCY = 2)
 // ============================================================================
-always @(*) begin
-    next_state = state;
-
-    case (state)
-        STATE_IDLE: begin
-            if (start) begin
-                // Check if buffer has enough data
-                if (buffer_count < window_size) begin
-                    // Error: insufficient data
-                    next_state = STATE_DONE;  // Will set error flag
-                end else begin
-                    case (operation)
-                        OP_SMA: begin
-                            next_state = STATE_SMA_SUM;
-                        end
-
-                        OP_EMA: begin
-                            // EMA: alpha × price_0 + (1-alpha) × prev_EMA
-                            // Simplified implementation (needs extension)
-                            next_state = STATE_DONE;
-                        end
-
-                        OP_MIN, OP_MAX: begin
-                            // MIN/MAX: iterate through window finding min/max
-                            next_state = STATE_DONE;  // Placeholder
-                        end
-
-                        default: begin
-                            // Unsupported operation
-                            next_state = STATE_DONE;
-                        end
-                    endcase
-                end
-            end
-        end
+// Stage 1: sign and magnitude, leading one
+reg        sum_sign;
+reg [63:0] sum_magnitude;
+reg [5:0]  sum_msb;
 
-        STATE_SMA_SUM: begin
-            if (price_index >= window_size) begin
-                // All prices summed, now divide
-                next_state = STATE_SMA_DIV;
-            end
-            // Stay in SMA_SUM or go to WAIT_FP if FP operation started
-        end
+wire [63:0] sum_abs = sum_in[63] ? -sum_in : sum_in;
 
-        STATE_WAIT_FP: begin
-            if (fp_result_valid) begin
-                if (price_index < window_size) begin
-                    // More prices to sum
-                    next_state = STATE_SMA_SUM;
-                end else begin
-                    // Division complete, done
-                    next_state = STATE_DONE;
-                end
-            end
-        end
+always @(posedge clk) begin
+    sum_sign      <= sum_in[63];
+    sum_magnitude <= sum_abs;
+    sum_msb       <= msb_index(sum_abs);
+end
 
-        STATE_SMA_DIV: begin
-            // Transition handled in sequential logic
-        end
+// Stage 2: normalise to 1.23 and round to nearest even. A value with its
+// leading one at bit p is 1.x * 2^(p - 24), biased exponent p + 103.
+wire [63:0] sum_normalized = sum_magnitude << (6'd63 - sum_msb);
+wire        sum_round_up   = sum_normalized[39] &&
+                             (sum_normalized[40] || (|sum_normalized[38:0]));
+wire [23:0] sum_mantissa   = {1'b0, sum_normalized[62:40]} + sum_round_up;
+wire [7:0]  sum_exponent   = {2'b0, sum_msb} + 8'd103 + sum_mantissa[23];
+
+reg [31:0] sum_float;
 
-        STATE_DONE: begin
-            next_state = STATE_IDLE;
+always @(posedge clk) begin
+    if (sum_magnitude == 64'h0) begin
+        sum_float <= 32'h0;
+    end else begin
+        sum_float <= {sum_sign, sum_exponent, sum_mantissa[22:0]};
+    end
+end
+
+// ============================================================================
+// Sideband Pipeline
+// ============================================================================
+// Valid, error and window length travel alongside the data, and auto
+// operations carry their {seq, op} tag
+reg [PIPE_DEPTH-1:0] valid_pipe;
+reg [PIPE_DEPTH-1:0] error_pipe;
+reg [PIPE_DEPTH-1:0] auto_pipe;
+reg [PIPE_DEPTH-1:0] all_pipe;               // Compute-all, handed to the stats unit
+reg [8:0]            window_pipe [0:CONVERT_LATENCY];
+reg [19:0]           tag_pipe    [0:PIPE_DEPTH-1];
+
+integer i;
+always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+        valid_pipe <= {PIPE_DEPTH{1'b0}};
+        error_pipe <= {PIPE_DEPTH{1'b0}};
+        auto_pipe  <= {PIPE_DEPTH{1'b0}};
+        all_pipe   <= {PIPE_DEPTH{1'b0}};
+    end else begin
+        valid_pipe <= {valid_pipe[PIPE_DEPTH-2:0], issue};
+        error_pipe <= {error_pipe[PIPE_DEPTH-2:0], issue && !issue_ok};
+        auto_pipe  <= {auto_pipe[PIPE_DEPTH-2:0], auto_issue};
+        all_pipe   <= {all_pipe[PIPE_DEPTH-2:0], all_start && issue_ok};
+    end
+end
+
+always @(posedge clk) begin
+    window_pipe[0] <= issue_length;
+    for (i = 1; i <= CONVERT_LATENCY; i = i + 1) begin
+        window_pipe[i] <= window_pipe[i-1];
+    end
+
+    tag_pipe[0] <= {pending_seq, pending_op};
+    for (i = 1; i < PIPE_DEPTH; i = i + 1) begin
+        tag_pipe[i] <= tag_pipe[i-1];
+    end
+end
+
+// The stats unit goes idle on the edge that raises stats_done; busy holds
+// for that cycle so STATUS never reads idle before done and error update
+assign busy = start || (|(valid_pipe & ~auto_pipe)) || stats_busy || stats_done;
+
+// ============================================================================
+// Mean - Sum x (1 / window)
+// ============================================================================
+wire [31:0] reciprocal = window_reciprocal(window_pipe[CONVERT_LATENCY]);
+wire [31:0] mean;
+
+altfp_mult32 reciprocal_multiplier (
+    .clock      (clk),
+    .dataa      (sum_float),
+    .datab      (reciprocal),
+    .result     (mean),
+    .overflow   (),
+    .underflow  (),
+    .nan        ()
+);
+
+// ============================================================================
+// Output Stage
+// ============================================================================
+// A NaN or infinite mean is an error, as in the software model
+wire out_valid  = valid_pipe[PIPE_DEPTH-1];
+wire out_auto   = auto_pipe[PIPE_DEPTH-1];
+wire out_error  = error_pipe[PIPE_DEPTH-1] || (mean[30:23] == 8'hFF);
+wire out_all    = all_pipe[PIPE_DEPTH-1];
+
+// ============================================================================
+// Compute-All Statistics
+// ============================================================================
+calculator_window_stats window_stats (
+    .clk               (clk),
+    .reset_n           (reset_n),
+
+    // Price Stream
+    .price_in          (price_in),
+    .write_enable      (tick),
+
+    // Control
+    .start             (all_start && issue_ok),
+    .window_length     (window_length),
+    .scale             (window_reciprocal(window_length - 9'd1)),
+    .mean_valid        (out_valid && out_all),
+    .mean              (mean),
+    .mean_error        (out_error),
+
+    // Results
+    .sma               (stats_sma),
+    .std_dev           (stats_std_dev),
+    .minimum           (stats_min),
+    .maximum           (stats_max),
+    .boll_upper        (stats_boll_upper),
+    .boll_lower        (stats_boll_lower),
+    .done              (stats_done),
+    .error             (stats_error),
+    .busy              (stats_busy)
+);
+
+always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+        result <= 32'h0;
+        result_valid <= 1'b0;
+        error <= 1'b0;
+    end else begin
+        // A compute-all completes when the stats unit is done
+        result_valid <= (out_valid && !out_auto && !out_all) || stats_done;
+
+        if (out_valid && !out_auto) begin
+            result <= mean;
+            error  <= out_error;
+        end else if (stats_done) begin
+            error  <= stats_error;
+        end else if (start) begin
+            // Clear error on new operation
+            error  <= 1'b0;
         end
+    end
+end
 
-        default: begin
-            next_state = STATE_IDLE;
+always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+        auto_result <= 32'h0;
+        auto_result_valid <= 1'b0;
+        auto_error <= 1'b0;
+        auto_op <= 4'h0;
+        auto_seq <= 16'h0;
+    end else begin
+        auto_result_valid <= out_valid && out_auto;
+
+        if (out_valid && out_auto) begin
+            auto_result <= mean;
+            auto_error  <= out_error;
+            {auto_seq, auto_op} <= tag_pipe[PIPE_DEPTH-1];
         end
-    endcase
+    end
 end
 
 endmodule
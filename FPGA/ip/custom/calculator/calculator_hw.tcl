@@ -39,6 +39,26 @@ add_fileset_file calculator_float_ops.v      VERILOG PATH calculator_float_ops.v
 add_fileset_file calculator_led_display.v    VERILOG PATH calculator_led_display.v
 add_fileset_file calculator_price_buffer.v   VERILOG PATH calculator_price_buffer.v
 add_fileset_file calculator_hft_ops.v        VERILOG PATH calculator_hft_ops.v
+add_fileset_file calculator_result_fifo.v    VERILOG PATH calculator_result_fifo.v
+add_fileset_file calculator_window_stats.v   VERILOG PATH calculator_window_stats.v
+
+# ALTFP_SQRT megafunction (IP Catalog: single precision, 16-cycle pipeline,
+# overflow and nan outputs) generated as altfp_sqrt32.v in this directory.
+# The altfp_sqrt32 in calculator_float_ops.v is a simulation-only stub that
+# returns zero and is hidden from synthesis.
+set altfp_sqrt32_file [file join [file dirname [info script]] altfp_sqrt32.v]
+if {[file exists $altfp_sqrt32_file]} {
+    add_fileset_file altfp_sqrt32.v          VERILOG PATH altfp_sqrt32.v
+}
+
+set_module_property VALIDATION_CALLBACK validate
+
+proc validate {} {
+    global altfp_sqrt32_file
+    if {![file exists $altfp_sqrt32_file]} {
+        send_message error "altfp_sqrt32.v not found: generate the ALTFP_SQRT megafunction (single precision, 16-cycle pipeline) next to calculator_hw.tcl. The stub in calculator_float_ops.v is for simulation only."
+    }
+}
 
 # ============================================================================
 # Parameters
@@ -73,8 +93,10 @@ add_interface_port reset reset_n reset_n Input 1
 # ============================================================================
 # Avalon-MM Slave Interface
 # ============================================================================
+# calculator_avalon_mm.v decodes a byte address (avs_address[6:2]) and the
+# register file registers readdata, so: SYMBOLS addressing, read latency 1
 add_interface s0 avalon end
-set_interface_property s0 addressUnits WORDS
+set_interface_property s0 addressUnits SYMBOLS
 set_interface_property s0 associatedClock clock
 set_interface_property s0 associatedReset reset
 set_interface_property s0 bitsPerSymbol 8
@@ -85,7 +107,7 @@ set_interface_property s0 holdTime 0
 set_interface_property s0 linewrapBursts false
 set_interface_property s0 maximumPendingReadTransactions 0
 set_interface_property s0 maximumPendingWriteTransactions 0
-set_interface_property s0 readLatency 0
+set_interface_property s0 readLatency 1
 set_interface_property s0 readWaitTime 1
 set_interface_property s0 setupTime 0
 set_interface_property s0 timingUnits Cycles
@@ -96,7 +118,7 @@ set_interface_property s0 PORT_NAME_MAP ""
 set_interface_property s0 CMSIS_SVD_VARIABLES ""
 set_interface_property s0 SVD_ADDRESS_GROUP ""
 
-add_interface_port s0 avs_s0_address address Input 6
+add_interface_port s0 avs_s0_address address Input 7
 add_interface_port s0 avs_s0_read read Input 1
 add_interface_port s0 avs_s0_write write Input 1
 add_interface_port s0 avs_s0_writedata writedata Input 32
@@ -108,8 +130,8 @@ set_interface_assignment s0 embeddedsw.configuration.isMemoryDevice 0
 set_interface_assignment s0 embeddedsw.configuration.isNonVolatileStorage 0
 set_interface_assignment s0 embeddedsw.configuration.isPrintableDevice 0
 
-# Memory map - 16 registers x 4 bytes = 64 bytes total (extended for HFT)
-set_module_assignment embeddedsw.CMacro.SIZE 64
+# Memory map - 32 registers x 4 bytes = 128 bytes total (extended for HFT)
+set_module_assignment embeddedsw.CMacro.SIZE 128
 set_module_assignment embeddedsw.CMacro.CONTROL 0x00
 set_module_assignment embeddedsw.CMacro.OPERAND_A 0x04
 set_module_assignment embeddedsw.CMacro.OPERAND_B 0x08
@@ -122,7 +144,16 @@ set_module_assignment embeddedsw.CMacro.BUFFER_COUNT 0x20
 set_module_assignment embeddedsw.CMacro.EMA_ALPHA 0x24
 set_module_assignment embeddedsw.CMacro.CONFIG_FLAGS 0x28
 set_module_assignment embeddedsw.CMacro.ERROR_CODE 0x2C
+set_module_assignment embeddedsw.CMacro.RESULT_FIFO_STATUS 0x30
+set_module_assignment embeddedsw.CMacro.RESULT_FIFO_TAG 0x34
+set_module_assignment embeddedsw.CMacro.RESULT_FIFO_DATA 0x38
 set_module_assignment embeddedsw.CMacro.VERSION 0x3C
+set_module_assignment embeddedsw.CMacro.STATS_SMA 0x40
+set_module_assignment embeddedsw.CMacro.STATS_STD_DEV 0x44
+set_module_assignment embeddedsw.CMacro.STATS_MIN 0x48
+set_module_assignment embeddedsw.CMacro.STATS_MAX 0x4C
+set_module_assignment embeddedsw.CMacro.STATS_BOLL_UP 0x50
+set_module_assignment embeddedsw.CMacro.STATS_BOLL_DN 0x54
 
 # ============================================================================
 # Interrupt Sender Interface
@@ -3,6 +3,19 @@
 // ============================================================================
 // Circular buffer for storing price history for HFT calculations
 // Implemented using on-chip M10K RAM blocks
+//
+// Alongside the prices the buffer keeps a running sum of the newest
+// window_size of them, updated on every write_enable: the new price is
+// added and the price leaving the window subtracted, so the sum is ready
+// the cycle after the tick for any window length.
+//
+// The sum is kept in signed fixed point (24 fraction bits). Integer adds
+// and subtracts are exact, so the sum never drifts however many prices
+// pass through: a price leaves the sum as exactly the value it entered
+// with. It is rebuilt from the RAM only when window_size changes without a
+// buffer reset, by one pass over the window (window_size + 2 cycles).
+// Writes during the pass are folded into it, so it finishes however fast
+// prices arrive.
 // ============================================================================
 
 module calculator_price_buffer (
@@ -18,45 +31,135 @@ module calculator_price_buffer (
     // Configuration
     input  wire [15:0] window_size,         // Configurable window (1-256)
 
-    // Read Interface (entire buffer output)
-    output wire [31:0] price_out_0,         // Price[0] - most recent
-    output wire [31:0] price_out_1,         // Price[1]
-    output wire [31:0] price_out_2,         // Price[2]
-    output wire [31:0] price_out_3,         // Price[3]
-    output wire [31:0] price_out_4,         // Price[4]
-    output wire [31:0] price_out_5,         // Price[5]
-    output wire [31:0] price_out_6,         // Price[6]
-    output wire [31:0] price_out_7,         // Price[7]
-    output wire [31:0] price_out_8,         // Price[8]
-    output wire [31:0] price_out_9,         // Price[9]
-    output wire [31:0] price_out_10,        // Price[10]
-    output wire [31:0] price_out_11,        // Price[11]
-    output wire [31:0] price_out_12,        // Price[12]
-    output wire [31:0] price_out_13,        // Price[13]
-    output wire [31:0] price_out_14,        // Price[14]
-    output wire [31:0] price_out_15,        // Price[15]
-    output wire [31:0] price_out_16,        // Price[16]
-    output wire [31:0] price_out_17,        // Price[17]
-    output wire [31:0] price_out_18,        // Price[18]
-    output wire [31:0] price_out_19,        // Price[19]
-    output wire [31:0] price_out_20,        // Price[20] - for SMA(20)
-    // ... extend up to 255 if needed for larger windows
+    // Running Sum (newest min(count, window_size) prices)
+    output reg  [63:0] window_sum,          // Signed fixed point, 24 fraction bits
+    output wire        window_sum_valid,    // Sum is exact for the current window
 
     // Status
     output reg  [15:0] count,               // Current fill count
-    output reg         buffer_full          // Buffer filled to window_size
+    output wire        buffer_full          // Buffer filled to window_size
 );
 
+// ============================================================================
+// Parameters
+// ============================================================================
+localparam DEPTH     = 256;                 // Price RAM entries
+
+// ============================================================================
+// Fixed-Point Conversion
+// ============================================================================
+// Returns {out_of_range, value}. Prices of 2^31 or more in magnitude,
+// infinities and NaN are out of range (value 0); a window holding one
+// makes the sum invalid until it leaves. Denormals read as zero, and bits
+// below 2^-24 are truncated toward zero.
+function [64:0] price_to_fixed;
+    input [31:0] price;
+    reg [7:0]  exponent;
+    reg [63:0] magnitude;
+    begin
+        exponent = price[30:23];
+        if (exponent == 8'd0) begin
+            price_to_fixed = 65'h0;
+        end else if (exponent >= 8'd158) begin
+            price_to_fixed = {1'b1, 64'h0};
+        end else begin
+            // {1.mantissa} x 2^(exponent - 127 - 23 + 24)
+            if (exponent >= 8'd126) begin
+                magnitude = {40'h0, 1'b1, price[22:0]} << (exponent - 8'd126);
+            end else begin
+                magnitude = {40'h0, 1'b1, price[22:0]} >> (8'd126 - exponent);
+            end
+            price_to_fixed = {1'b0, price[31] ? -magnitude : magnitude};
+        end
+    end
+endfunction
+
 // ============================================================================
 // RAM Storage
 // ============================================================================
-// Using register array for prices (will be inferred as M10K RAM by Quartus)
-// Supporting up to 256 prices (8-bit address)
-reg [31:0] price_ram [0:255];
+// One write port and one synchronous read port, so Quartus infers M10K.
+// The read port serves the running sum (the price leaving the window) or
+// the resynchronisation pass.
+reg [31:0] price_ram [0:DEPTH-1];
 
 // Write pointer (circular)
 reg [7:0] write_ptr;
 
+wire [7:0] write_ptr_next = buffer_reset ? 8'h0 :
+                            write_enable ? write_ptr + 1'b1 : write_ptr;
+
+reg        resync_active;
+reg [7:0]  resync_addr;
+wire       resync_issue;                    // The pass reads resync_addr this cycle
+reg [31:0] ram_q;
+reg        bypass;                          // Read hit the entry being written
+reg [31:0] bypass_price;
+
+// Oldest price in the window after this cycle's write; it leaves on the
+// next write once the window is full
+wire [7:0]  leaving_addr = write_ptr_next - window_size[7:0];
+wire [7:0]  read_addr    = resync_issue ? resync_addr : leaving_addr;
+wire [31:0] read_price   = bypass ? bypass_price : ram_q;
+
+always @(posedge clk) begin
+    if (write_enable && !buffer_reset) begin
+        price_ram[write_ptr] <= price_in;
+    end
+    ram_q <= price_ram[read_addr];
+
+    // Window of 1: the price leaving next is the one written now
+    bypass       <= write_enable && (read_addr == write_ptr);
+    bypass_price <= price_in;
+end
+
+// ============================================================================
+// Running Sum
+// ============================================================================
+wire [64:0] new_fixed  = price_to_fixed(price_in);
+wire [64:0] read_fixed = price_to_fixed(read_price);
+
+reg  [8:0]  bad_count;                      // Out-of-range prices in the sum
+reg  [15:0] sum_window;                     // window_size the sum was built for
+reg         sum_synced;
+
+// Resynchronisation pass
+reg  [8:0]  resync_remaining;               // Reads still to issue
+reg         resync_read;                    // A read was issued last cycle
+reg  [63:0] resync_sum;
+reg  [8:0]  resync_bad;
+
+wire        window_full     = (count >= window_size);
+wire        window_changed  = (window_size != sum_window);
+wire        window_in_range = (window_size != 16'd0) && (window_size <= DEPTH);
+wire [15:0] sum_length      = window_full ? window_size : count;
+
+// The pass reads newest first. A price written meanwhile joins its sum; the
+// price that leaves a full window then is the oldest one the pass has not
+// read yet, so that read is skipped, or if it is in flight its value is
+// not added. With nothing left to read it is one already in the sum, and
+// the read port fetched it as the leaving price last cycle.
+wire        resync_drop = write_enable && window_full;
+wire        resync_done = (resync_remaining == 9'h0);
+wire [8:0]  resync_left = resync_remaining -
+                          ((resync_drop && !resync_done) ? 9'd1 : 9'd0);
+wire        resync_take = resync_read && !(resync_drop && resync_done);
+wire        resync_sub  = resync_drop && resync_done && !resync_read;
+wire [63:0] resync_add  = (resync_take  ? read_fixed[63:0] : 64'h0) +
+                          (write_enable ? new_fixed[63:0]  : 64'h0) -
+                          (resync_sub   ? read_fixed[63:0] : 64'h0);
+wire [8:0]  resync_add_bad = (resync_take  ? {8'h0, read_fixed[64]} : 9'h0) +
+                             (write_enable ? {8'h0, new_fixed[64]}  : 9'h0) -
+                             (resync_sub   ? {8'h0, read_fixed[64]} : 9'h0);
+
+assign resync_issue = resync_active && (resync_left != 9'h0);
+
+assign window_sum_valid = sum_synced && !window_changed && window_in_range &&
+                          (bad_count == 9'd0);
+
+// Full for the current window, also after window_size changes without a
+// buffer reset
+assign buffer_full = (window_size != 16'd0) && window_full;
+
 // ============================================================================
 // Buffer Management Logic
 // ============================================================================
@@ -64,62 +167,69 @@ always @(posedge clk or negedge reset_n) begin
     if (!reset_n) begin
         write_ptr <= 8'h0;
         count <= 16'h0;
-        buffer_full <= 1'b0;
+        window_sum <= 64'h0;
+        bad_count <= 9'h0;
+        sum_window <= 16'h0;
+        sum_synced <= 1'b1;
+        resync_active <= 1'b0;
+        resync_addr <= 8'h0;
+        resync_remaining <= 9'h0;
+        resync_read <= 1'b0;
+        resync_sum <= 64'h0;
+        resync_bad <= 9'h0;
     end else begin
+        write_ptr <= write_ptr_next;
+
         if (buffer_reset) begin
-            // Reset buffer
-            write_ptr <= 8'h0;
+            // Reset buffer: an empty window sums to zero
             count <= 16'h0;
-            buffer_full <= 1'b0;
-        end else if (write_enable) begin
-            // Write new price to buffer
-            price_ram[write_ptr] <= price_in;
-
-            // Increment write pointer (circular)
-            write_ptr <= write_ptr + 1'b1;
-
+            window_sum <= 64'h0;
+            bad_count <= 9'h0;
+            sum_window <= window_size;
+            sum_synced <= 1'b1;
+            resync_active <= 1'b0;
+        end else begin
             // Update count (saturate at window_size)
-            if (count < window_size) begin
+            if (write_enable && (count < window_size)) begin
                 count <= count + 1'b1;
             end
 
-            // Update buffer_full flag
-            if (count >= (window_size - 1)) begin
-                buffer_full <= 1'b1;
+            if (window_changed) begin
+                // Start a pass over the newest sum_length prices before
+                // this cycle's write, which joins it at once
+                sum_window <= window_size;
+                sum_synced <= 1'b0;
+                resync_active <= window_in_range;
+                resync_addr <= write_ptr - 1'b1;
+                resync_remaining <= sum_length[8:0] - (resync_drop ? 9'd1 : 9'd0);
+                resync_read <= 1'b0;
+                resync_sum <= write_enable ? new_fixed[63:0] : 64'h0;
+                resync_bad <= write_enable ? {8'h0, new_fixed[64]} : 9'h0;
+            end else if (resync_active) begin
+                // Issue one read per cycle, accumulate it the cycle after
+                if (resync_issue) begin
+                    resync_addr <= resync_addr - 1'b1;
+                end
+                resync_remaining <= resync_left - (resync_issue ? 9'd1 : 9'd0);
+                resync_read <= resync_issue;
+                resync_sum <= resync_sum + resync_add;
+                resync_bad <= resync_bad + resync_add_bad;
+
+                // Done once the last read has been accumulated
+                if (resync_left == 9'h0) begin
+                    window_sum <= resync_sum + resync_add;
+                    bad_count <= resync_bad + resync_add_bad;
+                    sum_synced <= 1'b1;
+                    resync_active <= 1'b0;
+                end
+            end else if (write_enable) begin
+                window_sum <= window_sum + new_fixed[63:0] -
+                              (window_full ? read_fixed[63:0] : 64'h0);
+                bad_count <= bad_count + new_fixed[64] -
+                             (window_full ? read_fixed[64] : 1'b0);
             end
         end
     end
 end
 
-// ============================================================================
-// Read Interface - Output Recent Prices
-// ============================================================================
-// Output the most recent N prices in circular buffer order
-// price_out_0 is always the most recent, price_out_1 is second most recent, etc.
-
-assign price_out_0  = price_ram[(write_ptr - 1) & 8'hFF];  // Most recent
-assign price_out_1  = price_ram[(write_ptr - 2) & 8'hFF];
-assign price_out_2  = price_ram[(write_ptr - 3) & 8'hFF];
-assign price_out_3  = price_ram[(write_ptr - 4) & 8'hFF];
-assign price_out_4  = price_ram[(write_ptr - 5) & 8'hFF];
-assign price_out_5  = price_ram[(write_ptr - 6) & 8'hFF];
-assign price_out_6  = price_ram[(write_ptr - 7) & 8'hFF];
-assign price_out_7  = price_ram[(write_ptr - 8) & 8'hFF];
-assign price_out_8  = price_ram[(write_ptr - 9) & 8'hFF];
-assign price_out_9  = price_ram[(write_ptr - 10) & 8'hFF];
-assign price_out_10 = price_ram[(write_ptr - 11) & 8'hFF];
-assign price_out_11 = price_ram[(write_ptr - 12) & 8'hFF];
-assign price_out_12 = price_ram[(write_ptr - 13) & 8'hFF];
-assign price_out_13 = price_ram[(write_ptr - 14) & 8'hFF];
-assign price_out_14 = price_ram[(write_ptr - 15) & 8'hFF];
-assign price_out_15 = price_ram[(write_ptr - 16) & 8'hFF];
-assign price_out_16 = price_ram[(write_ptr - 17) & 8'hFF];
-assign price_out_17 = price_ram[(write_ptr - 18) & 8'hFF];
-assign price_out_18 = price_ram[(write_ptr - 19) & 8'hFF];
-assign price_out_19 = price_ram[(write_ptr - 20) & 8'hFF];
-assign price_out_20 = price_ram[(write_ptr - 21) & 8'hFF];
-
-// Note: For larger windows (up to 256), additional outputs can be added
-// or a read address interface can be implemented
-
 endmodule
@@ -11,7 +11,7 @@ module calculator_registers (
     input  wire        reset_n,
 
     // Avalon-MM Interface (from calculator_avalon_mm)
-    input  wire [3:0]  reg_address,        // Register address (byte aligned / 4)
+    input  wire [4:0]  reg_address,        // Register address (byte aligned / 4)
     input  wire        reg_write,          // Write enable
     input  wire        reg_read,           // Read enable
     input  wire [31:0] reg_writedata,      // Data to write
@@ -30,12 +30,31 @@ module calculator_registers (
     // Buffer Interface
     output reg  [31:0] buffer_price_write,  // Price to write to buffer
     output reg         buffer_write_enable, // Write enable pulse
+    output reg  [15:0] buffer_write_seq,    // Sequence number of the price written
     output reg         buffer_reset,        // Reset buffer
     output reg  [15:0] buffer_window_size,  // Window size configuration
     input  wire [15:0] buffer_count,        // Current buffer count
     input  wire        buffer_full,         // Buffer full flag
     output reg  [31:0] ema_alpha,           // EMA alpha parameter
 
+    // Auto-Compute and Result FIFO Interface
+    output wire [15:0] auto_ops,            // Operations run on each price write
+    input  wire [52:0] fifo_head,           // {error, op, seq, result}
+    input  wire        fifo_empty,
+    input  wire [6:0]  fifo_count,
+    input  wire        fifo_overflow,
+    output wire        fifo_pop,            // RESULT_FIFO_DATA read
+    output reg         fifo_flush,
+    output reg         fifo_clear_overflow,
+
+    // Compute-All Results (held until the next successful compute-all)
+    input  wire [31:0] stats_sma,
+    input  wire [31:0] stats_std_dev,
+    input  wire [31:0] stats_min,
+    input  wire [31:0] stats_max,
+    input  wire [31:0] stats_boll_upper,
+    input  wire [31:0] stats_boll_lower,
+
     // Interrupt
     output reg         calc_interrupt      // Interrupt output
 );
@@ -55,24 +74,44 @@ module calculator_registers (
 // 0x1C    | BUFFER_WRITE     | W      | Write price to circular buffer
 // 0x20    | BUFFER_COUNT     | R      | Current buffer fill count
 // 0x24    | EMA_ALPHA        | R/W    | Alpha parameter for EMA (32-bit float)
-// 0x28    | CONFIG_FLAGS     | R/W    | Configuration bits
+// 0x28    | CONFIG_FLAGS     | R/W    | [0]=auto_compute, [31:16]=auto op mask
 // 0x2C    | ERROR_CODE       | R      | Detailed error information
+// 0x30    | RESULT_FIFO_STAT | R/W    | [6:0]=count, [31]=overflow; write [0]=flush,
+//         |                  |        | [31]=clear overflow
+// 0x34    | RESULT_FIFO_TAG  | R      | Head entry: [31]=valid, [30]=error,
+//         |                  |        | [19:16]=operation, [15:0]=sequence
+// 0x38    | RESULT_FIFO_DATA | R      | Head result (float); the read pops it
 // 0x3C    | VERSION          | R      | IP version (0xHFT10001)
+// 0x40    | STATS_SMA        | R      | Compute-all: simple moving average
+// 0x44    | STATS_STD_DEV    | R      | Compute-all: sample standard deviation
+// 0x48    | STATS_MIN        | R      | Compute-all: window minimum
+// 0x4C    | STATS_MAX        | R      | Compute-all: window maximum
+// 0x50    | STATS_BOLL_UP    | R      | Compute-all: SMA + 2 x STD_DEV
+// 0x54    | STATS_BOLL_DN    | R      | Compute-all: SMA - 2 x STD_DEV
 // ============================================================================
 
-localparam  REG_CONTROL       = 4'h0;     // 0x00 / 4 = 0
-localparam  REG_OPERAND_A     = 4'h1;     // 0x04 / 4 = 1
-localparam  REG_OPERAND_B     = 4'h2;     // 0x08 / 4 = 2
-localparam  REG_RESULT        = 4'h3;     // 0x0C / 4 = 3
-localparam  REG_STATUS        = 4'h4;     // 0x10 / 4 = 4
-localparam  REG_INT_ENABLE    = 4'h5;     // 0x14 / 4 = 5
-localparam  REG_BUFFER_CTRL   = 4'h6;     // 0x18 / 4 = 6
-localparam  REG_BUFFER_WRITE  = 4'h7;     // 0x1C / 4 = 7
-localparam  REG_BUFFER_COUNT  = 4'h8;     // 0x20 / 4 = 8
-localparam  REG_EMA_ALPHA     = 4'h9;     // 0x24 / 4 = 9
-localparam  REG_CONFIG_FLAGS  = 4'hA;     // 0x28 / 4 = 10
-localparam  REG_ERROR_CODE    = 4'hB;     // 0x2C / 4 = 11
-localparam  REG_VERSION       = 4'hF;     // 0x3C / 4 = 15
+localparam  REG_CONTROL       = 5'h00;    // 0x00 / 4 = 0
+localparam  REG_OPERAND_A     = 5'h01;    // 0x04 / 4 = 1
+localparam  REG_OPERAND_B     = 5'h02;    // 0x08 / 4 = 2
+localparam  REG_RESULT        = 5'h03;    // 0x0C / 4 = 3
+localparam  REG_STATUS        = 5'h04;    // 0x10 / 4 = 4
+localparam  REG_INT_ENABLE    = 5'h05;    // 0x14 / 4 = 5
+localparam  REG_BUFFER_CTRL   = 5'h06;    // 0x18 / 4 = 6
+localparam  REG_BUFFER_WRITE  = 5'h07;    // 0x1C / 4 = 7
+localparam  REG_BUFFER_COUNT  = 5'h08;    // 0x20 / 4 = 8
+localparam  REG_EMA_ALPHA     = 5'h09;    // 0x24 / 4 = 9
+localparam  REG_CONFIG_FLAGS  = 5'h0A;    // 0x28 / 4 = 10
+localparam  REG_ERROR_CODE    = 5'h0B;    // 0x2C / 4 = 11
+localparam  REG_FIFO_STATUS   = 5'h0C;    // 0x30 / 4 = 12
+localparam  REG_FIFO_TAG      = 5'h0D;    // 0x34 / 4 = 13
+localparam  REG_FIFO_DATA     = 5'h0E;    // 0x38 / 4 = 14
+localparam  REG_VERSION       = 5'h0F;    // 0x3C / 4 = 15
+localparam  REG_STATS_SMA     = 5'h10;    // 0x40 / 4 = 16
+localparam  REG_STATS_STD_DEV = 5'h11;    // 0x44 / 4 = 17
+localparam  REG_STATS_MIN     = 5'h12;    // 0x48 / 4 = 18
+localparam  REG_STATS_MAX     = 5'h13;    // 0x4C / 4 = 19
+localparam  REG_STATS_BOLL_UP = 5'h14;    // 0x50 / 4 = 20
+localparam  REG_STATS_BOLL_DN = 5'h15;    // 0x54 / 4 = 21
 
 // Internal Registers
 reg [31:0] control_reg;
@@ -82,9 +121,16 @@ reg        int_enable_reg;
 reg        prev_calc_done;                // Edge detection for done signal
 reg [31:0] config_flags_reg;
 reg [31:0] error_code_reg;
+reg [15:0] price_seq;                     // Prices written since buffer reset
 
 // HFT Version constant
-localparam VERSION_CODE = 32'h00010001;   // HFT v1.0001 (version 1.0001)
+localparam VERSION_CODE = 32'h00010003;   // HFT v1.0003 (version 1.0003)
+
+// Auto-compute runs HFT operations only (codes 4-15)
+assign auto_ops = config_flags_reg[0] ? {config_flags_reg[31:20], 4'h0} : 16'h0;
+
+// A RESULT_FIFO_DATA read returns the head and pops it in the same cycle
+assign fifo_pop = reg_read && (reg_address == REG_FIFO_DATA) && !fifo_empty;
 
 // ============================================================================
 // Register Write Logic
@@ -101,6 +147,10 @@ always @(posedge clk or negedge reset_n) begin
         buffer_reset         <= 1'b0;
         buffer_write_enable  <= 1'b0;
         buffer_price_write   <= 32'h0;
+        buffer_write_seq     <= 16'h0;
+        price_seq            <= 16'h0;
+        fifo_flush           <= 1'b0;
+        fifo_clear_overflow  <= 1'b0;
         ema_alpha            <= 32'h3E4CCCCD; // Default α=0.2 (IEEE 754)
         config_flags_reg     <= 32'h0;
         error_code_reg       <= 32'h0;
@@ -109,6 +159,8 @@ always @(posedge clk or negedge reset_n) begin
         calc_start          <= 1'b0;
         buffer_write_enable <= 1'b0;
         buffer_reset        <= 1'b0;
+        fifo_flush          <= 1'b0;
+        fifo_clear_overflow <= 1'b0;
 
         if (reg_write) begin
             case (reg_address)
@@ -133,11 +185,16 @@ always @(posedge clk or negedge reset_n) begin
                 REG_BUFFER_CTRL: begin
                     buffer_window_size <= reg_writedata[15:0];
                     buffer_reset       <= reg_writedata[16];
+                    if (reg_writedata[16]) begin
+                        price_seq <= 16'h0;
+                    end
                 end
 
                 REG_BUFFER_WRITE: begin
                     buffer_price_write  <= reg_writedata;
                     buffer_write_enable <= 1'b1;  // Pulse for one cycle
+                    buffer_write_seq    <= price_seq;
+                    price_seq           <= price_seq + 1'b1;
                 end
 
                 REG_EMA_ALPHA: begin
@@ -148,6 +205,11 @@ always @(posedge clk or negedge reset_n) begin
                     config_flags_reg <= reg_writedata;
                 end
 
+                REG_FIFO_STATUS: begin
+                    fifo_flush          <= reg_writedata[0];
+                    fifo_clear_overflow <= reg_writedata[31];
+                end
+
                 default: begin
                     // Read-only or invalid registers - no action
                 end
@@ -209,10 +271,48 @@ always @(posedge clk or negedge reset_n) begin
                     reg_readdata <= error_code_reg;
                 end
 
+                REG_FIFO_STATUS: begin
+                    reg_readdata <= {fifo_overflow, 24'h0, fifo_count};
+                end
+
+                REG_FIFO_TAG: begin
+                    reg_readdata <= fifo_empty ? 32'h0 :
+                                    {1'b1, fifo_head[52], 10'h0,
+                                     fifo_head[51:48], fifo_head[47:32]};
+                end
+
+                REG_FIFO_DATA: begin
+                    reg_readdata <= fifo_empty ? 32'h0 : fifo_head[31:0];
+                end
+
                 REG_VERSION: begin
                     reg_readdata <= VERSION_CODE;
                 end
 
+                REG_STATS_SMA: begin
+                    reg_readdata <= stats_sma;
+                end
+
+                REG_STATS_STD_DEV: begin
+                    reg_readdata <= stats_std_dev;
+                end
+
+                REG_STATS_MIN: begin
+                    reg_readdata <= stats_min;
+                end
+
+                REG_STATS_MAX: begin
+                    reg_readdata <= stats_max;
+                end
+
+                REG_STATS_BOLL_UP: begin
+                    reg_readdata <= stats_boll_upper;
+                end
+
+                REG_STATS_BOLL_DN: begin
+                    reg_readdata <= stats_boll_lower;
+                end
+
                 default: begin
                     reg_readdata <= 32'h0;
                 end
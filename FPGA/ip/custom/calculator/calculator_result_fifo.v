@@ -0,0 +1,96 @@
+// ============================================================================
+// Calculator Result FIFO Module
+// ============================================================================
+// Holds the results of auto-compute operations until the HPS drains them
+// through RESULT_FIFO_TAG / RESULT_FIFO_DATA
+//
+// The head entry is read combinationally so the register file can return it
+// and pop it in the same read cycle; Quartus maps the array to MLAB. A push
+// into a full FIFO is dropped and sets the sticky overflow flag, as does a
+// lost pulse (results the sequencer could not issue). Overflow stays set
+// until the HPS clears it.
+// ============================================================================
+
+module calculator_result_fifo #(
+    parameter WIDTH      = 53,              // {error, op[3:0], seq[15:0], result[31:0]}
+    parameter ADDR_WIDTH = 6                // 64 entries
+) (
+    // Clock and Reset
+    input  wire                  clk,
+    input  wire                  reset_n,
+
+    // Write Side (from calculator_hft_ops)
+    input  wire                  push,
+    input  wire [WIDTH-1:0]      push_data,
+    input  wire                  lost,               // Results were dropped upstream
+
+    // Read Side (from calculator_registers)
+    input  wire                  pop,
+    input  wire                  flush,
+    input  wire                  clear_overflow,
+    output wire [WIDTH-1:0]      head,
+    output wire                  empty,
+    output reg  [ADDR_WIDTH:0]   count,
+    output reg                   overflow
+);
+
+// ============================================================================
+// Storage
+// ============================================================================
+localparam DEPTH = 1 << ADDR_WIDTH;
+
+reg [WIDTH-1:0]      fifo_ram [0:DEPTH-1];
+reg [ADDR_WIDTH-1:0] write_ptr;
+reg [ADDR_WIDTH-1:0] read_ptr;
+
+wire full     = (count == DEPTH);
+wire do_pop   = pop && !empty && !flush;
+wire do_push  = push && (!full || do_pop) && !flush;
+
+assign empty = (count == {(ADDR_WIDTH+1){1'b0}});
+assign head  = fifo_ram[read_ptr];
+
+always @(posedge clk) begin
+    if (do_push) begin
+        fifo_ram[write_ptr] <= push_data;
+    end
+end
+
+// ============================================================================
+// Pointers and Flags
+// ============================================================================
+always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+        write_ptr <= {ADDR_WIDTH{1'b0}};
+        read_ptr  <= {ADDR_WIDTH{1'b0}};
+        count     <= {(ADDR_WIDTH+1){1'b0}};
+        overflow  <= 1'b0;
+    end else begin
+        if (flush) begin
+            write_ptr <= {ADDR_WIDTH{1'b0}};
+            read_ptr  <= {ADDR_WIDTH{1'b0}};
+            count     <= {(ADDR_WIDTH+1){1'b0}};
+        end else begin
+            if (do_push) begin
+                write_ptr <= write_ptr + 1'b1;
+            end
+            if (do_pop) begin
+                read_ptr <= read_ptr + 1'b1;
+            end
+            if (do_push && !do_pop) begin
+                count <= count + 1'b1;
+            end else if (do_pop && !do_push) begin
+                count <= count - 1'b1;
+            end
+        end
+
+        // A clear in the same cycle as a new loss leaves the flag set
+        if ((push && full && !do_pop && !flush) || lost) begin
+            overflow <= 1'b1;
+        end else if (clear_overflow) begin
+            overflow <= 1'b0;
+        end
+    end
+end
+
+endmodule
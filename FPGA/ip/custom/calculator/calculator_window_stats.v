@@ -0,0 +1,405 @@
+// ============================================================================
+// Calculator Window Statistics Module
+// ============================================================================
+// Compute-all datapath: one pass over the window yields MIN, MAX and the
+// sample standard deviation; the Bollinger bands reuse the mean and sigma
+//
+// calculator_hft_ops captures the window on the issue cycle (start) and
+// hands over its SMA result as the mean (mean_valid). The pass then reads
+// the window oldest first, one price per clock, through three datapaths
+// running side by side:
+//
+//   MIN / MAX   compared as IEEE 754 bit patterns
+//   deviation   (price - mean) squared in float and summed in a 120-bit
+//               fixed-point register (48 fraction bits), one add per
+//               clock, without the interleaved partial sums a pipelined
+//               float adder would need
+//
+// After the pass: variance = sum x 1/(N - 1), sigma = sqrt(variance), and
+// mean +/- 2 sigma in two parallel adders. A window of 1 has sigma 0.
+//
+// The module keeps its own 512-entry copy of the price stream. The pass
+// never competes with the running sum for calculator_price_buffer's read
+// port, and with at most 256 prices in a window, writes during a pass land
+// only in slots the pass has already read.
+// ============================================================================
+
+module calculator_window_stats (
+    // Clock and Reset
+    input  wire        clk,
+    input  wire        reset_n,
+
+    // Price Stream (same writes as calculator_price_buffer)
+    input  wire [31:0] price_in,
+    input  wire        write_enable,
+
+    // Control (from calculator_hft_ops)
+    input  wire        start,               // Capture the window (pulse)
+    input  wire [8:0]  window_length,       // 1-256
+    input  wire [31:0] scale,               // 1 / (window_length - 1), 0 for 1
+    input  wire        mean_valid,          // Mean of the captured window (pulse)
+    input  wire [31:0] mean,
+    input  wire        mean_error,
+
+    // Results (updated only when an operation succeeds)
+    output reg  [31:0] sma,
+    output reg  [31:0] std_dev,
+    output reg  [31:0] minimum,
+    output reg  [31:0] maximum,
+    output reg  [31:0] boll_upper,
+    output reg  [31:0] boll_lower,
+    output reg         done,                // Pulse
+    output reg         error,
+    output wire        busy
+);
+
+// ============================================================================
+// Pipeline Geometry
+// ============================================================================
+localparam HISTORY_DEPTH = 512;
+localparam ADD_LATENCY   = 7;                           // altfp_add_sub32
+localparam MULT_LATENCY  = 5;                           // altfp_mult32
+localparam SQRT_LATENCY  = 16;                          // altfp_sqrt32
+
+// Read, deviation, square, fixed-point conversion
+localparam PASS_DEPTH    = 1 + ADD_LATENCY + MULT_LATENCY + 1;   // 14 cycles
+
+// Float conversion (2), x scale, sqrt, 2 sigma register, mean +/- 2 sigma
+localparam [5:0] FINISH_LATENCY = 2 + MULT_LATENCY + SQRT_LATENCY + 1 + ADD_LATENCY;
+
+localparam ACC_WIDTH     = 120;                         // 256 x 2^64 < 2^120
+localparam ACC_FRAC      = 48;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+// a < b for finite IEEE 754 values (-0 and +0 compare equal)
+function float_less;
+    input [31:0] a;
+    input [31:0] b;
+    begin
+        if (a[31] != b[31]) begin
+            float_less = a[31] && ((a[30:0] | b[30:0]) != 31'h0);
+        end else if (a[31]) begin
+            float_less = (a[30:0] > b[30:0]);
+        end else begin
+            float_less = (a[30:0] < b[30:0]);
+        end
+    end
+endfunction
+
+// A non-negative float in fixed point with ACC_FRAC fraction bits; bits
+// below 2^-48 are truncated, zero and denormals read as zero
+function [ACC_WIDTH-1:0] square_to_fixed;
+    input [31:0] value;
+    reg [7:0] exponent;
+    begin
+        exponent = value[30:23];
+        if (exponent == 8'd0) begin
+            square_to_fixed = {ACC_WIDTH{1'b0}};
+        end else if (exponent >= 8'd102) begin
+            // {1.mantissa} x 2^(exponent - 127 - 23 + 48)
+            square_to_fixed = {{(ACC_WIDTH-24){1'b0}}, 1'b1, value[22:0]} << (exponent - 8'd102);
+        end else begin
+            square_to_fixed = {{(ACC_WIDTH-24){1'b0}}, 1'b1, value[22:0]} >> (8'd102 - exponent);
+        end
+    end
+endfunction
+
+// Index of the most significant set bit
+function [6:0] msb_index;
+    input [ACC_WIDTH-1:0] value;
+    integer b;
+    begin
+        msb_index = 7'd0;
+        for (b = 0; b < ACC_WIDTH; b = b + 1) begin
+            if (value[b]) begin
+                msb_index = b[6:0];
+            end
+        end
+    end
+endfunction
+
+// ============================================================================
+// Price History
+// ============================================================================
+reg [31:0] history_ram [0:HISTORY_DEPTH-1];
+reg [8:0]  history_ptr;                     // Next slot to write
+reg [8:0]  scan_addr;
+reg [31:0] scan_price;
+
+always @(posedge clk) begin
+    if (write_enable) begin
+        history_ram[history_ptr] <= price_in;
+    end
+    scan_price <= history_ram[scan_addr];
+end
+
+always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+        history_ptr <= 9'h0;
+    end else if (write_enable) begin
+        history_ptr <= history_ptr + 1'b1;
+    end
+end
+
+// ============================================================================
+// Control
+// ============================================================================
+localparam S_IDLE   = 2'd0;
+localparam S_MEAN   = 2'd1;                 // Waiting for the SMA result
+localparam S_SCAN   = 2'd2;
+localparam S_FINISH = 2'd3;
+
+reg [1:0]  state;
+reg [8:0]  scan_length;
+reg [8:0]  scan_remaining;
+reg [31:0] mean_reg;
+reg [31:0] scale_reg;
+reg [5:0]  finish_count;
+
+reg [PASS_DEPTH-1:0] pass_pipe;             // Reads in flight, by stage
+wire scan_read = (state == S_SCAN) && (scan_remaining != 9'h0);
+wire pass_done = (state == S_SCAN) && (scan_remaining == 9'h0) && (pass_pipe == {PASS_DEPTH{1'b0}});
+
+assign busy = (state != S_IDLE);
+
+// ============================================================================
+// Pass Datapaths
+// ============================================================================
+// Stage 0: price out of the history RAM
+reg        first_price;
+reg [31:0] running_min;
+reg [31:0] running_max;
+
+always @(posedge clk) begin
+    if (state == S_MEAN) begin
+        first_price <= 1'b1;
+    end else if (pass_pipe[0]) begin
+        first_price <= 1'b0;
+        if (first_price || float_less(scan_price, running_min)) begin
+            running_min <= scan_price;
+        end
+        if (first_price || float_less(running_max, scan_price)) begin
+            running_max <= scan_price;
+        end
+    end
+end
+
+// Stages 1-7: deviation from the mean
+wire [31:0] deviation;
+
+altfp_add_sub32 deviation_subtractor (
+    .clock      (clk),
+    .dataa      (scan_price),
+    .datab      (mean_reg),
+    .add_sub    (1'b0),
+    .result     (deviation),
+    .overflow   (),
+    .underflow  (),
+    .nan        ()
+);
+
+// Stages 8-12: squared deviation
+wire [31:0] deviation_sq;
+
+altfp_mult32 deviation_squarer (
+    .clock      (clk),
+    .dataa      (deviation),
+    .datab      (deviation),
+    .result     (deviation_sq),
+    .overflow   (),
+    .underflow  (),
+    .nan        ()
+);
+
+// Stage 13: fixed point, then accumulate
+reg [ACC_WIDTH-1:0] square_fixed;
+reg [ACC_WIDTH-1:0] square_sum;
+
+always @(posedge clk) begin
+    square_fixed <= square_to_fixed(deviation_sq);
+
+    if (state == S_MEAN) begin
+        square_sum <= {ACC_WIDTH{1'b0}};
+    end else if (pass_pipe[PASS_DEPTH-1]) begin
+        square_sum <= square_sum + square_fixed;
+    end
+end
+
+// ============================================================================
+// Finish Datapaths
+// ============================================================================
+// Sum of squares to float (round to nearest even). A value with its
+// leading one at bit p is 1.x * 2^(p - 48), biased exponent p + 79.
+reg [ACC_WIDTH-1:0] sum_magnitude;
+reg [6:0]           sum_msb;
+
+always @(posedge clk) begin
+    sum_magnitude <= square_sum;
+    sum_msb       <= msb_index(square_sum);
+end
+
+wire [ACC_WIDTH-1:0] sum_normalized = sum_magnitude << (7'd119 - sum_msb);
+wire        sum_round_up = sum_normalized[95] &&
+                           (sum_normalized[96] || (|sum_normalized[94:0]));
+wire [23:0] sum_mantissa = {1'b0, sum_normalized[118:96]} + sum_round_up;
+wire [7:0]  sum_exponent = {1'b0, sum_msb} + 8'd79 + sum_mantissa[23];
+
+reg [31:0] sum_float;
+
+always @(posedge clk) begin
+    if (sum_magnitude == {ACC_WIDTH{1'b0}}) begin
+        sum_float <= 32'h0;
+    end else begin
+        sum_float <= {1'b0, sum_exponent, sum_mantissa[22:0]};
+    end
+end
+
+// Sample variance and standard deviation
+wire [31:0] variance;
+wire [31:0] sigma;
+
+altfp_mult32 variance_multiplier (
+    .clock      (clk),
+    .dataa      (sum_float),
+    .datab      (scale_reg),
+    .result     (variance),
+    .overflow   (),
+    .underflow  (),
+    .nan        ()
+);
+
+altfp_sqrt32 sigma_sqrt (
+    .clock      (clk),
+    .data       (variance),
+    .result     (sigma),
+    .overflow   (),
+    .nan        ()
+);
+
+// 2 sigma is exact: one more in the exponent (zero stays zero)
+reg [31:0] two_sigma;
+
+always @(posedge clk) begin
+    two_sigma <= (sigma[30:23] == 8'd0) ? 32'h0 : {sigma[31], sigma[30:23] + 8'd1, sigma[22:0]};
+end
+
+// Bollinger bands, side by side
+wire [31:0] band_upper;
+wire [31:0] band_lower;
+
+altfp_add_sub32 upper_adder (
+    .clock      (clk),
+    .dataa      (mean_reg),
+    .datab      (two_sigma),
+    .add_sub    (1'b1),
+    .result     (band_upper),
+    .overflow   (),
+    .underflow  (),
+    .nan        ()
+);
+
+altfp_add_sub32 lower_subtractor (
+    .clock      (clk),
+    .dataa      (mean_reg),
+    .datab      (two_sigma),
+    .add_sub    (1'b0),
+    .result     (band_lower),
+    .overflow   (),
+    .underflow  (),
+    .nan        ()
+);
+
+// Any NaN or infinity is an error, as in the software model
+wire finish_error = (sigma[30:23] == 8'hFF) ||
+                    (band_upper[30:23] == 8'hFF) ||
+                    (band_lower[30:23] == 8'hFF);
+
+// ============================================================================
+// State Machine
+// ============================================================================
+// Each finish stage holds its inputs until the results are taken, so
+// waiting FINISH_LATENCY cycles is enough to line them up
+always @(posedge clk or negedge reset_n) begin
+    if (!reset_n) begin
+        state <= S_IDLE;
+        scan_addr <= 9'h0;
+        scan_length <= 9'h0;
+        scan_remaining <= 9'h0;
+        mean_reg <= 32'h0;
+        scale_reg <= 32'h0;
+        finish_count <= 6'h0;
+        pass_pipe <= {PASS_DEPTH{1'b0}};
+        sma <= 32'h0;
+        std_dev <= 32'h0;
+        minimum <= 32'h0;
+        maximum <= 32'h0;
+        boll_upper <= 32'h0;
+        boll_lower <= 32'h0;
+        done <= 1'b0;
+        error <= 1'b0;
+    end else begin
+        done <= 1'b0;
+        pass_pipe <= {pass_pipe[PASS_DEPTH-2:0], scan_read};
+
+        case (state)
+            S_IDLE: begin
+                if (start) begin
+                    // The window as the running sum sees it this cycle
+                    scan_addr <= history_ptr - window_length;
+                    scan_length <= window_length;
+                    scale_reg <= scale;
+                    state <= S_MEAN;
+                end
+            end
+
+            S_MEAN: begin
+                if (mean_valid) begin
+                    if (mean_error) begin
+                        error <= 1'b1;
+                        done <= 1'b1;
+                        state <= S_IDLE;
+                    end else begin
+                        mean_reg <= mean;
+                        scan_remaining <= scan_length;
+                        state <= S_SCAN;
+                    end
+                end
+            end
+
+            S_SCAN: begin
+                if (scan_read) begin
+                    scan_addr <= scan_addr + 1'b1;
+                    scan_remaining <= scan_remaining - 1'b1;
+                end
+                if (pass_done) begin
+                    finish_count <= FINISH_LATENCY;
+                    state <= S_FINISH;
+                end
+            end
+
+            S_FINISH: begin
+                if (finish_count != 6'h0) begin
+                    finish_count <= finish_count - 1'b1;
+                end else begin
+                    if (!finish_error) begin
+                        sma <= mean_reg;
+                        std_dev <= sigma;
+                        minimum <= running_min;
+                        maximum <= running_max;
+                        boll_upper <= band_upper;
+                        boll_lower <= band_lower;
+                    end
+                    error <= finish_error;
+                    done <= 1'b1;
+                    state <= S_IDLE;
+                end
+            end
+
+            default: state <= S_IDLE;
+        endcase
+    end
+end
+
+endmodule
@@ -0,0 +1,456 @@
+// ============================================================================
+// Hot-Path Allocator Benchmark (alloc_bench)
+// ============================================================================
+// Times the per-tick allocation pattern (allocate a batch of small objects,
+// touch them, release them) through three allocators:
+//
+//   malloc   glibc malloc()/free()
+//   pool     mempool_t through a per-thread mempool_cache_t
+//   arena    arena_t, one arena_reset() per batch
+//
+// --threads adds a two-thread run in which one thread allocates and the
+// other frees, the decode -> strategy hand-off, where glibc pays for
+// cross-thread frees and the pool just migrates objects between caches.
+//
+// MALLOC_GUARD builds also offer --guard-selftest, which checks that the
+// pool and arena paths never reach the system allocator and that the
+// guard does catch a malloc() on an armed thread.
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include "mempool.h"
+#include "arena.h"
+#include "malloc_guard.h"
+#include "histogram.h"
+#include "rt_setup.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define DEFAULT_OBJECT_SIZE    96           // A book update with a few levels
+#define DEFAULT_BATCH          64           // Objects per batch (one recvmmsg() worth)
+#define DEFAULT_BATCHES        100000
+#define MAX_BATCH              1024
+#define HANDOFF_RING_SIZE      4096         // Producer -> consumer pointers (power of two)
+#define TOUCHED_BYTES          32           // Written per object, as a decoder would
+
+typedef enum {
+    ALLOC_MALLOC = 0,
+    ALLOC_POOL,
+    ALLOC_ARENA,
+    ALLOC_COUNT
+} allocator_t;
+
+static const char *allocator_names[ALLOC_COUNT] = { "malloc", "pool", "arena" };
+
+typedef struct {
+    size_t object_size;
+    uint32_t batch;
+    uint64_t batches;
+} bench_config_t;
+
+// ============================================================================
+// Global Variables
+// ============================================================================
+static void *batch_objects[MAX_BATCH];
+static void *volatile sink;                 // Keeps the compiler from eliding malloc/free pairs
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline void touch_object(void *object, uint64_t value) {
+    memset(object, (int)(value & 0xFF), TOUCHED_BYTES);
+    sink = object;
+}
+
+// ============================================================================
+// Single-Thread Batches
+// ============================================================================
+
+// One batch through the selected allocator; returns 0, or -1 if it ran dry
+static int run_batch(allocator_t allocator, const bench_config_t *config,
+                     mempool_cache_t *cache, arena_t *arena, uint64_t seed) {
+    uint32_t n = config->batch;
+
+    switch (allocator) {
+    case ALLOC_MALLOC:
+        for (uint32_t i = 0; i < n; i++) {
+            batch_objects[i] = malloc(config->object_size);
+            if (batch_objects[i] == NULL) {
+                return -1;
+            }
+            touch_object(batch_objects[i], seed + i);
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            free(batch_objects[i]);
+        }
+        break;
+
+    case ALLOC_POOL:
+        for (uint32_t i = 0; i < n; i++) {
+            batch_objects[i] = mempool_alloc(cache);
+            if (batch_objects[i] == NULL) {
+                return -1;
+            }
+            touch_object(batch_objects[i], seed + i);
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            mempool_free(cache, batch_objects[i]);
+        }
+        break;
+
+    case ALLOC_ARENA:
+        for (uint32_t i = 0; i < n; i++) {
+            batch_objects[i] = arena_alloc(arena, config->object_size);
+            if (batch_objects[i] == NULL) {
+                return -1;
+            }
+            touch_object(batch_objects[i], seed + i);
+        }
+        arena_reset(arena);
+        break;
+
+    default:
+        return -1;
+    }
+    return 0;
+}
+
+static int bench_single(allocator_t allocator, const bench_config_t *config,
+                        mempool_t *pool, arena_t *arena) {
+    histogram_t latency;
+    mempool_cache_t cache;
+    char label[32];
+
+    snprintf(label, sizeof(label), "%s batch", allocator_names[allocator]);
+    histogram_init(&latency, label);
+    mempool_cache_init(&cache, pool);
+
+    uint64_t start_ns = now_ns();
+    for (uint64_t b = 0; b < config->batches; b++) {
+        uint64_t t0 = now_ns();
+        if (run_batch(allocator, config, &cache, arena, b) != 0) {
+            fprintf(stderr, "%s: out of memory at batch %llu\n", allocator_names[allocator],
+                    (unsigned long long)b);
+            mempool_cache_flush(&cache);
+            return -1;
+        }
+        histogram_record(&latency, now_ns() - t0);
+    }
+    uint64_t elapsed_ns = now_ns() - start_ns;
+    mempool_cache_flush(&cache);
+
+    uint64_t objects = config->batches * config->batch;
+    histogram_print_summary(&latency, stdout);
+    printf("  %-24s %.1f ns per object (alloc + touch + release)\n", "",
+           (double)elapsed_ns / (double)objects);
+    return 0;
+}
+
+// ============================================================================
+// Cross-Thread Hand-Off
+// ============================================================================
+typedef struct {
+    allocator_t allocator;
+    mempool_t *pool;
+    void *ring[HANDOFF_RING_SIZE];
+    uint32_t head;                          // Written by the producer
+    uint32_t tail;                          // Written by the consumer
+    bool producer_done;
+    uint64_t objects;
+    uint64_t full_spins;                    // Producer found the ring full
+    mempool_cache_t consumer_cache;
+} handoff_t;
+
+static void *consumer_thread(void *arg) {
+    handoff_t *handoff = (handoff_t *)arg;
+    uint32_t tail = 0;
+
+    mempool_cache_init(&handoff->consumer_cache, handoff->pool);
+    for (;;) {
+        uint32_t head = __atomic_load_n(&handoff->head, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            if (__atomic_load_n(&handoff->producer_done, __ATOMIC_ACQUIRE) &&
+                __atomic_load_n(&handoff->head, __ATOMIC_ACQUIRE) == tail) {
+                break;
+            }
+            continue;
+        }
+        while (tail != head) {
+            void *object = handoff->ring[tail & (HANDOFF_RING_SIZE - 1)];
+            sink = object;
+            if (handoff->allocator == ALLOC_POOL) {
+                mempool_free(&handoff->consumer_cache, object);
+            } else {
+                free(object);
+            }
+            tail++;
+        }
+        __atomic_store_n(&handoff->tail, tail, __ATOMIC_RELEASE);
+    }
+    mempool_cache_flush(&handoff->consumer_cache);
+    return NULL;
+}
+
+static int bench_handoff(allocator_t allocator, const bench_config_t *config, mempool_t *pool) {
+    static handoff_t handoff;
+    mempool_cache_t producer_cache;
+    pthread_t consumer;
+    uint32_t head = 0;
+    int ret = 0;
+
+    memset(&handoff, 0, sizeof(handoff));
+    handoff.allocator = allocator;
+    handoff.pool = pool;
+    mempool_cache_init(&producer_cache, pool);
+
+    if (pthread_create(&consumer, NULL, consumer_thread, &handoff) != 0) {
+        fprintf(stderr, "pthread_create failed\n");
+        return -1;
+    }
+
+    uint64_t total = config->batches * config->batch;
+    uint64_t start_ns = now_ns();
+    for (uint64_t i = 0; i < total; i++) {
+        void *object = allocator == ALLOC_POOL ? mempool_alloc(&producer_cache)
+                                               : malloc(config->object_size);
+        if (object == NULL) {
+            fprintf(stderr, "%s: out of memory after %llu objects\n", allocator_names[allocator],
+                    (unsigned long long)i);
+            ret = -1;
+            break;
+        }
+        touch_object(object, i);
+
+        while (head - __atomic_load_n(&handoff.tail, __ATOMIC_ACQUIRE) >= HANDOFF_RING_SIZE) {
+            handoff.full_spins++;
+        }
+        handoff.ring[head & (HANDOFF_RING_SIZE - 1)] = object;
+        head++;
+        if ((head & (config->batch - 1)) == 0 || i + 1 == total) {
+            __atomic_store_n(&handoff.head, head, __ATOMIC_RELEASE);
+        }
+    }
+    __atomic_store_n(&handoff.head, head, __ATOMIC_RELEASE);
+    __atomic_store_n(&handoff.producer_done, true, __ATOMIC_RELEASE);
+    pthread_join(consumer, NULL);
+    uint64_t elapsed_ns = now_ns() - start_ns;
+
+    printf("%-24s %llu objects, %.1f ns per object, %.2f M objects/s\n",
+           allocator_names[allocator], (unsigned long long)head,
+           head ? (double)elapsed_ns / (double)head : 0.0,
+           elapsed_ns ? (double)head * 1000.0 / (double)elapsed_ns : 0.0);
+    if (allocator == ALLOC_POOL) {
+        printf("  %-22s producer cache: %llu refills, consumer cache: %llu drains\n", "",
+               (unsigned long long)producer_cache.refills,
+               (unsigned long long)handoff.consumer_cache.drains);
+    }
+    mempool_cache_flush(&producer_cache);
+    return ret;
+}
+
+// ============================================================================
+// Guard Self-Test
+// ============================================================================
+
+static int guard_selftest(const bench_config_t *config, mempool_t *pool, arena_t *arena) {
+    mempool_cache_t cache;
+    int ret = 0;
+
+    mempool_cache_init(&cache, pool);
+
+    // Pool and arena: must not reach the system allocator at all
+    uint64_t before = malloc_guard_violations();
+    malloc_guard_arm();
+    for (uint64_t b = 0; b < 1000 && ret == 0; b++) {
+        if (run_batch(ALLOC_POOL, config, &cache, arena, b) != 0 ||
+            run_batch(ALLOC_ARENA, config, &cache, arena, b) != 0) {
+            ret = -1;
+        }
+    }
+    malloc_guard_disarm();
+    uint64_t pool_violations = malloc_guard_violations() - before;
+    printf("Guard: pool + arena batches     %llu violations (expected 0)\n",
+           (unsigned long long)pool_violations);
+    if (pool_violations != 0) {
+        ret = -1;
+    }
+
+    // A deliberate malloc() on the armed thread must be caught
+    before = malloc_guard_violations();
+    malloc_guard_arm();
+    sink = malloc(config->object_size);
+    malloc_guard_disarm();
+    free(sink);
+    uint64_t malloc_violations = malloc_guard_violations() - before;
+    printf("Guard: deliberate malloc()      %llu violations (expected 1)\n",
+           (unsigned long long)malloc_violations);
+    if (malloc_violations != 1) {
+        ret = -1;
+    }
+
+    mempool_cache_flush(&cache);
+    printf("Guard self-test %s\n", ret == 0 ? "passed" : "FAILED");
+    return ret;
+}
+
+// ============================================================================
+// Usage
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("\n");
+    printf("Per-batch allocate/touch/release latency through malloc, an object pool\n");
+    printf("and a bump arena.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  -h, --help          Show this help message\n");
+    printf("  -n N                Batches per allocator (default: %d)\n", DEFAULT_BATCHES);
+    printf("  --batch N           Objects per batch, power of two up to %d (default: %d)\n",
+           MAX_BATCH, DEFAULT_BATCH);
+    printf("  --size BYTES        Object size (default: %d)\n", DEFAULT_OBJECT_SIZE);
+    printf("  --only NAME         Run one allocator: malloc, pool or arena\n");
+    printf("  --threads           Also run the cross-thread hand-off (malloc, pool)\n");
+    printf("  --guard-selftest    Check the allocator guard (make MALLOC_GUARD=1)\n");
+    printf("  --cpu N             Pin to CPU N\n");
+    printf("  --rt-priority N     SCHED_FIFO priority (default: 0 = SCHED_OTHER)\n");
+    printf("  --no-mlock          Do not lock and pre-fault memory\n");
+    printf("\n");
+    printf("Typical run on the board: %s --cpu 1 --rt-priority 80 --threads\n", program_name);
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+int main(int argc, char *argv[]) {
+    bench_config_t config = {
+        .object_size = DEFAULT_OBJECT_SIZE,
+        .batch = DEFAULT_BATCH,
+        .batches = DEFAULT_BATCHES,
+    };
+    int only = -1;
+    bool threads = false;
+    bool selftest = false;
+    bool lock_memory = true;
+    int cpu = -1;
+    int rt_priority = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            config.batches = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            config.batch = (uint32_t)atoi(argv[++i]);
+            if (config.batch == 0 || config.batch > MAX_BATCH ||
+                (config.batch & (config.batch - 1)) != 0) {
+                fprintf(stderr, "Invalid batch: %s (power of two, 1-%d)\n", argv[i], MAX_BATCH);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            config.object_size = (size_t)atoi(argv[++i]);
+            if (config.object_size < sizeof(void *) || config.object_size < TOUCHED_BYTES) {
+                fprintf(stderr, "Invalid size: %s (at least %d bytes)\n", argv[i], TOUCHED_BYTES);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--only") == 0 && i + 1 < argc) {
+            i++;
+            for (int a = 0; a < ALLOC_COUNT; a++) {
+                if (strcmp(argv[i], allocator_names[a]) == 0) {
+                    only = a;
+                }
+            }
+            if (only < 0) {
+                fprintf(stderr, "Unknown allocator: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            threads = true;
+        } else if (strcmp(argv[i], "--guard-selftest") == 0) {
+            if (!malloc_guard_enabled()) {
+                fprintf(stderr, "--guard-selftest needs a MALLOC_GUARD build: make MALLOC_GUARD=1\n");
+                return 1;
+            }
+            selftest = true;
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rt-priority") == 0 && i + 1 < argc) {
+            rt_priority = atoi(argv[++i]);
+            if (rt_priority < 0 || rt_priority > 99) {
+                fprintf(stderr, "Invalid RT priority: %s (0-99)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--no-mlock") == 0) {
+            lock_memory = false;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    rt_config_t rt_config;
+    rt_report_t rt_report;
+    rt_default_config(&rt_config);
+    rt_config.cpu = cpu;
+    rt_config.priority = rt_priority;
+    rt_config.lock_memory = lock_memory;
+    if (!lock_memory) {
+        rt_config.stack_prefault = rt_config.heap_prefault = 0;
+    }
+    rt_setup(&rt_config, &rt_report);
+    rt_print_report(&rt_report, stdout);
+
+    // Room for one batch per cache plus what the cross-thread run keeps in flight
+    mempool_t pool;
+    arena_t arena;
+    uint32_t capacity = 4 * config.batch + HANDOFF_RING_SIZE + 4 * MEMPOOL_BATCH;
+    if (mempool_init(&pool, "bench", config.object_size, capacity) != 0) {
+        return 1;
+    }
+    if (arena_init(&arena, "bench", (size_t)config.batch * (config.object_size + ARENA_DEFAULT_ALIGN)) != 0) {
+        mempool_destroy(&pool);
+        return 1;
+    }
+
+    int ret = 0;
+    if (selftest) {
+        ret = guard_selftest(&config, &pool, &arena);
+    } else {
+        printf("\n%llu batches of %u x %zu-byte objects\n",
+               (unsigned long long)config.batches, config.batch, config.object_size);
+        for (int a = 0; a < ALLOC_COUNT && ret == 0; a++) {
+            if (only < 0 || only == a) {
+                ret = bench_single((allocator_t)a, &config, &pool, &arena);
+            }
+        }
+
+        if (threads && ret == 0) {
+            printf("\nCross-thread hand-off (allocate on one thread, free on another)\n");
+            for (int a = ALLOC_MALLOC; a <= ALLOC_POOL && ret == 0; a++) {
+                if (only < 0 || only == a) {
+                    ret = bench_handoff((allocator_t)a, &config, &pool);
+                }
+            }
+        }
+
+        printf("\n");
+        mempool_print_stats(&pool, stdout);
+        arena_print_stats(&arena, stdout);
+    }
+
+    arena_destroy(&arena);
+    mempool_destroy(&pool);
+    return ret == 0 ? 0 : 1;
+}
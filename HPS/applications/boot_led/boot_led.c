@@ -3,6 +3,9 @@
 // ============================================================================
 // Displays LED patterns on boot to indicate the custom Linux image is running
 // Uses direct memory-mapped I/O to the FPGA LEDs via lightweight HPS-FPGA bridge
+//
+// Telemetry mode (--telemetry) instead shows calculator health published by
+// the trading process in shared memory, woken by a single timerfd
 // ============================================================================
 
 #include <stdio.h>
@@ -13,9 +16,12 @@
 #include <fcntl.h>
 #include <signal.h>
 #include <string.h>
+#include <sched.h>
 #include <sys/mman.h>
+#include <sys/timerfd.h>
 #include <time.h>
 #include <errno.h>
+#include "telemetry.h"
 
 // ============================================================================
 // Hardware Constants - DE10-Nano Cyclone V SoC
@@ -47,11 +53,21 @@
 #define HEARTBEAT_PAUSE_US          700000  // 700ms pause between beats
 #define KNIGHT_RIDER_DELAY_US       60000   // 60ms for knight rider effect
 
+// ============================================================================
+// Telemetry Mode
+// ============================================================================
+#define TELEMETRY_TICK_NS           100000000ULL  // 100ms timerfd period (10 wakeups/s)
+#define TELEMETRY_RATE_WINDOW_NS    1000000000ULL // ops/s measured over 1s
+#define TELEMETRY_ERROR_HOLD_TICKS  50            // Errors stay solid for 5s
+#define TELEMETRY_DEFAULT_CPU       0             // Keep off the trading core
+
 // ============================================================================
 // Global State
 // ============================================================================
 static volatile sig_atomic_t keep_running = 1;
 static volatile uint32_t *led_register = NULL;
+static uint32_t led_shadow = 0;       // Last value written to the PIO
+static bool led_shadow_valid = false;
 static void *mapped_base = NULL;
 static int memory_fd = -1;
 
@@ -73,10 +89,19 @@ static void led_write(uint8_t value) {
     }
     
 #if LED_ACTIVE_LOW
-    *led_register = (uint32_t)(~value & 0xFF);
+    uint32_t reg_value = (uint32_t)(~value & 0xFF);
 #else
-    *led_register = (uint32_t)(value & 0xFF);
+    uint32_t reg_value = (uint32_t)(value & 0xFF);
 #endif
+
+    // Skip bridge writes that would not change the LEDs (telemetry mode
+    // mostly rewrites the same bar every tick)
+    if (led_shadow_valid && reg_value == led_shadow) {
+        return;
+    }
+    *led_register = reg_value;
+    led_shadow = reg_value;
+    led_shadow_valid = true;
 }
 
 static void led_all_on(void) {
@@ -158,6 +183,141 @@ static void pattern_counter_cycle(void) {
     counter++;
 }
 
+// ============================================================================
+// Telemetry Display
+// ============================================================================
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Logarithmic bar: one LED per decade of ops/s (1 LED >= 1/s ... 8 LEDs >= 10M/s)
+static uint8_t telemetry_bar(double ops_per_sec) {
+    int lit = 0;
+    double level = 1.0;
+
+    while (lit < LED_COUNT && ops_per_sec >= level) {
+        lit++;
+        level *= 10.0;
+    }
+    return (uint8_t)((1U << lit) - 1);
+}
+
+// Telemetry loop:
+//   writer absent or dead -> LED0 blinks slowly (1s period)
+//   error in the last 5s  -> all LEDs solid
+//   p99 over budget       -> ops/s bar blinks
+//   otherwise             -> ops/s bar
+// One blocking timerfd read per tick; no usleep drift and no busy polling.
+static int run_telemetry(int cpu) {
+    if (cpu >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+            fprintf(stderr, "boot_led: Failed to pin to CPU %d: %s\n", cpu, strerror(errno));
+            return -1;
+        }
+    }
+
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (timer_fd < 0) {
+        fprintf(stderr, "boot_led: timerfd_create failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    struct itimerspec period;
+    period.it_interval.tv_sec = 0;
+    period.it_interval.tv_nsec = (long)TELEMETRY_TICK_NS;
+    period.it_value = period.it_interval;
+    if (timerfd_settime(timer_fd, 0, &period, NULL) != 0) {
+        fprintf(stderr, "boot_led: timerfd_settime failed: %s\n", strerror(errno));
+        close(timer_fd);
+        return -1;
+    }
+
+    const telemetry_block_t *block = NULL;
+    telemetry_block_t sample;
+    telemetry_block_t window_start;
+    uint64_t window_start_ns = 0;
+    bool have_window = false;
+    uint64_t tick = 0;
+    uint32_t error_hold = 0;
+    uint8_t bar = 0;
+
+    memset(&window_start, 0, sizeof(window_start));
+
+    while (keep_running) {
+        uint64_t expirations;
+        if (read(timer_fd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations)) {
+            if (errno == EINTR) {
+                continue;  // Signal: re-check keep_running
+            }
+            fprintf(stderr, "boot_led: timerfd read failed: %s\n", strerror(errno));
+            break;
+        }
+        tick += expirations;  // Count ticks missed under load too
+
+        if (block == NULL) {
+            block = telemetry_open_reader(NULL);
+        }
+        if (block != NULL) {
+            telemetry_snapshot(block, &sample);
+        }
+        if (block == NULL || !telemetry_writer_alive(&sample)) {
+            led_write(((tick / 5) & 1) ? 0x01 : 0x00);
+            have_window = false;
+            error_hold = 0;
+            bar = 0;
+            continue;
+        }
+
+        uint64_t now_ns = monotonic_ns();
+        if (!have_window || sample.writer_pid != window_start.writer_pid) {
+            window_start = sample;
+            window_start_ns = now_ns;
+            have_window = true;
+        }
+
+        // Counters wrap; unsigned differences stay correct
+        if (sample.errors != window_start.errors) {
+            error_hold = TELEMETRY_ERROR_HOLD_TICKS;
+        } else if (error_hold > expirations) {
+            error_hold -= (uint32_t)expirations;
+        } else {
+            error_hold = 0;
+        }
+
+        uint64_t elapsed_ns = now_ns - window_start_ns;
+        if (elapsed_ns >= TELEMETRY_RATE_WINDOW_NS) {
+            uint32_t ops = sample.ops - window_start.ops;
+            bar = telemetry_bar((double)ops * 1e9 / (double)elapsed_ns);
+            window_start = sample;
+            window_start_ns = now_ns;
+        } else {
+            // Errors are compared per tick, ops per window
+            window_start.errors = sample.errors;
+        }
+
+        bool over_budget = sample.latency_budget_ns != 0 &&
+                           sample.latency_p99_ns > sample.latency_budget_ns;
+
+        if (error_hold > 0) {
+            led_all_on();
+        } else if (over_budget) {
+            led_write(((tick / 2) & 1) ? 0x00 : bar);
+        } else {
+            led_write(bar);
+        }
+    }
+
+    telemetry_close_reader(block);
+    close(timer_fd);
+    return 0;
+}
+
 // ============================================================================
 // Hardware Initialization
 // ============================================================================
@@ -222,6 +382,10 @@ static void print_usage(const char *program_name) {
     fprintf(stderr, "  -d, --daemon     Run as daemon (background, no startup pattern)\n");
     fprintf(stderr, "  -o, --oneshot    Run startup pattern once and exit\n");
     fprintf(stderr, "  -p, --pattern N  Select pattern: 0=heartbeat (default), 1=knight, 2=counter\n");
+    fprintf(stderr, "  -t, --telemetry  Show calculator telemetry instead of a pattern\n");
+    fprintf(stderr, "                   (ops/s bar, blinking on p99 breach, solid on error)\n");
+    fprintf(stderr, "  -c, --cpu N      CPU to pin telemetry mode to (default: %d, -1 = no pinning)\n",
+            TELEMETRY_DEFAULT_CPU);
     fprintf(stderr, "  -h, --help       Show this help message\n");
     fprintf(stderr, "\n");
     fprintf(stderr, "Requires root privileges for /dev/mem access.\n");
@@ -235,6 +399,8 @@ int main(int argc, char *argv[]) {
     bool daemon_mode = false;
     bool oneshot_mode = false;
     int pattern_type = 0;  // 0=heartbeat, 1=knight rider, 2=counter
+    bool telemetry_mode = false;
+    int telemetry_cpu = TELEMETRY_DEFAULT_CPU;
     
     // Parse arguments
     for (int arg_index = 1; arg_index < argc; arg_index++) {
@@ -250,6 +416,16 @@ int main(int argc, char *argv[]) {
                     return 1;
                 }
             }
+        } else if (strcmp(argv[arg_index], "-t") == 0 || strcmp(argv[arg_index], "--telemetry") == 0) {
+            telemetry_mode = true;
+        } else if (strcmp(argv[arg_index], "-c") == 0 || strcmp(argv[arg_index], "--cpu") == 0) {
+            if (arg_index + 1 < argc) {
+                telemetry_cpu = atoi(argv[++arg_index]);
+                if (telemetry_cpu < -1 || telemetry_cpu >= CPU_SETSIZE) {
+                    fprintf(stderr, "Invalid CPU number\n");
+                    return 1;
+                }
+            }
         } else if (strcmp(argv[arg_index], "-h") == 0 || strcmp(argv[arg_index], "--help") == 0) {
             print_usage(argv[0]);
             return 0;
@@ -300,6 +476,13 @@ int main(int argc, char *argv[]) {
         return 0;
     }
     
+    // Telemetry mode replaces the continuous pattern
+    if (telemetry_mode) {
+        int ret = run_telemetry(telemetry_cpu);
+        hardware_cleanup();
+        return ret == 0 ? 0 : 1;
+    }
+    
     // Main loop - run continuous pattern
     while (keep_running) {
         switch (pattern_type) {
@@ -0,0 +1,838 @@
+// ============================================================================
+// HPS-FPGA Bridge Microbenchmark Suite
+// ============================================================================
+// Measures raw access costs on each path from the HPS into the FPGA fabric:
+//   - 32-bit reads and writes over the lightweight bridge (0xFF200000)
+//   - Posted-write throughput and read-after-write latency
+//   - Write bursts over the full HPS-to-FPGA bridge (0xC0000000)
+//   - /dev/mem (O_SYNC) mapping versus the fpga_uio mapping
+// Results are reported as latency histograms. A RAM-backed mock target lets
+// the harness build and run off-board (numbers then only validate the tool).
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include "calculator_driver.h"
+#include "fpga_uio.h"
+#include "fpga_uio_inline.h"
+#include "histogram.h"
+
+// ============================================================================
+// Bridge Windows - DE10-Nano Cyclone V SoC
+// ============================================================================
+#define LW_BRIDGE_SPAN          0x00200000  // 2MB lightweight HPS-to-FPGA
+#define H2F_BRIDGE_BASE         0xC0000000  // Full HPS-to-FPGA bridge
+#define H2F_BRIDGE_MAX_SPAN     0x3C000000  // 960MB window
+
+// ============================================================================
+// Defaults
+// ============================================================================
+#define DEFAULT_ITERATIONS      100000
+#define DEFAULT_BATCH           1
+#define DEFAULT_LW_OFFSET       (CALCULATOR_0_BASE + CALC_REG_OPERAND_A)  // Scratch R/W register
+#define DEFAULT_H2F_SPAN        4096
+#define DEFAULT_UIO_DEVICE      "/dev/uio0"
+#define DEFAULT_UIO_MAP_SIZE    0x1000
+#define POSTED_WRITE_CHUNK      256         // Writes per throughput sample
+
+// ============================================================================
+// Benchmark Selection
+// ============================================================================
+enum {
+    TEST_LW_READ      = 1 << 0,
+    TEST_LW_WRITE     = 1 << 1,
+    TEST_POSTED_WRITE = 1 << 2,
+    TEST_RAW          = 1 << 3,
+    TEST_H2F_BURST    = 1 << 4,
+    TEST_DEVMEM_UIO   = 1 << 5,
+    TEST_UIO_INLINE   = 1 << 6,
+    TEST_ALL          = 0x7F
+};
+
+typedef struct {
+    const char *name;
+    unsigned int flag;
+    const char *description;
+} bench_test_desc_t;
+
+static const bench_test_desc_t bench_tests[] = {
+    {"lw-read",       TEST_LW_READ,      "32-bit reads over the lightweight bridge"},
+    {"lw-write",      TEST_LW_WRITE,     "32-bit writes over the lightweight bridge"},
+    {"posted-write",  TEST_POSTED_WRITE, "Back-to-back posted write throughput"},
+    {"raw",           TEST_RAW,          "Read-after-write round trip latency"},
+    {"h2f-burst",     TEST_H2F_BURST,    "Block writes/reads over the full HPS-to-FPGA bridge"},
+    {"devmem-vs-uio", TEST_DEVMEM_UIO,   "/dev/mem (O_SYNC) vs fpga_uio mapping"},
+    {"uio-inline",    TEST_UIO_INLINE,   "Checked fpga_uio_read32/write32 vs inline register handles"},
+};
+
+#define NUM_BENCH_TESTS (sizeof(bench_tests) / sizeof(bench_tests[0]))
+
+// ============================================================================
+// Configuration and Target State
+// ============================================================================
+typedef struct {
+    unsigned int tests;
+    uint32_t iterations;
+    uint32_t batch;
+    uint32_t lw_offset;
+    uint32_t h2f_offset;
+    uint32_t h2f_span;
+    const char *uio_device;
+    uint32_t uio_offset;
+    int cpu;
+    bool mock;
+    bool full_histograms;
+} bench_config_t;
+
+typedef struct {
+    int mem_fd;
+    void *lw_base;
+    void *h2f_base;
+    size_t h2f_map_size;
+} bench_target_t;
+
+static volatile uint32_t bench_sink;  // Keeps reads observable
+
+// ============================================================================
+// Target Mapping
+// ============================================================================
+
+static void *bench_map_window(bench_target_t *target, const bench_config_t *config,
+                              off_t phys_base, size_t span) {
+    void *base;
+
+    if (config->mock) {
+        base = mmap(NULL, span, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    } else {
+        base = mmap(NULL, span, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, target->mem_fd, phys_base);
+    }
+
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "bridge_bench: mmap of 0x%08llX (+0x%zX) failed: %s\n",
+                (unsigned long long)phys_base, span, strerror(errno));
+        return NULL;
+    }
+    return base;
+}
+
+static int bench_target_open(bench_target_t *target, const bench_config_t *config) {
+    memset(target, 0, sizeof(*target));
+    target->mem_fd = -1;
+
+    if (!config->mock) {
+        target->mem_fd = open("/dev/mem", O_RDWR | O_SYNC);
+        if (target->mem_fd < 0) {
+            fprintf(stderr, "bridge_bench: Could not open /dev/mem: %s\n", strerror(errno));
+            fprintf(stderr, "bridge_bench: Run as root, or use --mock to run off-board\n");
+            return -1;
+        }
+    }
+
+    target->lw_base = bench_map_window(target, config, HPS_LW_BRIDGE_BASE, LW_BRIDGE_SPAN);
+    if (target->lw_base == NULL) {
+        return -1;
+    }
+
+    if (config->tests & TEST_H2F_BURST) {
+        // Map whole pages covering [h2f_offset, h2f_offset + h2f_span)
+        long page_size = sysconf(_SC_PAGESIZE);
+        size_t page_offset = config->h2f_offset & ~((uint32_t)page_size - 1U);
+        target->h2f_map_size = (config->h2f_offset - page_offset) + config->h2f_span;
+        target->h2f_map_size = (target->h2f_map_size + (size_t)page_size - 1) & ~((size_t)page_size - 1);
+        target->h2f_base = bench_map_window(target, config,
+                                            (off_t)(H2F_BRIDGE_BASE + page_offset),
+                                            target->h2f_map_size);
+        if (target->h2f_base == NULL) {
+            return -1;
+        }
+        target->h2f_base = (uint8_t *)target->h2f_base + (config->h2f_offset - page_offset);
+    }
+
+    return 0;
+}
+
+static void bench_target_close(bench_target_t *target) {
+    long page_size = sysconf(_SC_PAGESIZE);
+
+    if (target->h2f_base != NULL) {
+        void *page = (void *)((uintptr_t)target->h2f_base & ~((uintptr_t)page_size - 1U));
+        munmap(page, target->h2f_map_size);
+        target->h2f_base = NULL;
+    }
+    if (target->lw_base != NULL) {
+        munmap(target->lw_base, LW_BRIDGE_SPAN);
+        target->lw_base = NULL;
+    }
+    if (target->mem_fd >= 0) {
+        close(target->mem_fd);
+        target->mem_fd = -1;
+    }
+}
+
+static volatile uint32_t *bench_lw_reg(const bench_target_t *target, uint32_t offset) {
+    return (volatile uint32_t *)((uint8_t *)target->lw_base + offset);
+}
+
+// ============================================================================
+// Reporting Helpers
+// ============================================================================
+
+static void bench_report(const histogram_t *hist, const bench_config_t *config) {
+    if (config->full_histograms) {
+        histogram_print(hist, stdout);
+    } else {
+        histogram_print_summary(hist, stdout);
+    }
+}
+
+static void bench_section(const char *title) {
+    printf("\n--- %s ---\n", title);
+}
+
+// ============================================================================
+// Timer Overhead
+// ============================================================================
+// Reported first so every other number can be read relative to it
+static void bench_timer_overhead(const bench_config_t *config) {
+    histogram_t hist;
+    histogram_init(&hist, "clock_gettime (ns)");
+
+    for (uint32_t i = 0; i < config->iterations; i++) {
+        uint64_t t0 = histogram_now_ns();
+        uint64_t t1 = histogram_now_ns();
+        histogram_record(&hist, t1 - t0);
+    }
+
+    bench_section("Timer overhead");
+    bench_report(&hist, config);
+}
+
+// ============================================================================
+// Lightweight Bridge: 32-bit Reads
+// ============================================================================
+static void bench_lw_read(const bench_target_t *target, const bench_config_t *config) {
+    volatile uint32_t *reg = bench_lw_reg(target, config->lw_offset);
+    histogram_t hist;
+    histogram_init(&hist, "lw read32 (ns/access)");
+
+    for (uint32_t i = 0; i < config->iterations; i++) {
+        uint32_t acc = 0;
+        uint64_t t0 = histogram_now_ns();
+        for (uint32_t b = 0; b < config->batch; b++) {
+            acc += *reg;
+        }
+        uint64_t t1 = histogram_now_ns();
+        bench_sink = acc;
+        histogram_record(&hist, (t1 - t0) / config->batch);
+    }
+
+    bench_section("Lightweight bridge read32");
+    printf("Target: 0x%08X (LW offset 0x%06X), batch=%u\n",
+           HPS_LW_BRIDGE_BASE + config->lw_offset, config->lw_offset, config->batch);
+    bench_report(&hist, config);
+}
+
+// ============================================================================
+// Lightweight Bridge: 32-bit Writes
+// ============================================================================
+// Measures the issue cost seen by the CPU; writes are posted, so completion
+// at the slave is covered by the posted-write and raw tests instead
+static void bench_lw_write(const bench_target_t *target, const bench_config_t *config) {
+    volatile uint32_t *reg = bench_lw_reg(target, config->lw_offset);
+    histogram_t hist;
+    histogram_init(&hist, "lw write32 (ns/access)");
+
+    for (uint32_t i = 0; i < config->iterations; i++) {
+        uint64_t t0 = histogram_now_ns();
+        for (uint32_t b = 0; b < config->batch; b++) {
+            *reg = i + b;
+        }
+        uint64_t t1 = histogram_now_ns();
+        histogram_record(&hist, (t1 - t0) / config->batch);
+    }
+    bench_sink = *reg;  // Drain outstanding posted writes
+
+    bench_section("Lightweight bridge write32");
+    printf("Target: 0x%08X (LW offset 0x%06X), batch=%u\n",
+           HPS_LW_BRIDGE_BASE + config->lw_offset, config->lw_offset, config->batch);
+    bench_report(&hist, config);
+}
+
+// ============================================================================
+// Lightweight Bridge: Posted Write Throughput
+// ============================================================================
+// Each sample issues POSTED_WRITE_CHUNK back-to-back writes and then a single
+// read of the same register, which cannot complete until every preceding
+// write has reached the slave
+static void bench_posted_write(const bench_target_t *target, const bench_config_t *config) {
+    volatile uint32_t *reg = bench_lw_reg(target, config->lw_offset);
+    uint32_t samples = config->iterations / POSTED_WRITE_CHUNK;
+    histogram_t hist;
+    uint64_t total_ns = 0;
+
+    if (samples == 0) {
+        samples = 1;
+    }
+    histogram_init(&hist, "posted write (ns/chunk)");
+
+    for (uint32_t i = 0; i < samples; i++) {
+        uint64_t t0 = histogram_now_ns();
+        for (uint32_t w = 0; w < POSTED_WRITE_CHUNK; w++) {
+            *reg = w;
+        }
+        bench_sink = *reg;
+        uint64_t t1 = histogram_now_ns();
+        total_ns += t1 - t0;
+        histogram_record(&hist, t1 - t0);
+    }
+
+    double writes = (double)samples * POSTED_WRITE_CHUNK;
+    double seconds = (double)total_ns / 1e9;
+
+    bench_section("Lightweight bridge posted-write throughput");
+    printf("Chunk: %u writes + 1 draining read\n", POSTED_WRITE_CHUNK);
+    printf("Throughput: %.0f writes/s, %.2f MB/s, %.1f ns/write\n",
+           writes / seconds, writes * sizeof(uint32_t) / seconds / 1e6,
+           (double)total_ns / writes);
+    bench_report(&hist, config);
+}
+
+// ============================================================================
+// Lightweight Bridge: Read-After-Write Latency
+// ============================================================================
+static void bench_raw(const bench_target_t *target, const bench_config_t *config) {
+    volatile uint32_t *reg = bench_lw_reg(target, config->lw_offset);
+    histogram_t hist;
+    uint32_t mismatches = 0;
+
+    histogram_init(&hist, "write+read (ns/pair)");
+
+    for (uint32_t i = 0; i < config->iterations; i++) {
+        uint32_t pattern = 0xA5000000U ^ i;
+        uint64_t t0 = histogram_now_ns();
+        *reg = pattern;
+        uint32_t readback = *reg;
+        uint64_t t1 = histogram_now_ns();
+        if (readback != pattern) {
+            mismatches++;
+        }
+        histogram_record(&hist, t1 - t0);
+    }
+
+    bench_section("Lightweight bridge read-after-write");
+    printf("Target: 0x%08X, readback mismatches: %u\n",
+           HPS_LW_BRIDGE_BASE + config->lw_offset, mismatches);
+    bench_report(&hist, config);
+}
+
+// ============================================================================
+// Full HPS-to-FPGA Bridge: Block Transfers
+// ============================================================================
+// Compares 32-bit store loops, 64-bit store loops, memcpy and the NEON
+// fpga_uio_write_block() over the same window, then 32-bit load loops
+// against fpga_uio_read_block(). Wider and consecutive accesses give the AXI
+// bridge a chance to form bursts instead of single-beat transactions.
+static void bench_h2f_burst(const bench_target_t *target, const bench_config_t *config) {
+    uint32_t words32 = config->h2f_span / sizeof(uint32_t);
+    uint32_t words64 = config->h2f_span / sizeof(uint64_t);
+    uint32_t samples = config->iterations / 100;
+    uint64_t *source = NULL;
+    uint64_t *readback = NULL;
+    histogram_t hist32, hist64, hist_memcpy, hist_block;
+    histogram_t hist_load32, hist_read_block;
+    uint64_t total32 = 0, total64 = 0, total_memcpy = 0, total_block = 0;
+    uint64_t total_load32 = 0, total_read_block = 0;
+
+    // The H2F window wrapped as a fpga_uio device for the block API
+    fpga_uio_dev_t h2f_dev = {
+        .fd = -1,
+        .map_base = target->h2f_base,
+        .map_size = config->h2f_span,
+        .is_initialized = true,
+    };
+
+    if (samples == 0) {
+        samples = 1;
+    }
+
+    if (posix_memalign((void **)&source, 64, config->h2f_span) != 0 ||
+        posix_memalign((void **)&readback, 64, config->h2f_span) != 0) {
+        fprintf(stderr, "bridge_bench: Failed to allocate %u byte buffers\n", config->h2f_span);
+        free(source);
+        return;
+    }
+    for (uint32_t i = 0; i < words64; i++) {
+        source[i] = 0x0123456789ABCDEFULL ^ i;
+    }
+
+    histogram_init(&hist32, "store32 loop (ns/block)");
+    histogram_init(&hist64, "store64 loop (ns/block)");
+    histogram_init(&hist_memcpy, "memcpy (ns/block)");
+    histogram_init(&hist_block, "write_block (ns/block)");
+    histogram_init(&hist_load32, "load32 loop (ns/block)");
+    histogram_init(&hist_read_block, "read_block (ns/block)");
+
+    for (uint32_t i = 0; i < samples; i++) {
+        volatile uint32_t *dst32 = (volatile uint32_t *)target->h2f_base;
+        volatile uint64_t *dst64 = (volatile uint64_t *)target->h2f_base;
+        const uint32_t *src32 = (const uint32_t *)source;
+        uint32_t *read32 = (uint32_t *)readback;
+        uint64_t t0, t1;
+
+        t0 = histogram_now_ns();
+        for (uint32_t w = 0; w < words32; w++) {
+            dst32[w] = src32[w];
+        }
+        bench_sink = dst32[words32 - 1];
+        t1 = histogram_now_ns();
+        histogram_record(&hist32, t1 - t0);
+        total32 += t1 - t0;
+
+        t0 = histogram_now_ns();
+        for (uint32_t w = 0; w < words64; w++) {
+            dst64[w] = source[w];
+        }
+        bench_sink = dst32[words32 - 1];
+        t1 = histogram_now_ns();
+        histogram_record(&hist64, t1 - t0);
+        total64 += t1 - t0;
+
+        t0 = histogram_now_ns();
+        memcpy(target->h2f_base, source, config->h2f_span);
+        bench_sink = dst32[words32 - 1];
+        t1 = histogram_now_ns();
+        histogram_record(&hist_memcpy, t1 - t0);
+        total_memcpy += t1 - t0;
+
+        t0 = histogram_now_ns();
+        fpga_uio_write_block(&h2f_dev, 0, source, config->h2f_span);
+        bench_sink = dst32[words32 - 1];
+        t1 = histogram_now_ns();
+        histogram_record(&hist_block, t1 - t0);
+        total_block += t1 - t0;
+
+        t0 = histogram_now_ns();
+        for (uint32_t w = 0; w < words32; w++) {
+            read32[w] = dst32[w];
+        }
+        t1 = histogram_now_ns();
+        histogram_record(&hist_load32, t1 - t0);
+        total_load32 += t1 - t0;
+
+        t0 = histogram_now_ns();
+        fpga_uio_read_block(&h2f_dev, 0, readback, config->h2f_span);
+        t1 = histogram_now_ns();
+        histogram_record(&hist_read_block, t1 - t0);
+        total_read_block += t1 - t0;
+    }
+
+    double bytes = (double)samples * config->h2f_span;
+
+    bench_section("Full HPS-to-FPGA bridge block transfers");
+    printf("Target: 0x%08X, block=%u bytes, samples=%u\n",
+           H2F_BRIDGE_BASE + config->h2f_offset, config->h2f_span, samples);
+    if (!config->mock) {
+        printf("Note: requires a memory slave (e.g. on-chip RAM) behind the H2F bridge\n");
+    }
+    if (memcmp(readback, source, config->h2f_span) != 0) {
+        printf("Warning: read_block data does not match what was written\n");
+    }
+    printf("store32:     %8.2f MB/s\n", bytes / ((double)total32 / 1e9) / 1e6);
+    printf("store64:     %8.2f MB/s\n", bytes / ((double)total64 / 1e9) / 1e6);
+    printf("memcpy:      %8.2f MB/s\n", bytes / ((double)total_memcpy / 1e9) / 1e6);
+    printf("write_block: %8.2f MB/s\n", bytes / ((double)total_block / 1e9) / 1e6);
+    printf("load32:      %8.2f MB/s\n", bytes / ((double)total_load32 / 1e9) / 1e6);
+    printf("read_block:  %8.2f MB/s\n", bytes / ((double)total_read_block / 1e9) / 1e6);
+    bench_report(&hist32, config);
+    bench_report(&hist64, config);
+    bench_report(&hist_memcpy, config);
+    bench_report(&hist_block, config);
+    bench_report(&hist_load32, config);
+    bench_report(&hist_read_block, config);
+
+    free(readback);
+    free(source);
+}
+
+// ============================================================================
+// /dev/mem (O_SYNC) versus UIO Mapping
+// ============================================================================
+// Reads the same register through both mappings. In mock mode the UIO device
+// is replaced by a second anonymous mapping so the harness path still runs.
+static int bench_uio_open(fpga_uio_dev_t *uio_dev, const bench_config_t *config) {
+    if (config->mock) {
+        void *mock_uio = mmap(NULL, DEFAULT_UIO_MAP_SIZE, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mock_uio == MAP_FAILED) {
+            fprintf(stderr, "bridge_bench: mock UIO mmap failed: %s\n", strerror(errno));
+            return -1;
+        }
+        uio_dev->fd = -1;
+        uio_dev->map_base = mock_uio;
+        uio_dev->map_size = DEFAULT_UIO_MAP_SIZE;
+        uio_dev->is_initialized = true;
+        return 0;
+    }
+    return fpga_uio_init(uio_dev, config->uio_device, DEFAULT_UIO_MAP_SIZE);
+}
+
+static void bench_uio_close(fpga_uio_dev_t *uio_dev, const bench_config_t *config) {
+    if (config->mock) {
+        munmap(uio_dev->map_base, DEFAULT_UIO_MAP_SIZE);
+        uio_dev->is_initialized = false;
+    } else {
+        fpga_uio_cleanup(uio_dev);
+    }
+}
+
+static void bench_devmem_vs_uio(const bench_target_t *target, const bench_config_t *config) {
+    volatile uint32_t *devmem_reg = bench_lw_reg(target, config->lw_offset);
+    fpga_uio_dev_t uio_dev;
+    volatile uint32_t *uio_reg = NULL;
+    histogram_t hist_devmem, hist_uio, hist_uio_checked;
+
+    if (bench_uio_open(&uio_dev, config) != 0) {
+        bench_section("/dev/mem vs UIO");
+        printf("Skipped: could not open %s\n", config->uio_device);
+        return;
+    }
+
+    uio_reg = (volatile uint32_t *)((uint8_t *)uio_dev.map_base + config->uio_offset);
+
+    histogram_init(&hist_devmem, "/dev/mem read32 (ns)");
+    histogram_init(&hist_uio, "uio read32 (ns)");
+    histogram_init(&hist_uio_checked, "fpga_uio_read32 (ns)");
+
+    for (uint32_t i = 0; i < config->iterations; i++) {
+        uint32_t value = 0;
+        uint64_t t0, t1;
+
+        t0 = histogram_now_ns();
+        bench_sink = *devmem_reg;
+        t1 = histogram_now_ns();
+        histogram_record(&hist_devmem, t1 - t0);
+
+        t0 = histogram_now_ns();
+        bench_sink = *uio_reg;
+        t1 = histogram_now_ns();
+        histogram_record(&hist_uio, t1 - t0);
+
+        t0 = histogram_now_ns();
+        fpga_uio_read32(&uio_dev, config->uio_offset, &value);
+        t1 = histogram_now_ns();
+        bench_sink = value;
+        histogram_record(&hist_uio_checked, t1 - t0);
+    }
+
+    bench_section("/dev/mem (O_SYNC) vs UIO");
+    printf("/dev/mem target: 0x%08X, UIO target: %s + 0x%X\n",
+           HPS_LW_BRIDGE_BASE + config->lw_offset,
+           config->mock ? "mock" : config->uio_device, config->uio_offset);
+    bench_report(&hist_devmem, config);
+    bench_report(&hist_uio, config);
+    bench_report(&hist_uio_checked, config);
+
+    bench_uio_close(&uio_dev, config);
+}
+
+// ============================================================================
+// Checked API versus Inline Register Handles
+// ============================================================================
+// Same register through fpga_uio_read32/write32 (out-of-line, validated on
+// every call) and through a fpga_reg32_t handle validated once. Batched so
+// the per-access difference is not buried in timer overhead.
+static void bench_uio_inline(const bench_config_t *config) {
+    fpga_uio_dev_t uio_dev;
+    fpga_reg32_t reg;
+    histogram_t hist_read_checked, hist_read_inline, hist_read_ordered;
+    histogram_t hist_write_checked, hist_write_inline, hist_write_ordered;
+
+    if (bench_uio_open(&uio_dev, config) != 0) {
+        bench_section("Checked vs inline UIO access");
+        printf("Skipped: could not open %s\n", config->uio_device);
+        return;
+    }
+    if (fpga_uio_reg32(&uio_dev, config->uio_offset, &reg) != 0) {
+        fprintf(stderr, "bridge_bench: invalid UIO register offset 0x%X\n", config->uio_offset);
+        bench_uio_close(&uio_dev, config);
+        return;
+    }
+
+    histogram_init(&hist_read_checked, "fpga_uio_read32 (ns)");
+    histogram_init(&hist_read_inline, "reg32_read (ns)");
+    histogram_init(&hist_read_ordered, "reg32_read_ordered (ns)");
+    histogram_init(&hist_write_checked, "fpga_uio_write32 (ns)");
+    histogram_init(&hist_write_inline, "reg32_write (ns)");
+    histogram_init(&hist_write_ordered, "reg32_write_ordered (ns)");
+
+    for (uint32_t i = 0; i < config->iterations; i++) {
+        uint32_t acc = 0;
+        uint32_t value = 0;
+        uint64_t t0, t1;
+
+        t0 = histogram_now_ns();
+        for (uint32_t b = 0; b < config->batch; b++) {
+            fpga_uio_read32(&uio_dev, config->uio_offset, &value);
+            acc += value;
+        }
+        t1 = histogram_now_ns();
+        histogram_record(&hist_read_checked, (t1 - t0) / config->batch);
+
+        t0 = histogram_now_ns();
+        for (uint32_t b = 0; b < config->batch; b++) {
+            acc += fpga_reg32_read(reg);
+        }
+        t1 = histogram_now_ns();
+        histogram_record(&hist_read_inline, (t1 - t0) / config->batch);
+
+        t0 = histogram_now_ns();
+        for (uint32_t b = 0; b < config->batch; b++) {
+            acc += fpga_reg32_read_ordered(reg);
+        }
+        t1 = histogram_now_ns();
+        histogram_record(&hist_read_ordered, (t1 - t0) / config->batch);
+        bench_sink = acc;
+
+        t0 = histogram_now_ns();
+        for (uint32_t b = 0; b < config->batch; b++) {
+            fpga_uio_write32(&uio_dev, config->uio_offset, i + b);
+        }
+        t1 = histogram_now_ns();
+        histogram_record(&hist_write_checked, (t1 - t0) / config->batch);
+
+        t0 = histogram_now_ns();
+        for (uint32_t b = 0; b < config->batch; b++) {
+            fpga_reg32_write(reg, i + b);
+        }
+        t1 = histogram_now_ns();
+        histogram_record(&hist_write_inline, (t1 - t0) / config->batch);
+
+        t0 = histogram_now_ns();
+        for (uint32_t b = 0; b < config->batch; b++) {
+            fpga_reg32_write_ordered(reg, i + b);
+        }
+        t1 = histogram_now_ns();
+        histogram_record(&hist_write_ordered, (t1 - t0) / config->batch);
+    }
+    bench_sink = fpga_reg32_read(reg);  // Drain outstanding posted writes
+
+    bench_section("Checked vs inline UIO access");
+    printf("UIO target: %s + 0x%X, batch=%u\n",
+           config->mock ? "mock" : config->uio_device, config->uio_offset, config->batch);
+    bench_report(&hist_read_checked, config);
+    bench_report(&hist_read_inline, config);
+    bench_report(&hist_read_ordered, config);
+    bench_report(&hist_write_checked, config);
+    bench_report(&hist_write_inline, config);
+    bench_report(&hist_write_ordered, config);
+
+    bench_uio_close(&uio_dev, config);
+}
+
+// ============================================================================
+// Usage
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options] [test ...]\n", program_name);
+    printf("\n");
+    printf("HPS-FPGA bridge microbenchmark suite\n");
+    printf("\n");
+    printf("Tests (default: all):\n");
+    for (size_t i = 0; i < NUM_BENCH_TESTS; i++) {
+        printf("  %-15s %s\n", bench_tests[i].name, bench_tests[i].description);
+    }
+    printf("\n");
+    printf("Options:\n");
+    printf("  -n, --iterations N    Samples per test (default: %d)\n", DEFAULT_ITERATIONS);
+    printf("  -b, --batch N         Accesses per timed sample for lw-read/lw-write/uio-inline (default: %d)\n", DEFAULT_BATCH);
+    printf("  -m, --mock            Use a RAM-backed mock target (no hardware required)\n");
+    printf("  -c, --cpu N           Pin the benchmark to CPU N\n");
+    printf("  -H, --histogram       Print full histograms instead of summaries\n");
+    printf("      --lw-offset OFF   Register offset inside the LW bridge (default: 0x%X)\n", DEFAULT_LW_OFFSET);
+    printf("      --h2f-offset OFF  Offset inside the H2F bridge window (default: 0x0)\n");
+    printf("      --h2f-span BYTES  Block size for h2f-burst (default: %d)\n", DEFAULT_H2F_SPAN);
+    printf("      --uio DEV         UIO device for devmem-vs-uio/uio-inline (default: %s)\n", DEFAULT_UIO_DEVICE);
+    printf("      --uio-offset OFF  Offset of the same register inside the UIO map (default: 0x0)\n");
+    printf("  -h, --help            Show this help message\n");
+    printf("\n");
+    printf("The default LW offset is the calculator OPERAND_A register, which is\n");
+    printf("read/write and has no side effects. All times are in nanoseconds.\n");
+    printf("Requires root privileges for /dev/mem access (except with --mock).\n");
+}
+
+static bool parse_u32(const char *text, uint32_t *value) {
+    char *end = NULL;
+    errno = 0;
+    unsigned long parsed = strtoul(text, &end, 0);
+    if (errno != 0 || end == text || *end != '\0' || parsed > UINT32_MAX) {
+        return false;
+    }
+    *value = (uint32_t)parsed;
+    return true;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+int main(int argc, char *argv[]) {
+    bench_config_t config = {
+        .tests = 0,
+        .iterations = DEFAULT_ITERATIONS,
+        .batch = DEFAULT_BATCH,
+        .lw_offset = DEFAULT_LW_OFFSET,
+        .h2f_offset = 0,
+        .h2f_span = DEFAULT_H2F_SPAN,
+        .uio_device = DEFAULT_UIO_DEVICE,
+        .uio_offset = 0,
+        .cpu = -1,
+        .mock = false,
+        .full_histograms = false,
+    };
+    bench_target_t target;
+
+    for (int arg_index = 1; arg_index < argc; arg_index++) {
+        const char *arg = argv[arg_index];
+        const char *next = (arg_index + 1 < argc) ? argv[arg_index + 1] : NULL;
+        uint32_t value = 0;
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(arg, "-m") == 0 || strcmp(arg, "--mock") == 0) {
+            config.mock = true;
+        } else if (strcmp(arg, "-H") == 0 || strcmp(arg, "--histogram") == 0) {
+            config.full_histograms = true;
+        } else if ((strcmp(arg, "-n") == 0 || strcmp(arg, "--iterations") == 0) && next) {
+            if (!parse_u32(next, &config.iterations) || config.iterations == 0) {
+                fprintf(stderr, "Invalid iteration count: %s\n", next);
+                return 1;
+            }
+            arg_index++;
+        } else if ((strcmp(arg, "-b") == 0 || strcmp(arg, "--batch") == 0) && next) {
+            if (!parse_u32(next, &config.batch) || config.batch == 0) {
+                fprintf(stderr, "Invalid batch size: %s\n", next);
+                return 1;
+            }
+            arg_index++;
+        } else if ((strcmp(arg, "-c") == 0 || strcmp(arg, "--cpu") == 0) && next) {
+            if (!parse_u32(next, &value)) {
+                fprintf(stderr, "Invalid CPU: %s\n", next);
+                return 1;
+            }
+            config.cpu = (int)value;
+            arg_index++;
+        } else if (strcmp(arg, "--lw-offset") == 0 && next) {
+            if (!parse_u32(next, &config.lw_offset) ||
+                config.lw_offset > LW_BRIDGE_SPAN - sizeof(uint32_t) || (config.lw_offset & 3U)) {
+                fprintf(stderr, "Invalid LW offset: %s\n", next);
+                return 1;
+            }
+            arg_index++;
+        } else if (strcmp(arg, "--h2f-offset") == 0 && next) {
+            if (!parse_u32(next, &config.h2f_offset) || (config.h2f_offset & 7U)) {
+                fprintf(stderr, "Invalid H2F offset: %s\n", next);
+                return 1;
+            }
+            arg_index++;
+        } else if (strcmp(arg, "--h2f-span") == 0 && next) {
+            if (!parse_u32(next, &config.h2f_span) || config.h2f_span < 64 || (config.h2f_span & 63U)) {
+                fprintf(stderr, "Invalid H2F span (multiple of 64 bytes): %s\n", next);
+                return 1;
+            }
+            arg_index++;
+        } else if (strcmp(arg, "--uio") == 0 && next) {
+            config.uio_device = next;
+            arg_index++;
+        } else if (strcmp(arg, "--uio-offset") == 0 && next) {
+            if (!parse_u32(next, &config.uio_offset) ||
+                config.uio_offset > DEFAULT_UIO_MAP_SIZE - sizeof(uint32_t) || (config.uio_offset & 3U)) {
+                fprintf(stderr, "Invalid UIO offset: %s\n", next);
+                return 1;
+            }
+            arg_index++;
+        } else if (strcmp(arg, "all") == 0) {
+            config.tests = TEST_ALL;
+        } else {
+            bool matched = false;
+            for (size_t i = 0; i < NUM_BENCH_TESTS; i++) {
+                if (strcmp(arg, bench_tests[i].name) == 0) {
+                    config.tests |= bench_tests[i].flag;
+                    matched = true;
+                    break;
+                }
+            }
+            if (!matched) {
+                fprintf(stderr, "Unknown option or test: %s\n", arg);
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+    }
+
+    if (config.tests == 0) {
+        config.tests = TEST_ALL;
+    }
+    if ((uint64_t)config.h2f_offset + config.h2f_span > H2F_BRIDGE_MAX_SPAN) {
+        fprintf(stderr, "H2F offset + span exceeds the bridge window\n");
+        return 1;
+    }
+
+    if (config.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(config.cpu, &cpus);
+        if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+            fprintf(stderr, "bridge_bench: Failed to pin to CPU %d: %s\n", config.cpu, strerror(errno));
+            return 1;
+        }
+    }
+
+    if (bench_target_open(&target, &config) != 0) {
+        bench_target_close(&target);
+        return 1;
+    }
+
+    printf("========================================================================\n");
+    printf("                   HPS-FPGA BRIDGE MICROBENCHMARK\n");
+    printf("========================================================================\n");
+    printf("Target:     %s\n", config.mock ? "MOCK (RAM-backed, numbers are not bridge costs)" : "hardware");
+    printf("Iterations: %u\n", config.iterations);
+    printf("CPU:        %s\n", config.cpu >= 0 ? "pinned" : "unpinned");
+
+    bench_timer_overhead(&config);
+
+    if (config.tests & TEST_LW_READ) {
+        bench_lw_read(&target, &config);
+    }
+    if (config.tests & TEST_LW_WRITE) {
+        bench_lw_write(&target, &config);
+    }
+    if (config.tests & TEST_POSTED_WRITE) {
+        bench_posted_write(&target, &config);
+    }
+    if (config.tests & TEST_RAW) {
+        bench_raw(&target, &config);
+    }
+    if (config.tests & TEST_H2F_BURST) {
+        bench_h2f_burst(&target, &config);
+    }
+    if (config.tests & TEST_DEVMEM_UIO) {
+        bench_devmem_vs_uio(&target, &config);
+    }
+    if (config.tests & TEST_UIO_INLINE) {
+        bench_uio_inline(&config);
+    }
+
+    bench_target_close(&target);
+    return 0;
+}
@@ -0,0 +1,449 @@
+// ============================================================================
+// Calculator-in-the-Loop Jitter Test (calc_jitter)
+// ============================================================================
+// cyclictest with the calculator in the loop: wake on an absolute periodic
+// timer, issue one calculator operation, and time three stages separately
+//
+//   wakeup    timer expiry -> thread running        (OS: scheduler, IRQs, C-states)
+//   submit    operands + start bit written          (bridge writes)
+//   complete  start -> result read back             (IP compute + status polls)
+//
+// Separate histograms per stage show whether a bad tail comes from the
+// kernel or from the bridge and IP. Cycles whose total exceeds a threshold
+// are kept as a time series, so outliers can be lined up with other events
+// (interrupt storms, log rotation, a cron job).
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/prctl.h>
+#include "calculator_driver.h"
+#include "histogram.h"
+#include "rt_setup.h"
+
+#define LOG_MODULE LOG_MODULE_APP
+#include "logger.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define DEFAULT_INTERVAL_US    1000         // Timer period
+#define DEFAULT_THRESHOLD_NS   100000       // Cycles above this total are outliers
+#define MAX_OUTLIERS           4096         // Time series capacity
+#define PRINTED_OUTLIERS       32           // Shown on stdout without --outliers FILE
+#define JITTER_WINDOW          20           // Price buffer window for HFT operations
+#define REPORT_INTERVAL_NS     1000000000ULL
+
+// ============================================================================
+// Outlier Time Series
+// ============================================================================
+typedef struct {
+    uint64_t cycle;          // Cycle number (0-based)
+    uint64_t offset_ns;      // Timer expiry relative to the first one
+    uint32_t wakeup_ns;
+    uint32_t submit_ns;
+    uint32_t complete_ns;
+} outlier_t;
+
+typedef struct {
+    uint64_t cycles;
+    uint64_t overruns;       // Periods skipped because a cycle ran past the next expiry
+    uint64_t failures;       // Operations that failed
+    uint64_t outliers;       // Cycles over the threshold (stored or not)
+    histogram_t wakeup;
+    histogram_t submit;
+    histogram_t complete;
+    histogram_t total;
+} jitter_stats_t;
+
+// ============================================================================
+// Global Variables
+// ============================================================================
+static volatile sig_atomic_t keep_running = 1;
+static jitter_stats_t stats;
+static outlier_t outliers[MAX_OUTLIERS];
+
+static void signal_handler(int sig) {
+    (void)sig;
+    keep_running = 0;
+}
+
+static void timespec_add_ns(struct timespec *ts, uint64_t ns) {
+    uint64_t nsec = (uint64_t)ts->tv_nsec + ns;
+    ts->tv_sec += (time_t)(nsec / 1000000000ULL);
+    ts->tv_nsec = (long)(nsec % 1000000000ULL);
+}
+
+static uint64_t timespec_ns(const struct timespec *ts) {
+    return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+// ============================================================================
+// Operation Setup
+// ============================================================================
+
+static int parse_operation(const char *name, calculator_operation_t *op) {
+    for (int i = CALC_OP_ADD; i <= CALC_OP_RANGE; i++) {
+        if (strcasecmp(name, calculator_operation_to_string((calculator_operation_t)i)) == 0) {
+            *op = (calculator_operation_t)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Operands for one operation; window operations get a preloaded buffer
+static void prepare_operation(calculator_operation_t op, float *operand_a, float *operand_b) {
+    if (op < CALC_OP_SMA) {
+        *operand_a = 1.5f;
+        *operand_b = 2.25f;
+        return;
+    }
+
+    calculator_buffer_reset();
+    calculator_set_window_size(JITTER_WINDOW);
+    for (int i = 0; i < JITTER_WINDOW; i++) {
+        calculator_buffer_write_price(100.0f + (float)(i % 5) * 0.25f);
+    }
+
+    if (op == CALC_OP_EMA) {
+        float alpha = 2.0f / (JITTER_WINDOW + 1);
+        calculator_set_ema_alpha(alpha);
+        *operand_a = 100.5f;
+        *operand_b = alpha;
+    } else {
+        *operand_a = 0.0f;
+        *operand_b = (float)JITTER_WINDOW;
+    }
+}
+
+// ============================================================================
+// Measurement Loop
+// ============================================================================
+
+static void record_cycle(uint64_t cycle, uint64_t offset_ns, uint64_t wakeup_ns,
+                         uint64_t submit_ns, uint64_t complete_ns, uint64_t threshold_ns) {
+    uint64_t total_ns = wakeup_ns + submit_ns + complete_ns;
+
+    histogram_record(&stats.wakeup, wakeup_ns);
+    histogram_record(&stats.submit, submit_ns);
+    histogram_record(&stats.complete, complete_ns);
+    histogram_record(&stats.total, total_ns);
+
+    if (total_ns > threshold_ns) {
+        if (stats.outliers < MAX_OUTLIERS) {
+            outlier_t *entry = &outliers[stats.outliers];
+            entry->cycle = cycle;
+            entry->offset_ns = offset_ns;
+            entry->wakeup_ns = (uint32_t)(wakeup_ns > UINT32_MAX ? UINT32_MAX : wakeup_ns);
+            entry->submit_ns = (uint32_t)(submit_ns > UINT32_MAX ? UINT32_MAX : submit_ns);
+            entry->complete_ns = (uint32_t)(complete_ns > UINT32_MAX ? UINT32_MAX : complete_ns);
+        }
+        stats.outliers++;
+    }
+}
+
+static void print_progress(void) {
+    printf("cycles %-9llu wakeup avg %6.1f max %7llu | submit p99 %6llu | "
+           "complete p99 %6llu | outliers %llu, overruns %llu\n",
+           (unsigned long long)stats.cycles, histogram_mean(&stats.wakeup),
+           (unsigned long long)stats.wakeup.max,
+           (unsigned long long)histogram_percentile(&stats.submit, 99.0),
+           (unsigned long long)histogram_percentile(&stats.complete, 99.0),
+           (unsigned long long)stats.outliers, (unsigned long long)stats.overruns);
+    fflush(stdout);
+}
+
+static int run_loop(calculator_operation_t op, uint64_t interval_ns, uint64_t loops,
+                    uint32_t duration_s, uint64_t threshold_ns, bool spin, bool quiet) {
+    float operand_a, operand_b, result;
+    struct timespec next;
+
+    prepare_operation(op, &operand_a, &operand_b);
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    timespec_add_ns(&next, interval_ns);
+    uint64_t first_ns = timespec_ns(&next);
+    uint64_t next_report_ns = first_ns + REPORT_INTERVAL_NS;
+
+    while (keep_running && (loops == 0 || stats.cycles < loops)) {
+        int ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        if (ret == EINTR) {
+            continue;
+        }
+        if (ret != 0) {
+            fprintf(stderr, "clock_nanosleep: %s\n", strerror(ret));
+            return -1;
+        }
+
+        uint64_t expiry_ns = timespec_ns(&next);
+        uint64_t woke_ns = histogram_now_ns();
+
+        if (calculator_submit_operation(op, operand_a, operand_b) != 0) {
+            stats.failures++;
+            keep_running = 0;
+            break;
+        }
+        uint64_t submitted_ns = histogram_now_ns();
+
+        // --spin: poll STATUS here without the driver's usleep() back-off
+        // so the completion stage measures the IP, not the sleep
+        if (spin) {
+            while (calculator_get_status().busy) {
+            }
+        }
+        if (calculator_complete_operation(op, &result) != 0) {
+            stats.failures++;
+        }
+        uint64_t completed_ns = histogram_now_ns();
+
+        record_cycle(stats.cycles, expiry_ns - first_ns, woke_ns - expiry_ns,
+                     submitted_ns - woke_ns, completed_ns - submitted_ns, threshold_ns);
+        stats.cycles++;
+
+        // Stay on the absolute schedule; skip expiries already in the past
+        timespec_add_ns(&next, interval_ns);
+        while (timespec_ns(&next) <= completed_ns) {
+            timespec_add_ns(&next, interval_ns);
+            stats.overruns++;
+        }
+
+        if (completed_ns >= next_report_ns) {
+            if (!quiet) {
+                print_progress();
+            }
+            next_report_ns += REPORT_INTERVAL_NS;
+            if (duration_s && completed_ns - first_ns >= (uint64_t)duration_s * 1000000000ULL) {
+                break;
+            }
+        }
+    }
+
+    return stats.failures == 0 ? 0 : -1;
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+static const char *dominant_stage(const outlier_t *entry) {
+    if (entry->wakeup_ns >= entry->submit_ns && entry->wakeup_ns >= entry->complete_ns) {
+        return "wakeup";
+    }
+    return entry->submit_ns >= entry->complete_ns ? "submit" : "complete";
+}
+
+static void print_outliers(FILE *output, bool csv, uint64_t limit) {
+    uint64_t stored = stats.outliers < MAX_OUTLIERS ? stats.outliers : MAX_OUTLIERS;
+
+    if (csv) {
+        fprintf(output, "cycle,time_s,wakeup_ns,submit_ns,complete_ns,dominant\n");
+    } else {
+        fprintf(output, "%10s %12s %10s %10s %10s  %s\n",
+                "cycle", "time (s)", "wakeup", "submit", "complete", "dominant");
+    }
+    for (uint64_t i = 0; i < stored && i < limit; i++) {
+        const outlier_t *entry = &outliers[i];
+        fprintf(output, csv ? "%llu,%.6f,%u,%u,%u,%s\n" : "%10llu %12.6f %10u %10u %10u  %s\n",
+                (unsigned long long)entry->cycle, (double)entry->offset_ns / 1e9,
+                entry->wakeup_ns, entry->submit_ns, entry->complete_ns, dominant_stage(entry));
+    }
+}
+
+static int print_report(const char *outlier_path, uint64_t interval_ns, uint64_t threshold_ns,
+                        bool full_histograms) {
+    printf("\nSummary: %llu cycles at %llu us, %llu overruns, %llu failed operations\n",
+           (unsigned long long)stats.cycles, (unsigned long long)(interval_ns / 1000),
+           (unsigned long long)stats.overruns, (unsigned long long)stats.failures);
+    histogram_print_summary(&stats.wakeup, stdout);
+    histogram_print_summary(&stats.submit, stdout);
+    histogram_print_summary(&stats.complete, stdout);
+    histogram_print_summary(&stats.total, stdout);
+    if (full_histograms) {
+        histogram_print(&stats.wakeup, stdout);
+        histogram_print(&stats.submit, stdout);
+        histogram_print(&stats.complete, stdout);
+    }
+
+    printf("\nOutliers over %llu ns: %llu", (unsigned long long)threshold_ns,
+           (unsigned long long)stats.outliers);
+    if (stats.outliers > MAX_OUTLIERS) {
+        printf(" (first %d kept)", MAX_OUTLIERS);
+    }
+    printf("\n");
+    if (stats.outliers == 0) {
+        return 0;
+    }
+
+    if (outlier_path != NULL) {
+        FILE *file = fopen(outlier_path, "w");
+        if (file == NULL) {
+            fprintf(stderr, "Failed to open %s: %s\n", outlier_path, strerror(errno));
+            return -1;
+        }
+        print_outliers(file, true, MAX_OUTLIERS);
+        fclose(file);
+        printf("Time series written to %s\n", outlier_path);
+    } else {
+        print_outliers(stdout, false, PRINTED_OUTLIERS);
+        if (stats.outliers > PRINTED_OUTLIERS) {
+            printf("... %llu more (use --outliers FILE for all of them)\n",
+                   (unsigned long long)(stats.outliers - PRINTED_OUTLIERS));
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// Usage
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("\n");
+    printf("Periodic timer wakeup + one calculator operation per cycle; wakeup,\n");
+    printf("submit and completion latency are measured separately.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  -h, --help          Show this help message\n");
+    printf("  -i, --interval US   Timer period (default: %d)\n", DEFAULT_INTERVAL_US);
+    printf("  -l, --loops N       Stop after N cycles (default: run until Ctrl+C)\n");
+    printf("  -d SECONDS          Stop after SECONDS\n");
+    printf("  --op NAME           Operation per cycle: ADD ... RANGE (default: ADD)\n");
+    printf("  --threshold NS      Outlier threshold on the cycle total (default: %d)\n",
+           DEFAULT_THRESHOLD_NS);
+    printf("  --outliers FILE     Write the outlier time series as CSV\n");
+    printf("  --histogram         Print the full per-stage histograms\n");
+    printf("  --spin              Busy-poll STATUS instead of the driver's wait\n");
+    printf("  --cpu N             Pin to CPU N\n");
+    printf("  --rt-priority N     SCHED_FIFO priority (default: 0 = SCHED_OTHER)\n");
+    printf("  --no-mlock          Do not lock and pre-fault memory\n");
+    printf("  --model             Use the software model (no FPGA; measures the OS only)\n");
+    printf("  -q, --quiet         No per-second progress lines\n");
+    printf("\n");
+    printf("Typical run on the board: %s --cpu 1 --rt-priority 80 -i 200 -d 60\n", program_name);
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+int main(int argc, char *argv[]) {
+    uint64_t interval_ns = DEFAULT_INTERVAL_US * 1000ULL;
+    uint64_t threshold_ns = DEFAULT_THRESHOLD_NS;
+    uint64_t loops = 0;
+    uint32_t duration_s = 0;
+    calculator_operation_t op = CALC_OP_ADD;
+    const char *outlier_path = NULL;
+    bool full_histograms = false;
+    bool spin = false;
+    bool use_model = false;
+    bool quiet = false;
+    bool lock_memory = true;
+    int cpu = -1;
+    int rt_priority = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if ((strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--interval") == 0) && i + 1 < argc) {
+            interval_ns = strtoull(argv[++i], NULL, 0) * 1000ULL;
+            if (interval_ns == 0) {
+                fprintf(stderr, "Invalid interval: %s\n", argv[i]);
+                return 1;
+            }
+        } else if ((strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--loops") == 0) && i + 1 < argc) {
+            loops = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            duration_s = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--op") == 0 && i + 1 < argc) {
+            if (parse_operation(argv[++i], &op) != 0) {
+                fprintf(stderr, "Unknown operation: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold_ns = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--outliers") == 0 && i + 1 < argc) {
+            outlier_path = argv[++i];
+        } else if (strcmp(argv[i], "--histogram") == 0) {
+            full_histograms = true;
+        } else if (strcmp(argv[i], "--spin") == 0) {
+            spin = true;
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rt-priority") == 0 && i + 1 < argc) {
+            rt_priority = atoi(argv[++i]);
+            if (rt_priority < 0 || rt_priority > 99) {
+                fprintf(stderr, "Invalid RT priority: %s (0-99)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--no-mlock") == 0) {
+            lock_memory = false;
+        } else if (strcmp(argv[i], "--model") == 0) {
+            use_model = true;
+        } else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    logger_init(LOG_LEVEL_INFO, stderr);
+    // Per-operation driver logs would be measured as completion latency
+    logger_set_module_level(LOG_MODULE_CALCULATOR, LOG_LEVEL_WARN);
+
+    struct sigaction signal_action;
+    memset(&signal_action, 0, sizeof(signal_action));
+    signal_action.sa_handler = signal_handler;
+    sigaction(SIGINT, &signal_action, NULL);
+    sigaction(SIGTERM, &signal_action, NULL);
+
+    rt_config_t rt_config;
+    rt_report_t rt_report;
+    rt_default_config(&rt_config);
+    rt_config.cpu = cpu;
+    rt_config.priority = rt_priority;
+    rt_config.lock_memory = lock_memory;
+    if (!lock_memory) {
+        rt_config.stack_prefault = rt_config.heap_prefault = 0;
+    }
+    rt_setup(&rt_config, &rt_report);
+    rt_print_report(&rt_report, stdout);
+
+    // SCHED_OTHER timers are rounded up by the 50 us default timer slack,
+    // which would swamp the wakeup histogram (SCHED_FIFO ignores slack)
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+
+    if ((use_model ? calculator_init_model() : calculator_init()) != 0) {
+        fprintf(stderr, "Failed to initialize the calculator\n");
+        return 1;
+    }
+
+    histogram_init(&stats.wakeup, "wakeup");
+    histogram_init(&stats.submit, "submit");
+    histogram_init(&stats.complete, "complete");
+    histogram_init(&stats.total, "total");
+
+    printf("\n%s every %llu us on %s%s\n", calculator_operation_to_string(op),
+           (unsigned long long)(interval_ns / 1000), use_model ? "the software model" : "hardware",
+           spin ? ", spinning on STATUS" : "");
+
+    uint64_t faults_before = rt_thread_faults();
+    int ret = run_loop(op, interval_ns, loops, duration_s, threshold_ns, spin, quiet);
+    uint64_t faults = rt_thread_faults() - faults_before;
+
+    calculator_cleanup();
+    if (print_report(outlier_path, interval_ns, threshold_ns, full_histograms) != 0) {
+        ret = -1;
+    }
+    printf("Page faults during the run: %llu\n", (unsigned long long)faults);
+    return ret == 0 ? 0 : 1;
+}
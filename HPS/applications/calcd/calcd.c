@@ -0,0 +1,555 @@
+// ============================================================================
+// Calculator Broker Daemon (calcd)
+// ============================================================================
+// Sole owner of the calculator IP. Clients submit requests through per-client
+// shared-memory SPSC rings (see libs/calcd/calcd_protocol.h); one poll-mode
+// thread pinned to a core drains every ring, runs the requests back to back
+// on the IP and posts the results to each client's response ring.
+//
+// One thread owns the hardware, so access is serialized without locks.
+// Each client gets a private price buffer: the daemon keeps a shadow of it
+// and reloads the IP buffer when a different client's window operation
+// comes up.
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <sched.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "calculator_driver.h"
+#include "calcd_protocol.h"
+#include "telemetry.h"
+#include "rt_setup.h"
+
+#define LOG_MODULE LOG_MODULE_APP
+#include "logger.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define CALCD_DEFAULT_CPU        1          // Core the daemon polls on
+#define CALCD_DEFAULT_BATCH      16         // Requests taken from one client per round
+#define CALCD_MAX_BATCH          CALCD_RING_SIZE
+#define CALCD_DEFAULT_WINDOW     20         // IP reset value of BUFFER_CTRL
+#define CALCD_PRICE_HISTORY      256        // Price RAM depth
+#define CALCD_HOUSEKEEPING_NS    100000000ULL  // Dead-client scan every 100ms
+
+// ============================================================================
+// Per-Client Context (daemon memory)
+// ============================================================================
+typedef struct {
+    uint32_t generation;                  // Slot generation this context belongs to
+    uint16_t window;                      // Buffer window size
+    uint32_t price_count;                 // Prices written since the last reset
+    float prices[CALCD_PRICE_HISTORY];    // Newest CALCD_PRICE_HISTORY prices
+    bool ema_valid;                       // EMA seeded since the last reset
+    float ema;                            // Latest EMA value
+} client_context_t;
+
+// ============================================================================
+// Statistics
+// ============================================================================
+typedef struct {
+    uint64_t requests;
+    uint64_t failures;
+    uint64_t rounds;        // Polling rounds that found work
+    uint64_t reloads;       // Price buffer context switches
+    uint64_t max_batch;     // Largest number of requests served in one round
+} calcd_stats_t;
+
+// ============================================================================
+// Global State
+// ============================================================================
+static volatile sig_atomic_t keep_running = 1;
+static calcd_shm_t *shm = NULL;
+static client_context_t contexts[CALCD_MAX_CLIENTS];
+static int loaded_client = -1;           // Whose prices are in the IP buffer
+static calcd_stats_t stats;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static void signal_handler(int signum) {
+    (void)signum;
+    keep_running = 0;
+}
+
+static inline void cpu_relax(void) {
+#if defined(__arm__) || defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void context_reset(client_context_t *ctx, uint16_t window) {
+    ctx->window = window;
+    ctx->price_count = 0;
+    ctx->ema_valid = false;
+}
+
+static void context_add_price(client_context_t *ctx, float price) {
+    ctx->prices[ctx->price_count % CALCD_PRICE_HISTORY] = price;
+    ctx->price_count++;
+}
+
+/**
+ * Make 'client' the owner of the IP price buffer
+ *
+ * Reloads the window size and the newest prices, then re-seeds the EMA with
+ * its last value (the first EMA update after a buffer reset seeds it).
+ *
+ * Returns: 0 on success, -1 on driver error
+ */
+static int context_load(int client) {
+    client_context_t *ctx = &contexts[client];
+
+    if (loaded_client == client) {
+        return 0;
+    }
+
+    loaded_client = -1;
+    calculator_set_window_size(ctx->window);
+    calculator_buffer_reset();
+
+    uint32_t count = ctx->price_count < CALCD_PRICE_HISTORY ? ctx->price_count : CALCD_PRICE_HISTORY;
+    for (uint32_t i = ctx->price_count - count; i != ctx->price_count; i++) {
+        if (calculator_buffer_write_price(ctx->prices[i % CALCD_PRICE_HISTORY]) != 0) {
+            return -1;
+        }
+    }
+
+    if (ctx->ema_valid) {
+        float seeded;
+        if (calculator_perform_operation(CALC_OP_EMA, ctx->ema, 0.0f, &seeded) != 0) {
+            return -1;
+        }
+    }
+
+    loaded_client = client;
+    stats.reloads++;
+    LOG_DEBUG("Loaded price buffer of client %d (%u prices, window %u)", client, count, ctx->window);
+    return 0;
+}
+
+// ============================================================================
+// Request Execution
+// ============================================================================
+
+/**
+ * Execute one request on the calculator
+ *
+ * Returns: 0 on success, -1 on failure (response->error_code is set)
+ */
+static int execute_request(int client, const calcd_request_t *request, calcd_response_t *response) {
+    client_context_t *ctx = &contexts[client];
+    int ret = 0;
+
+    switch (request->type) {
+        case CALCD_REQ_BUFFER_RESET: {
+            float window = request->operand_b;
+            if (!(window >= 1.0f && window <= (float)CALCD_PRICE_HISTORY)) {
+                ret = -1;
+                break;
+            }
+            context_reset(ctx, (uint16_t)window);
+            if (loaded_client == client) {
+                calculator_set_window_size(ctx->window);
+                calculator_buffer_reset();
+            }
+            break;
+        }
+
+        case CALCD_REQ_BUFFER_PRICE:
+            // Only the owner of the IP buffer writes through; others load lazily
+            context_add_price(ctx, request->operand_a);
+            if (loaded_client == client) {
+                ret = calculator_buffer_write_price(request->operand_a);
+            }
+            break;
+
+        case CALCD_REQ_OPERATION: {
+            calculator_operation_t op = (calculator_operation_t)request->op;
+
+            if (op > CALC_OP_RANGE) {
+                ret = -1;
+                break;
+            }
+
+            // Basic arithmetic does not touch the price buffer
+            if (op >= CALC_OP_SMA && context_load(client) != 0) {
+                ret = -1;
+                break;
+            }
+
+            if (op == CALC_OP_EMA) {
+                // Same sequence as calculator_ema(): alpha, price, update
+                calculator_set_ema_alpha(request->operand_b);
+                context_add_price(ctx, request->operand_a);
+                ret = calculator_buffer_write_price(request->operand_a);
+                if (ret == 0) {
+                    ret = calculator_perform_operation(op, request->operand_a, request->operand_b,
+                                                       &response->result);
+                }
+                if (ret == 0) {
+                    ctx->ema = response->result;
+                    ctx->ema_valid = true;
+                }
+                break;
+            }
+
+            ret = calculator_perform_operation(op, request->operand_a, request->operand_b,
+                                               &response->result);
+            break;
+        }
+
+        default:
+            ret = -1;
+            break;
+    }
+
+    response->tag = request->tag;
+    response->status = ret;
+    response->error_code = (ret != 0) ? calculator_read_reg(CALC_REG_ERROR_CODE) : 0;
+    return ret;
+}
+
+// ============================================================================
+// Slot Management
+// ============================================================================
+
+/**
+ * Release slots whose client detached or died
+ */
+static void housekeeping(void) {
+    for (int i = 0; i < CALCD_MAX_CLIENTS; i++) {
+        calcd_slot_control_t *control = &shm->slots[i].control;
+        uint32_t state = __atomic_load_n(&control->state, __ATOMIC_ACQUIRE);
+
+        if (state == CALCD_SLOT_ACTIVE && kill((pid_t)control->pid, 0) != 0 && errno == ESRCH) {
+            LOG_WARN("Client %d (pid %u) exited without detaching", i, control->pid);
+            state = CALCD_SLOT_CLOSING;
+        }
+        if (state == CALCD_SLOT_CLOSING) {
+            LOG_INFO("Client %d detached", i);
+            if (loaded_client == i) {
+                loaded_client = -1;
+            }
+            __atomic_store_n(&control->state, CALCD_SLOT_FREE, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+/**
+ * Serve up to 'batch' requests from one client
+ *
+ * Only as many requests are taken as the response ring can absorb, so a
+ * client that stops reading responses stalls itself, never the daemon.
+ *
+ * Returns: Number of requests served
+ */
+static uint32_t serve_client(int client, uint32_t batch) {
+    calcd_slot_t *slot = &shm->slots[client];
+    client_context_t *ctx = &contexts[client];
+
+    if (__atomic_load_n(&slot->control.state, __ATOMIC_ACQUIRE) != CALCD_SLOT_ACTIVE) {
+        return 0;
+    }
+
+    // New client in this slot: fresh price buffer
+    if (ctx->generation != slot->control.generation) {
+        LOG_INFO("Client %d attached (pid %u)", client, slot->control.pid);
+        ctx->generation = slot->control.generation;
+        context_reset(ctx, CALCD_DEFAULT_WINDOW);
+        if (loaded_client == client) {
+            loaded_client = -1;
+        }
+    }
+
+    uint32_t limit = calcd_response_free(&slot->responses);
+    if (limit > batch) {
+        limit = batch;
+    }
+
+    uint32_t served = 0;
+    calcd_request_t request;
+    while (served < limit && calcd_request_pop(&slot->requests, &request)) {
+        calcd_response_t response;
+        memset(&response, 0, sizeof(response));
+
+        int ret = execute_request(client, &request, &response);
+        if (ret != 0) {
+            stats.failures++;
+        }
+        if (ret != 0 || !(request.flags & CALCD_FLAG_POSTED)) {
+            calcd_response_push(&slot->responses, &response);
+        }
+        served++;
+    }
+
+    return served;
+}
+
+// ============================================================================
+// Shared Segment
+// ============================================================================
+static int shm_create(const char *name, bool model) {
+    // Refuse to replace a live daemon's segment
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd >= 0) {
+        calcd_header_t header;
+        memset(&header, 0, sizeof(header));
+        ssize_t got = read(fd, &header, sizeof(header));
+        close(fd);
+        if (got == (ssize_t)sizeof(header) && header.magic == CALCD_MAGIC &&
+            (kill((pid_t)header.daemon_pid, 0) == 0 || errno == EPERM)) {
+            fprintf(stderr, "calcd: already running (pid %u)\n", header.daemon_pid);
+            return -1;
+        }
+        shm_unlink(name);
+    }
+
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0660);
+    if (fd < 0) {
+        fprintf(stderr, "calcd: shm_open %s: %s\n", name, strerror(errno));
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(calcd_shm_t)) != 0) {
+        fprintf(stderr, "calcd: ftruncate: %s\n", strerror(errno));
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+
+    void *map = mmap(NULL, sizeof(calcd_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "calcd: mmap: %s\n", strerror(errno));
+        shm_unlink(name);
+        return -1;
+    }
+
+    // Touch every page now rather than on the first client request
+    shm = (calcd_shm_t *)map;
+    memset(shm, 0, sizeof(*shm));
+    shm->header.version = CALCD_VERSION;
+    shm->header.daemon_pid = (uint32_t)getpid();
+    shm->header.max_clients = CALCD_MAX_CLIENTS;
+    shm->header.model = model ? 1 : 0;
+    __atomic_store_n(&shm->header.magic, CALCD_MAGIC, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+static void shm_destroy(const char *name) {
+    if (shm != NULL) {
+        __atomic_store_n(&shm->header.magic, 0, __ATOMIC_RELEASE);
+        munmap(shm, sizeof(calcd_shm_t));
+        shm = NULL;
+    }
+    shm_unlink(name);
+}
+
+// ============================================================================
+// Usage
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("\n");
+    printf("Calculator broker: owns the calculator IP and serves clients\n");
+    printf("through shared-memory request/response rings.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  -h, --help        Show this help message\n");
+    printf("  -v, --verbose     DEBUG log level (including per-operation driver logs)\n");
+    printf("  --log SPEC        Per-module log levels, e.g. calculator=info,app=debug\n");
+    printf("  --model           Serve from the software model (no FPGA; x86 testing)\n");
+    printf("  --cpu N           Core to pin the polling thread to (default: %d, -1 = no pinning)\n",
+           CALCD_DEFAULT_CPU);
+    printf("  --rt-priority N   SCHED_FIFO priority of the polling thread (default: 0 = SCHED_OTHER)\n");
+    printf("  --no-mlock        Do not lock and pre-fault memory\n");
+    printf("  --batch N         Requests taken from one client per round (default: %d)\n",
+           CALCD_DEFAULT_BATCH);
+    printf("  --name NAME       Shared memory name (default: %s)\n", CALCD_DEFAULT_NAME);
+    printf("  --telemetry       Publish op/error counters for boot_led --telemetry\n");
+    printf("\n");
+    printf("The polling thread never sleeps; give it a core of its own.\n");
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+int main(int argc, char *argv[]) {
+    const char *name = CALCD_DEFAULT_NAME;
+    bool use_model = false;
+    bool publish_telemetry = false;
+    bool verbose_mode = false;
+    const char *module_levels = NULL;
+    int cpu = CALCD_DEFAULT_CPU;
+    int rt_priority = 0;
+    bool lock_memory = true;
+    int batch = CALCD_DEFAULT_BATCH;
+    log_level_t log_level = LOG_LEVEL_INFO;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
+            log_level = LOG_LEVEL_DEBUG;
+            verbose_mode = true;
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            module_levels = argv[++i];
+        } else if (strcmp(argv[i], "--model") == 0) {
+            use_model = true;
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rt-priority") == 0 && i + 1 < argc) {
+            rt_priority = atoi(argv[++i]);
+            if (rt_priority < 0 || rt_priority > 99) {
+                fprintf(stderr, "Invalid RT priority: %s (0-99)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--no-mlock") == 0) {
+            lock_memory = false;
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch = atoi(argv[++i]);
+            if (batch < 1 || batch > CALCD_MAX_BATCH) {
+                fprintf(stderr, "Invalid batch size: %s (1-%d)\n", argv[i], CALCD_MAX_BATCH);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--telemetry") == 0) {
+            publish_telemetry = true;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    logger_init(log_level, stderr);
+    // The driver logs every operation at INFO; keep that off the hot path
+    if (!verbose_mode) {
+        logger_set_module_level(LOG_MODULE_CALCULATOR, LOG_LEVEL_WARN);
+    }
+    if (module_levels != NULL && logger_configure_modules(module_levels) != 0) {
+        fprintf(stderr, "Invalid --log specification: %s\n", module_levels);
+        return 1;
+    }
+
+    struct sigaction signal_action;
+    memset(&signal_action, 0, sizeof(signal_action));
+    signal_action.sa_handler = signal_handler;
+    sigaction(SIGINT, &signal_action, NULL);
+    sigaction(SIGTERM, &signal_action, NULL);
+
+    // Pin, prioritize and lock before the IP and the rings are mapped, so
+    // MCL_FUTURE covers them too. Failed steps are reported, not fatal.
+    rt_config_t rt_config;
+    rt_report_t rt_report;
+    rt_default_config(&rt_config);
+    rt_config.cpu = cpu;
+    rt_config.priority = rt_priority;
+    rt_config.lock_memory = lock_memory;
+    if (!lock_memory) {
+        rt_config.stack_prefault = rt_config.heap_prefault = 0;
+    }
+    if (rt_setup(&rt_config, &rt_report) != 0) {
+        LOG_WARN("Real-time setup incomplete:");
+        rt_print_report(&rt_report, stderr);
+    } else if (verbose_mode) {
+        rt_print_report(&rt_report, stderr);
+    }
+
+    if ((use_model ? calculator_init_model() : calculator_init()) != 0) {
+        fprintf(stderr, "calcd: Failed to initialize the calculator\n");
+        return 1;
+    }
+    if (publish_telemetry && telemetry_open_writer(NULL) != 0) {
+        calculator_cleanup();
+        return 1;
+    }
+    if (shm_create(name, use_model) != 0) {
+        telemetry_close_writer();
+        calculator_cleanup();
+        return 1;
+    }
+
+    LOG_INFO("calcd serving %s on %s (cpu %d, %d clients, batch %d)",
+             name, use_model ? "software model" : "hardware", cpu, CALCD_MAX_CLIENTS, batch);
+
+    // Poll loop: one pass over every slot per round, starting one slot
+    // further each time so no client is always served first
+    uint64_t next_housekeeping_ns = monotonic_ns() + CALCD_HOUSEKEEPING_NS;
+    uint64_t serving_faults = rt_thread_faults();
+    uint32_t loops = 0;
+    uint32_t idle_rounds = 0;
+    int first = 0;
+
+    while (keep_running) {
+        uint32_t served = 0;
+
+        for (i = 0; i < CALCD_MAX_CLIENTS; i++) {
+            served += serve_client((first + i) % CALCD_MAX_CLIENTS, (uint32_t)batch);
+        }
+        first = (first + 1) % CALCD_MAX_CLIENTS;
+
+        if (served > 0) {
+            stats.requests += served;
+            stats.rounds++;
+            if (served > stats.max_batch) {
+                stats.max_batch = served;
+            }
+            idle_rounds = 0;
+        } else {
+            cpu_relax();
+            // On a dedicated core this returns at once; on a shared one it
+            // lets clients run instead of burning the whole time slice
+            if ((++idle_rounds & 1023) == 0) {
+                sched_yield();
+            }
+        }
+
+        // Check the clock only every 1024 rounds
+        if ((++loops & 1023) == 0) {
+            uint64_t now_ns = monotonic_ns();
+            if (now_ns >= next_housekeeping_ns) {
+                housekeeping();
+                next_housekeeping_ns = now_ns + CALCD_HOUSEKEEPING_NS;
+            }
+        }
+    }
+
+    LOG_INFO("calcd stopping: %llu requests (%llu failed) in %llu rounds, "
+             "max %llu per round, %llu buffer reloads, %llu page faults while serving",
+             (unsigned long long)stats.requests, (unsigned long long)stats.failures,
+             (unsigned long long)stats.rounds, (unsigned long long)stats.max_batch,
+             (unsigned long long)stats.reloads,
+             (unsigned long long)(rt_thread_faults() - serving_faults));
+
+    shm_destroy(name);
+    telemetry_close_writer();
+    calculator_cleanup();
+    return 0;
+}
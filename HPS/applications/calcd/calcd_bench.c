@@ -0,0 +1,188 @@
+// ============================================================================
+// Calculator Broker Client Benchmark (calcd_bench)
+// ============================================================================
+// Measures round-trip latency and throughput through calcd, and checks that
+// window operations see this client's prices only
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "calcd_client.h"
+#include "histogram.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define DEFAULT_ITERATIONS   100000
+#define PIPELINE_DEPTH       32       // Requests in flight in pipelined mode
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+/**
+ * One blocking ADD at a time: submit, spin for the response
+ *
+ * Returns: Number of wrong or failed results
+ */
+static int bench_blocking(calcd_client_t *client, int iterations) {
+    histogram_t latency;
+    int failures = 0;
+
+    histogram_init(&latency, "blocking round trip");
+    uint64_t start_ns = histogram_now_ns();
+
+    for (int i = 0; i < iterations; i++) {
+        float a = (float)(i & 1023);
+        float result;
+        uint64_t t0 = histogram_now_ns();
+        int ret = calcd_perform_operation(client, CALC_OP_ADD, a, 1.0f, &result);
+        histogram_record(&latency, histogram_now_ns() - t0);
+
+        if (ret != 0 || result != a + 1.0f) {
+            failures++;
+        }
+    }
+
+    uint64_t elapsed_ns = histogram_now_ns() - start_ns;
+    histogram_print_summary(&latency, stdout);
+    printf("  blocking:  %.0f ops/s\n", (double)iterations * 1e9 / (double)elapsed_ns);
+    return failures;
+}
+
+/**
+ * Keep PIPELINE_DEPTH requests in flight so the daemon can batch them
+ *
+ * Returns: Number of wrong or failed results
+ */
+static int bench_pipelined(calcd_client_t *client, int iterations) {
+    calcd_request_t request;
+    calcd_response_t response;
+    int submitted = 0;
+    int completed = 0;
+    int failures = 0;
+
+    memset(&request, 0, sizeof(request));
+    request.type = CALCD_REQ_OPERATION;
+    request.op = CALC_OP_MUL;
+    request.operand_b = 2.0f;
+
+    uint64_t first_tag = client->next_tag;
+    uint64_t start_ns = histogram_now_ns();
+
+    while (completed < iterations) {
+        while (submitted < iterations && submitted - completed < PIPELINE_DEPTH) {
+            request.operand_a = (float)(submitted & 1023);
+            if (calcd_client_submit(client, &request) != 0) {
+                break;
+            }
+            submitted++;
+        }
+        while (calcd_client_poll(client, &response)) {
+            // Tags grow by one per request
+            float expected = (float)((response.tag - first_tag) & 1023) * 2.0f;
+            if (response.status != 0 || response.result != expected) {
+                failures++;
+            }
+            completed++;
+        }
+    }
+
+    uint64_t elapsed_ns = histogram_now_ns() - start_ns;
+    printf("  pipelined: %.0f ops/s (%d in flight)\n",
+           (double)iterations * 1e9 / (double)elapsed_ns, PIPELINE_DEPTH);
+    return failures;
+}
+
+/**
+ * Load a private price series and check SMA over it
+ *
+ * Run two instances at once with different --seed values: each must keep
+ * getting its own average even though they share one price buffer in the IP.
+ *
+ * Returns: Number of wrong or failed results
+ */
+static int check_private_buffer(calcd_client_t *client, int rounds, float seed) {
+    int failures = 0;
+
+    for (int r = 0; r < rounds; r++) {
+        float result;
+        float sum = 0.0f;
+
+        if (calcd_buffer_reset(client, 8) != 0) {
+            return failures + 1;
+        }
+        for (int i = 0; i < 8; i++) {
+            float price = seed + (float)(r % 16) + (float)i;
+            sum += price;
+            if (calcd_buffer_write_price(client, price) != 0) {
+                return failures + 1;
+            }
+        }
+        if (calcd_perform_operation(client, CALC_OP_SMA, 0.0f, 8.0f, &result) != 0 ||
+            fabsf(result - sum / 8.0f) > 0.001f) {
+            failures++;
+        }
+    }
+
+    printf("  private price buffer: %d rounds, %d mismatches, %llu posted errors\n",
+           rounds, failures, (unsigned long long)client->posted_errors);
+    return failures;
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("\n");
+    printf("Options:\n");
+    printf("  -h, --help     Show this help message\n");
+    printf("  -n N           Iterations per benchmark (default: %d)\n", DEFAULT_ITERATIONS);
+    printf("  --seed X       Base price for the private buffer check (default: 100)\n");
+    printf("  --name NAME    calcd shared memory name (default: %s)\n", CALCD_DEFAULT_NAME);
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = NULL;
+    int iterations = DEFAULT_ITERATIONS;
+    float seed = 100.0f;
+    calcd_client_t client;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+            if (iterations <= 0) {
+                fprintf(stderr, "Invalid iteration count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtof(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (calcd_client_open(&client, name) != 0) {
+        return 1;
+    }
+
+    printf("calcd backend: %s\n", client.shm->header.model ? "software model" : "hardware");
+    int failures = bench_blocking(&client, iterations);
+    failures += bench_pipelined(&client, iterations);
+    failures += check_private_buffer(&client, iterations / 100 + 1, seed);
+
+    calcd_client_close(&client);
+
+    printf("Result: %s (%d failures)\n", failures == 0 ? "PASS" : "FAIL", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -96,7 +96,7 @@ const hft_test_case_t hft_test_cases[] = {
         10,
         10,
         0.0f,
-        103.25f  // Average of 100-106
+        103.2f  // Mean of the 10 prices
     },
     {
         CALC_OP_SMA,
@@ -190,7 +190,7 @@ const hft_test_case_t hft_test_cases[] = {
         6,
         19,  // α = 2/(19+1) = 0.1
         0.1f,
-        104.5f  // Approximate EMA value
+        102.63f  // Seeded with first price, 5 updates
     },
     {
         CALC_OP_EMA,
@@ -199,7 +199,7 @@ const hft_test_case_t hft_test_cases[] = {
         6,
         19,
         0.1f,
-        105.5f  // Approximate EMA value
+        107.37f  // Seeded with first price, 5 updates
     },
     {
         CALC_OP_EMA,
@@ -217,7 +217,7 @@ const hft_test_case_t hft_test_cases[] = {
         6,
         9,  // α = 2/(9+1) = 0.2
         0.2f,
-        101.5f  // Approximate
+        101.16f  // Seeded with first price, 5 updates
     },
     {
         CALC_OP_EMA,
@@ -226,7 +226,7 @@ const hft_test_case_t hft_test_cases[] = {
         6,
         3,  // α = 2/(3+1) = 0.5
         0.5f,
-        65.0f  // Highly responsive EMA
+        75.16f  // Highly responsive EMA
     },
     {
         CALC_OP_EMA,
@@ -235,7 +235,7 @@ const hft_test_case_t hft_test_cases[] = {
         5,
         5,
         0.333f,
-        3.5f  // EMA will differ from SMA(3.0)
+        3.39f  // Weights recent prices more than SMA(3.0)
     },
     {
         CALC_OP_EMA,
@@ -244,7 +244,7 @@ const hft_test_case_t hft_test_cases[] = {
         6,
         7,  // α = 2/(7+1) = 0.25
         0.25f,
-        105.0f  // Approximate
+        105.42f  // Seeded with first price, 5 updates
     },
 
     // ========================================================================
@@ -257,7 +257,7 @@ const hft_test_case_t hft_test_cases[] = {
         8,
         8,
         0.0f,
-        5.24f  // Standard deviation
+        5.24f  // Sample standard deviation (n-1)
     },
     {
         CALC_OP_STD_DEV,
@@ -324,7 +324,7 @@ const hft_test_case_t hft_test_cases[] = {
         10,
         10,
         0.0f,
-        107.0f  // Approximate: mean + 2*std
+        106.65f  // mean 103 + 2 * sample std 1.826
     },
     {
         CALC_OP_BOLLINGER_DN,
@@ -333,7 +333,7 @@ const hft_test_case_t hft_test_cases[] = {
         10,
         10,
         0.0f,
-        101.0f  // Approximate: mean - 2*std
+        99.35f  // mean 103 - 2 * sample std 1.826
     },
     {
         CALC_OP_RSI,
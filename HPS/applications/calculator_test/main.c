@@ -9,14 +9,23 @@
 #include <math.h>
 #include <string.h>
 #include <signal.h>
+#include <unistd.h>
 #include "calculator_driver.h"
 #include "test_cases.h"
+#include "hft_test_cases.h"
+#include "histogram.h"
+#include "flight_recorder.h"
+#include "telemetry.h"
+#include "rt_setup.h"
+
+#define LOG_MODULE LOG_MODULE_APP
 #include "logger.h"
 
 // ============================================================================
 // Configuration
 // ============================================================================
 #define FLOAT_TOLERANCE 0.001f  // Tolerance for floating point comparison
+#define HFT_TOLERANCE   0.01f   // HFT expectations are quoted to 2 decimals
 #define DELAY_BETWEEN_TESTS_US 500000  // 500ms delay to observe LEDs
 
 // ============================================================================
@@ -30,6 +39,36 @@
 #define COLOR_CYAN    "\033[36m"
 #define COLOR_BOLD    "\033[1m"
 
+// ============================================================================
+// Timing State
+// ============================================================================
+// Operation codes are 4 bits wide, so one histogram per code covers them all
+#define NUM_OPERATIONS (CALC_CTRL_OP_MASK + 1)
+
+static histogram_t basic_latency;               // Per-case latency, basic suite
+static histogram_t hft_latency;                 // Per-case compute latency, HFT suite
+static histogram_t load_latency;                // Price buffer load time per HFT case
+static histogram_t op_latency[NUM_OPERATIONS];  // Throughput mode, per operation
+
+static uint64_t latency_budget_ns = 0;          // p99 budget published to telemetry
+
+// ============================================================================
+// Operations the IP Does Not Implement
+// ============================================================================
+// calculator_hft_ops.v issues only SMA and ALL (issue_ok); every other window
+// operation completes with STATUS.error. On the FPGA and under co-simulation
+// their cases are expected to fail that way and are reported as skipped. The
+// software model implements every operation. --unsupported replaces the list.
+#define HFT_CASE_SKIPPED (-1)
+
+static const calculator_operation_t ip_unsupported_ops[] = {
+    CALC_OP_EMA, CALC_OP_WMA, CALC_OP_VWAP, CALC_OP_STD_DEV, CALC_OP_RSI,
+    CALC_OP_BOLLINGER_UP, CALC_OP_BOLLINGER_DN, CALC_OP_MIN, CALC_OP_MAX,
+    CALC_OP_RANGE,
+};
+
+static bool op_unsupported[NUM_OPERATIONS];
+
 // ============================================================================
 // Helper Functions
 // ============================================================================
@@ -54,10 +93,42 @@ static void print_banner(void) {
     printf("========================================================================\n");
 }
 
+/**
+ * Mark the operations named in a comma-separated list as unsupported
+ *
+ * "none" clears the list. Returns: 0 on success, -1 on an unknown name
+ */
+static int parse_unsupported(const char *list) {
+    char names[128];
+    char *name;
+    char *save = NULL;
+    int op;
+
+    memset(op_unsupported, 0, sizeof(op_unsupported));
+    if (strcmp(list, "none") == 0) {
+        return 0;
+    }
+
+    snprintf(names, sizeof(names), "%s", list);
+    for (name = strtok_r(names, ",", &save); name != NULL; name = strtok_r(NULL, ",", &save)) {
+        for (op = 0; op < NUM_OPERATIONS; op++) {
+            if (strcmp(name, calculator_operation_to_string((calculator_operation_t)op)) == 0) {
+                break;
+            }
+        }
+        if (op == NUM_OPERATIONS) {
+            fprintf(stderr, "Unknown operation in --unsupported: %s\n", name);
+            return -1;
+        }
+        op_unsupported[op] = true;
+    }
+    return 0;
+}
+
 /**
  * Print test summary
  */
-static void print_summary(int total, int passed, int failed) {
+static void print_summary(int total, int passed, int failed, int skipped) {
     printf("\n");
     printf("========================================================================\n");
     printf("                        TEST SUMMARY\n");
@@ -65,9 +136,12 @@ static void print_summary(int total, int passed, int failed) {
     printf("Total tests:    %s%d%s\n", COLOR_BOLD, total, COLOR_RESET);
     printf("Passed:         %s%s%d%s\n", COLOR_GREEN, COLOR_BOLD, passed, COLOR_RESET);
     printf("Failed:         %s%s%d%s\n", failed > 0 ? COLOR_RED : COLOR_GREEN, COLOR_BOLD, failed, COLOR_RESET);
+    if (skipped > 0) {
+        printf("Skipped:        %s%d%s (not implemented by the IP)\n", COLOR_YELLOW, skipped, COLOR_RESET);
+    }
     printf("Success rate:   %s%.1f%%%s\n",
            failed == 0 ? COLOR_GREEN : (passed > failed ? COLOR_YELLOW : COLOR_RED),
-           (float)passed / total * 100.0f,
+           (float)passed / (total - skipped) * 100.0f,
            COLOR_RESET);
     printf("========================================================================\n");
 
@@ -92,9 +166,9 @@ static int run_test_case(const test_case_t *test, int test_num) {
     LOG_INFO("Test %d/%d: %s", test_num, num_test_cases, test->description);
     LOG_INFO("========================================");
     LOG_DEBUG("Operation: %s (0x%X)", calculator_operation_to_string(test->operation), test->operation);
-    LOG_DEBUG("Operand A: %.6f (0x%08X)", test->operand_a, *((uint32_t *)&test->operand_a));
-    LOG_DEBUG("Operand B: %.6f (0x%08X)", test->operand_b, *((uint32_t *)&test->operand_b));
-    LOG_DEBUG("Expected:  %.6f (0x%08X)", test->expected_result, *((uint32_t *)&test->expected_result));
+    LOG_DEBUG("Operand A: %.6f (0x%08X)", test->operand_a, calculator_float_to_bits(test->operand_a));
+    LOG_DEBUG("Operand B: %.6f (0x%08X)", test->operand_b, calculator_float_to_bits(test->operand_b));
+    LOG_DEBUG("Expected:  %.6f (0x%08X)", test->expected_result, calculator_float_to_bits(test->expected_result));
     LOG_DEBUG("Tolerance: %.6f", FLOAT_TOLERANCE);
 
     // Print test header
@@ -115,12 +189,15 @@ static int run_test_case(const test_case_t *test, int test_num) {
 
     // Perform calculation
     LOG_DEBUG("Executing calculation operation...");
+    uint64_t start_ns = histogram_now_ns();
     ret = calculator_perform_operation(
         test->operation,
         test->operand_a,
         test->operand_b,
         &result
     );
+    uint64_t elapsed_ns = histogram_now_ns() - start_ns;
+    histogram_record(&basic_latency, elapsed_ns);
 
     if (ret != 0) {
         LOG_ERROR("Test %d FAILED: Operation returned error code %d", test_num, ret);
@@ -130,8 +207,9 @@ static int run_test_case(const test_case_t *test, int test_num) {
     }
 
     LOG_DEBUG("Operation completed successfully");
-    LOG_DEBUG("Actual result: %.6f (0x%08X)", result, *((uint32_t *)&result));
+    LOG_DEBUG("Actual result: %.6f (0x%08X)", result, calculator_float_to_bits(result));
     printf("  Result:       %.6f\n", result);
+    printf("  Latency:      %llu ns\n", (unsigned long long)elapsed_ns);
 
     // Verify result
     float diff = fabsf(result - test->expected_result);
@@ -144,8 +222,8 @@ static int run_test_case(const test_case_t *test, int test_num) {
         return 1;  // Test passed
     } else {
         LOG_ERROR("Test %d FAILED: Result mismatch", test_num);
-        LOG_ERROR("  Expected: %.6f (0x%08X)", test->expected_result, *((uint32_t *)&test->expected_result));
-        LOG_ERROR("  Actual:   %.6f (0x%08X)", result, *((uint32_t *)&result));
+        LOG_ERROR("  Expected: %.6f (0x%08X)", test->expected_result, calculator_float_to_bits(test->expected_result));
+        LOG_ERROR("  Actual:   %.6f (0x%08X)", result, calculator_float_to_bits(result));
         LOG_ERROR("  Diff:     %.6f (tolerance: %.6f)", diff, FLOAT_TOLERANCE);
         printf("  %sDifference:   %.6f (tolerance: %.6f)%s\n",
                COLOR_RED, diff, FLOAT_TOLERANCE, COLOR_RESET);
@@ -154,6 +232,250 @@ static int run_test_case(const test_case_t *test, int test_num) {
     }
 }
 
+/**
+ * Load an HFT test case into the price buffer and execute it
+ *
+ * SMA/STD_DEV/MIN/MAX/etc. load every price first and run the operation once
+ * over the window. EMA is a streaming indicator, so each price is pushed and
+ * the EMA updated in turn; the final update is the result.
+ *
+ * Returns: 0 on success, -1 on driver error
+ */
+static int execute_hft_case(const hft_test_case_t *test, float *result,
+                            uint64_t *load_ns, uint64_t *compute_ns) {
+    uint64_t start_ns = histogram_now_ns();
+    uint16_t i;
+
+    calculator_buffer_reset();
+    calculator_set_window_size(test->window_size);
+
+    if (test->operation == CALC_OP_EMA) {
+        *load_ns = histogram_now_ns() - start_ns;
+        start_ns = histogram_now_ns();
+        for (i = 0; i < test->price_count; i++) {
+            if (calculator_ema(test->prices[i], test->alpha, result) != 0) {
+                return -1;
+            }
+        }
+        *compute_ns = histogram_now_ns() - start_ns;
+        return 0;
+    }
+
+    for (i = 0; i < test->price_count; i++) {
+        if (calculator_buffer_write_price(test->prices[i]) != 0) {
+            return -1;
+        }
+    }
+    *load_ns = histogram_now_ns() - start_ns;
+
+    start_ns = histogram_now_ns();
+    int ret = calculator_perform_operation(test->operation, 0.0f,
+                                           (float)test->window_size, result);
+    *compute_ns = histogram_now_ns() - start_ns;
+
+    return ret;
+}
+
+/**
+ * Run a single HFT test case through the price buffer
+ *
+ * Returns: 1 if passed, 0 if failed, HFT_CASE_SKIPPED if the operation is
+ * unsupported and completed with an error. An unsupported operation that
+ * returns a result fails, right or wrong: the list is out of date.
+ */
+static int run_hft_test_case(const hft_test_case_t *test, int test_num) {
+    float result = 0.0f;
+    uint64_t load_ns = 0;
+    uint64_t compute_ns = 0;
+
+    LOG_INFO("========================================");
+    LOG_INFO("HFT Test %d/%d: %s", test_num, num_hft_test_cases, test->description);
+    LOG_INFO("========================================");
+    LOG_DEBUG("Operation: %s (0x%X), prices=%u, window=%u, alpha=%.6f",
+              calculator_operation_to_string(test->operation), test->operation,
+              test->price_count, test->window_size, test->alpha);
+
+    printf("\n");
+    printf("%s────────────────────────────────────────────────────────────────────────%s\n",
+           COLOR_CYAN, COLOR_RESET);
+    printf("%s[HFT %d/%d]%s %s\n",
+           COLOR_BOLD, test_num, num_hft_test_cases, COLOR_RESET, test->description);
+    printf("%s────────────────────────────────────────────────────────────────────────%s\n",
+           COLOR_CYAN, COLOR_RESET);
+
+    printf("  Operation:    %s%s%s\n",
+           COLOR_YELLOW, calculator_operation_to_string(test->operation), COLOR_RESET);
+    printf("  Prices:       %u (window %u", test->price_count, test->window_size);
+    if (test->operation == CALC_OP_EMA) {
+        printf(", alpha %.3f", test->alpha);
+    }
+    printf(")\n");
+    printf("  Expected:     %.6f\n", test->expected_result);
+
+    bool unsupported = op_unsupported[test->operation];
+    int ret = execute_hft_case(test, &result, &load_ns, &compute_ns);
+
+    if (ret != 0 && unsupported) {
+        LOG_INFO("HFT test %d SKIPPED: %s is not implemented by the IP", test_num,
+                 calculator_operation_to_string(test->operation));
+        printf("  %sResult:       ERROR (not implemented by the IP)%s\n", COLOR_YELLOW, COLOR_RESET);
+        printf("  %sStatus:       - SKIP%s\n", COLOR_YELLOW, COLOR_RESET);
+        return HFT_CASE_SKIPPED;
+    }
+    if (ret != 0) {
+        LOG_ERROR("HFT test %d FAILED: Operation returned error", test_num);
+        printf("  %sResult:       ERROR (operation failed)%s\n", COLOR_RED, COLOR_RESET);
+        printf("  %sStatus:       ✗ FAIL%s\n", COLOR_RED, COLOR_RESET);
+        return 0;
+    }
+
+    histogram_record(&load_latency, load_ns);
+    histogram_record(&hft_latency, compute_ns);
+
+    printf("  Result:       %.6f\n", result);
+    printf("  Latency:      load %llu ns, compute %llu ns\n",
+           (unsigned long long)load_ns, (unsigned long long)compute_ns);
+
+    if (unsupported) {
+        LOG_ERROR("HFT test %d FAILED: %s is listed as unsupported but returned a result",
+                  test_num, calculator_operation_to_string(test->operation));
+        printf("  %sStatus:       ✗ FAIL (expected unsupported; update --unsupported)%s\n",
+               COLOR_RED, COLOR_RESET);
+        return 0;
+    }
+
+    float diff = fabsf(result - test->expected_result);
+    if (float_equals(result, test->expected_result, HFT_TOLERANCE)) {
+        LOG_INFO("HFT test %d PASSED: Result matches expected value", test_num);
+        printf("  %sStatus:       ✓ PASS%s\n", COLOR_GREEN, COLOR_RESET);
+        return 1;
+    }
+
+    LOG_ERROR("HFT test %d FAILED: expected %.6f, actual %.6f, diff %.6f",
+              test_num, test->expected_result, result, diff);
+    printf("  %sDifference:   %.6f (tolerance: %.6f)%s\n",
+           COLOR_RED, diff, HFT_TOLERANCE, COLOR_RESET);
+    printf("  %sStatus:       ✗ FAIL%s\n", COLOR_RED, COLOR_RESET);
+    return 0;
+}
+
+/**
+ * Print the latency histograms collected during a normal run
+ */
+static void print_latency_summary(bool run_basic, bool run_hft) {
+    printf("\n");
+    printf("========================================================================\n");
+    printf("                     LATENCY SUMMARY (ns)\n");
+    printf("========================================================================\n");
+    if (run_basic) {
+        histogram_print_summary(&basic_latency, stdout);
+    }
+    if (run_hft) {
+        histogram_print_summary(&load_latency, stdout);
+        histogram_print_summary(&hft_latency, stdout);
+    }
+}
+
+/**
+ * Throughput mode: repeat every selected case back to back
+ *
+ * Each operation code gets its own histogram of per-call latency. ops/s is
+ * measured over the wall time of the repeat loop, so it includes loading the
+ * price buffer - that is the rate a caller can actually sustain.
+ *
+ * Cases of unsupported operations are not run.
+ *
+ * Returns: Number of repetitions whose result was wrong or errored
+ */
+static int run_throughput(int iterations, bool run_basic, bool run_hft) {
+    uint64_t wall_ns[NUM_OPERATIONS] = {0};
+    uint64_t ops[NUM_OPERATIONS] = {0};
+    int mismatches = 0;
+    int i, n;
+
+    for (i = 0; i < NUM_OPERATIONS; i++) {
+        histogram_init(&op_latency[i],
+                       calculator_operation_to_string((calculator_operation_t)i));
+    }
+
+    if (run_basic) {
+        for (i = 0; i < num_test_cases; i++) {
+            const test_case_t *test = &test_cases[i];
+            uint64_t loop_start = histogram_now_ns();
+
+            for (n = 0; n < iterations; n++) {
+                float result;
+                uint64_t start_ns = histogram_now_ns();
+                int ret = calculator_perform_operation(test->operation, test->operand_a,
+                                                       test->operand_b, &result);
+                histogram_record(&op_latency[test->operation], histogram_now_ns() - start_ns);
+
+                if (ret != 0 || !float_equals(result, test->expected_result, FLOAT_TOLERANCE)) {
+                    mismatches++;
+                }
+            }
+
+            wall_ns[test->operation] += histogram_now_ns() - loop_start;
+            ops[test->operation] += (uint64_t)iterations;
+            telemetry_set_latency(histogram_percentile(&op_latency[test->operation], 99.0),
+                                  latency_budget_ns);
+        }
+    }
+
+    if (run_hft) {
+        for (i = 0; i < num_hft_test_cases; i++) {
+            const hft_test_case_t *test = &hft_test_cases[i];
+            uint64_t loop_start = histogram_now_ns();
+
+            if (op_unsupported[test->operation]) {
+                continue;
+            }
+            for (n = 0; n < iterations; n++) {
+                float result = 0.0f;
+                uint64_t load_ns, compute_ns;
+                int ret = execute_hft_case(test, &result, &load_ns, &compute_ns);
+                histogram_record(&load_latency, load_ns);
+                histogram_record(&op_latency[test->operation], compute_ns);
+
+                if (ret != 0 || !float_equals(result, test->expected_result, HFT_TOLERANCE)) {
+                    mismatches++;
+                }
+            }
+
+            wall_ns[test->operation] += histogram_now_ns() - loop_start;
+            ops[test->operation] += (uint64_t)iterations;
+            telemetry_set_latency(histogram_percentile(&op_latency[test->operation], 99.0),
+                                  latency_budget_ns);
+        }
+    }
+
+    printf("\n");
+    printf("========================================================================\n");
+    printf("            THROUGHPUT (%d repetitions per case, latency in ns)\n", iterations);
+    printf("========================================================================\n");
+    printf("%-14s %12s\n", "Operation", "ops/s");
+    for (i = 0; i < NUM_OPERATIONS; i++) {
+        if (ops[i] == 0) {
+            continue;
+        }
+        printf("%-14s %12.0f\n", op_latency[i].label,
+               (double)ops[i] * 1e9 / (double)wall_ns[i]);
+    }
+    printf("\n");
+    for (i = 0; i < NUM_OPERATIONS; i++) {
+        if (ops[i] != 0) {
+            histogram_print_summary(&op_latency[i], stdout);
+        }
+    }
+    if (run_hft) {
+        histogram_print_summary(&load_latency, stdout);
+    }
+    printf("\nResult mismatches: %s%d%s\n",
+           mismatches > 0 ? COLOR_RED : COLOR_GREEN, mismatches, COLOR_RESET);
+
+    return mismatches;
+}
+
 /**
  * Print usage information
  */
@@ -165,6 +487,31 @@ static void print_usage(const char *program_name) {
     printf("  -q, --quick    Quick mode (no delays between tests)\n");
     printf("  -v, --verbose  Verbose output (DEBUG log level)\n");
     printf("  -vv, --trace   Trace output (TRACE log level, maximum verbosity)\n");
+    printf("  --basic        Run only the basic arithmetic suite\n");
+    printf("  --hft          Run only the HFT suite (price buffer operations)\n");
+    printf("  --throughput N Repeat every case N times back to back and report\n");
+    printf("                 ops/s and latency percentiles per operation\n");
+    printf("  --log SPEC     Per-module log levels, e.g. calculator=trace,app=warn\n");
+    printf("                 (modules: default, calculator, fpga_uio, led, app)\n");
+    printf("  --flight-recorder FILE\n");
+    printf("                 Record ops, errors and register snapshots into a\n");
+    printf("                 crash-surviving ring file (read it with fr_dump)\n");
+    printf("  --model        Run against the software model of the IP (no FPGA,\n");
+    printf("                 no root; works on an x86 host)\n");
+    printf("  --unsupported LIST\n");
+    printf("                 HFT operations the IP does not implement, e.g.\n");
+    printf("                 EMA,MIN or none. Their cases count as skipped while\n");
+    printf("                 they complete with an error, and fail if they return\n");
+    printf("                 a result (default: all but SMA and ALL on the FPGA\n");
+    printf("                 and under co-simulation, none on the software model)\n");
+    printf("  --telemetry    Publish op/error counters and p99 latency to shared\n");
+    printf("                 memory (%s) for boot_led --telemetry\n", TELEMETRY_DEFAULT_NAME);
+    printf("  --p99-budget NS\n");
+    printf("                 p99 latency budget shown as a blinking bar (default: none)\n");
+    printf("  --cpu N        Pin to CPU N\n");
+    printf("  --rt-priority N\n");
+    printf("                 Run as SCHED_FIFO with priority N (1-99)\n");
+    printf("  --mlock        Lock and pre-fault memory before the run\n");
     printf("\n");
     printf("Log Levels:\n");
     printf("  Default: INFO  - Normal operation messages\n");
@@ -184,9 +531,21 @@ static void print_usage(const char *program_name) {
 int main(int argc, char *argv[]) {
     int passed = 0;
     int failed = 0;
+    int skipped = 0;
     int i;
     bool quick_mode = false;
     bool verbose_mode = false;
+    bool run_basic = true;
+    bool run_hft = true;
+    int throughput_iterations = 0;
+    const char *module_levels = NULL;
+    const char *recorder_path = NULL;
+    bool publish_telemetry = false;
+    bool use_model = false;
+    const char *unsupported_list = NULL;
+    int cpu = -1;
+    int rt_priority = 0;
+    bool lock_memory = false;
     log_level_t log_level = LOG_LEVEL_INFO;
 
     // Parse command line arguments
@@ -202,11 +561,90 @@ int main(int argc, char *argv[]) {
         } else if (strcmp(argv[i], "-vv") == 0 || strcmp(argv[i], "--trace") == 0) {
             verbose_mode = true;
             log_level = LOG_LEVEL_TRACE;
+        } else if (strcmp(argv[i], "--basic") == 0) {
+            run_basic = true;
+            run_hft = false;
+        } else if (strcmp(argv[i], "--hft") == 0) {
+            run_basic = false;
+            run_hft = true;
+        } else if (strcmp(argv[i], "--throughput") == 0 && i + 1 < argc) {
+            throughput_iterations = atoi(argv[++i]);
+            if (throughput_iterations <= 0) {
+                fprintf(stderr, "Invalid throughput iteration count: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            module_levels = argv[++i];
+        } else if (strcmp(argv[i], "--flight-recorder") == 0 && i + 1 < argc) {
+            recorder_path = argv[++i];
+        } else if (strcmp(argv[i], "--model") == 0) {
+            use_model = true;
+        } else if (strcmp(argv[i], "--unsupported") == 0 && i + 1 < argc) {
+            unsupported_list = argv[++i];
+        } else if (strcmp(argv[i], "--telemetry") == 0) {
+            publish_telemetry = true;
+        } else if (strcmp(argv[i], "--p99-budget") == 0 && i + 1 < argc) {
+            latency_budget_ns = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rt-priority") == 0 && i + 1 < argc) {
+            rt_priority = atoi(argv[++i]);
+            if (rt_priority < 0 || rt_priority > 99) {
+                fprintf(stderr, "Invalid RT priority: %s (0-99)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--mlock") == 0) {
+            lock_memory = true;
         }
     }
 
+    // Under co-simulation --model runs the RTL, so the IP's limits apply
+#ifdef CALC_COSIM
+    bool on_ip = true;
+#else
+    bool on_ip = !use_model;
+#endif
+    if (unsupported_list != NULL) {
+        if (parse_unsupported(unsupported_list) != 0) {
+            return 1;
+        }
+    } else if (on_ip) {
+        for (i = 0; i < (int)(sizeof(ip_unsupported_ops) / sizeof(ip_unsupported_ops[0])); i++) {
+            op_unsupported[ip_unsupported_ops[i]] = true;
+        }
+    }
+
+    // Per-call logging would dominate the timings in throughput mode
+    if (throughput_iterations > 0 && !verbose_mode) {
+        log_level = LOG_LEVEL_WARN;
+    }
+
     // Initialize logging system
     logger_init(log_level, stderr);
+    if (module_levels != NULL && logger_configure_modules(module_levels) != 0) {
+        fprintf(stderr, "Invalid --log specification: %s\n", module_levels);
+        return 1;
+    }
+    if (recorder_path != NULL) {
+        if (flight_recorder_open(recorder_path, FR_DEFAULT_CAPACITY) != 0) {
+            fprintf(stderr, "Failed to open flight recorder: %s\n", recorder_path);
+            return 1;
+        }
+        logger_set_event_hook(flight_recorder_log);
+        atexit(flight_recorder_close);
+    }
+    if (publish_telemetry) {
+        if (telemetry_open_writer(NULL) != 0) {
+            fprintf(stderr, "Failed to open telemetry block: %s\n", TELEMETRY_DEFAULT_NAME);
+            return 1;
+        }
+        atexit(telemetry_close_writer);
+    }
+#ifdef LOGGER_ASYNC
+    // LOG_* calls only enqueue; the writer thread formats and is drained at exit
+    logger_async_init(log_level, stderr, NULL);
+    atexit(logger_async_shutdown);
+#endif
     LOG_INFO("Calculator Test Suite Starting");
     LOG_INFO("Arguments: argc=%d", argc);
     for (i = 0; i < argc; i++) {
@@ -218,10 +656,29 @@ int main(int argc, char *argv[]) {
     // Print banner
     print_banner();
 
+    // Before the driver maps the IP, so MCL_FUTURE covers its mappings too
+    rt_report_t rt_report;
+    bool rt_requested = cpu >= 0 || rt_priority > 0 || lock_memory;
+    if (rt_requested) {
+        rt_config_t rt_config;
+        rt_default_config(&rt_config);
+        rt_config.cpu = cpu;
+        rt_config.priority = rt_priority;
+        rt_config.lock_memory = lock_memory;
+        if (!lock_memory) {
+            rt_config.stack_prefault = rt_config.heap_prefault = 0;
+        }
+        if (rt_setup(&rt_config, &rt_report) != 0) {
+            LOG_WARN("Real-time setup incomplete");
+        }
+        printf("\n");
+        rt_print_report(&rt_report, stdout);
+    }
+
     // Initialize calculator driver
     LOG_INFO("Initializing calculator driver...");
     printf("\nInitializing calculator driver...\n");
-    if (calculator_init() != 0) {
+    if ((use_model ? calculator_init_model() : calculator_init()) != 0) {
         LOG_ERROR("Failed to initialize calculator driver");
         printf("\n%sERROR: Failed to initialize calculator driver%s\n", COLOR_RED, COLOR_RESET);
         printf("\nTroubleshooting:\n");
@@ -235,8 +692,26 @@ int main(int argc, char *argv[]) {
 
     LOG_INFO("Calculator driver initialized successfully");
     printf("\n%s✓ Calculator driver initialized successfully%s\n", COLOR_GREEN, COLOR_RESET);
-    LOG_INFO("Running %d test cases...", num_test_cases);
-    printf("\nRunning %d test cases...\n", num_test_cases);
+
+    histogram_init(&basic_latency, "basic op latency");
+    histogram_init(&hft_latency, "hft compute latency");
+    histogram_init(&load_latency, "price buffer load");
+
+    if (throughput_iterations > 0) {
+        LOG_INFO("Throughput mode: %d repetitions per case", throughput_iterations);
+        uint64_t faults_before = rt_thread_faults();
+        int mismatches = run_throughput(throughput_iterations, run_basic, run_hft);
+        if (rt_requested) {
+            printf("Page faults during the run: %llu\n",
+                   (unsigned long long)(rt_thread_faults() - faults_before));
+        }
+        calculator_cleanup();
+        return (mismatches == 0) ? 0 : 1;
+    }
+
+    int total = (run_basic ? num_test_cases : 0) + (run_hft ? num_hft_test_cases : 0);
+    LOG_INFO("Running %d test cases...", total);
+    printf("\nRunning %d test cases...\n", total);
 
     if (!quick_mode) {
         printf("\n%sNote: Watch LED[7:0] to see result register bits change in real-time!%s\n",
@@ -246,7 +721,7 @@ int main(int argc, char *argv[]) {
 
     // Run all test cases
     LOG_INFO("Starting test execution...");
-    for (i = 0; i < num_test_cases; i++) {
+    for (i = 0; run_basic && i < num_test_cases; i++) {
         LOG_DEBUG("Executing test case %d/%d", i + 1, num_test_cases);
         
         if (run_test_case(&test_cases[i], i + 1)) {
@@ -264,15 +739,36 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    // Run HFT test cases through the price buffer
+    for (i = 0; run_hft && i < num_hft_test_cases; i++) {
+        LOG_DEBUG("Executing HFT test case %d/%d", i + 1, num_hft_test_cases);
+
+        int ret = run_hft_test_case(&hft_test_cases[i], i + 1);
+        if (ret == HFT_CASE_SKIPPED) {
+            skipped++;
+        } else if (ret) {
+            passed++;
+        } else {
+            failed++;
+            LOG_WARN("HFT test %d failed (total passed: %d, failed: %d)", i + 1, passed, failed);
+        }
+
+        if (!quick_mode && i < num_hft_test_cases - 1) {
+            usleep(DELAY_BETWEEN_TESTS_US);
+        }
+    }
+
     // Print summary
-    LOG_INFO("Test execution complete: %d passed, %d failed out of %d total", passed, failed, num_test_cases);
-    print_summary(num_test_cases, passed, failed);
+    LOG_INFO("Test execution complete: %d passed, %d failed, %d skipped out of %d total",
+             passed, failed, skipped, total);
+    print_latency_summary(run_basic, run_hft);
+    print_summary(total, passed, failed, skipped);
 
     // Cleanup
     LOG_INFO("Cleaning up...");
     calculator_cleanup();
     LOG_INFO("Test suite completed");
 
-    // Return exit code (0 if all passed, 1 if any failed)
+    // Return exit code (0 if none failed, 1 if any failed)
     return (failed == 0) ? 0 : 1;
 }
@@ -0,0 +1,306 @@
+// ============================================================================
+// Flight Recorder - Dump Tool
+// ============================================================================
+// Prints the events left in a flight recorder file, oldest first. Works on
+// the file of a live, crashed or killed process. Also measures the cost of
+// recording an event on the hot path.
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "flight_recorder.h"
+#include "calculator_driver.h"
+#include "logger.h"
+#include "histogram.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define BENCH_DEFAULT_EVENTS    1000000
+#define BENCH_BATCH             16      // Events per timed sample
+#define BENCH_FILE              "/tmp/fr_dump_bench.fr"
+
+// ============================================================================
+// Dump Options
+// ============================================================================
+typedef struct {
+    uint64_t last;                  // Only print the last N events (0 = all)
+    long thread;                    // Only print this thread (-1 = all)
+    bool summary;                   // Print per-type counts at the end
+} dump_options_t;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static float bits_to_float(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static const char *op_name(uint32_t op) {
+    return calculator_operation_to_string((calculator_operation_t)(op & CALC_CTRL_OP_MASK));
+}
+
+// Ticks since the file was opened, in nanoseconds (signed: a record may be
+// stamped just before the calibration anchor on another thread)
+static int64_t ticks_to_ns(const fr_header_t *header, uint64_t ticks, uint64_t since) {
+    return (int64_t)((double)(int64_t)(ticks - since) * 1e9 / header->ticks_per_sec);
+}
+
+static void format_time(const fr_header_t *header, uint64_t timestamp, char *buffer, size_t size) {
+    uint64_t wall_ns = header->start_realtime_ns + (uint64_t)ticks_to_ns(header, timestamp, header->start_ticks);
+    time_t seconds = (time_t)(wall_ns / 1000000000ULL);
+    struct tm tm_info;
+    size_t len;
+
+    localtime_r(&seconds, &tm_info);
+    len = strftime(buffer, size, "%Y-%m-%d %H:%M:%S", &tm_info);
+    snprintf(buffer + len, size - len, ".%06llu",
+             (unsigned long long)((wall_ns % 1000000000ULL) / 1000));
+}
+
+static void print_record(const fr_header_t *header, const fr_record_t *record, uint64_t previous) {
+    char timestamp[64];
+    uint32_t i;
+
+    format_time(header, record->timestamp, timestamp, sizeof(timestamp));
+    printf("[%s] [+%8.3fus] [T%u] [%s] %-12s ",
+           timestamp,
+           previous ? (double)ticks_to_ns(header, record->timestamp, previous) / 1000.0 : 0.0,
+           record->thread,
+           (record->source < LOG_MODULE_COUNT) ? logger_module_name((log_module_t)record->source) : "?",
+           flight_recorder_event_name(record->type));
+
+    switch (record->type) {
+        case FR_EVENT_OP_ISSUED:
+            printf("%s a=%.6f b=%.6f", op_name(record->code),
+                   bits_to_float(record->data[0]), bits_to_float(record->data[1]));
+            break;
+        case FR_EVENT_OP_COMPLETED:
+            printf("%s result=%.6f (0x%08X)", op_name(record->code),
+                   bits_to_float(record->data[0]), record->data[0]);
+            break;
+        case FR_EVENT_OP_ERROR:
+            printf("%s error_code=0x%08X status=0x%08X", op_name(record->data[0]),
+                   record->code, record->data[1]);
+            break;
+        case FR_EVENT_TIMEOUT:
+            printf("control=0x%08X (%s) status=0x%08X polls=%u", record->code,
+                   op_name(record->code), record->data[0], record->data[1]);
+            break;
+        case FR_EVENT_REG_SNAPSHOT:
+            printf("0x%02X:", record->code);
+            for (i = 0; i < record->count && i < FR_RECORD_WORDS; i++) {
+                printf(" %08X", record->data[i]);
+            }
+            break;
+        case FR_EVENT_LOG:
+            printf("%s line %u \"%.*s\"", logger_level_name((log_level_t)record->code), record->data[0],
+                   (int)((FR_RECORD_WORDS - 1) * sizeof(uint32_t)), (const char *)&record->data[1]);
+            break;
+        default:
+            printf("code=0x%08X", record->code);
+            for (i = 0; i < record->count && i < FR_RECORD_WORDS; i++) {
+                printf(" %08X", record->data[i]);
+            }
+            break;
+    }
+    printf("\n");
+}
+
+// ============================================================================
+// Dump File
+// ============================================================================
+static int dump_file(const char *path, const dump_options_t *options) {
+    FILE *input = fopen(path, "rb");
+    fr_header_t header;
+    uint64_t counts[FR_EVENT_MARK + 2] = {0};
+    uint64_t torn = 0;
+    uint64_t printed = 0;
+    uint64_t previous = 0;
+
+    if (input == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    if (fread(&header, sizeof(header), 1, input) != 1 ||
+        memcmp(header.magic, FR_FILE_MAGIC, sizeof(FR_FILE_MAGIC)) != 0 ||
+        header.version != FR_FILE_VERSION ||
+        header.record_size != sizeof(fr_record_t) ||
+        header.capacity == 0 || (header.capacity & (header.capacity - 1)) != 0 ||
+        !(header.ticks_per_sec > 0.0)) {
+        fprintf(stderr, "%s: not a flight recorder file (version %d)\n", path, FR_FILE_VERSION);
+        fclose(input);
+        return -1;
+    }
+
+    fr_record_t *records = malloc((size_t)header.capacity * sizeof(fr_record_t));
+    if (records == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        fclose(input);
+        return -1;
+    }
+
+    if (fseek(input, header.header_size, SEEK_SET) != 0 ||
+        fread(records, sizeof(fr_record_t), header.capacity, input) != header.capacity) {
+        fprintf(stderr, "%s: truncated file\n", path);
+        free(records);
+        fclose(input);
+        return -1;
+    }
+    fclose(input);
+
+    uint64_t head = header.head;
+    uint64_t first = (head > header.capacity) ? head - header.capacity : 0;
+    if (options->last > 0 && head - first > options->last) {
+        first = head - options->last;
+    }
+
+    printf("Process %s (pid %u), %llu events recorded, capacity %u, %.3f MHz ticks\n\n",
+           header.process, header.pid, (unsigned long long)head, header.capacity,
+           header.ticks_per_sec / 1e6);
+
+    for (uint64_t sequence = first; sequence < head; sequence++) {
+        const fr_record_t *record = &records[sequence & (header.capacity - 1)];
+
+        // Torn by a crash mid-write, or already overwritten by a newer event
+        if (record->sequence != sequence + 1) {
+            torn++;
+            continue;
+        }
+        if (options->thread >= 0 && record->thread != (uint32_t)options->thread) {
+            continue;
+        }
+
+        print_record(&header, record, previous);
+        previous = record->timestamp;
+        counts[(record->type <= FR_EVENT_MARK) ? record->type : FR_EVENT_MARK + 1]++;
+        printed++;
+    }
+
+    printf("\n%llu events printed", (unsigned long long)printed);
+    if (torn > 0) {
+        printf(", %llu incomplete records skipped", (unsigned long long)torn);
+    }
+    printf("\n");
+
+    if (options->summary) {
+        printf("\n%-14s %s\n", "Event", "Count");
+        for (uint16_t type = FR_EVENT_OP_ISSUED; type <= FR_EVENT_MARK + 1; type++) {
+            if (counts[type] > 0) {
+                printf("%-14s %llu\n", flight_recorder_event_name(type), (unsigned long long)counts[type]);
+            }
+        }
+    }
+
+    free(records);
+    return 0;
+}
+
+// ============================================================================
+// Hot-Path Benchmark
+// ============================================================================
+static int run_bench(uint32_t events) {
+    static histogram_t record_hist;
+    static histogram_t snapshot_hist;
+    uint32_t issued[2] = { 0x43D9F70A, 0x41200000 };
+    uint32_t registers[16] = {0};
+    uint32_t n;
+
+    if (flight_recorder_open(BENCH_FILE, FR_DEFAULT_CAPACITY) != 0) {
+        return -1;
+    }
+
+    histogram_init(&record_hist, "OP_ISSUED record");
+    histogram_init(&snapshot_hist, "16-register snapshot");
+
+    printf("Flight recorder cost, ns per event (%u events, %d per sample)\n\n", events, BENCH_BATCH);
+
+    for (n = 0; n < events; n += BENCH_BATCH) {
+        uint64_t start = histogram_now_ns();
+        for (int k = 0; k < BENCH_BATCH; k++) {
+            flight_recorder_record(FR_EVENT_OP_ISSUED, LOG_MODULE_CALCULATOR, CALC_OP_SMA, issued, 2);
+        }
+        histogram_record(&record_hist, (histogram_now_ns() - start) / BENCH_BATCH);
+    }
+
+    for (n = 0; n < events / 16; n++) {
+        uint64_t start = histogram_now_ns();
+        flight_recorder_snapshot(LOG_MODULE_CALCULATOR, registers, 16);
+        histogram_record(&snapshot_hist, histogram_now_ns() - start);
+    }
+
+    flight_recorder_close();
+    unlink(BENCH_FILE);
+
+    histogram_print_summary(&record_hist, stdout);
+    histogram_print_summary(&snapshot_hist, stdout);
+    return 0;
+}
+
+// ============================================================================
+// Usage
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options] <file>\n", program_name);
+    printf("       %s --bench [N]\n", program_name);
+    printf("\n");
+    printf("Print the events in a flight recorder file, oldest first.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  -h, --help          Show this help message\n");
+    printf("  -n, --last N        Only print the last N events\n");
+    printf("  -t, --thread N      Only print events from thread N\n");
+    printf("  -s, --summary       Print per-event-type counts\n");
+    printf("  --bench [N]         Measure hot-path cost of N events (default %d)\n",
+           BENCH_DEFAULT_EVENTS);
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+int main(int argc, char *argv[]) {
+    dump_options_t options = { 0, -1, false };
+    const char *path = NULL;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            uint32_t events = BENCH_DEFAULT_EVENTS;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                events = (uint32_t)atoi(argv[++i]);
+            }
+            return (run_bench(events) == 0) ? 0 : 1;
+        } else if ((strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--last") == 0) && i + 1 < argc) {
+            options.last = strtoull(argv[++i], NULL, 0);
+        } else if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--thread") == 0) && i + 1 < argc) {
+            options.thread = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--summary") == 0) {
+            options.summary = true;
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (path == NULL) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    return (dump_file(path, &options) == 0) ? 0 : 1;
+}
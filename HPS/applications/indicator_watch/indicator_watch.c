@@ -0,0 +1,423 @@
+// ============================================================================
+// Indicator Board (indicator_watch)
+// ============================================================================
+// Reader, demo publisher and benchmark for the indicator publication segment
+// (libs/indicators/indicator_shm.h)
+//
+//   indicator_watch                 Print the board of published values
+//   indicator_watch --publish       Compute indicators on the calculator and
+//                                   publish them (demo writer)
+//   indicator_watch --bench         Publish/read cost and torn-read check
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "calculator_driver.h"
+#include "indicator_shm.h"
+#include "histogram.h"
+
+#define LOG_MODULE LOG_MODULE_APP
+#include "logger.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define DEFAULT_INTERVAL_MS    1000     // Board refresh period
+#define DEFAULT_RATE_HZ        10       // Demo ticks per second per symbol
+#define DEFAULT_SYMBOLS        4
+#define DEMO_WINDOW            20
+#define BENCH_NAME             "/hps_indicators_bench"
+#define BENCH_ITERATIONS       1000000
+
+// Indicators the demo writer computes on every tick
+static const calculator_operation_t demo_indicators[] = {
+    CALC_OP_SMA, CALC_OP_STD_DEV, CALC_OP_MIN, CALC_OP_MAX, CALC_OP_RSI
+};
+#define DEMO_INDICATOR_COUNT  (sizeof(demo_indicators) / sizeof(demo_indicators[0]))
+
+static const char *demo_symbols[] = {
+    "ES", "NQ", "CL", "GC", "ZN", "6E", "YM", "RTY"
+};
+#define DEMO_SYMBOL_MAX  (sizeof(demo_symbols) / sizeof(demo_symbols[0]))
+
+// ============================================================================
+// Global Variables
+// ============================================================================
+static volatile sig_atomic_t keep_running = 1;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    keep_running = 0;
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void sleep_ns(uint64_t ns) {
+    struct timespec ts = { .tv_sec = (time_t)(ns / 1000000000ULL),
+                           .tv_nsec = (long)(ns % 1000000000ULL) };
+    nanosleep(&ts, NULL);
+}
+
+// ============================================================================
+// Board (reader)
+// ============================================================================
+
+/**
+ * Print every published (symbol, indicator) slot with its update rate
+ *
+ * @param shm       Reader handle
+ * @param last_seq  Per-slot sequence numbers from the previous call (updated)
+ * @param period_ns Time since the previous call
+ */
+static void print_board(const indicator_shm_t *shm,
+                        uint32_t last_seq[INDICATOR_SHM_MAX_SYMBOLS][INDICATOR_SHM_MAX_INDICATORS],
+                        uint64_t period_ns) {
+    uint32_t symbol_count = indicator_shm_symbol_count(shm);
+    uint64_t now_ns = monotonic_ns();
+
+    printf("%-8s %-14s %14s %8s %10s %10s\n",
+           "SYMBOL", "INDICATOR", "VALUE", "WINDOW", "AGE(ms)", "UPD/s");
+    for (uint32_t s = 0; s < symbol_count; s++) {
+        for (uint32_t ind = 0; ind < INDICATOR_SHM_MAX_INDICATORS; ind++) {
+            indicator_value_t value;
+            uint32_t seq;
+
+            if (indicator_shm_read(shm, s, ind, &value, &seq) != 0) {
+                continue;
+            }
+            // seq advances by 2 per publish
+            double rate = (last_seq[s][ind] != 0 && period_ns > 0)
+                ? (double)((seq - last_seq[s][ind]) / 2) * 1e9 / (double)period_ns : 0.0;
+            last_seq[s][ind] = seq;
+
+            printf("%-8s %-14s %14.4f %8u %10.1f %10.1f\n",
+                   shm->segment->symbols[s],
+                   calculator_operation_to_string((calculator_operation_t)ind),
+                   value.value, value.window,
+                   (double)(now_ns - value.timestamp_ns) / 1e6, rate);
+        }
+    }
+    printf("writer: pid %u (%s)\n\n", shm->segment->header.writer_pid,
+           indicator_shm_writer_alive(shm) ? "alive" : "gone");
+    fflush(stdout);
+}
+
+static int run_board(const char *name, uint32_t interval_ms, bool once) {
+    static uint32_t last_seq[INDICATOR_SHM_MAX_SYMBOLS][INDICATOR_SHM_MAX_INDICATORS];
+    indicator_shm_t shm;
+
+    if (indicator_shm_open_reader(&shm, name) != 0) {
+        fprintf(stderr, "No indicator segment %s (is a publisher running?)\n",
+                name != NULL ? name : INDICATOR_SHM_DEFAULT_NAME);
+        return -1;
+    }
+
+    uint64_t last_ns = monotonic_ns();
+    print_board(&shm, last_seq, 0);
+    while (!once && keep_running) {
+        sleep_ns((uint64_t)interval_ms * 1000000ULL);
+        uint64_t now_ns = monotonic_ns();
+        print_board(&shm, last_seq, now_ns - last_ns);
+        last_ns = now_ns;
+    }
+
+    indicator_shm_close(&shm);
+    return 0;
+}
+
+// ============================================================================
+// Demo Publisher (writer)
+// ============================================================================
+
+/**
+ * Random-walk prices per symbol; every tick reloads the symbol's window into
+ * the IP, runs the demo indicators and publishes the results
+ */
+static int run_publisher(const char *name, bool use_model, uint32_t symbol_count, uint32_t rate_hz) {
+    static float history[DEMO_SYMBOL_MAX][DEMO_WINDOW];
+    int symbol_index[DEMO_SYMBOL_MAX];
+    indicator_shm_t shm;
+    uint64_t tick = 0;
+    int ret = 0;
+
+    if ((use_model ? calculator_init_model() : calculator_init()) != 0) {
+        fprintf(stderr, "Failed to initialize the calculator\n");
+        return -1;
+    }
+    if (indicator_shm_open_writer(&shm, name) != 0) {
+        calculator_cleanup();
+        return -1;
+    }
+
+    for (uint32_t s = 0; s < symbol_count; s++) {
+        symbol_index[s] = indicator_shm_add_symbol(&shm, demo_symbols[s]);
+        for (uint32_t i = 0; i < DEMO_WINDOW; i++) {
+            history[s][i] = 100.0f * (float)(s + 1);
+        }
+    }
+
+    LOG_INFO("Publishing %u symbols x %zu indicators at %u Hz (%s)", symbol_count,
+             DEMO_INDICATOR_COUNT, rate_hz, use_model ? "software model" : "hardware");
+
+    uint64_t period_ns = 1000000000ULL / rate_hz;
+    uint64_t next_ns = monotonic_ns();
+    srand(1);
+
+    while (keep_running && ret == 0) {
+        for (uint32_t s = 0; s < symbol_count && ret == 0; s++) {
+            // Shift in a new price: +-0.5% step
+            memmove(&history[s][0], &history[s][1], (DEMO_WINDOW - 1) * sizeof(float));
+            float step = ((float)(rand() % 1001) - 500.0f) / 100000.0f;
+            history[s][DEMO_WINDOW - 1] = history[s][DEMO_WINDOW - 2] * (1.0f + step);
+
+            calculator_buffer_reset();
+            for (uint32_t i = 0; i < DEMO_WINDOW; i++) {
+                calculator_buffer_write_price(history[s][i]);
+            }
+
+            for (uint32_t k = 0; k < DEMO_INDICATOR_COUNT; k++) {
+                indicator_value_t value;
+
+                if (calculator_perform_operation(demo_indicators[k], 0.0f, (float)DEMO_WINDOW,
+                                                 &value.value) != 0) {
+                    LOG_ERROR("%s failed for %s",
+                              calculator_operation_to_string(demo_indicators[k]), demo_symbols[s]);
+                    ret = -1;
+                    break;
+                }
+                value.window = DEMO_WINDOW;
+                value.timestamp_ns = monotonic_ns();
+                value.source_seq = tick;
+                indicator_shm_publish(&shm, (uint32_t)symbol_index[s], demo_indicators[k], &value);
+            }
+        }
+        tick++;
+
+        next_ns += period_ns;
+        uint64_t now_ns = monotonic_ns();
+        if (next_ns > now_ns) {
+            sleep_ns(next_ns - now_ns);
+        } else {
+            next_ns = now_ns;
+        }
+    }
+
+    LOG_INFO("Publisher stopping after %llu ticks", (unsigned long long)tick);
+    indicator_shm_close(&shm);
+    calculator_cleanup();
+    return ret;
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+typedef struct {
+    indicator_shm_t *shm;
+    bool stop;
+    uint64_t published;
+} hammer_args_t;
+
+// Writer thread: publish value == source_seq as fast as possible
+static void *hammer_thread(void *arg) {
+    hammer_args_t *args = (hammer_args_t *)arg;
+    indicator_value_t value;
+    uint64_t n = 0;
+
+    while (!__atomic_load_n(&args->stop, __ATOMIC_RELAXED)) {
+        n++;
+        value.value = (float)(n & 0xFFFFFF);   // Exact in a float
+        value.window = (uint32_t)n;
+        value.timestamp_ns = n;
+        value.source_seq = n;
+        indicator_shm_publish(args->shm, 0, CALC_OP_SMA, &value);
+    }
+    args->published = n;
+    return NULL;
+}
+
+static int run_bench(void) {
+    indicator_shm_t writer;
+    indicator_shm_t reader;
+    indicator_value_t value;
+    histogram_t publish_hist;
+    histogram_t read_hist;
+    uint32_t i;
+
+    if (indicator_shm_open_writer(&writer, BENCH_NAME) != 0) {
+        return -1;
+    }
+    if (indicator_shm_open_reader(&reader, BENCH_NAME) != 0) {
+        fprintf(stderr, "Failed to map %s read-only\n", BENCH_NAME);
+        indicator_shm_close(&writer);
+        return -1;
+    }
+    indicator_shm_add_symbol(&writer, "BENCH");
+
+    // Uncontended cost; timing pairs of 16 calls keeps clock_gettime out of the figure
+    histogram_init(&publish_hist, "publish (per call)");
+    histogram_init(&read_hist, "read (per call)");
+    memset(&value, 0, sizeof(value));
+    for (i = 0; i < BENCH_ITERATIONS / 16; i++) {
+        uint64_t t0 = histogram_now_ns();
+        for (int k = 0; k < 16; k++) {
+            value.source_seq++;
+            indicator_shm_publish(&writer, 0, CALC_OP_EMA, &value);
+        }
+        uint64_t t1 = histogram_now_ns();
+        for (int k = 0; k < 16; k++) {
+            indicator_shm_read(&reader, 0, CALC_OP_EMA, &value, NULL);
+        }
+        uint64_t t2 = histogram_now_ns();
+        histogram_record(&publish_hist, (t1 - t0) / 16);
+        histogram_record(&read_hist, (t2 - t1) / 16);
+    }
+    histogram_print_summary(&publish_hist, stdout);
+    histogram_print_summary(&read_hist, stdout);
+
+    // Contended: a writer thread hammers one slot while this thread reads it.
+    // Every snapshot must be internally consistent.
+    hammer_args_t args = { .shm = &writer, .stop = false, .published = 0 };
+    pthread_t thread;
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t retries_exhausted = 0;
+
+    if (pthread_create(&thread, NULL, hammer_thread, &args) != 0) {
+        fprintf(stderr, "pthread_create failed\n");
+        indicator_shm_close(&reader);
+        indicator_shm_close(&writer);
+        return -1;
+    }
+
+    uint64_t end_ns = monotonic_ns() + 1000000000ULL;
+    while (monotonic_ns() < end_ns) {
+        for (i = 0; i < 1024; i++) {
+            if (indicator_shm_read(&reader, 0, CALC_OP_SMA, &value, NULL) != 0) {
+                if (errno == EAGAIN) {
+                    retries_exhausted++;
+                }
+                continue;
+            }
+            reads++;
+            uint64_t n = value.source_seq;
+            if (value.timestamp_ns != n || value.window != (uint32_t)n ||
+                value.value != (float)(n & 0xFFFFFF)) {
+                torn++;
+            }
+        }
+    }
+    __atomic_store_n(&args.stop, true, __ATOMIC_RELAXED);
+    pthread_join(thread, NULL);
+
+    printf("  contended: %llu publishes, %llu reads, %llu torn, %llu gave up\n",
+           (unsigned long long)args.published, (unsigned long long)reads,
+           (unsigned long long)torn, (unsigned long long)retries_exhausted);
+
+    indicator_shm_close(&reader);
+    indicator_shm_close(&writer);
+    shm_unlink(BENCH_NAME);
+    return torn == 0 ? 0 : -1;
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("\n");
+    printf("Options:\n");
+    printf("  -h, --help        Show this help message\n");
+    printf("  -1, --once        Print the board once and exit\n");
+    printf("  -i MS             Board refresh period (default: %d ms)\n", DEFAULT_INTERVAL_MS);
+    printf("  --name NAME       Shared memory name (default: %s)\n", INDICATOR_SHM_DEFAULT_NAME);
+    printf("  --publish         Demo writer: compute and publish indicators\n");
+    printf("  --model           Publisher uses the software model (no FPGA)\n");
+    printf("  --symbols N       Publisher symbol count (default: %d, max %zu)\n",
+           DEFAULT_SYMBOLS, DEMO_SYMBOL_MAX);
+    printf("  --rate HZ         Publisher ticks per second (default: %d)\n", DEFAULT_RATE_HZ);
+    printf("  --bench           Measure publish/read cost and check for torn reads\n");
+}
+
+int main(int argc, char *argv[]) {
+    const char *name = NULL;
+    bool once = false;
+    bool publish = false;
+    bool use_model = false;
+    bool bench = false;
+    int interval_ms = DEFAULT_INTERVAL_MS;
+    int symbol_count = DEFAULT_SYMBOLS;
+    int rate_hz = DEFAULT_RATE_HZ;
+    int ret;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "-1") == 0 || strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval_ms = atoi(argv[++i]);
+            if (interval_ms <= 0) {
+                fprintf(stderr, "Invalid interval: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--publish") == 0) {
+            publish = true;
+        } else if (strcmp(argv[i], "--model") == 0) {
+            use_model = true;
+        } else if (strcmp(argv[i], "--symbols") == 0 && i + 1 < argc) {
+            symbol_count = atoi(argv[++i]);
+            if (symbol_count < 1 || symbol_count > (int)DEMO_SYMBOL_MAX) {
+                fprintf(stderr, "Invalid symbol count: %s (1-%zu)\n", argv[i], DEMO_SYMBOL_MAX);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            rate_hz = atoi(argv[++i]);
+            if (rate_hz < 1) {
+                fprintf(stderr, "Invalid rate: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    logger_init(LOG_LEVEL_INFO, stderr);
+    // The driver logs every operation at INFO
+    logger_set_module_level(LOG_MODULE_CALCULATOR, LOG_LEVEL_WARN);
+
+    struct sigaction signal_action;
+    memset(&signal_action, 0, sizeof(signal_action));
+    signal_action.sa_handler = signal_handler;
+    sigaction(SIGINT, &signal_action, NULL);
+    sigaction(SIGTERM, &signal_action, NULL);
+
+    if (bench) {
+        ret = run_bench();
+    } else if (publish) {
+        ret = run_publisher(name, use_model, (uint32_t)symbol_count, (uint32_t)rate_hz);
+    } else {
+        ret = run_board(name, (uint32_t)interval_ms, once);
+    }
+
+    return ret == 0 ? 0 : 1;
+}
@@ -0,0 +1,365 @@
+// ============================================================================
+// Asynchronous Logger - Binary Log Decoder
+// ============================================================================
+// Turns binary files written by logger_async (binary mode) back into the
+// same text lines the writer thread would have produced. Also measures the
+// hot-path cost of an async log call against the synchronous logger_log().
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include "logger.h"
+#include "logger_async.h"
+#include "histogram.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define MAX_RECORD_SIZE         65536   // Larger records mean a corrupt file
+#define BENCH_DEFAULT_CALLS     100000
+#define BENCH_BATCH             16      // Log calls per timed sample
+#define BENCH_DRAIN_EVERY       256     // Calls between pauses that let the writer drain
+#define BENCH_DRAIN_PAUSE_US    2000
+
+// ============================================================================
+// Decoder State
+// ============================================================================
+typedef struct {
+    alog_site_t site;
+    uint64_t count;                 // Messages decoded for this site
+} decoded_site_t;
+
+typedef struct {
+    int max_level;                  // Highest level printed
+    long thread;                    // Only print this thread (-1 = all)
+    bool stats;                     // Print per-site counts at the end
+    bool quiet;                     // Do not print messages (stats only)
+} decode_options_t;
+
+static decoded_site_t *sites = NULL;
+static size_t num_sites = 0;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static decoded_site_t *find_site(uint64_t id) {
+    if (id == 0 || id > num_sites || sites[id - 1].site.format == NULL) {
+        return NULL;
+    }
+    return &sites[id - 1];
+}
+
+static int define_site(const alog_record_t *record) {
+    const uint8_t *payload = (const uint8_t *)(record + 1);
+    size_t payload_size = record->size - sizeof(*record);
+    uint32_t line;
+
+    if (payload_size < sizeof(line) + 2 || record->site == 0 || record->site > MAX_RECORD_SIZE * 16ULL) {
+        return -1;
+    }
+
+    // Both strings must be terminated inside the record
+    const char *file = (const char *)payload + sizeof(line);
+    size_t strings_size = payload_size - sizeof(line);
+    const char *file_end = memchr(file, '\0', strings_size);
+    if (file_end == NULL) {
+        return -1;
+    }
+    const char *format = file_end + 1;
+    if (memchr(format, '\0', strings_size - (size_t)(format - file)) == NULL) {
+        return -1;
+    }
+
+    if (record->site > num_sites) {
+        decoded_site_t *grown = realloc(sites, (size_t)record->site * sizeof(*sites));
+        if (grown == NULL) {
+            return -1;
+        }
+        memset(grown + num_sites, 0, ((size_t)record->site - num_sites) * sizeof(*sites));
+        sites = grown;
+        num_sites = (size_t)record->site;
+    }
+
+    memcpy(&line, payload, sizeof(line));
+    decoded_site_t *entry = &sites[record->site - 1];
+    free((void *)entry->site.file);
+    free((void *)entry->site.format);
+    entry->site.file = strdup(file);
+    entry->site.format = strdup(format);
+    entry->site.line = (int)line;
+    entry->site.level = (log_level_t)record->level;
+    entry->site.id = (uint32_t)record->site;
+    return 0;
+}
+
+static void print_stats(void) {
+    size_t i;
+
+    printf("\n%-10s %-5s %-28s %s\n", "Count", "Level", "Site", "Format");
+    for (i = 0; i < num_sites; i++) {
+        const decoded_site_t *entry = &sites[i];
+        char location[64];
+
+        if (entry->site.format == NULL) {
+            continue;
+        }
+        const char *filename = strrchr(entry->site.file, '/');
+        filename = (filename != NULL) ? filename + 1 : entry->site.file;
+        snprintf(location, sizeof(location), "%s:%d", filename, entry->site.line);
+        printf("%-10llu %-5s %-28s %s\n",
+               (unsigned long long)entry->count, logger_level_name(entry->site.level),
+               location, entry->site.format);
+    }
+}
+
+// ============================================================================
+// Decode a Binary Log File
+// ============================================================================
+static int decode_file(const char *path, const decode_options_t *options) {
+    FILE *input = fopen(path, "rb");
+    alog_file_header_t header;
+    alog_calibration_t calibration = { 0, 0, 1e9 };
+    uint64_t messages = 0;
+    uint64_t dropped = 0;
+    int ret = 0;
+
+    if (input == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    if (fread(&header, sizeof(header), 1, input) != 1 ||
+        memcmp(header.magic, ALOG_FILE_MAGIC, sizeof(ALOG_FILE_MAGIC)) != 0) {
+        fprintf(stderr, "%s: not a logger_async binary log\n", path);
+        fclose(input);
+        return -1;
+    }
+    if (header.version != ALOG_FILE_VERSION || header.header_size != sizeof(header)) {
+        fprintf(stderr, "%s: unsupported format version %u\n", path, header.version);
+        fclose(input);
+        return -1;
+    }
+
+    alog_record_t *record = malloc(MAX_RECORD_SIZE);
+    if (record == NULL) {
+        fclose(input);
+        return -1;
+    }
+
+    while (fread(record, sizeof(*record), 1, input) == 1) {
+        if (record->size < sizeof(*record) || record->size > MAX_RECORD_SIZE || (record->size & 7U) != 0) {
+            fprintf(stderr, "%s: corrupt record (size %u)\n", path, record->size);
+            ret = -1;
+            break;
+        }
+        if (fread(record + 1, record->size - sizeof(*record), 1, input) != 1 && record->size > sizeof(*record)) {
+            fprintf(stderr, "%s: truncated record at end of file\n", path);
+            ret = -1;
+            break;
+        }
+
+        switch (record->type) {
+            case ALOG_RECORD_SITE:
+                if (define_site(record) != 0) {
+                    fprintf(stderr, "%s: corrupt site definition\n", path);
+                }
+                break;
+
+            case ALOG_RECORD_CALIBRATION:
+                if (record->size >= sizeof(*record) + 2 * sizeof(uint64_t)) {
+                    const uint8_t *payload = (const uint8_t *)(record + 1);
+                    calibration.ticks = record->timestamp;
+                    memcpy(&calibration.realtime_ns, payload, sizeof(uint64_t));
+                    memcpy(&calibration.ticks_per_sec, payload + sizeof(uint64_t), sizeof(double));
+                }
+                break;
+
+            case ALOG_RECORD_DROPPED: {
+                uint64_t count = 0;
+                if (record->size >= sizeof(*record) + sizeof(count)) {
+                    memcpy(&count, record + 1, sizeof(count));
+                }
+                dropped += count;
+                if (!options->quiet) {
+                    printf("[logger_async] [T%u] dropped %llu messages (ring full)\n",
+                           record->thread, (unsigned long long)count);
+                }
+                break;
+            }
+
+            case ALOG_RECORD_MESSAGE: {
+                decoded_site_t *entry = find_site(record->site);
+                if (entry == NULL ||
+                    record->size < sizeof(*record) + (size_t)record->nargs * sizeof(uint64_t)) {
+                    fprintf(stderr, "%s: message with unknown site %llu\n",
+                            path, (unsigned long long)record->site);
+                    break;
+                }
+                messages++;
+                entry->count++;
+                if (!options->quiet && record->level <= options->max_level &&
+                    (options->thread < 0 || (long)record->thread == options->thread)) {
+                    logger_async_print(stdout, record, &entry->site, &calibration);
+                }
+                break;
+            }
+
+            default:
+                // Unknown record types are skipped so newer writers stay readable
+                break;
+        }
+    }
+
+    if (options->stats) {
+        print_stats();
+        printf("\nMessages: %llu, dropped: %llu\n",
+               (unsigned long long)messages, (unsigned long long)dropped);
+    }
+
+    free(record);
+    fclose(input);
+    return ret;
+}
+
+// ============================================================================
+// Hot-Path Benchmark
+// ============================================================================
+
+// Time BENCH_BATCH log calls per sample, with regular pauses outside the
+// timed region so the writer keeps up and no call takes the drop path
+#define BENCH_LOOP(hist, calls, LOG_CALL)                                        \
+    do {                                                                         \
+        uint32_t n_;                                                             \
+        for (n_ = 0; n_ < (calls); n_ += BENCH_BATCH) {                          \
+            uint64_t start_ = histogram_now_ns();                                \
+            for (int k_ = 0; k_ < BENCH_BATCH; k_++) {                           \
+                LOG_CALL;                                                        \
+            }                                                                    \
+            histogram_record((hist), (histogram_now_ns() - start_) / BENCH_BATCH); \
+            if ((n_ % BENCH_DRAIN_EVERY) == 0) {                                 \
+                usleep(BENCH_DRAIN_PAUSE_US);                                    \
+            }                                                                    \
+        }                                                                        \
+    } while (0)
+
+static int run_bench(uint32_t calls) {
+    static histogram_t sync_hist;
+    static histogram_t async_int_hist;
+    static histogram_t async_mixed_hist;
+    const char *op_name = "SMA";
+    double price = 435.93;
+    uint32_t value = 0x43D9F70A;
+
+    FILE *devnull = fopen("/dev/null", "w");
+    if (devnull == NULL) {
+        perror("/dev/null");
+        return -1;
+    }
+
+    histogram_init(&sync_hist, "logger_log (sync)");
+    histogram_init(&async_int_hist, "ALOG 2 ints");
+    histogram_init(&async_mixed_hist, "ALOG int+float+string");
+
+    printf("Log call cost, ns per call (%u calls, %d per sample)\n\n", calls, BENCH_BATCH);
+
+    logger_init(LOG_LEVEL_INFO, devnull);
+    BENCH_LOOP(&sync_hist, calls,
+               logger_log(LOG_LEVEL_INFO, __FILE__, __LINE__, "REG WRITE: offset=0x%02X, value=0x%08X", 0x1C, value));
+
+    if (logger_async_init(LOG_LEVEL_INFO, devnull, NULL) != 0) {
+        fprintf(stderr, "Failed to start async logger\n");
+        fclose(devnull);
+        return -1;
+    }
+    BENCH_LOOP(&async_int_hist, calls,
+               ALOG_INFO("REG WRITE: offset=0x%02X, value=0x%08X", 0x1C, value));
+    BENCH_LOOP(&async_mixed_hist, calls,
+               ALOG_INFO("OP COMPLETE: %s window=%u result=%.6f", op_name, 10, price));
+    logger_async_shutdown();
+
+    histogram_print_summary(&sync_hist, stdout);
+    histogram_print_summary(&async_int_hist, stdout);
+    histogram_print_summary(&async_mixed_hist, stdout);
+    printf("\nDropped messages: %llu\n", (unsigned long long)logger_async_dropped());
+
+    fclose(devnull);
+    return 0;
+}
+
+// ============================================================================
+// Usage
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options] <file.alog>\n", program_name);
+    printf("       %s --bench [N]\n", program_name);
+    printf("\n");
+    printf("Decode a binary log written by logger_async_init(..., path).\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  -h, --help          Show this help message\n");
+    printf("  -l, --level LEVEL   Highest level to print (ERROR, WARN, INFO, DEBUG, TRACE)\n");
+    printf("  -t, --thread N      Only print messages from thread N\n");
+    printf("  -s, --stats         Print per-call-site message counts\n");
+    printf("  -q, --quiet         Do not print messages (use with --stats)\n");
+    printf("  --bench [N]         Measure hot-path cost of N log calls (default %d)\n",
+           BENCH_DEFAULT_CALLS);
+}
+
+static int parse_level(const char *name) {
+    int level;
+
+    for (level = LOG_LEVEL_ERROR; level <= LOG_LEVEL_TRACE; level++) {
+        if (strcasecmp(name, logger_level_name((log_level_t)level)) == 0) {
+            return level;
+        }
+    }
+    return atoi(name);
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+int main(int argc, char *argv[]) {
+    decode_options_t options = { LOG_LEVEL_TRACE, -1, false, false };
+    const char *path = NULL;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            uint32_t calls = BENCH_DEFAULT_CALLS;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                calls = (uint32_t)atoi(argv[++i]);
+            }
+            return (run_bench(calls) == 0) ? 0 : 1;
+        } else if ((strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--level") == 0) && i + 1 < argc) {
+            options.max_level = parse_level(argv[++i]);
+        } else if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--thread") == 0) && i + 1 < argc) {
+            options.thread = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--stats") == 0) {
+            options.stats = true;
+        } else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quiet") == 0) {
+            options.quiet = true;
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (path == NULL) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    return (decode_file(path, &options) == 0) ? 0 : 1;
+}
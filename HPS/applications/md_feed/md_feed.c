@@ -0,0 +1,769 @@
+// ============================================================================
+// Market Data Feed Tool (md_feed)
+// ============================================================================
+// First stage of the live pipeline: receive the multicast feed, decode it in
+// place and report rates, gaps and wire-to-handler latency. Also contains a
+// sender, so the whole path can be tested on loopback.
+//
+//   md_feed --send --iface 127.0.0.1 &     Local sender
+//   md_feed --iface 127.0.0.1              Receive, decode, report
+//   md_feed --arbitrate ...                Receive lines A and B, keep the
+//                                          first copy of each datagram
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <sched.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "market_data.h"
+#include "md_udp.h"
+#include "md_packet_ring.h"
+#include "md_arbiter.h"
+#include "rt_setup.h"
+#include "arena.h"
+#include "malloc_guard.h"
+#include "histogram.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define DEFAULT_RATE           10000    // Sender datagrams per second
+#define DEFAULT_TICKS          4        // Ticks per datagram
+#define REPORT_INTERVAL_NS     1000000000ULL
+
+static const char *feed_symbols[] = { "ES", "NQ", "CL", "GC", "ZN", "6E", "YM", "RTY" };
+#define FEED_SYMBOL_COUNT  (sizeof(feed_symbols) / sizeof(feed_symbols[0]))
+
+// ============================================================================
+// Global Variables
+// ============================================================================
+static volatile sig_atomic_t keep_running = 1;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    keep_running = 0;
+}
+
+static uint64_t realtime_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================================
+// Sender
+// ============================================================================
+typedef struct {
+    const char *group;
+    const char *interface;
+    uint16_t port;
+    uint32_t rate;           // Datagrams per second (0 = unpaced)
+    uint32_t ticks;          // Ticks per datagram
+    uint64_t count;          // Datagrams to send (0 = until interrupted)
+    uint32_t line;           // Line index written into the header (0 = A, 1 = B)
+    double loss_pct;         // Datagrams dropped on purpose
+    double reorder_pct;      // Datagrams held back and sent after the next one
+    unsigned int seed;       // Impairment RNG seed (0 = derived from the line)
+} sender_config_t;
+
+// Impairments use their own RNG so the A and B senders, which share the
+// feed RNG seed, still produce identical feed content
+static bool impair(unsigned int *state, double pct) {
+    return pct > 0.0 && (double)rand_r(state) * 100.0 / ((double)RAND_MAX + 1.0) < pct;
+}
+
+static int send_datagram(int fd, const struct sockaddr_in *dest, const uint8_t *data, size_t length) {
+    if (sendto(fd, data, length, 0, (const struct sockaddr *)dest, sizeof(*dest)) < 0 &&
+        errno != ENOBUFS) {
+        fprintf(stderr, "sendto: %s\n", strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+static int run_sender(const sender_config_t *config) {
+    uint8_t datagram[sizeof(md_packet_header_t) + 64 * sizeof(md_tick_t)];
+    uint8_t held[sizeof(datagram)];
+    bool holding = false;
+    md_packet_header_t header;
+    float prices[FEED_SYMBOL_COUNT];
+    uint64_t sequence = 0;
+    uint64_t dropped = 0;
+    uint64_t reordered = 0;
+    unsigned int impair_state = config->seed ? config->seed : 0x5EED0000U + config->line;
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        fprintf(stderr, "socket: %s\n", strerror(errno));
+        return -1;
+    }
+
+    struct sockaddr_in dest;
+    memset(&dest, 0, sizeof(dest));
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(config->port);
+    if (!inet_aton(config->group, &dest.sin_addr)) {
+        fprintf(stderr, "Invalid destination address: %s\n", config->group);
+        close(fd);
+        return -1;
+    }
+
+    unsigned char loop = 1;
+    unsigned char ttl = 1;
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    if (config->interface != NULL) {
+        struct in_addr iface;
+        if (!inet_aton(config->interface, &iface) ||
+            setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface)) != 0) {
+            fprintf(stderr, "Invalid multicast interface: %s\n", config->interface);
+            close(fd);
+            return -1;
+        }
+    }
+
+    for (uint32_t s = 0; s < FEED_SYMBOL_COUNT; s++) {
+        prices[s] = 100.0f * (float)(s + 1);
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = MD_MAGIC;
+    header.version = MD_VERSION;
+    header.line = (uint8_t)config->line;
+    header.tick_count = (uint16_t)config->ticks;
+    size_t length = sizeof(header) + config->ticks * sizeof(md_tick_t);
+
+    printf("Sending line %c to %s:%u, %u ticks per datagram, %s\n", 'A' + (int)config->line,
+           config->group, config->port, config->ticks, config->rate ? "paced" : "unpaced");
+    if (config->loss_pct > 0.0 || config->reorder_pct > 0.0) {
+        printf("Impairments: %.2f%% loss, %.2f%% reordered\n", config->loss_pct, config->reorder_pct);
+    }
+    if (config->rate) {
+        printf("Rate: %u datagrams/s\n", config->rate);
+    }
+
+    uint64_t period_ns = config->rate ? 1000000000ULL / config->rate : 0;
+    uint64_t next_ns = monotonic_ns();
+    srand(1);
+
+    while (keep_running && (config->count == 0 || sequence < config->count)) {
+        for (uint32_t t = 0; t < config->ticks; t++) {
+            md_tick_t tick;
+            uint32_t s = (uint32_t)((sequence * config->ticks + t) % FEED_SYMBOL_COUNT);
+
+            prices[s] *= 1.0f + ((float)(rand() % 1001) - 500.0f) / 1000000.0f;
+            memset(&tick, 0, sizeof(tick));
+            memcpy(tick.symbol, feed_symbols[s], strlen(feed_symbols[s]));
+            tick.price = prices[s];
+            tick.volume = (float)(1 + rand() % 100);
+            memcpy(datagram + sizeof(header) + t * sizeof(tick), &tick, sizeof(tick));
+        }
+
+        header.sequence = ++sequence;
+        header.send_ns = realtime_ns();
+        memcpy(datagram, &header, sizeof(header));
+
+        if (impair(&impair_state, config->loss_pct)) {
+            dropped++;
+        } else if (!holding && impair(&impair_state, config->reorder_pct)) {
+            // Send this one after the next datagram
+            memcpy(held, datagram, length);
+            holding = true;
+            reordered++;
+        } else {
+            if (send_datagram(fd, &dest, datagram, length) != 0 ||
+                (holding && send_datagram(fd, &dest, held, length) != 0)) {
+                close(fd);
+                return -1;
+            }
+            holding = false;
+        }
+
+        if (period_ns) {
+            // Spin to the next slot: sleeping would add the timer slack to every gap
+            next_ns += period_ns;
+            while (monotonic_ns() < next_ns && keep_running) {
+            }
+        }
+    }
+
+    if (holding) {
+        send_datagram(fd, &dest, held, length);
+    }
+    printf("Sent %llu datagrams (%llu dropped, %llu reordered)\n", (unsigned long long)sequence,
+           (unsigned long long)dropped, (unsigned long long)reordered);
+    close(fd);
+    return 0;
+}
+
+// ============================================================================
+// Receiver and Decode Stage
+// ============================================================================
+// Normalized tick handed from the decode stage to the book stage. Created
+// in the per-batch arena and released in bulk when the batch is done.
+typedef struct {
+    uint64_t sequence;
+    uint64_t rx_ns;
+    float price;
+    float volume;
+    uint16_t symbol;             // Index into feed_symbols
+    uint8_t line;
+} tick_event_t;
+
+// Worst case: every datagram of a full batch packed with ticks
+#define EVENT_ARENA_SIZE \
+    (MD_MAX_BATCH * (MD_MAX_DATAGRAM / sizeof(md_tick_t)) * sizeof(tick_event_t))
+
+typedef struct {
+    uint64_t datagrams;
+    uint64_t ticks;
+    uint64_t invalid;
+    uint64_t gaps;               // Missing sequence numbers
+    uint64_t out_of_order;       // Sequence numbers at or below the last one
+    uint64_t next_sequence;      // Expected sequence (0 = none seen yet)
+    float last_price[FEED_SYMBOL_COUNT];
+    histogram_t wire_latency;    // send_ns -> rx_ns (kernel timestamp if enabled)
+    histogram_t handler_latency; // send_ns -> decode stage
+    md_arbiter_t *arbiter;       // A/B arbitration (NULL = single line)
+    arena_t events;              // Per-batch tick events
+    tick_event_t *chunks[MD_MAX_BATCH];   // One event array per datagram in the batch
+    uint32_t chunk_counts[MD_MAX_BATCH];
+    uint32_t chunk_count;
+} decode_state_t;
+
+static int symbol_index(const char *symbol) {
+    for (uint32_t s = 0; s < FEED_SYMBOL_COUNT; s++) {
+        if (strncmp(symbol, feed_symbols[s], 8) == 0) {
+            return (int)s;
+        }
+    }
+    return -1;
+}
+
+// Book stage: latest price per symbol from the batch's events
+static void apply_events(decode_state_t *state) {
+    for (uint32_t c = 0; c < state->chunk_count; c++) {
+        const tick_event_t *events = state->chunks[c];
+        for (uint32_t e = 0; e < state->chunk_counts[c]; e++) {
+            state->last_price[events[e].symbol] = events[e].price;
+        }
+    }
+}
+
+// Decode stage: runs on the receive buffers in place and turns each tick
+// into a tick_event_t for the book stage, allocated from the batch arena
+static void decode_batch(const md_packet_t *packets, uint32_t count, void *context) {
+    decode_state_t *state = (decode_state_t *)context;
+    uint64_t now_ns = realtime_ns();
+
+    for (uint32_t i = 0; i < count; i++) {
+        const md_packet_header_t *header;
+        const md_tick_t *ticks;
+        int n = md_decode(&packets[i], &header, &ticks);
+
+        if (n < 0) {
+            state->invalid++;
+            continue;
+        }
+
+        uint64_t sequence = header->sequence;
+        if (state->arbiter != NULL &&
+            !md_arbiter_accept(state->arbiter, packets[i].line, sequence, packets[i].rx_ns)) {
+            continue;   // The other line already delivered it
+        }
+
+        if (state->next_sequence != 0 && sequence != state->next_sequence) {
+            if (sequence > state->next_sequence) {
+                state->gaps += sequence - state->next_sequence;
+            } else {
+                state->out_of_order++;
+            }
+        }
+        if (sequence >= state->next_sequence) {
+            state->next_sequence = sequence + 1;
+        }
+
+        uint64_t send_ns = header->send_ns;
+        if (packets[i].rx_ns > send_ns) {
+            histogram_record(&state->wire_latency, packets[i].rx_ns - send_ns);
+        }
+        if (now_ns > send_ns) {
+            histogram_record(&state->handler_latency, now_ns - send_ns);
+        }
+
+        tick_event_t *events = arena_alloc(&state->events, (size_t)n * sizeof(*events));
+        uint32_t event_count = 0;
+        for (int t = 0; events != NULL && t < n; t++) {
+            md_tick_t tick;
+            memcpy(&tick, &ticks[t], sizeof(tick));   // Packed record: unaligned fields
+            int s = symbol_index(tick.symbol);
+            if (s >= 0) {
+                tick_event_t *event = &events[event_count++];
+                event->sequence = sequence;
+                event->rx_ns = packets[i].rx_ns;
+                event->price = tick.price;
+                event->volume = tick.volume;
+                event->symbol = (uint16_t)s;
+                event->line = (uint8_t)packets[i].line;
+            }
+        }
+        if (event_count > 0) {
+            state->chunks[state->chunk_count] = events;
+            state->chunk_counts[state->chunk_count++] = event_count;
+        }
+
+        state->datagrams++;
+        state->ticks += (uint64_t)n;
+    }
+
+    apply_events(state);
+    state->chunk_count = 0;
+    arena_reset(&state->events);
+}
+
+// ============================================================================
+// Receive Backends
+// ============================================================================
+typedef enum {
+    BACKEND_UDP = 0,     // recvmmsg() on a UDP socket
+    BACKEND_RING = 1     // AF_PACKET TPACKET_V3 ring
+} backend_t;
+
+typedef struct {
+    backend_t backend;
+    md_udp_receiver_t udp;
+    md_ring_receiver_t ring;
+} feed_receiver_t;
+
+static int receiver_open(feed_receiver_t *rx, backend_t backend,
+                         const md_udp_config_t *udp_config, const md_ring_config_t *ring_config) {
+    rx->backend = backend;
+    if (backend == BACKEND_RING) {
+        if (md_ring_open(&rx->ring, ring_config) != 0) {
+            return -1;
+        }
+        printf("Receiving %s:%u on %s via packet ring (%u x %u KB blocks, %u ms block timeout%s)\n",
+               ring_config->groups[0], ring_config->port, ring_config->ifname,
+               ring_config->block_count, ring_config->block_size / 1024,
+               ring_config->block_timeout_ms, ring_config->spin ? ", non-blocking" : "");
+        return 0;
+    }
+
+    if (md_udp_open(&rx->udp, udp_config) != 0) {
+        return -1;
+    }
+    printf("Receiving %s:%u (batch %u, %s timestamps, %s buffers%s%s)\n",
+           udp_config->group, udp_config->port, rx->udp.config.batch,
+           rx->udp.config.kernel_timestamps ? "kernel" : "user",
+           rx->udp.buffers_huge ? "huge page" : "4K page",
+           udp_config->spin ? ", non-blocking" : "",
+           udp_config->busy_poll_us ? ", busy poll" : "");
+    return 0;
+}
+
+static int receiver_poll(feed_receiver_t *rx, md_packet_handler_t handler, void *context) {
+    if (rx->backend == BACKEND_RING) {
+        return md_ring_receive(&rx->ring, handler, context);
+    }
+    return md_udp_receive(&rx->udp, handler, context);
+}
+
+static void receiver_print_stats(feed_receiver_t *rx) {
+    if (rx->backend == BACKEND_RING) {
+        const md_ring_stats_t *stats = &rx->ring.stats;
+
+        md_ring_update_stats(&rx->ring);
+        printf("  packet ring: %llu blocks, %.1f datagrams/block, %llu skipped, "
+               "%llu kernel drops, %llu ring full\n",
+               (unsigned long long)stats->blocks,
+               stats->blocks ? (double)stats->datagrams / (double)stats->blocks : 0.0,
+               (unsigned long long)stats->skipped, (unsigned long long)stats->kernel_drops,
+               (unsigned long long)stats->kernel_freezes);
+        return;
+    }
+
+    const md_udp_stats_t *stats = &rx->udp.stats;
+    printf("  recvmmsg: %llu calls, %.1f datagrams/call, max batch %u, %llu empty, %llu truncated\n",
+           (unsigned long long)stats->calls,
+           stats->calls ? (double)stats->datagrams / (double)stats->calls : 0.0,
+           stats->max_batch, (unsigned long long)stats->empty_calls,
+           (unsigned long long)stats->truncated);
+}
+
+static int receiver_fd(const feed_receiver_t *rx) {
+    return rx->backend == BACKEND_RING ? rx->ring.fd : rx->udp.fd;
+}
+
+static void receiver_close(feed_receiver_t *rx) {
+    if (rx->backend == BACKEND_RING) {
+        md_ring_close(&rx->ring);
+    } else {
+        md_udp_close(&rx->udp);
+    }
+}
+
+// ============================================================================
+// Receive Loop
+// ============================================================================
+/**
+ * Receive and decode until count datagrams, duration_s or Ctrl+C
+ *
+ * @param lines        1, or 2 to arbitrate between line A and line B
+ * @param wait_in_poll With two (non-blocking) lines: sleep in poll() until
+ *                     either has data instead of spinning
+ */
+static int run_receiver(backend_t backend, const md_udp_config_t udp_configs[],
+                        const md_ring_config_t ring_configs[], uint32_t lines, bool wait_in_poll,
+                        uint64_t count, uint32_t duration_s, bool guard) {
+    static decode_state_t state;
+    static md_arbiter_t arbiter;
+    feed_receiver_t *rx;
+    uint32_t opened;
+
+    // The receivers embed their descriptor arrays; keep them off the stack
+    rx = calloc(lines, sizeof(*rx));
+    if (rx == NULL) {
+        return -1;
+    }
+    for (opened = 0; opened < lines; opened++) {
+        if (receiver_open(&rx[opened], backend, &udp_configs[opened], &ring_configs[opened]) != 0) {
+            break;
+        }
+    }
+    if (opened < lines) {
+        while (opened > 0) {
+            receiver_close(&rx[--opened]);
+        }
+        free(rx);
+        return -1;
+    }
+
+    memset(&state, 0, sizeof(state));
+    if (arena_init(&state.events, "tick events", EVENT_ARENA_SIZE) != 0) {
+        for (uint32_t l = 0; l < lines; l++) {
+            receiver_close(&rx[l]);
+        }
+        free(rx);
+        return -1;
+    }
+    histogram_init(&state.wire_latency, "send -> rx timestamp");
+    histogram_init(&state.handler_latency, "send -> decode");
+    if (lines > 1) {
+        md_arbiter_init(&arbiter);
+        state.arbiter = &arbiter;
+    }
+
+    uint64_t start_ns = monotonic_ns();
+    uint64_t next_report_ns = start_ns + REPORT_INTERVAL_NS;
+    uint64_t last_datagrams = 0;
+    int ret = 0;
+
+    // Nothing from here to the summary may touch the system allocator
+    if (guard) {
+        malloc_guard_arm();
+    }
+    while (keep_running && ret == 0 && (count == 0 || state.datagrams < count)) {
+        if (lines > 1 && wait_in_poll) {
+            struct pollfd pfds[2] = {
+                { .fd = receiver_fd(&rx[0]), .events = POLLIN, .revents = 0 },
+                { .fd = receiver_fd(&rx[1]), .events = POLLIN, .revents = 0 }
+            };
+            poll(pfds, 2, 100);
+        }
+        for (uint32_t l = 0; l < lines; l++) {
+            if (receiver_poll(&rx[l], decode_batch, &state) < 0) {
+                ret = -1;
+                break;
+            }
+        }
+
+        uint64_t now_ns = monotonic_ns();
+        if (now_ns >= next_report_ns) {
+            printf("%llu datagrams/s, p50 %llu ns, p99 %llu ns (send -> decode)\n",
+                   (unsigned long long)(state.datagrams - last_datagrams),
+                   (unsigned long long)histogram_percentile(&state.handler_latency, 50.0),
+                   (unsigned long long)histogram_percentile(&state.handler_latency, 99.0));
+            fflush(stdout);
+            last_datagrams = state.datagrams;
+            next_report_ns += REPORT_INTERVAL_NS;
+            if (duration_s && now_ns - start_ns >= (uint64_t)duration_s * 1000000000ULL) {
+                break;
+            }
+        }
+    }
+
+    malloc_guard_disarm();
+
+    printf("\nSummary:\n");
+    printf("  datagrams %llu, ticks %llu, invalid %llu, gaps %llu, out of order %llu\n",
+           (unsigned long long)state.datagrams, (unsigned long long)state.ticks,
+           (unsigned long long)state.invalid, (unsigned long long)state.gaps,
+           (unsigned long long)state.out_of_order);
+    for (uint32_t l = 0; l < lines; l++) {
+        if (lines > 1) {
+            printf("  line %c", 'A' + (int)l);
+        }
+        receiver_print_stats(&rx[l]);
+    }
+    if (lines > 1) {
+        md_arbiter_finish(&arbiter);
+        md_arbiter_print(&arbiter, stdout);
+    }
+    histogram_print_summary(&state.wire_latency, stdout);
+    histogram_print_summary(&state.handler_latency, stdout);
+    printf("  ");
+    arena_print_stats(&state.events, stdout);
+    if (guard) {
+        uint64_t violations = malloc_guard_violations();
+        printf("  malloc guard: %llu system allocator calls on the hot path\n",
+               (unsigned long long)violations);
+        if (violations > 0) {
+            ret = -1;
+        }
+    }
+
+    arena_destroy(&state.events);
+    for (uint32_t l = 0; l < lines; l++) {
+        receiver_close(&rx[l]);
+    }
+    free(rx);
+    return ret;
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]          Receive and decode\n", program_name);
+    printf("       %s --send [options]   Local test sender\n", program_name);
+    printf("\n");
+    printf("Common options:\n");
+    printf("  -h, --help          Show this help message\n");
+    printf("  --group ADDR        Multicast group or unicast address (default: %s)\n",
+           MD_DEFAULT_GROUP);
+    printf("  --port N            UDP port (default: %d)\n", MD_DEFAULT_PORT);
+    printf("  --iface ADDR        Local interface address (e.g. 127.0.0.1 for loopback)\n");
+    printf("  -n N                Stop after N datagrams (default: run until Ctrl+C)\n");
+    printf("\n");
+    printf("Receiver options:\n");
+    printf("  --batch N           Datagrams per recvmmsg() (default: %d)\n", MD_MAX_BATCH);
+    printf("  --spin              Non-blocking receive in a busy loop\n");
+    printf("  --busy-poll US      SO_BUSY_POLL budget in microseconds\n");
+    printf("  --no-timestamps     No SO_TIMESTAMPNS (user-space receive time instead)\n");
+    printf("  --no-hugepages      4K-page receive buffers\n");
+    printf("  --rcvbuf BYTES      SO_RCVBUF size\n");
+    printf("  --cpu N             Pin to CPU N\n");
+    printf("  --guard             Fail if the receive loop calls malloc/free (make MALLOC_GUARD=1)\n");
+    printf("  --rt-priority N     Receive as SCHED_FIFO with priority N (1-99)\n");
+    printf("  --no-mlock          Do not lock and pre-fault memory\n");
+    printf("  --ring IFNAME       Receive through an AF_PACKET ring on IFNAME (needs CAP_NET_RAW)\n");
+    printf("  --block-size KB     Ring block size (default: %u)\n", MD_RING_DEFAULT_BLOCK_SIZE / 1024);
+    printf("  --blocks N          Ring block count (default: %d)\n", MD_RING_DEFAULT_BLOCKS);
+    printf("  --block-timeout MS  Ring block retire timeout (default: %d)\n", MD_RING_DEFAULT_TIMEOUT_MS);
+    printf("  -d SECONDS          Stop after SECONDS\n");
+    printf("  --arbitrate         Receive line A and line B and forward the first copy\n");
+    printf("  --port-b N          Line B port (default: --port + 1)\n");
+    printf("  --group-b ADDR      Line B group (default: --group)\n");
+    printf("\n");
+    printf("Sender options:\n");
+    printf("  --rate N            Datagrams per second, 0 = unpaced (default: %d)\n", DEFAULT_RATE);
+    printf("  --ticks N           Ticks per datagram, 1-64 (default: %d)\n", DEFAULT_TICKS);
+    printf("  --line N            Line number written to the header, 0 = A, 1 = B (default: 0)\n");
+    printf("  --loss PCT          Drop PCT%% of datagrams\n");
+    printf("  --reorder PCT       Swap PCT%% of datagrams with the next one\n");
+    printf("  --seed N            Impairment random seed (default: per line)\n");
+}
+
+int main(int argc, char *argv[]) {
+    md_udp_config_t rx_config;
+    md_ring_config_t ring_config;
+    md_udp_config_t rx_configs[MD_ARB_LINES];
+    md_ring_config_t ring_configs[MD_ARB_LINES];
+    const char *group_b = NULL;
+    uint16_t port_b = 0;
+    bool arbitrate = false;
+    sender_config_t tx_config;
+    backend_t backend = BACKEND_UDP;
+    bool send_mode = false;
+    uint64_t count = 0;
+    uint32_t duration_s = 0;
+    int cpu = -1;
+    int rt_priority = 0;
+    bool lock_memory = true;
+    bool guard = false;
+
+    md_udp_default_config(&rx_config);
+    md_ring_default_config(&ring_config);
+    memset(&tx_config, 0, sizeof(tx_config));
+    tx_config.group = MD_DEFAULT_GROUP;
+    tx_config.port = MD_DEFAULT_PORT;
+    tx_config.rate = DEFAULT_RATE;
+    tx_config.ticks = DEFAULT_TICKS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--send") == 0) {
+            send_mode = true;
+        } else if (strcmp(argv[i], "--group") == 0 && i + 1 < argc) {
+            rx_config.group = tx_config.group = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            rx_config.port = tx_config.port = (uint16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--iface") == 0 && i + 1 < argc) {
+            rx_config.interface = tx_config.interface = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = tx_config.count = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            rx_config.batch = (uint32_t)atoi(argv[++i]);
+            if (rx_config.batch < 1 || rx_config.batch > MD_MAX_BATCH) {
+                fprintf(stderr, "Invalid batch: %s (1-%d)\n", argv[i], MD_MAX_BATCH);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--spin") == 0) {
+            rx_config.spin = true;
+        } else if (strcmp(argv[i], "--busy-poll") == 0 && i + 1 < argc) {
+            rx_config.busy_poll_us = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-timestamps") == 0) {
+            rx_config.kernel_timestamps = false;
+        } else if (strcmp(argv[i], "--no-hugepages") == 0) {
+            rx_config.hugepages = false;
+        } else if (strcmp(argv[i], "--rcvbuf") == 0 && i + 1 < argc) {
+            rx_config.rcvbuf = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rt-priority") == 0 && i + 1 < argc) {
+            rt_priority = atoi(argv[++i]);
+            if (rt_priority < 0 || rt_priority > 99) {
+                fprintf(stderr, "Invalid RT priority: %s (0-99)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--guard") == 0) {
+            if (!malloc_guard_enabled()) {
+                fprintf(stderr, "--guard needs a MALLOC_GUARD build: make MALLOC_GUARD=1\n");
+                return 1;
+            }
+            guard = true;
+        } else if (strcmp(argv[i], "--no-mlock") == 0) {
+            lock_memory = false;
+        } else if (strcmp(argv[i], "--ring") == 0 && i + 1 < argc) {
+            backend = BACKEND_RING;
+            ring_config.ifname = argv[++i];
+        } else if (strcmp(argv[i], "--block-size") == 0 && i + 1 < argc) {
+            ring_config.block_size = (uint32_t)atoi(argv[++i]) * 1024;
+        } else if (strcmp(argv[i], "--blocks") == 0 && i + 1 < argc) {
+            ring_config.block_count = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--block-timeout") == 0 && i + 1 < argc) {
+            ring_config.block_timeout_ms = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            duration_s = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--arbitrate") == 0) {
+            arbitrate = true;
+        } else if (strcmp(argv[i], "--port-b") == 0 && i + 1 < argc) {
+            port_b = (uint16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--group-b") == 0 && i + 1 < argc) {
+            group_b = argv[++i];
+        } else if (strcmp(argv[i], "--line") == 0 && i + 1 < argc) {
+            tx_config.line = (uint32_t)atoi(argv[++i]);
+            if (tx_config.line >= MD_ARB_LINES) {
+                fprintf(stderr, "Invalid line: %s (0-%d)\n", argv[i], MD_ARB_LINES - 1);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--loss") == 0 && i + 1 < argc) {
+            tx_config.loss_pct = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--reorder") == 0 && i + 1 < argc) {
+            tx_config.reorder_pct = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            tx_config.seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            tx_config.rate = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            tx_config.ticks = (uint32_t)atoi(argv[++i]);
+            if (tx_config.ticks < 1 || tx_config.ticks > 64) {
+                fprintf(stderr, "Invalid tick count: %s (1-64)\n", argv[i]);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    struct sigaction signal_action;
+    memset(&signal_action, 0, sizeof(signal_action));
+    signal_action.sa_handler = signal_handler;
+    sigaction(SIGINT, &signal_action, NULL);
+    sigaction(SIGTERM, &signal_action, NULL);
+
+    // The receiver is the hot path: pin, prioritize and lock it before the
+    // receive buffers are mapped. The test sender is left alone.
+    if (!send_mode) {
+        rt_config_t rt_config;
+        rt_report_t rt_report;
+        rt_default_config(&rt_config);
+        rt_config.cpu = cpu;
+        rt_config.priority = rt_priority;
+        rt_config.lock_memory = lock_memory;
+        if (!lock_memory) {
+            rt_config.stack_prefault = rt_config.heap_prefault = 0;
+        }
+        if (rt_setup(&rt_config, &rt_report) != 0) {
+            rt_print_report(&rt_report, stderr);
+        }
+    } else if (cpu >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+            fprintf(stderr, "Failed to pin to CPU %d: %s\n", cpu, strerror(errno));
+            return 1;
+        }
+    }
+
+    // The ring receiver filters on the same group and port
+    ring_config.groups[0] = rx_config.group;
+    ring_config.port = rx_config.port;
+    ring_config.spin = rx_config.spin;
+
+    // Line B differs from line A only in group, port and line number. Two
+    // lines are read from one thread, so neither receiver may block; unless
+    // --spin was given the loop sleeps in poll() on both instead.
+    uint32_t lines = arbitrate ? MD_ARB_LINES : 1;
+    bool wait_in_poll = !rx_config.spin;
+    for (uint32_t l = 0; l < lines; l++) {
+        rx_configs[l] = rx_config;
+        ring_configs[l] = ring_config;
+        if (arbitrate) {
+            rx_configs[l].spin = ring_configs[l].spin = true;
+        }
+    }
+    if (arbitrate) {
+        rx_configs[1].line = ring_configs[1].line = 1;
+        rx_configs[1].port = ring_configs[1].port = port_b ? port_b : (uint16_t)(rx_config.port + 1);
+        if (group_b != NULL) {
+            rx_configs[1].group = ring_configs[1].groups[0] = group_b;
+        }
+    }
+
+    int ret = send_mode ? run_sender(&tx_config)
+                        : run_receiver(backend, rx_configs, ring_configs, lines, wait_in_poll,
+                                       count, duration_s, guard);
+    return ret == 0 ? 0 : 1;
+}
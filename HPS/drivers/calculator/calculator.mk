@@ -0,0 +1,99 @@
+# ============================================================================
+# Calculator Driver - Make Fragment for Applications
+# ============================================================================
+# Applications that use the driver include this after setting CROSS_COMPILE,
+# add $(CALC_CFLAGS) to CFLAGS, build their objects in $(CALC_OBJ_DIR) and
+# link $(CALC_LINK) $(CALC_LDLIBS).
+#
+# libcalculator.a holds the driver and everything it calls: the software
+# model, logger, flight recorder and telemetry (and the async logger with
+# LOGGER_ASYNC=1). It is built once per configuration, in build/<config>/
+# next to this file, so objects compiled with different toolchains or with
+# RELEASE=1, LOGGER_ASYNC=1 or COSIM=1 never end up in the same archive.
+# ============================================================================
+
+CALC_DRIVER_DIR := $(abspath $(dir $(lastword $(MAKEFILE_LIST))))
+CALC_LIBS_DIR := $(abspath $(CALC_DRIVER_DIR)/../../libs)
+CALC_COSIM_DIR := $(abspath $(CALC_DRIVER_DIR)/../calculator_cosim)
+
+CALC_CONFIG := $(if $(CROSS_COMPILE),$(patsubst %-,%,$(notdir $(CROSS_COMPILE))),native)$(if $(RELEASE),-release)$(if $(LOGGER_ASYNC),-async)$(if $(COSIM),-cosim)
+CALC_BUILD_DIR := $(CALC_DRIVER_DIR)/build/$(CALC_CONFIG)
+CALC_LIB := $(CALC_BUILD_DIR)/libcalculator.a
+
+# The including application's own objects go in build/<config>/ next to
+# its Makefile, for the same reason. CALC_CONFIG_STAMP holds the config
+# of the last build there; binaries depend on it so that switching
+# configuration relinks them even when every object is already built.
+CALC_OBJ_DIR := build/$(CALC_CONFIG)
+CALC_CONFIG_STAMP := build/config
+
+# Headers of the driver and of the libraries it exposes
+CALC_CFLAGS := -I$(CALC_DRIVER_DIR)
+CALC_CFLAGS += -I$(CALC_LIBS_DIR)/logger
+CALC_CFLAGS += -I$(CALC_LIBS_DIR)/flight_recorder
+CALC_CFLAGS += -I$(CALC_LIBS_DIR)/telemetry
+
+# Release builds compile out every log call below WARN: make RELEASE=1
+ifdef RELEASE
+CALC_CFLAGS += -DLOG_COMPILE_LEVEL=LOG_LEVEL_WARN
+endif
+
+# Asynchronous logging: make LOGGER_ASYNC=1 moves log formatting and I/O
+# to a background writer thread (see ../../libs/logger/logger_async.h)
+ifdef LOGGER_ASYNC
+CALC_CFLAGS += -DLOGGER_ASYNC
+endif
+
+CALC_DEPS := $(CALC_DRIVER_DIR)/calculator_driver.h $(CALC_DRIVER_DIR)/calculator_model.h
+CALC_DEPS += $(CALC_LIBS_DIR)/logger/logger.h $(CALC_LIBS_DIR)/logger/logger_async.h $(CALC_LIBS_DIR)/logger/logger_ticks.h
+CALC_DEPS += $(CALC_LIBS_DIR)/flight_recorder/flight_recorder.h
+CALC_DEPS += $(CALC_LIBS_DIR)/telemetry/telemetry.h
+
+# System libraries the archive needs: -lm for the model's sqrt(), -lrt for
+# shm_open() in telemetry (glibc < 2.34)
+CALC_LDLIBS := -lm -lrt
+ifdef LOGGER_ASYNC
+CALC_LDLIBS += -lpthread
+endif
+
+# What an application links, in order, after its own objects
+CALC_LINK := $(CALC_LIB)
+
+# Co-simulation: make CROSS_COMPILE= COSIM=1 leaves the software model out
+# of the archive and links a Verilator model of the RTL instead, so --model
+# runs against the hardware description (see ../calculator_cosim/README.md).
+# CALC_COSIM tells applications that --model has the IP's limits.
+ifdef COSIM
+CALC_CFLAGS += -DCALC_COSIM
+CALC_LINK += $(CALC_COSIM_DIR)/libcalculator_cosim.a
+CALC_LDLIBS += -lstdc++ -lpthread
+endif
+
+# ============================================================================
+# Build Rules (for the including Makefile)
+# ============================================================================
+# The archive is always handed to drivers/calculator/Makefile, which
+# rebuilds only what is out of date; applications relink only when it
+# changed. The including Makefile's first target stays its default goal.
+ifndef CALC_DRIVER_BUILD
+calc_saved_goal := $(.DEFAULT_GOAL)
+
+$(CALC_LIB): calc-lib-force
+	@$(MAKE) --no-print-directory -C $(CALC_DRIVER_DIR) CROSS_COMPILE=$(CROSS_COMPILE) RELEASE=$(RELEASE) LOGGER_ASYNC=$(LOGGER_ASYNC) COSIM=$(COSIM)
+
+ifdef COSIM
+$(CALC_COSIM_DIR)/libcalculator_cosim.a: calc-lib-force
+	@$(MAKE) --no-print-directory -C $(CALC_COSIM_DIR)
+endif
+
+calc-lib-force:
+
+$(CALC_OBJ_DIR):
+	mkdir -p $@
+
+# Rewritten only when the configuration differs, so binaries relink once
+$(CALC_CONFIG_STAMP): calc-lib-force | $(CALC_OBJ_DIR)
+	@[ "$$(cat $@ 2>/dev/null)" = "$(CALC_CONFIG)" ] || echo "$(CALC_CONFIG)" > $@
+
+.DEFAULT_GOAL := $(calc_saved_goal)
+endif
@@ -8,10 +8,21 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/file.h>
 #include <sys/mman.h>
 #include <string.h>
 #include <errno.h>
 #include "calculator_driver.h"
+#include "calculator_model.h"
+#include "flight_recorder.h"
+#include "telemetry.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CALC_HAVE_NEON 1
+#endif
+
+#define LOG_MODULE LOG_MODULE_CALCULATOR
 #include "logger.h"
 
 // ============================================================================
@@ -25,12 +36,108 @@
 // Global Variables
 // ============================================================================
 static void *virtual_base = NULL;
+static size_t mapped_span = 0;      // HW_REGS_SPAN, or one page from the kernel driver
 static int mem_fd = -1;
+static int lock_fd = -1;
 static volatile uint32_t *calculator_regs = NULL;
+static bool model_backend = false;  // Registers live in calculator_model.c
 
 // Operation timeout (in polling iterations)
 #define CALC_TIMEOUT 1000000
 
+// ============================================================================
+// Ownership Lock
+// ============================================================================
+// Only one process may drive the IP at a time; interleaved register writes
+// from two processes corrupt both operations. Processes that share the
+// calculator go through calcd instead.
+static int calculator_lock(void) {
+    lock_fd = open(CALCULATOR_LOCK_PATH, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (lock_fd < 0) {
+        // No lock directory (or no permission): run unprotected
+        LOG_WARN("Could not open %s: %s (ownership not enforced)", CALCULATOR_LOCK_PATH, strerror(errno));
+        return 0;
+    }
+
+    if (flock(lock_fd, LOCK_EX | LOCK_NB) != 0) {
+        LOG_ERROR("Calculator is in use by another process (%s is locked)", CALCULATOR_LOCK_PATH);
+        LOG_ERROR("Hint: if calcd is running, use the calcd client library instead");
+        close(lock_fd);
+        lock_fd = -1;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void calculator_unlock(void) {
+    if (lock_fd >= 0) {
+        close(lock_fd);  // Releases the flock
+        lock_fd = -1;
+    }
+}
+
+// ============================================================================
+// Kernel Driver Register Page
+// ============================================================================
+// calculator_kmod.ko exposes the registers as one mmap()able page on
+// CALCULATOR_DEVICE_PATH, so the driver runs without root and without
+// /dev/mem. RAM-backed test devices (calculator_fake.ko) are skipped:
+// nothing behind them computes unless a test responder is running.
+static int calculator_map_device(void) {
+    const char *name = strrchr(CALCULATOR_DEVICE_PATH, '/');
+    char backend_path[128];
+    char backend[16] = "";
+
+    snprintf(backend_path, sizeof(backend_path), "/sys/class/misc/%s/backend",
+             name != NULL ? name + 1 : CALCULATOR_DEVICE_PATH);
+    FILE *backend_file = fopen(backend_path, "r");
+    if (backend_file == NULL) {
+        return -1;   // No kernel driver loaded
+    }
+    if (fgets(backend, sizeof(backend), backend_file) == NULL) {
+        backend[0] = '\0';
+    }
+    fclose(backend_file);
+    if (strncmp(backend, "hardware", 8) != 0) {
+        LOG_WARN("%s is not backed by hardware (%s), using /dev/mem", CALCULATOR_DEVICE_PATH, backend_path);
+        return -1;
+    }
+
+    mem_fd = open(CALCULATOR_DEVICE_PATH, O_RDWR | O_CLOEXEC);
+    if (mem_fd < 0) {
+        LOG_WARN("Could not open %s: %s, using /dev/mem", CALCULATOR_DEVICE_PATH, strerror(errno));
+        return -1;
+    }
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    virtual_base = mmap(NULL, (size_t)page_size, PROT_READ | PROT_WRITE, MAP_SHARED, mem_fd, 0);
+    if (virtual_base == MAP_FAILED) {
+        LOG_WARN("mmap() of %s failed: %s, using /dev/mem", CALCULATOR_DEVICE_PATH, strerror(errno));
+        virtual_base = NULL;
+        close(mem_fd);
+        mem_fd = -1;
+        return -1;
+    }
+
+    mapped_span = (size_t)page_size;
+    calculator_regs = (volatile uint32_t *)virtual_base;
+    LOG_INFO("Calculator driver initialized on %s", CALCULATOR_DEVICE_PATH);
+    return 0;
+}
+
+// Version check and optional register dump, once the registers are mapped
+static void calculator_report_mapping(void) {
+    uint32_t version = calculator_read_reg(CALC_REG_VERSION);
+    LOG_INFO("  Hardware version: 0x%08X", version);
+
+    // Dump all registers for debugging
+    if (LOG_ENABLED(LOG_LEVEL_TRACE)) {
+        LOG_TRACE("Initial register state:");
+        logger_register_dump(LOG_LEVEL_TRACE, "Calculator Registers", calculator_regs, CALC_DUMP_REGS);
+    }
+}
+
 // ============================================================================
 // Initialize Calculator Driver
 // ============================================================================
@@ -41,12 +148,23 @@ int calculator_init(void) {
     LOG_DEBUG("CALCULATOR_BASE: 0x%08X", CALCULATOR_BASE);
     LOG_DEBUG("HW_REGS_SPAN: 0x%08X (%u bytes)", HW_REGS_SPAN, HW_REGS_SPAN);
     
+    if (calculator_lock() != 0) {
+        return -1;
+    }
+
+    // Prefer the kernel driver's register page (no root needed)
+    if (calculator_map_device() == 0) {
+        calculator_report_mapping();
+        return 0;
+    }
+
     // Open /dev/mem for memory mapping
     LOG_DEBUG("Opening /dev/mem for memory mapping...");
     mem_fd = open("/dev/mem", (O_RDWR | O_SYNC));
     if (mem_fd == -1) {
         LOG_ERROR("Could not open /dev/mem: %s", strerror(errno));
         LOG_ERROR("Hint: Run as root (sudo) or add user to appropriate group");
+        calculator_unlock();
         return -1;
     }
     LOG_DEBUG("Successfully opened /dev/mem (fd=%d)", mem_fd);
@@ -66,9 +184,11 @@ int calculator_init(void) {
         LOG_ERROR("mmap() failed: %s", strerror(errno));
         close(mem_fd);
         mem_fd = -1;
+        calculator_unlock();
         return -1;
     }
     LOG_DEBUG("Memory mapped successfully: virtual_base=%p", virtual_base);
+    mapped_span = HW_REGS_SPAN;
 
     // Calculate calculator register base address
     calculator_regs = (volatile uint32_t *)(
@@ -82,12 +202,27 @@ int calculator_init(void) {
     LOG_DEBUG("  Register offset: 0x%08X", CALCULATOR_0_BASE);
     
     // Verify initialization by reading version register
-    uint32_t version = calculator_read_reg(CALC_REG_VERSION);
-    LOG_INFO("  Hardware version: 0x%08X", version);
-    
-    // Dump all registers for debugging
-    LOG_TRACE("Initial register state:");
-    logger_register_dump(LOG_LEVEL_TRACE, "Calculator Registers", calculator_regs, 16);
+    calculator_report_mapping();
+
+    return 0;
+}
+
+// ============================================================================
+// Initialize Calculator Driver (Software Model)
+// ============================================================================
+int calculator_init_model(void) {
+    if (calculator_regs != NULL) {
+        LOG_ERROR("Calculator driver already initialized");
+        return -1;
+    }
+
+    // calculator_regs points at the model's register file so direct reads
+    // (register dumps, flight recorder snapshots) see the model state
+    calculator_regs = calculator_model_reset();
+    model_backend = true;
+
+    LOG_INFO("Calculator driver initialized on the software model");
+    LOG_INFO("  Hardware version: 0x%08X", calculator_read_reg(CALC_REG_VERSION));
 
     return 0;
 }
@@ -98,9 +233,16 @@ int calculator_init(void) {
 void calculator_cleanup(void) {
     LOG_INFO("Cleaning up calculator driver...");
     
+    if (model_backend) {
+        model_backend = false;
+        calculator_regs = NULL;
+        LOG_INFO("Calculator driver cleanup complete");
+        return;
+    }
+
     if (virtual_base != NULL && virtual_base != MAP_FAILED) {
         LOG_DEBUG("Unmapping virtual memory: %p", virtual_base);
-        if (munmap(virtual_base, HW_REGS_SPAN) != 0) {
+        if (munmap(virtual_base, mapped_span) != 0) {
             LOG_WARN("munmap() failed: %s", strerror(errno));
         } else {
             LOG_DEBUG("Memory unmapped successfully");
@@ -111,7 +253,7 @@ void calculator_cleanup(void) {
     }
 
     if (mem_fd >= 0) {
-        LOG_DEBUG("Closing /dev/mem (fd=%d)", mem_fd);
+        LOG_DEBUG("Closing register device (fd=%d)", mem_fd);
         if (close(mem_fd) != 0) {
             LOG_WARN("close() failed: %s", strerror(errno));
         }
@@ -121,6 +263,7 @@ void calculator_cleanup(void) {
     }
 
     calculator_regs = NULL;
+    calculator_unlock();
     LOG_INFO("Calculator driver cleanup complete");
 }
 
@@ -133,12 +276,26 @@ void calculator_write_reg(uint32_t offset, uint32_t value) {
         return;
     }
 
-    if (offset > 0x3C) {
-        LOG_WARN("Register offset out of range: 0x%02X (max: 0x3C)", offset);
+    if (offset > CALC_REG_SPAN - 4) {
+        LOG_WARN("Register offset out of range: 0x%02X (max: 0x%02X)", offset, CALC_REG_SPAN - 4);
+        return;
+    }
+
+    if (model_backend) {
+        LOG_REG_WRITE(offset, value);
+        calculator_model_write(offset, value);
         return;
     }
 
     uint32_t reg_index = offset / 4;
+
+    // Read-back verification costs two extra bus reads per write, so it only
+    // runs when DEBUG output is enabled for this module
+    if (!LOG_ENABLED(LOG_LEVEL_DEBUG)) {
+        calculator_regs[reg_index] = value;
+        return;
+    }
+
     uint32_t old_value = calculator_regs[reg_index];
     
     LOG_REG_WRITE(offset, value);
@@ -162,12 +319,12 @@ uint32_t calculator_read_reg(uint32_t offset) {
         return 0;
     }
 
-    if (offset > 0x3C) {
-        LOG_WARN("Register offset out of range: 0x%02X (max: 0x3C)", offset);
+    if (offset > CALC_REG_SPAN - 4) {
+        LOG_WARN("Register offset out of range: 0x%02X (max: 0x%02X)", offset, CALC_REG_SPAN - 4);
         return 0;
     }
 
-    uint32_t value = calculator_regs[offset / 4];
+    uint32_t value = model_backend ? calculator_model_read(offset) : calculator_regs[offset / 4];
     LOG_REG_READ(offset, value);
     
     return value;
@@ -219,6 +376,7 @@ int calculator_wait_for_completion(void) {
             LOG_ERROR("Calculator error detected during wait");
             uint32_t error_code = calculator_read_reg(CALC_REG_ERROR_CODE);
             LOG_ERROR("Error code: 0x%08X", error_code);
+            flight_recorder_snapshot(LOG_MODULE_CALCULATOR, calculator_regs, CALC_DUMP_REGS);
             return -1;
         }
 
@@ -226,7 +384,18 @@ int calculator_wait_for_completion(void) {
             LOG_ERROR("Calculator operation timeout after %d polls", poll_count);
             LOG_ERROR("Final status: busy=%d, error=%d, done=%d", 
                      status.busy, status.error, status.done);
-            logger_register_dump(LOG_LEVEL_ERROR, "Register state at timeout", calculator_regs, 16);
+
+            // Snapshot the registers into the flight recorder (plain stores)
+            // rather than formatting 16 lines while already late; fall back
+            // to the log only when no recorder is open
+            if (flight_recorder_active()) {
+                uint32_t info[2] = { calculator_regs[CALC_REG_STATUS / 4], (uint32_t)poll_count };
+                flight_recorder_record(FR_EVENT_TIMEOUT, LOG_MODULE_CALCULATOR,
+                                       calculator_regs[CALC_REG_CONTROL / 4], info, 2);
+                flight_recorder_snapshot(LOG_MODULE_CALCULATOR, calculator_regs, CALC_DUMP_REGS);
+            } else {
+                logger_register_dump(LOG_LEVEL_ERROR, "Register state at timeout", calculator_regs, CALC_DUMP_REGS);
+            }
             return -1;
         }
 
@@ -246,24 +415,14 @@ int calculator_wait_for_completion(void) {
 // ============================================================================
 // Perform Calculation Operation
 // ============================================================================
-int calculator_perform_operation(
-    calculator_operation_t op,
-    float operand_a,
-    float operand_b,
-    float *result
-) {
+int calculator_submit_operation(calculator_operation_t op, float operand_a, float operand_b) {
     if (calculator_regs == NULL) {
         LOG_ERROR("Calculator not initialized");
         return -1;
     }
 
-    if (result == NULL) {
-        LOG_ERROR("Result pointer is NULL");
-        return -1;
-    }
-
-    if (op > CALC_OP_DIV) {
-        LOG_ERROR("Invalid operation code: %d (max: %d)", op, CALC_OP_DIV);
+    if (op > CALC_OP_ALL) {
+        LOG_ERROR("Invalid operation code: %d (max: %d)", op, CALC_OP_ALL);
         return -1;
     }
 
@@ -281,10 +440,9 @@ int calculator_perform_operation(
         LOG_DEBUG("Previous operation completed, proceeding");
     }
 
-    // Write operands
-    // Cast float to uint32_t to preserve bit pattern
-    uint32_t operand_a_bits = *((uint32_t *)&operand_a);
-    uint32_t operand_b_bits = *((uint32_t *)&operand_b);
+    // Write operands (bit patterns, see calculator_float_to_bits)
+    uint32_t operand_a_bits = calculator_float_to_bits(operand_a);
+    uint32_t operand_b_bits = calculator_float_to_bits(operand_b);
 
     LOG_DEBUG("Writing operands: A=0x%08X (%.6f), B=0x%08X (%.6f)", 
              operand_a_bits, operand_a, operand_b_bits, operand_b);
@@ -297,17 +455,36 @@ int calculator_perform_operation(
     LOG_DEBUG("Starting operation: control=0x%08X (start=1, op=0x%X)", control, op);
     calculator_write_reg(CALC_REG_CONTROL, control);
 
+    uint32_t issued[2] = { operand_a_bits, operand_b_bits };
+    flight_recorder_record(FR_EVENT_OP_ISSUED, LOG_MODULE_CALCULATOR, op, issued, 2);
+
+    return 0;
+}
+
+int calculator_complete_operation(calculator_operation_t op, float *result) {
+    if (result == NULL) {
+        LOG_ERROR("Result pointer is NULL");
+        return -1;
+    }
+
     // Wait for completion
     LOG_DEBUG("Waiting for operation to complete...");
     if (calculator_wait_for_completion() != 0) {
-        LOG_OP_ERROR(op, calculator_read_reg(CALC_REG_ERROR_CODE));
+        uint32_t error_code = calculator_read_reg(CALC_REG_ERROR_CODE);
+        uint32_t failed[2] = { op, calculator_read_reg(CALC_REG_STATUS) };
+        flight_recorder_record(FR_EVENT_OP_ERROR, LOG_MODULE_CALCULATOR, error_code, failed, 2);
+        telemetry_count_error(error_code, !(failed[1] & CALC_STATUS_ERROR));
+        LOG_OP_ERROR(op, error_code);
         return -1;
     }
 
     // Check for errors
-    status = calculator_get_status();
+    calculator_status_t status = calculator_get_status();
     if (status.error) {
         uint32_t error_code = calculator_read_reg(CALC_REG_ERROR_CODE);
+        uint32_t failed[2] = { op, calculator_read_reg(CALC_REG_STATUS) };
+        flight_recorder_record(FR_EVENT_OP_ERROR, LOG_MODULE_CALCULATOR, error_code, failed, 2);
+        telemetry_count_error(error_code, false);
         LOG_OP_ERROR(op, error_code);
         LOG_ERROR("Calculator reported an error (code: 0x%08X)", error_code);
         LOG_ERROR("This may indicate overflow, underflow, NaN, or division by zero");
@@ -316,14 +493,34 @@ int calculator_perform_operation(
 
     // Read result
     uint32_t result_bits = calculator_read_reg(CALC_REG_RESULT);
-    *result = *((float *)&result_bits);
-    
+    *result = calculator_bits_to_float(result_bits);
+
+    flight_recorder_record(FR_EVENT_OP_COMPLETED, LOG_MODULE_CALCULATOR, op, &result_bits, 1);
+    telemetry_count_op();
+
     LOG_OP_COMPLETE(op, *result);
     LOG_DEBUG("Result: 0x%08X (%.6f)", result_bits, *result);
 
     return 0;
 }
 
+int calculator_perform_operation(
+    calculator_operation_t op,
+    float operand_a,
+    float operand_b,
+    float *result
+) {
+    if (result == NULL) {
+        LOG_ERROR("Result pointer is NULL");
+        return -1;
+    }
+
+    if (calculator_submit_operation(op, operand_a, operand_b) != 0) {
+        return -1;
+    }
+    return calculator_complete_operation(op, result);
+}
+
 // ============================================================================
 // Set Interrupt Enable
 // ============================================================================
@@ -343,6 +540,204 @@ const char* calculator_operation_to_string(calculator_operation_t op) {
         case CALC_OP_SUB: return "SUB";
         case CALC_OP_MUL: return "MUL";
         case CALC_OP_DIV: return "DIV";
+        case CALC_OP_SMA: return "SMA";
+        case CALC_OP_EMA: return "EMA";
+        case CALC_OP_WMA: return "WMA";
+        case CALC_OP_VWAP: return "VWAP";
+        case CALC_OP_STD_DEV: return "STD_DEV";
+        case CALC_OP_RSI: return "RSI";
+        case CALC_OP_BOLLINGER_UP: return "BOLLINGER_UP";
+        case CALC_OP_BOLLINGER_DN: return "BOLLINGER_DN";
+        case CALC_OP_MIN: return "MIN";
+        case CALC_OP_MAX: return "MAX";
+        case CALC_OP_RANGE: return "RANGE";
+        case CALC_OP_ALL: return "ALL";
         default:          return "UNKNOWN";
     }
 }
+
+// ============================================================================
+// HFT Buffer Management
+// ============================================================================
+int calculator_buffer_write_price(float price) {
+    if (calculator_regs == NULL) {
+        LOG_ERROR("Calculator not initialized - cannot write price");
+        return -1;
+    }
+
+    uint32_t price_bits;
+    memcpy(&price_bits, &price, sizeof(price_bits));
+    LOG_TRACE("Buffer write: price=%.6f (0x%08X)", price, price_bits);
+    calculator_write_reg(CALC_REG_BUFFER_WRITE, price_bits);
+
+    return 0;
+}
+
+void calculator_buffer_reset(void) {
+    // Preserve the configured window size while pulsing the reset bit
+    uint32_t buffer_ctrl = calculator_read_reg(CALC_REG_BUFFER_CTRL) & CALC_BUFFER_WINDOW_MASK;
+    LOG_DEBUG("Resetting price buffer (window=%u)", buffer_ctrl);
+    calculator_write_reg(CALC_REG_BUFFER_CTRL, buffer_ctrl | CALC_BUFFER_RESET);
+}
+
+void calculator_set_window_size(uint16_t window_size) {
+    LOG_DEBUG("Setting window size: %u", window_size);
+    calculator_write_reg(CALC_REG_BUFFER_CTRL, window_size);
+}
+
+uint16_t calculator_get_buffer_count(void) {
+    return (uint16_t)(calculator_read_reg(CALC_REG_BUFFER_COUNT) & CALC_BUFFER_WINDOW_MASK);
+}
+
+void calculator_set_ema_alpha(float alpha) {
+    uint32_t alpha_bits;
+    memcpy(&alpha_bits, &alpha, sizeof(alpha_bits));
+    LOG_DEBUG("Setting EMA alpha: %.6f (0x%08X)", alpha, alpha_bits);
+    calculator_write_reg(CALC_REG_EMA_ALPHA, alpha_bits);
+}
+
+uint32_t calculator_get_version(void) {
+    return calculator_read_reg(CALC_REG_VERSION);
+}
+
+// ============================================================================
+// HFT Operations
+// ============================================================================
+// Window operations run over the price buffer; the window length is passed
+// in OPERAND_B as documented in the register map
+static int calculator_window_operation(calculator_operation_t op, uint16_t window, float *result) {
+    return calculator_perform_operation(op, 0.0f, (float)window, result);
+}
+
+int calculator_sma(uint16_t window, float *result) {
+    return calculator_window_operation(CALC_OP_SMA, window, result);
+}
+
+int calculator_ema(float price, float alpha, float *result) {
+    calculator_set_ema_alpha(alpha);
+    if (calculator_buffer_write_price(price) != 0) {
+        return -1;
+    }
+    return calculator_perform_operation(CALC_OP_EMA, price, alpha, result);
+}
+
+int calculator_std_dev(uint16_t window, float *result) {
+    return calculator_window_operation(CALC_OP_STD_DEV, window, result);
+}
+
+int calculator_min(uint16_t window, float *result) {
+    return calculator_window_operation(CALC_OP_MIN, window, result);
+}
+
+int calculator_max(uint16_t window, float *result) {
+    return calculator_window_operation(CALC_OP_MAX, window, result);
+}
+
+// ============================================================================
+// Compute-All
+// ============================================================================
+// The six results sit in consecutive registers, so they come back as one
+// 16-byte and one 8-byte NEON load (the bridge splits each into 32-bit
+// beats) instead of six separately issued uncached reads
+static void calculator_read_stats(uint32_t bits[CALC_STATS_COUNT]) {
+    if (model_backend) {
+        for (int i = 0; i < CALC_STATS_COUNT; i++) {
+            bits[i] = calculator_model_read(CALC_REG_STATS_SMA + 4 * i);
+        }
+        return;
+    }
+
+    const volatile uint32_t *src = &calculator_regs[CALC_REG_STATS_SMA / 4];
+    __asm__ __volatile__("" ::: "memory");
+#ifdef CALC_HAVE_NEON
+    vst1q_u32(bits, vld1q_u32((const uint32_t *)src));
+    vst1_u32(bits + 4, vld1_u32((const uint32_t *)src + 4));
+#else
+    for (int i = 0; i < CALC_STATS_COUNT; i++) {
+        bits[i] = src[i];
+    }
+#endif
+    __asm__ __volatile__("" ::: "memory");
+}
+
+int calculator_compute_all(uint16_t window, calculator_indicators_t *out) {
+    if (out == NULL) {
+        LOG_ERROR("Indicator pointer is NULL");
+        return -1;
+    }
+
+    float sma;
+    if (calculator_window_operation(CALC_OP_ALL, window, &sma) != 0) {
+        return -1;
+    }
+
+    uint32_t bits[CALC_STATS_COUNT];
+    calculator_read_stats(bits);
+    out->sma          = calculator_bits_to_float(bits[0]);
+    out->std_dev      = calculator_bits_to_float(bits[1]);
+    out->min          = calculator_bits_to_float(bits[2]);
+    out->max          = calculator_bits_to_float(bits[3]);
+    out->bollinger_up = calculator_bits_to_float(bits[4]);
+    out->bollinger_dn = calculator_bits_to_float(bits[5]);
+
+    LOG_TRACE("Stats: sma=%.6f std_dev=%.6f min=%.6f max=%.6f", out->sma, out->std_dev, out->min, out->max);
+    return 0;
+}
+
+// ============================================================================
+// Auto-Compute
+// ============================================================================
+int calculator_auto_compute_enable(uint16_t op_mask) {
+    if (op_mask == 0 || (op_mask & ((1U << CALC_OP_SMA) - 1)) != 0 ||
+        (op_mask & (1U << CALC_OP_ALL)) != 0) {
+        LOG_ERROR("Invalid auto-compute operation mask: 0x%04X (HFT operations only)", op_mask);
+        return -1;
+    }
+
+    LOG_DEBUG("Enabling auto-compute: op mask 0x%04X", op_mask);
+    calculator_write_reg(CALC_REG_CONFIG_FLAGS,
+                         ((uint32_t)op_mask << CALC_CONFIG_AUTO_OPS_SHIFT) | CALC_CONFIG_AUTO_COMPUTE);
+    return 0;
+}
+
+void calculator_auto_compute_disable(void) {
+    LOG_DEBUG("Disabling auto-compute");
+    calculator_write_reg(CALC_REG_CONFIG_FLAGS, 0);
+}
+
+int calculator_auto_compute_drain(calculator_auto_result_t *results, int max_results) {
+    if (calculator_regs == NULL) {
+        LOG_ERROR("Calculator not initialized - cannot drain result FIFO");
+        return -1;
+    }
+    if (results == NULL || max_results < 0) {
+        LOG_ERROR("Invalid result array");
+        return -1;
+    }
+
+    uint32_t fifo_status = calculator_read_reg(CALC_REG_FIFO_STATUS);
+    if (fifo_status & CALC_FIFO_OVERFLOW) {
+        LOG_WARN("Result FIFO overflowed - auto-compute results were lost");
+        calculator_write_reg(CALC_REG_FIFO_STATUS, CALC_FIFO_OVERFLOW);
+    }
+
+    // Entries counted here stay queued, so only the tag is checked again
+    int available = (int)(fifo_status & CALC_FIFO_COUNT_MASK);
+    int count = 0;
+    while (count < available && count < max_results) {
+        uint32_t tag = calculator_read_reg(CALC_REG_FIFO_TAG);
+        if (!(tag & CALC_FIFO_TAG_VALID)) {
+            break;
+        }
+        uint32_t value_bits = calculator_read_reg(CALC_REG_FIFO_DATA);
+
+        calculator_auto_result_t *entry = &results[count++];
+        entry->sequence = (uint16_t)(tag & CALC_FIFO_TAG_SEQ_MASK);
+        entry->operation = (calculator_operation_t)((tag >> CALC_FIFO_TAG_OP_SHIFT) & CALC_CTRL_OP_MASK);
+        entry->error = (tag & CALC_FIFO_TAG_ERROR) != 0;
+        entry->value = calculator_bits_to_float(value_bits);
+    }
+
+    LOG_TRACE("Drained %d auto-compute result(s)", count);
+    return count;
+}
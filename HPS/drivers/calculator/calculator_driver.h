@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 // ============================================================================
 // Calculator Base Address
@@ -25,6 +26,17 @@
 #define HPS_LW_BRIDGE_BASE  0xFF200000
 #define CALCULATOR_BASE     (HPS_LW_BRIDGE_BASE + CALCULATOR_0_BASE)
 
+// Register page of the kernel driver (HPS/drivers/calculator_kmod), used
+// in preference to /dev/mem when present
+#ifndef CALCULATOR_DEVICE_PATH
+#define CALCULATOR_DEVICE_PATH "/dev/calculator0"
+#endif
+
+// Advisory lock held by the process that owns the calculator
+#ifndef CALCULATOR_LOCK_PATH
+#define CALCULATOR_LOCK_PATH "/run/calculator.lock"
+#endif
+
 // ============================================================================
 // Register Offsets
 // ============================================================================
@@ -38,16 +50,28 @@
 #define CALC_REG_BUFFER_WRITE  0x1C  // Write price to circular buffer
 #define CALC_REG_BUFFER_COUNT  0x20  // Current buffer fill count
 #define CALC_REG_EMA_ALPHA     0x24  // Alpha parameter for EMA (32-bit float)
-#define CALC_REG_CONFIG_FLAGS  0x28  // Configuration bits
+#define CALC_REG_CONFIG_FLAGS  0x28  // [0]=auto_compute, [31:16]=auto op mask
 #define CALC_REG_ERROR_CODE    0x2C  // Detailed error information
+#define CALC_REG_FIFO_STATUS   0x30  // Result FIFO [6:0]=count, [31]=overflow
+#define CALC_REG_FIFO_TAG      0x34  // Result FIFO head tag (read-only)
+#define CALC_REG_FIFO_DATA     0x38  // Result FIFO head result (read pops)
 #define CALC_REG_VERSION       0x3C  // IP version
+#define CALC_REG_STATS_SMA     0x40  // Compute-all results (read-only), updated
+#define CALC_REG_STATS_STD_DEV 0x44  // together when CALC_OP_ALL succeeds
+#define CALC_REG_STATS_MIN     0x48
+#define CALC_REG_STATS_MAX     0x4C
+#define CALC_REG_STATS_BOLL_UP 0x50
+#define CALC_REG_STATS_BOLL_DN 0x54
+
+#define CALC_STATS_COUNT       6     // Registers in the compute-all block
+#define CALC_REG_SPAN          0x80  // 32 registers
 
 // ============================================================================
 // Control Register Bit Fields
 // ============================================================================
 #define CALC_CTRL_START_BIT  31
 #define CALC_CTRL_OP_MASK    0xF  // 4-bit operation code
-#define CALC_CTRL_START      (1 << CALC_CTRL_START_BIT)
+#define CALC_CTRL_START      (1U << CALC_CTRL_START_BIT)
 
 // ============================================================================
 // Status Register Bit Fields
@@ -57,6 +81,54 @@
 #define CALC_STATUS_DONE      0x04
 #define CALC_STATUS_BUF_FULL  0x08
 
+// ============================================================================
+// Buffer Control Register Bit Fields
+// ============================================================================
+#define CALC_BUFFER_WINDOW_MASK  0xFFFF       // [15:0] window size
+#define CALC_BUFFER_RESET        (1U << 16)   // [16] reset buffer (self-clearing)
+
+// ============================================================================
+// Auto-Compute and Result FIFO Bit Fields
+// ============================================================================
+// With CALC_CONFIG_AUTO_COMPUTE set, every BUFFER_WRITE runs the operations
+// selected in CONFIG_FLAGS[31:16] over the configured window and queues
+// their results, tagged with the price's sequence number (prices written
+// since the last buffer reset), in the result FIFO
+#define CALC_CONFIG_AUTO_COMPUTE    (1U << 0)
+#define CALC_CONFIG_AUTO_OPS_SHIFT  16
+#define CALC_CONFIG_AUTO_OP(op)     (1U << (CALC_CONFIG_AUTO_OPS_SHIFT + (op)))
+
+#define CALC_FIFO_DEPTH          64
+#define CALC_FIFO_COUNT_MASK     0x7F         // FIFO_STATUS [6:0] entries queued
+#define CALC_FIFO_OVERFLOW       (1U << 31)   // FIFO_STATUS [31] results lost (sticky)
+#define CALC_FIFO_FLUSH          (1U << 0)    // FIFO_STATUS write: empty the FIFO
+                                              // (write CALC_FIFO_OVERFLOW to clear it)
+#define CALC_FIFO_TAG_VALID      (1U << 31)   // FIFO_TAG [31] FIFO not empty
+#define CALC_FIFO_TAG_ERROR      (1U << 30)   // FIFO_TAG [30] operation failed
+#define CALC_FIFO_TAG_OP_SHIFT   16           // FIFO_TAG [19:16] operation
+#define CALC_FIFO_TAG_SEQ_MASK   0xFFFF       // FIFO_TAG [15:0] price sequence number
+
+// Register dumps stop below the FIFO data register, whose read pops an entry
+#define CALC_DUMP_REGS  (CALC_REG_FIFO_DATA / 4)
+
+// ============================================================================
+// Float <-> Register Bits
+// ============================================================================
+// Operand and result registers hold IEEE-754 bit patterns. memcpy is the
+// defined way to reinterpret them (a pointer cast breaks strict aliasing);
+// at -O1 and above it compiles to a single register move.
+static inline uint32_t calculator_float_to_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline float calculator_bits_to_float(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
 // ============================================================================
 // Calculator Operation Types
 // ============================================================================
@@ -77,7 +149,8 @@ typedef enum {
     CALC_OP_BOLLINGER_DN = 11, // Bollinger Lower Band
     CALC_OP_MIN = 12,          // Minimum over window
     CALC_OP_MAX = 13,          // Maximum over window
-    CALC_OP_RANGE = 14         // Range (Max - Min)
+    CALC_OP_RANGE = 14,        // Range (Max - Min)
+    CALC_OP_ALL = 15           // All of the CALC_REG_STATS_* indicators at once
 } calculator_operation_t;
 
 // ============================================================================
@@ -89,20 +162,54 @@ typedef struct {
     bool done;   // Calculation complete
 } calculator_status_t;
 
+// ============================================================================
+// Auto-Compute Result
+// ============================================================================
+typedef struct {
+    uint16_t sequence;                 // Price that triggered it (since buffer reset)
+    calculator_operation_t operation;
+    bool error;                        // The operation failed; value is undefined
+    float value;
+} calculator_auto_result_t;
+
+// ============================================================================
+// Compute-All Result
+// ============================================================================
+// Field order matches CALC_REG_STATS_SMA..CALC_REG_STATS_BOLL_DN
+typedef struct {
+    float sma;
+    float std_dev;        // Sample standard deviation (N - 1)
+    float min;
+    float max;
+    float bollinger_up;   // sma + 2 x std_dev
+    float bollinger_dn;   // sma - 2 x std_dev
+} calculator_indicators_t;
+
 // ============================================================================
 // Function Prototypes
 // ============================================================================
 
 /**
  * Initialize the calculator driver
- * Opens /dev/mem and maps calculator registers into virtual memory
+ * Maps the register page of CALCULATOR_DEVICE_PATH when the kernel driver
+ * is loaded, otherwise opens /dev/mem and maps the calculator registers
  *
- * Returns: 0 on success, -1 on failure
+ * Returns: 0 on success, -1 on failure (including when another process
+ *          already owns the calculator, see CALCULATOR_LOCK_PATH)
  *
- * Note: Must be run as root or with appropriate permissions
+ * Note: The /dev/mem path must be run as root or with appropriate permissions
  */
 int calculator_init(void);
 
+/**
+ * Initialize the driver on the software model instead of the hardware
+ * Every driver function then runs against calculator_model.c, so code
+ * built on the driver can be tested on a host without the FPGA
+ *
+ * Returns: 0 on success, -1 if the driver is already initialized
+ */
+int calculator_init_model(void);
+
 /**
  * Cleanup and close the calculator driver
  * Unmaps memory and closes file descriptors
@@ -112,9 +219,9 @@ void calculator_cleanup(void);
 /**
  * Perform a calculation operation
  *
- * @param op        Operation to perform (ADD, SUB, MUL, DIV)
+ * @param op        Operation to perform (any calculator_operation_t)
  * @param operand_a First operand (32-bit float)
- * @param operand_b Second operand (32-bit float)
+ * @param operand_b Second operand (32-bit float, window size for HFT ops)
  * @param result    Pointer to store result (32-bit float)
  *
  * Returns: 0 on success, -1 on failure
@@ -124,6 +231,9 @@ void calculator_cleanup(void);
  * 2. Starts the calculation
  * 3. Waits for completion
  * 4. Reads and returns the result
+ *
+ * HFT operations (SMA and above) run over the price buffer, which must be
+ * loaded with calculator_buffer_write_price() beforehand
  */
 int calculator_perform_operation(
     calculator_operation_t op,
@@ -132,6 +242,33 @@ int calculator_perform_operation(
     float *result
 );
 
+/**
+ * Start an operation without waiting for it (first half of
+ * calculator_perform_operation)
+ *
+ * Waits for a previous operation still in flight, writes the operands and
+ * sets the start bit. Splitting issue from completion lets callers time
+ * the two separately or do other work while the IP computes.
+ *
+ * @param op        Operation to perform (any calculator_operation_t)
+ * @param operand_a First operand (32-bit float)
+ * @param operand_b Second operand (32-bit float, window size for HFT ops)
+ *
+ * Returns: 0 on success, -1 on failure
+ */
+int calculator_submit_operation(calculator_operation_t op, float operand_a, float operand_b);
+
+/**
+ * Wait for the operation started by calculator_submit_operation() and read
+ * its result (second half of calculator_perform_operation)
+ *
+ * @param op     Operation that was submitted (for error reporting)
+ * @param result Pointer to store result (32-bit float)
+ *
+ * Returns: 0 on success, -1 on timeout or calculator error
+ */
+int calculator_complete_operation(calculator_operation_t op, float *result);
+
 /**
  * Get current calculator status
  *
@@ -239,7 +376,9 @@ uint32_t calculator_get_version(void);
  *
  * Returns: 0 on success, -1 on failure
  *
- * Note: Buffer must contain at least 'window' prices
+ * Note: Buffer must contain at least 'window' prices. The hardware keeps a
+ *       running sum of the configured window, so SMA fails for any other
+ *       length or while a price of 2^31 or more in magnitude is in the window
  */
 int calculator_sma(uint16_t window, float *result);
 
@@ -286,4 +425,58 @@ int calculator_min(uint16_t window, float *result);
  */
 int calculator_max(uint16_t window, float *result);
 
+/**
+ * Calculate every window indicator in one operation
+ *
+ * @param window Number of periods (must match configured window_size)
+ * @param out    Filled with SMA, standard deviation, min, max and both
+ *               Bollinger bands over the same window
+ *
+ * Returns: 0 on success, -1 on failure
+ *
+ * Note: One CONTROL write and one STATUS poll replace six operations. The
+ *       hardware makes a single pass over the window (about window + 60
+ *       cycles) and the six results are read back as one block. The window
+ *       rules of calculator_sma() apply.
+ */
+int calculator_compute_all(uint16_t window, calculator_indicators_t *out);
+
+// ============================================================================
+// Auto-Compute Functions
+// ============================================================================
+
+/**
+ * Run operations automatically on every price write
+ *
+ * @param op_mask Bit n selects operation n (CALC_OP_SMA..CALC_OP_RANGE).
+ *                Each runs over the configured window (set_window_size),
+ *                lowest code first
+ *
+ * Returns: 0 on success, -1 if op_mask is empty or selects a basic
+ *          operation (bits 0-3) or CALC_OP_ALL
+ *
+ * Note: calculator_buffer_write_price() then becomes a single posted write;
+ *       results queue in the result FIFO until drained. Operations still
+ *       queued when the next price arrives are dropped and flag overflow.
+ */
+int calculator_auto_compute_enable(uint16_t op_mask);
+
+/**
+ * Stop auto-compute (results already queued stay in the FIFO)
+ */
+void calculator_auto_compute_disable(void);
+
+/**
+ * Drain the result FIFO
+ *
+ * @param results     Array to fill, oldest result first
+ * @param max_results Capacity of results
+ *
+ * Returns: Number of results read (0 if the FIFO is empty), -1 on failure
+ *
+ * Note: A FIFO overflow since the last drain is logged and cleared; the
+ *       sequence numbers show which results are missing.
+ */
+int calculator_auto_compute_drain(calculator_auto_result_t *results, int max_results);
+
 #endif // CALCULATOR_DRIVER_H
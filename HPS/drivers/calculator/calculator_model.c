@@ -0,0 +1,451 @@
+// ============================================================================
+// Calculator Software Model - Implementation
+// ============================================================================
+// Register-level model of the calculator IP (see calculator_model.h)
+//
+// Arithmetic follows the documented operation semantics (the expectations in
+// calculator_test), computed in double and rounded to float:
+//   ADD/SUB/MUL/DIV  error on NaN, infinity or division by zero
+//   window ops       window length from OPERAND_B, error if the buffer holds
+//                    fewer prices than that (or the window is 0 or > 256)
+//   SMA              as the RTL's running sum: the length must equal the
+//                    BUFFER_CTRL window, and prices of 2^31 or more in
+//                    magnitude (or NaN) in the window are an error
+//   EMA              streaming: OPERAND_A is the new price, alpha comes from
+//                    EMA_ALPHA; the first update after a buffer reset seeds
+//                    the EMA with the price
+//   ALL              SMA's window rules; writes the STATS_* block (SMA,
+//                    standard deviation, min, max, both bands) only if every
+//                    value is finite, and RESULT = SMA. Manual only: an
+//                    auto-compute ALL queues an error entry
+// With auto-compute enabled in CONFIG_FLAGS, each BUFFER_WRITE runs the
+// selected operations over the BUFFER_CTRL window (OPERAND_A = the price)
+// and queues tagged results in the result FIFO; RESULT and STATUS are left
+// alone. ERROR_CODE stays 0, as in the current RTL.
+// ============================================================================
+
+#include <string.h>
+#include <math.h>
+#include "calculator_driver.h"
+#include "calculator_model.h"
+
+// ============================================================================
+// Model State
+// ============================================================================
+#define CALC_MODEL_NUM_REGS  32
+
+static uint32_t model_regs[CALC_MODEL_NUM_REGS];
+static float price_ram[CALC_MODEL_BUFFER_DEPTH];
+static uint32_t write_ptr;
+static uint32_t buffer_count;
+static double ema_value;
+static int ema_valid;
+static uint16_t price_seq;                  // Prices written since buffer reset
+
+// Result FIFO: {tag, result} per entry, tag as read from FIFO_TAG
+static uint32_t fifo_tag[CALC_FIFO_DEPTH];
+static uint32_t fifo_data[CALC_FIFO_DEPTH];
+static uint32_t fifo_head;
+static uint32_t fifo_count;
+static uint32_t fifo_overflow;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static float bits_to_float(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static uint32_t float_to_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint32_t window_size_reg(void) {
+    return model_regs[CALC_REG_BUFFER_CTRL / 4] & CALC_BUFFER_WINDOW_MASK;
+}
+
+// Price 'age' steps back from the newest (0 = most recent)
+static double price_at(uint32_t age) {
+    return price_ram[(write_ptr - 1 - age) % CALC_MODEL_BUFFER_DEPTH];
+}
+
+static void update_buffer_status(void) {
+    uint32_t window = window_size_reg();
+
+    model_regs[CALC_REG_BUFFER_COUNT / 4] = buffer_count;
+    if (window != 0 && buffer_count >= window) {
+        model_regs[CALC_REG_STATUS / 4] |= CALC_STATUS_BUF_FULL;
+    } else {
+        model_regs[CALC_REG_STATUS / 4] &= ~CALC_STATUS_BUF_FULL;
+    }
+}
+
+// The RTL's running sum only holds prices below CALC_MODEL_SUM_LIMIT
+static int window_in_sum_range(uint32_t window) {
+    for (uint32_t i = 0; i < window; i++) {
+        if (!(fabs(price_at(i)) < CALC_MODEL_SUM_LIMIT)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static double window_mean(uint32_t window) {
+    double sum = 0.0;
+    for (uint32_t i = 0; i < window; i++) {
+        sum += price_at(i);
+    }
+    return sum / window;
+}
+
+// Sample standard deviation (n - 1); 0 for a single price
+static double window_std_dev(uint32_t window, double mean) {
+    if (window < 2) {
+        return 0.0;
+    }
+
+    double sum_sq = 0.0;
+    for (uint32_t i = 0; i < window; i++) {
+        double diff = price_at(i) - mean;
+        sum_sq += diff * diff;
+    }
+    return sqrt(sum_sq / (window - 1));
+}
+
+/**
+ * Run one window operation over the newest 'window' prices
+ *
+ * Returns: 0 on success, -1 on error
+ */
+static int execute_window_op(uint32_t op, uint32_t window, double *result) {
+    double mean, low, high;
+    uint32_t i;
+
+    if (window == 0 || window > CALC_MODEL_BUFFER_DEPTH || buffer_count < window) {
+        return -1;
+    }
+
+    switch (op) {
+        case CALC_OP_SMA:
+            if (window != window_size_reg() || !window_in_sum_range(window)) {
+                return -1;
+            }
+            *result = window_mean(window);
+            return 0;
+
+        case CALC_OP_VWAP:  // No volume input yet: equal weights
+            *result = window_mean(window);
+            return 0;
+
+        case CALC_OP_WMA: {
+            // Newest price weighs 'window', oldest weighs 1
+            double sum = 0.0;
+            for (i = 0; i < window; i++) {
+                sum += price_at(i) * (double)(window - i);
+            }
+            *result = sum / ((double)window * (window + 1) / 2.0);
+            return 0;
+        }
+
+        case CALC_OP_STD_DEV:
+            *result = window_std_dev(window, window_mean(window));
+            return 0;
+
+        case CALC_OP_BOLLINGER_UP:
+        case CALC_OP_BOLLINGER_DN:
+            mean = window_mean(window);
+            *result = (op == CALC_OP_BOLLINGER_UP)
+                ? mean + 2.0 * window_std_dev(window, mean)
+                : mean - 2.0 * window_std_dev(window, mean);
+            return 0;
+
+        case CALC_OP_RSI: {
+            double gains = 0.0;
+            double losses = 0.0;
+            for (i = 0; i + 1 < window; i++) {
+                double change = price_at(i) - price_at(i + 1);
+                if (change > 0.0) {
+                    gains += change;
+                } else {
+                    losses -= change;
+                }
+            }
+            if (losses == 0.0) {
+                *result = (gains == 0.0) ? 50.0 : 100.0;
+            } else {
+                *result = 100.0 - 100.0 / (1.0 + gains / losses);
+            }
+            return 0;
+        }
+
+        case CALC_OP_MIN:
+        case CALC_OP_MAX:
+        case CALC_OP_RANGE:
+            low = high = price_at(0);
+            for (i = 1; i < window; i++) {
+                double price = price_at(i);
+                if (price < low) {
+                    low = price;
+                }
+                if (price > high) {
+                    high = price;
+                }
+            }
+            *result = (op == CALC_OP_MIN) ? low : (op == CALC_OP_MAX) ? high : high - low;
+            return 0;
+
+        default:
+            return -1;
+    }
+}
+
+/**
+ * Run one operation on operands a and b
+ *
+ * Returns: 0 on success, -1 on error (including a NaN or infinite result)
+ */
+static int compute_operation(uint32_t op, double a, double b, float *result_f) {
+    double result = 0.0;
+    int ret = 0;
+
+    switch (op) {
+        case CALC_OP_ADD: result = a + b; break;
+        case CALC_OP_SUB: result = a - b; break;
+        case CALC_OP_MUL: result = a * b; break;
+        case CALC_OP_DIV:
+            if (b == 0.0) {
+                ret = -1;
+            } else {
+                result = a / b;
+            }
+            break;
+
+        case CALC_OP_EMA: {
+            double alpha = bits_to_float(model_regs[CALC_REG_EMA_ALPHA / 4]);
+            ema_value = ema_valid ? alpha * a + (1.0 - alpha) * ema_value : a;
+            ema_valid = 1;
+            result = ema_value;
+            break;
+        }
+
+        default:
+            // Window length travels in OPERAND_B as a float
+            ret = (b >= 0.0 && b <= (double)CALC_MODEL_BUFFER_DEPTH)
+                ? execute_window_op(op, (uint32_t)b, &result)
+                : -1;
+            break;
+    }
+
+    *result_f = (float)result;
+    if (ret != 0 || isnan(*result_f) || isinf(*result_f)) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Compute-all: the STATS_* block over the newest 'window' prices
+ *
+ * Returns: 0 on success (block written), -1 on error (block unchanged)
+ */
+static int execute_compute_all(double b, float *sma_f) {
+    uint32_t window = (uint32_t)b;
+    double values[CALC_STATS_COUNT];
+    float stats[CALC_STATS_COUNT];
+    int i;
+
+    if (!(b >= 0.0 && b <= (double)CALC_MODEL_BUFFER_DEPTH) ||
+        execute_window_op(CALC_OP_SMA, window, &values[0]) != 0 ||
+        execute_window_op(CALC_OP_MIN, window, &values[2]) != 0 ||
+        execute_window_op(CALC_OP_MAX, window, &values[3]) != 0) {
+        return -1;
+    }
+    values[1] = window_std_dev(window, values[0]);
+    values[4] = values[0] + 2.0 * values[1];
+    values[5] = values[0] - 2.0 * values[1];
+
+    for (i = 0; i < CALC_STATS_COUNT; i++) {
+        stats[i] = (float)values[i];
+        if (isnan(stats[i]) || isinf(stats[i])) {
+            return -1;
+        }
+    }
+    for (i = 0; i < CALC_STATS_COUNT; i++) {
+        model_regs[CALC_REG_STATS_SMA / 4 + i] = float_to_bits(stats[i]);
+    }
+    *sma_f = stats[0];
+    return 0;
+}
+
+/**
+ * Execute the operation latched in CONTROL and update RESULT/STATUS
+ */
+static void execute_operation(uint32_t op) {
+    double a = bits_to_float(model_regs[CALC_REG_OPERAND_A / 4]);
+    double b = bits_to_float(model_regs[CALC_REG_OPERAND_B / 4]);
+    float result_f;
+    int ret = (op == CALC_OP_ALL) ? execute_compute_all(b, &result_f)
+                                  : compute_operation(op, a, b, &result_f);
+
+    if (ret != 0) {
+        // RESULT keeps its previous value on error, as in the RTL
+        model_regs[CALC_REG_STATUS / 4] |= CALC_STATUS_ERROR;
+    } else {
+        model_regs[CALC_REG_RESULT / 4] = float_to_bits(result_f);
+    }
+    model_regs[CALC_REG_STATUS / 4] |= CALC_STATUS_DONE;
+}
+
+// ============================================================================
+// Auto-Compute and Result FIFO
+// ============================================================================
+
+// Mirror the FIFO head and status into the register file
+static void update_fifo_regs(void) {
+    model_regs[CALC_REG_FIFO_STATUS / 4] = fifo_count | (fifo_overflow ? CALC_FIFO_OVERFLOW : 0);
+    model_regs[CALC_REG_FIFO_TAG / 4] = fifo_count ? fifo_tag[fifo_head] : 0;
+    model_regs[CALC_REG_FIFO_DATA / 4] = fifo_count ? fifo_data[fifo_head] : 0;
+}
+
+static void fifo_push(uint32_t tag, uint32_t data) {
+    if (fifo_count == CALC_FIFO_DEPTH) {
+        fifo_overflow = 1;
+        return;
+    }
+    uint32_t slot = (fifo_head + fifo_count) % CALC_FIFO_DEPTH;
+    fifo_tag[slot] = tag;
+    fifo_data[slot] = data;
+    fifo_count++;
+}
+
+/**
+ * Run the auto-compute operations for the price just written
+ */
+static void execute_auto_ops(float price, uint16_t sequence) {
+    uint32_t config = model_regs[CALC_REG_CONFIG_FLAGS / 4];
+    if (!(config & CALC_CONFIG_AUTO_COMPUTE)) {
+        return;
+    }
+
+    // HFT operations only, lowest code first, over the configured window
+    uint32_t op_mask = (config >> CALC_CONFIG_AUTO_OPS_SHIFT) & 0xFFF0;
+    for (uint32_t op = CALC_OP_SMA; op <= CALC_CTRL_OP_MASK; op++) {
+        if (!(op_mask & (1U << op))) {
+            continue;
+        }
+
+        float result_f = 0.0f;
+        uint32_t tag = CALC_FIFO_TAG_VALID | (op << CALC_FIFO_TAG_OP_SHIFT) | sequence;
+        if (compute_operation(op, price, (double)window_size_reg(), &result_f) != 0) {
+            tag |= CALC_FIFO_TAG_ERROR;
+        }
+        fifo_push(tag, float_to_bits(result_f));
+    }
+    update_fifo_regs();
+}
+
+// ============================================================================
+// Public Interface
+// ============================================================================
+volatile uint32_t *calculator_model_reset(void) {
+    memset(model_regs, 0, sizeof(model_regs));
+    memset(price_ram, 0, sizeof(price_ram));
+    write_ptr = 0;
+    buffer_count = 0;
+    ema_value = 0.0;
+    ema_valid = 0;
+    price_seq = 0;
+    fifo_head = 0;
+    fifo_count = 0;
+    fifo_overflow = 0;
+
+    model_regs[CALC_REG_BUFFER_CTRL / 4] = CALC_MODEL_DEFAULT_WINDOW;
+    model_regs[CALC_REG_EMA_ALPHA / 4] = CALC_MODEL_DEFAULT_ALPHA;
+    model_regs[CALC_REG_VERSION / 4] = CALC_MODEL_VERSION;
+
+    return model_regs;
+}
+
+void calculator_model_write(uint32_t offset, uint32_t value) {
+    switch (offset) {
+        case CALC_REG_CONTROL:
+            // Reads back the operation only; bit 31 starts it
+            model_regs[CALC_REG_CONTROL / 4] = value & CALC_CTRL_OP_MASK;
+            if (value & CALC_CTRL_START) {
+                model_regs[CALC_REG_STATUS / 4] &= ~(CALC_STATUS_BUSY | CALC_STATUS_ERROR | CALC_STATUS_DONE);
+                execute_operation(value & CALC_CTRL_OP_MASK);
+            }
+            break;
+
+        case CALC_REG_OPERAND_A:
+        case CALC_REG_OPERAND_B:
+        case CALC_REG_EMA_ALPHA:
+        case CALC_REG_CONFIG_FLAGS:
+            model_regs[offset / 4] = value;
+            break;
+
+        case CALC_REG_INT_ENABLE:
+            model_regs[offset / 4] = value & 1U;
+            break;
+
+        case CALC_REG_BUFFER_CTRL:
+            // The reset bit is a pulse and never reads back
+            model_regs[offset / 4] = value & CALC_BUFFER_WINDOW_MASK;
+            if (value & CALC_BUFFER_RESET) {
+                write_ptr = 0;
+                buffer_count = 0;
+                ema_valid = 0;
+                price_seq = 0;
+            }
+            update_buffer_status();
+            break;
+
+        case CALC_REG_BUFFER_WRITE:
+            price_ram[write_ptr % CALC_MODEL_BUFFER_DEPTH] = bits_to_float(value);
+            write_ptr++;
+            // The fill count saturates at the configured window
+            if (buffer_count < window_size_reg()) {
+                buffer_count++;
+            }
+            update_buffer_status();
+            execute_auto_ops(bits_to_float(value), price_seq++);
+            break;
+
+        case CALC_REG_FIFO_STATUS:
+            if (value & CALC_FIFO_FLUSH) {
+                fifo_head = 0;
+                fifo_count = 0;
+            }
+            if (value & CALC_FIFO_OVERFLOW) {
+                fifo_overflow = 0;
+            }
+            update_fifo_regs();
+            break;
+
+        default:
+            // RESULT, STATUS, BUFFER_COUNT, ERROR_CODE, FIFO_TAG, FIFO_DATA,
+            // VERSION and the STATS_* block are read-only
+            break;
+    }
+}
+
+uint32_t calculator_model_read(uint32_t offset) {
+    if (offset / 4 >= CALC_MODEL_NUM_REGS) {
+        return 0;
+    }
+
+    uint32_t value = model_regs[offset / 4];
+
+    // Reading FIFO_DATA pops the head entry
+    if (offset == CALC_REG_FIFO_DATA && fifo_count != 0) {
+        fifo_head = (fifo_head + 1) % CALC_FIFO_DEPTH;
+        fifo_count--;
+        update_fifo_regs();
+    }
+    return value;
+}
@@ -0,0 +1,59 @@
+// ============================================================================
+// Calculator Software Model - Header File
+// ============================================================================
+// Register-level model of the calculator IP for running the driver (and
+// everything built on it) on a host without the FPGA, e.g. an x86 build box
+//
+// The model exposes the same 32-register file as the hardware. Writes have
+// the hardware side effects (start, price buffer, buffer reset); an operation
+// completes within the CONTROL write, so STATUS reads back done/error at once.
+// Auto-compute results are queued within the BUFFER_WRITE write.
+// ============================================================================
+
+#ifndef CALCULATOR_MODEL_H
+#define CALCULATOR_MODEL_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Model Parameters (match the RTL reset values)
+// ============================================================================
+#define CALC_MODEL_VERSION         0x00010003  // HFT v1.0003
+#define CALC_MODEL_BUFFER_DEPTH    256         // Price RAM entries
+#define CALC_MODEL_DEFAULT_WINDOW  20
+#define CALC_MODEL_DEFAULT_ALPHA   0x3E4CCCCD  // 0.2f
+#define CALC_MODEL_SUM_LIMIT       2147483648.0  // SMA price magnitude bound (2^31)
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+/**
+ * Reset the model to its power-on state
+ *
+ * Returns: Pointer to the model's register file (32 x 32-bit). Reading it
+ *          directly is equivalent to calculator_model_read(), except that
+ *          it does not pop the result FIFO.
+ */
+volatile uint32_t *calculator_model_reset(void);
+
+/**
+ * Write a model register (with hardware side effects)
+ *
+ * @param offset Register offset (CALC_REG_* constants)
+ * @param value  Value to write
+ */
+void calculator_model_write(uint32_t offset, uint32_t value);
+
+/**
+ * Read a model register
+ *
+ * @param offset Register offset (CALC_REG_* constants)
+ *
+ * Returns: Register value (0 for unmapped offsets)
+ *
+ * Note: Reading CALC_REG_FIFO_DATA pops the result FIFO, as in the RTL
+ */
+uint32_t calculator_model_read(uint32_t offset);
+
+#endif // CALCULATOR_MODEL_H
@@ -0,0 +1,264 @@
+// ============================================================================
+// Calculator Register Map - C++ Header (header-only)
+// ============================================================================
+// Typed view of the register map in calculator_driver.h for C++ callers
+//
+// Registers, bitfields and operations are types carrying constexpr offsets,
+// masks and control words, so everything but the volatile accesses folds
+// away at compile time: building a control word, packing operands and
+// decoding STATUS compile to the same loads, stores and bit tests as the
+// hand-written C driver. What the types add is checking:
+//
+//   - reading a write-only or writing a read-only register is a
+//     static_assert, not a silent no-op on the bus
+//   - a field can only be applied to the register it belongs to
+//   - operation codes are template arguments checked against the IP's range
+//
+// Requires C++14. Offsets and bits come from calculator_driver.h, which
+// stays the single source of truth.
+//
+//   calc::RegisterFile regs(mapped_page);
+//   regs.submit<CALC_OP_MUL>(price, quantity);
+//   while (regs.status().busy()) {}
+//   float notional = regs.result();
+// ============================================================================
+
+#ifndef CALCULATOR_REGS_HPP
+#define CALCULATOR_REGS_HPP
+
+#include <cstdint>
+
+extern "C" {
+#include "calculator_driver.h"
+}
+
+namespace calc {
+
+// ============================================================================
+// Float <-> Register Bits
+// ============================================================================
+inline std::uint32_t float_bits(float value) {
+    return calculator_float_to_bits(value);
+}
+
+inline float bits_float(std::uint32_t bits) {
+    return calculator_bits_to_float(bits);
+}
+
+// ============================================================================
+// Register Descriptors
+// ============================================================================
+enum class Access { ReadOnly, WriteOnly, ReadWrite };
+
+template <std::uint32_t Offset, Access Mode>
+struct Register {
+    static_assert(Offset % 4 == 0, "registers are 32-bit aligned");
+    static_assert(Offset < CALC_REG_SPAN, "offset outside the 32-register file");
+
+    static constexpr std::uint32_t offset = Offset;
+    static constexpr std::uint32_t index = Offset / 4;
+    static constexpr bool readable = Mode != Access::WriteOnly;
+    static constexpr bool writable = Mode != Access::ReadOnly;
+};
+
+// Access modes follow the RTL (calculator_registers.v): the operands read
+// back, BUFFER_WRITE does not. Reading FifoData pops the result FIFO.
+namespace reg {
+using Control      = Register<CALC_REG_CONTROL,      Access::ReadWrite>;
+using OperandA     = Register<CALC_REG_OPERAND_A,    Access::ReadWrite>;
+using OperandB     = Register<CALC_REG_OPERAND_B,    Access::ReadWrite>;
+using Result       = Register<CALC_REG_RESULT,       Access::ReadOnly>;
+using Status       = Register<CALC_REG_STATUS,       Access::ReadOnly>;
+using IntEnable    = Register<CALC_REG_INT_ENABLE,   Access::ReadWrite>;
+using BufferCtrl   = Register<CALC_REG_BUFFER_CTRL,  Access::ReadWrite>;
+using BufferWrite  = Register<CALC_REG_BUFFER_WRITE, Access::WriteOnly>;
+using BufferCount  = Register<CALC_REG_BUFFER_COUNT, Access::ReadOnly>;
+using EmaAlpha     = Register<CALC_REG_EMA_ALPHA,    Access::ReadWrite>;
+using ConfigFlags  = Register<CALC_REG_CONFIG_FLAGS, Access::ReadWrite>;
+using ErrorCode    = Register<CALC_REG_ERROR_CODE,   Access::ReadOnly>;
+using FifoStatus   = Register<CALC_REG_FIFO_STATUS,  Access::ReadWrite>;
+using FifoTag      = Register<CALC_REG_FIFO_TAG,     Access::ReadOnly>;
+using FifoData     = Register<CALC_REG_FIFO_DATA,    Access::ReadOnly>;
+using Version      = Register<CALC_REG_VERSION,      Access::ReadOnly>;
+using StatsSma     = Register<CALC_REG_STATS_SMA,     Access::ReadOnly>;
+using StatsStdDev  = Register<CALC_REG_STATS_STD_DEV, Access::ReadOnly>;
+using StatsMin     = Register<CALC_REG_STATS_MIN,     Access::ReadOnly>;
+using StatsMax     = Register<CALC_REG_STATS_MAX,     Access::ReadOnly>;
+using StatsBollUp  = Register<CALC_REG_STATS_BOLL_UP, Access::ReadOnly>;
+using StatsBollDn  = Register<CALC_REG_STATS_BOLL_DN, Access::ReadOnly>;
+} // namespace reg
+
+// ============================================================================
+// Bitfield Descriptors
+// ============================================================================
+template <typename Reg, unsigned Lsb, unsigned Width>
+struct Field {
+    static_assert(Width > 0 && Lsb + Width <= 32, "field outside a 32-bit register");
+
+    using reg = Reg;
+    static constexpr unsigned lsb = Lsb;
+    static constexpr std::uint32_t mask =
+        (Width == 32 ? 0xFFFFFFFFu : ((1u << Width) - 1u)) << Lsb;
+
+    // Value placed in the field (excess bits dropped, as the hardware would)
+    static constexpr std::uint32_t make(std::uint32_t value) {
+        return (value << Lsb) & mask;
+    }
+
+    static constexpr std::uint32_t insert(std::uint32_t word, std::uint32_t value) {
+        return (word & ~mask) | make(value);
+    }
+
+    static constexpr std::uint32_t extract(std::uint32_t word) {
+        return (word & mask) >> Lsb;
+    }
+
+    static constexpr bool test(std::uint32_t word) {
+        return (word & mask) != 0;
+    }
+};
+
+namespace field {
+using Start       = Field<reg::Control,    CALC_CTRL_START_BIT, 1>;
+using Operation   = Field<reg::Control,    0, 4>;
+using Busy        = Field<reg::Status,     0, 1>;
+using Error       = Field<reg::Status,     1, 1>;
+using Done        = Field<reg::Status,     2, 1>;
+using BufFull     = Field<reg::Status,     3, 1>;
+using IrqEnable   = Field<reg::IntEnable,  0, 1>;
+using Window      = Field<reg::BufferCtrl, 0, 16>;
+using BufferReset = Field<reg::BufferCtrl, 16, 1>;
+using AutoCompute = Field<reg::ConfigFlags, 0, 1>;
+using AutoOps     = Field<reg::ConfigFlags, CALC_CONFIG_AUTO_OPS_SHIFT, 16>;
+using FifoCount    = Field<reg::FifoStatus, 0, 7>;
+using FifoFlush    = Field<reg::FifoStatus, 0, 1>;    // Write side of bit 0
+using FifoOverflow = Field<reg::FifoStatus, 31, 1>;
+using TagValid     = Field<reg::FifoTag,    31, 1>;
+using TagError     = Field<reg::FifoTag,    30, 1>;
+using TagOp        = Field<reg::FifoTag,    CALC_FIFO_TAG_OP_SHIFT, 4>;
+using TagSeq       = Field<reg::FifoTag,    0, 16>;
+} // namespace field
+
+// The typed fields must agree with the C masks
+static_assert(field::Start::mask == CALC_CTRL_START, "CONTROL.start");
+static_assert(field::Operation::mask == CALC_CTRL_OP_MASK, "CONTROL.operation");
+static_assert(field::Busy::mask == CALC_STATUS_BUSY, "STATUS.busy");
+static_assert(field::Error::mask == CALC_STATUS_ERROR, "STATUS.error");
+static_assert(field::Done::mask == CALC_STATUS_DONE, "STATUS.done");
+static_assert(field::BufFull::mask == CALC_STATUS_BUF_FULL, "STATUS.buf_full");
+static_assert(field::Window::mask == CALC_BUFFER_WINDOW_MASK, "BUFFER_CTRL.window");
+static_assert(field::BufferReset::mask == CALC_BUFFER_RESET, "BUFFER_CTRL.reset");
+static_assert(field::AutoCompute::mask == CALC_CONFIG_AUTO_COMPUTE, "CONFIG_FLAGS.auto_compute");
+static_assert(field::AutoOps::make(1u << CALC_OP_SMA) == CALC_CONFIG_AUTO_OP(CALC_OP_SMA), "CONFIG_FLAGS.auto_ops");
+static_assert(field::FifoCount::mask == CALC_FIFO_COUNT_MASK, "FIFO_STATUS.count");
+static_assert(field::FifoFlush::mask == CALC_FIFO_FLUSH, "FIFO_STATUS.flush");
+static_assert(field::FifoOverflow::mask == CALC_FIFO_OVERFLOW, "FIFO_STATUS.overflow");
+static_assert(field::TagValid::mask == CALC_FIFO_TAG_VALID, "FIFO_TAG.valid");
+static_assert(field::TagError::mask == CALC_FIFO_TAG_ERROR, "FIFO_TAG.error");
+static_assert(field::TagSeq::mask == CALC_FIFO_TAG_SEQ_MASK, "FIFO_TAG.sequence");
+
+// ============================================================================
+// Register Values
+// ============================================================================
+
+// STATUS as read: one load, then plain bit tests
+class StatusWord {
+public:
+    constexpr explicit StatusWord(std::uint32_t raw) : raw_(raw) {}
+
+    constexpr bool busy() const { return field::Busy::test(raw_); }
+    constexpr bool error() const { return field::Error::test(raw_); }
+    constexpr bool done() const { return field::Done::test(raw_); }
+    constexpr bool buffer_full() const { return field::BufFull::test(raw_); }
+    constexpr std::uint32_t raw() const { return raw_; }
+
+private:
+    std::uint32_t raw_;
+};
+
+// ============================================================================
+// Operation Descriptors
+// ============================================================================
+template <calculator_operation_t Op>
+struct Operation {
+    static_assert(Op >= CALC_OP_ADD && Op <= CALC_OP_ALL, "not a calculator operation");
+
+    static constexpr calculator_operation_t code = Op;
+    // Window operations run over the price buffer; operand B is the window
+    static constexpr bool windowed = Op >= CALC_OP_SMA;
+    static constexpr std::uint32_t control =
+        field::Start::make(1) | field::Operation::make(static_cast<std::uint32_t>(Op));
+};
+
+// ============================================================================
+// Register File
+// ============================================================================
+// A pointer to the mapped registers (/dev/calculator0, /dev/mem or the
+// software model's array). Copying it is free; it owns nothing.
+class RegisterFile {
+public:
+    explicit RegisterFile(volatile std::uint32_t *base) : base_(base) {}
+
+    template <typename Reg>
+    std::uint32_t read() const {
+        static_assert(Reg::readable, "register is write-only");
+        return base_[Reg::index];
+    }
+
+    template <typename Reg>
+    void write(std::uint32_t value) const {
+        static_assert(Reg::writable, "register is read-only");
+        base_[Reg::index] = value;
+    }
+
+    // Read-modify-write of one field (two bus accesses)
+    template <typename F>
+    void update(std::uint32_t value) const {
+        write<typename F::reg>(F::insert(read<typename F::reg>(), value));
+    }
+
+    template <typename F>
+    std::uint32_t get() const {
+        return F::extract(read<typename F::reg>());
+    }
+
+    StatusWord status() const {
+        return StatusWord(read<reg::Status>());
+    }
+
+    float result() const {
+        return bits_float(read<reg::Result>());
+    }
+
+    // Operands, then the constant control word: three stores, no arithmetic
+    template <calculator_operation_t Op>
+    void submit(float operand_a, float operand_b) const {
+        write<reg::OperandA>(float_bits(operand_a));
+        write<reg::OperandB>(float_bits(operand_b));
+        write<reg::Control>(Operation<Op>::control);
+    }
+
+    // Window operations take the window length as operand B
+    template <calculator_operation_t Op>
+    void submit_window(std::uint16_t window) const {
+        static_assert(Operation<Op>::windowed, "not a window operation");
+        submit<Op>(0.0f, static_cast<float>(window));
+    }
+
+    void push_price(float price) const {
+        write<reg::BufferWrite>(float_bits(price));
+    }
+
+    void set_window(std::uint16_t window) const {
+        write<reg::BufferCtrl>(field::Window::make(window));
+    }
+
+    volatile std::uint32_t *base() const { return base_; }
+
+private:
+    volatile std::uint32_t *base_;
+};
+
+} // namespace calc
+
+#endif // CALCULATOR_REGS_HPP
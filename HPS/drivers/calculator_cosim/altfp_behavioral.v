@@ -0,0 +1,176 @@
+// ============================================================================
+// Behavioral ALTFP Models for Co-simulation
+// ============================================================================
+// Stand-ins for the Intel altfp_add_sub32 / altfp_mult32 / altfp_div32 /
+// altfp_sqrt32 megafunctions with the same ports and pipeline depths. Arithmetic is done
+// in C (calculator_cosim_fp() in calculator_cosim.cpp) with the ALTFP
+// conventions: denormal inputs read as zero, denormal results flush to zero
+// and raise underflow.
+//
+// Verilator only: compiled with +define+CALCULATOR_BEHAVIORAL_FP, which
+// drops the placeholder modules in calculator_float_ops.v
+// ============================================================================
+
+// Operation codes shared with calculator_cosim_fp()
+`define ALTFP_SIM_ADD  3'd0
+`define ALTFP_SIM_SUB  3'd1
+`define ALTFP_SIM_MUL  3'd2
+`define ALTFP_SIM_DIV  3'd3
+`define ALTFP_SIM_SQRT 3'd4
+
+// Flag bits returned by calculator_cosim_fp_flags()
+`define ALTFP_SIM_OVERFLOW  0
+`define ALTFP_SIM_UNDERFLOW 1
+`define ALTFP_SIM_NAN       2
+`define ALTFP_SIM_DIV_ZERO  3
+
+import "DPI-C" pure function int calculator_cosim_fp(input int op, input int a, input int b);
+import "DPI-C" pure function int calculator_cosim_fp_flags(input int op, input int a, input int b);
+
+// ============================================================================
+// Shared Pipeline
+// ============================================================================
+// Computes on the operands presented at a clock edge and shows the result
+// LATENCY edges later, like the megafunctions (no enable, no stall)
+module altfp_sim_pipe #(
+    parameter LATENCY = 7
+) (
+    input  wire        clock,
+    input  wire [2:0]  op,
+    input  wire [31:0] dataa,
+    input  wire [31:0] datab,
+    output wire [31:0] result,
+    output wire [3:0]  flags
+);
+    wire [31:0] result_in = calculator_cosim_fp({29'h0, op}, dataa, datab);
+    wire [31:0] flags_in  = calculator_cosim_fp_flags({29'h0, op}, dataa, datab);
+
+    reg [31:0] result_pipe [0:LATENCY-1];
+    reg [3:0]  flags_pipe  [0:LATENCY-1];
+
+    integer i;
+    always @(posedge clock) begin
+        result_pipe[0] <= result_in;
+        flags_pipe[0]  <= flags_in[3:0];
+
+        for (i = 1; i < LATENCY; i = i + 1) begin
+            result_pipe[i] <= result_pipe[i-1];
+            flags_pipe[i]  <= flags_pipe[i-1];
+        end
+    end
+
+    assign result = result_pipe[LATENCY-1];
+    assign flags  = flags_pipe[LATENCY-1];
+endmodule
+
+// ============================================================================
+// altfp_add_sub32 (pipeline depth 7)
+// ============================================================================
+module altfp_add_sub32 (
+    input  wire        clock,
+    input  wire [31:0] dataa,
+    input  wire [31:0] datab,
+    input  wire        add_sub,            // 1=add, 0=sub
+    output wire [31:0] result,
+    output wire        overflow,
+    output wire        underflow,
+    output wire        nan
+);
+    wire [3:0] flags;
+
+    altfp_sim_pipe #(.LATENCY(7)) pipe (
+        .clock  (clock),
+        .op     (add_sub ? `ALTFP_SIM_ADD : `ALTFP_SIM_SUB),
+        .dataa  (dataa),
+        .datab  (datab),
+        .result (result),
+        .flags  (flags)
+    );
+
+    assign overflow  = flags[`ALTFP_SIM_OVERFLOW];
+    assign underflow = flags[`ALTFP_SIM_UNDERFLOW];
+    assign nan       = flags[`ALTFP_SIM_NAN];
+endmodule
+
+// ============================================================================
+// altfp_mult32 (pipeline depth 5)
+// ============================================================================
+module altfp_mult32 (
+    input  wire        clock,
+    input  wire [31:0] dataa,
+    input  wire [31:0] datab,
+    output wire [31:0] result,
+    output wire        overflow,
+    output wire        underflow,
+    output wire        nan
+);
+    wire [3:0] flags;
+
+    altfp_sim_pipe #(.LATENCY(5)) pipe (
+        .clock  (clock),
+        .op     (`ALTFP_SIM_MUL),
+        .dataa  (dataa),
+        .datab  (datab),
+        .result (result),
+        .flags  (flags)
+    );
+
+    assign overflow  = flags[`ALTFP_SIM_OVERFLOW];
+    assign underflow = flags[`ALTFP_SIM_UNDERFLOW];
+    assign nan       = flags[`ALTFP_SIM_NAN];
+endmodule
+
+// ============================================================================
+// altfp_div32 (pipeline depth 6)
+// ============================================================================
+module altfp_div32 (
+    input  wire        clock,
+    input  wire [31:0] dataa,
+    input  wire [31:0] datab,
+    output wire [31:0] result,
+    output wire        overflow,
+    output wire        underflow,
+    output wire        nan,
+    output wire        division_by_zero
+);
+    wire [3:0] flags;
+
+    altfp_sim_pipe #(.LATENCY(6)) pipe (
+        .clock  (clock),
+        .op     (`ALTFP_SIM_DIV),
+        .dataa  (dataa),
+        .datab  (datab),
+        .result (result),
+        .flags  (flags)
+    );
+
+    assign overflow         = flags[`ALTFP_SIM_OVERFLOW];
+    assign underflow        = flags[`ALTFP_SIM_UNDERFLOW];
+    assign nan              = flags[`ALTFP_SIM_NAN];
+    assign division_by_zero = flags[`ALTFP_SIM_DIV_ZERO];
+endmodule
+
+// ============================================================================
+// altfp_sqrt32 (pipeline depth 16)
+// ============================================================================
+module altfp_sqrt32 (
+    input  wire        clock,
+    input  wire [31:0] data,
+    output wire [31:0] result,
+    output wire        overflow,
+    output wire        nan
+);
+    wire [3:0] flags;
+
+    altfp_sim_pipe #(.LATENCY(16)) pipe (
+        .clock  (clock),
+        .op     (`ALTFP_SIM_SQRT),
+        .dataa  (data),
+        .datab  (32'h0),
+        .result (result),
+        .flags  (flags)
+    );
+
+    assign overflow = flags[`ALTFP_SIM_OVERFLOW];
+    assign nan      = flags[`ALTFP_SIM_NAN];
+endmodule
@@ -0,0 +1,398 @@
+// ============================================================================
+// Calculator Co-simulation Backend - Implementation
+// ============================================================================
+// Implements the calculator_model.h interface on a Verilator model of the
+// RTL (FPGA/ip/custom/calculator), so calculator_driver.c and everything
+// built on it runs unmodified against the hardware description on a host
+//
+// Each register access is one Avalon-MM transfer driven cycle by cycle,
+// with the address units and read latency that calculator_hw.tcl declares
+// (the Makefile passes them in). Simulated time only advances on bus
+// transfers, as on the board, where the IP runs while the CPU is busy
+// crossing the bridge.
+//
+// Environment:
+//   CALC_COSIM_BUS_GAP   idle fabric cycles before each transfer (default 8,
+//                        roughly one lightweight-bridge round trip at 50 MHz)
+//   CALC_COSIM_VCD       waveform file (TRACE=1 builds only)
+//   CALC_COSIM_QUIET     set to skip the statistics report at exit
+// ============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Vcalculator.h"
+#include "Vcalculator___024root.h"
+#include "Vcalculator__Dpi.h"
+#include "verilated.h"
+#if VM_TRACE
+#include "verilated_vcd_c.h"
+#endif
+
+extern "C" {
+#include "calculator_driver.h"
+#include "calculator_model.h"
+}
+
+// Avalon-MM timing from calculator_hw.tcl (set by the Makefile)
+#ifndef CALC_COSIM_READ_LATENCY
+#define CALC_COSIM_READ_LATENCY 1
+#endif
+#ifndef CALC_COSIM_BYTE_ADDRESS
+#define CALC_COSIM_BYTE_ADDRESS 1
+#endif
+
+#define CALC_COSIM_NUM_REGS     32
+#define CALC_COSIM_NUM_OPS      16
+#define CALC_COSIM_DEFAULT_GAP  8
+#define CALC_COSIM_RESET_CYCLES 4
+
+// Ops not seen done within this many cycles of their start are dropped
+// from the latency statistics (the RTL never finished them)
+#define CALC_COSIM_OP_LIMIT     100000
+
+// ============================================================================
+// Simulation State
+// ============================================================================
+static VerilatedContext *context;
+static Vcalculator *top;
+#if VM_TRACE
+static VerilatedVcdC *trace;
+#endif
+
+static uint32_t shadow_regs[CALC_COSIM_NUM_REGS];  // Last value moved per register
+static uint64_t cycle;
+static unsigned bus_gap = CALC_COSIM_DEFAULT_GAP;
+
+// ============================================================================
+// Statistics
+// ============================================================================
+struct op_stats {
+    uint64_t count;
+    uint64_t total_cycles;
+    uint64_t min_cycles;
+    uint64_t max_cycles;
+};
+
+static uint64_t reg_reads[CALC_COSIM_NUM_REGS];
+static uint64_t reg_writes[CALC_COSIM_NUM_REGS];
+static uint64_t bus_cycles;             // Cycles spent in transfers (gap included)
+static uint64_t irq_pulses;
+static struct op_stats ops[CALC_COSIM_NUM_OPS];
+static uint64_t ops_unfinished;
+
+static bool op_pending;
+static unsigned pending_op;
+static uint64_t pending_start;
+
+// ============================================================================
+// Floating Point (DPI, see altfp_behavioral.v)
+// ============================================================================
+
+// ALTFP reads denormal operands as zero
+static float altfp_input(int bits) {
+    float value = calculator_bits_to_float((uint32_t)bits);
+    return std::fpclassify(value) == FP_SUBNORMAL ? std::copysign(0.0f, value) : value;
+}
+
+static float altfp_compute(int op, int a, int b) {
+    float fa = altfp_input(a);
+    float fb = altfp_input(b);
+
+    switch (op) {
+        case 0:  return fa + fb;
+        case 1:  return fa - fb;
+        case 2:  return fa * fb;
+        case 3:  return fa / fb;
+        default: return std::sqrt(fa);
+    }
+}
+
+int calculator_cosim_fp(int op, int a, int b) {
+    float result = altfp_compute(op, a, b);
+
+    // ...and flushes denormal results
+    if (std::fpclassify(result) == FP_SUBNORMAL) {
+        result = std::copysign(0.0f, result);
+    }
+    return (int)calculator_float_to_bits(result);
+}
+
+int calculator_cosim_fp_flags(int op, int a, int b) {
+    float fa = altfp_input(a);
+    float fb = altfp_input(b);
+    float result = altfp_compute(op, a, b);
+    bool divide_by_zero = op == 3 && fb == 0.0f && !std::isnan(fa);
+    int flags = 0;
+
+    if (std::isinf(result) && std::isfinite(fa) && std::isfinite(fb) && !divide_by_zero) {
+        flags |= 1 << 0;   // overflow
+    }
+    if (std::fpclassify(result) == FP_SUBNORMAL) {
+        flags |= 1 << 1;   // underflow (flushed to zero)
+    }
+    if (std::isnan(result)) {
+        flags |= 1 << 2;
+    }
+    if (divide_by_zero) {
+        flags |= 1 << 3;
+    }
+    return flags;
+}
+
+// ============================================================================
+// Clock and Bus Functional Model
+// ============================================================================
+
+static void cosim_tick(void) {
+    top->clk = 0;
+    top->eval();
+    context->timeInc(1);
+#if VM_TRACE
+    if (trace != NULL) {
+        trace->dump(context->time());
+    }
+#endif
+
+    top->clk = 1;
+    top->eval();
+    context->timeInc(1);
+#if VM_TRACE
+    if (trace != NULL) {
+        trace->dump(context->time());
+    }
+#endif
+
+    cycle++;
+    irq_pulses += top->ins_irq_irq;
+
+    // calc_done is the core's one-cycle completion pulse
+    if (op_pending && top->rootp->calculator__DOT__calc_done) {
+        struct op_stats *stats = &ops[pending_op];
+        uint64_t latency = cycle - pending_start;
+
+        if (stats->count == 0 || latency < stats->min_cycles) {
+            stats->min_cycles = latency;
+        }
+        if (latency > stats->max_cycles) {
+            stats->max_cycles = latency;
+        }
+        stats->count++;
+        stats->total_cycles += latency;
+        op_pending = false;
+    } else if (op_pending && cycle - pending_start > CALC_COSIM_OP_LIMIT) {
+        ops_unfinished++;
+        op_pending = false;
+    }
+}
+
+static void bus_idle(unsigned cycles) {
+    for (unsigned i = 0; i < cycles; i++) {
+        cosim_tick();
+    }
+}
+
+static uint32_t bus_address(uint32_t offset) {
+    return CALC_COSIM_BYTE_ADDRESS ? offset : offset / 4;
+}
+
+// One Avalon-MM write: held until waitrequest is low at a rising edge
+static void bus_write(uint32_t offset, uint32_t value) {
+    uint64_t start = cycle;
+
+    bus_idle(bus_gap);
+    top->avs_s0_address = bus_address(offset);
+    top->avs_s0_writedata = value;
+    top->avs_s0_write = 1;
+    do {
+        top->eval();
+        bool accepted = !top->avs_s0_waitrequest;
+        cosim_tick();
+        if (accepted) {
+            break;
+        }
+    } while (true);
+    top->avs_s0_write = 0;
+    top->eval();
+
+    bus_cycles += cycle - start;
+}
+
+// One Avalon-MM read: readdata is sampled READ_LATENCY edges after the
+// edge that accepted the command
+static uint32_t bus_read(uint32_t offset) {
+    uint64_t start = cycle;
+    uint32_t value = 0;
+
+    bus_idle(bus_gap);
+    top->avs_s0_address = bus_address(offset);
+    top->avs_s0_read = 1;
+    do {
+        top->eval();
+        bool accepted = !top->avs_s0_waitrequest;
+        if (accepted && CALC_COSIM_READ_LATENCY == 0) {
+            value = top->avs_s0_readdata;
+            cosim_tick();
+            break;
+        }
+        cosim_tick();
+        if (accepted) {
+            top->avs_s0_read = 0;
+            bus_idle(CALC_COSIM_READ_LATENCY - 1);
+            top->eval();
+            value = top->avs_s0_readdata;
+            cosim_tick();
+            break;
+        }
+    } while (true);
+    top->avs_s0_read = 0;
+    top->eval();
+
+    bus_cycles += cycle - start;
+    return value;
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+static const char *const reg_names[CALC_COSIM_NUM_REGS] = {
+    "CONTROL", "OPERAND_A", "OPERAND_B", "RESULT", "STATUS", "INT_ENABLE",
+    "BUFFER_CTRL", "BUFFER_WRITE", "BUFFER_COUNT", "EMA_ALPHA", "CONFIG_FLAGS",
+    "ERROR_CODE", "FIFO_STATUS", "FIFO_TAG", "FIFO_DATA", "VERSION",
+    "STATS_SMA", "STATS_STD_DEV", "STATS_MIN", "STATS_MAX", "STATS_BOLL_UP",
+    "STATS_BOLL_DN", "RESERVED", "RESERVED", "RESERVED", "RESERVED", "RESERVED",
+    "RESERVED", "RESERVED", "RESERVED", "RESERVED", "RESERVED"
+};
+
+static void cosim_report(void) {
+    if (top == NULL || getenv("CALC_COSIM_QUIET") != NULL) {
+        return;
+    }
+
+    fprintf(stderr, "\ncalculator_cosim: %llu cycles (%llu in bus transfers, gap %u), %llu irq pulses\n",
+            (unsigned long long)cycle, (unsigned long long)bus_cycles, bus_gap,
+            (unsigned long long)irq_pulses);
+
+    fprintf(stderr, "  %-12s %10s %10s\n", "register", "reads", "writes");
+    for (int i = 0; i < CALC_COSIM_NUM_REGS; i++) {
+        if (reg_reads[i] != 0 || reg_writes[i] != 0) {
+            fprintf(stderr, "  %-12s %10llu %10llu\n", reg_names[i],
+                    (unsigned long long)reg_reads[i], (unsigned long long)reg_writes[i]);
+        }
+    }
+
+    // Cycles from the accepted CONTROL write to the core's done pulse
+    fprintf(stderr, "  %-12s %10s %10s %10s %10s\n", "operation", "count", "min", "avg", "max");
+    for (int op = 0; op < CALC_COSIM_NUM_OPS; op++) {
+        const struct op_stats *stats = &ops[op];
+        if (stats->count != 0) {
+            fprintf(stderr, "  %-12s %10llu %10llu %10.1f %10llu\n",
+                    calculator_operation_to_string((calculator_operation_t)op),
+                    (unsigned long long)stats->count, (unsigned long long)stats->min_cycles,
+                    (double)stats->total_cycles / stats->count, (unsigned long long)stats->max_cycles);
+        }
+    }
+    if (ops_unfinished != 0) {
+        fprintf(stderr, "  %llu operation(s) never signalled done\n", (unsigned long long)ops_unfinished);
+    }
+}
+
+static void cosim_shutdown(void) {
+    cosim_report();
+    if (top == NULL) {
+        return;
+    }
+
+    top->final();
+#if VM_TRACE
+    if (trace != NULL) {
+        trace->close();
+        delete trace;
+        trace = NULL;
+    }
+#endif
+    delete top;
+    top = NULL;
+    delete context;
+    context = NULL;
+}
+
+// ============================================================================
+// Model Interface (calculator_model.h)
+// ============================================================================
+
+static void cosim_create(void) {
+    const char *gap = getenv("CALC_COSIM_BUS_GAP");
+    if (gap != NULL) {
+        bus_gap = (unsigned)strtoul(gap, NULL, 0);
+    }
+
+    context = new VerilatedContext;
+    top = new Vcalculator(context, "calculator");
+
+#if VM_TRACE
+    const char *vcd = getenv("CALC_COSIM_VCD");
+    if (vcd != NULL) {
+        context->traceEverOn(true);
+        trace = new VerilatedVcdC;
+        top->trace(trace, 99);
+        trace->open(vcd);
+    }
+#endif
+
+    atexit(cosim_shutdown);
+}
+
+volatile uint32_t *calculator_model_reset(void) {
+    if (top == NULL) {
+        cosim_create();
+    }
+
+    top->avs_s0_read = 0;
+    top->avs_s0_write = 0;
+    top->avs_s0_address = 0;
+    top->avs_s0_writedata = 0;
+
+    top->reset_n = 0;
+    bus_idle(CALC_COSIM_RESET_CYCLES);
+    top->reset_n = 1;
+    bus_idle(1);
+
+    memset(shadow_regs, 0, sizeof(shadow_regs));
+    op_pending = false;
+
+    return shadow_regs;
+}
+
+void calculator_model_write(uint32_t offset, uint32_t value) {
+    if (top == NULL || offset >= CALC_COSIM_NUM_REGS * 4 || (offset & 3) != 0) {
+        return;
+    }
+
+    bus_write(offset, value);
+    reg_writes[offset / 4]++;
+    shadow_regs[offset / 4] = value;
+
+    if (offset == CALC_REG_CONTROL && (value & CALC_CTRL_START) != 0) {
+        if (op_pending) {
+            ops_unfinished++;
+        }
+        op_pending = true;
+        pending_op = value & CALC_CTRL_OP_MASK;
+        pending_start = cycle;
+    }
+}
+
+uint32_t calculator_model_read(uint32_t offset) {
+    if (top == NULL || offset >= CALC_COSIM_NUM_REGS * 4 || (offset & 3) != 0) {
+        return 0;
+    }
+
+    uint32_t value = bus_read(offset);
+    reg_reads[offset / 4]++;
+    shadow_regs[offset / 4] = value;
+    return value;
+}
@@ -0,0 +1,68 @@
+// ============================================================================
+// Calculator Fake Platform Devices
+// ============================================================================
+// Registers RAM-backed "calculator" platform devices so calculator_kmod.ko
+// can be loaded and exercised on any host, without the FPGA:
+//
+//   insmod calculator_kmod.ko
+//   insmod calculator_fake.ko devices=2      -> /dev/calculator0, 1
+//   ./calculator_kmod_test                   (plays the IP from user space)
+// ============================================================================
+
+#include <linux/module.h>
+#include <linux/kernel.h>
+#include <linux/init.h>
+#include <linux/platform_device.h>
+#include "calculator_kmod.h"
+
+#define CALCULATOR_FAKE_MAX       8
+#define CALCULATOR_FAKE_VERSION   0x00010003  // Same as the RTL and the software model
+
+static unsigned int devices = 1;
+module_param(devices, uint, 0444);
+MODULE_PARM_DESC(devices, "Number of fake calculators (1-8, default: 1)");
+
+static struct platform_device *fake_devices[CALCULATOR_FAKE_MAX];
+
+static int __init calculator_fake_init(void)
+{
+    const struct calculator_platform_data pdata = {
+        .ram_backed = true,
+        .version = CALCULATOR_FAKE_VERSION,
+    };
+    unsigned int i;
+
+    if (devices == 0 || devices > CALCULATOR_FAKE_MAX)
+        return -EINVAL;
+
+    for (i = 0; i < devices; i++) {
+        // The platform core copies pdata
+        fake_devices[i] = platform_device_register_data(NULL, CALCULATOR_DRIVER_NAME, i,
+                                                        &pdata, sizeof(pdata));
+        if (IS_ERR(fake_devices[i])) {
+            int ret = PTR_ERR(fake_devices[i]);
+
+            while (i-- > 0)
+                platform_device_unregister(fake_devices[i]);
+            return ret;
+        }
+    }
+
+    pr_info("calculator_fake: %u RAM-backed device(s)\n", devices);
+    return 0;
+}
+
+static void __exit calculator_fake_exit(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < devices; i++)
+        platform_device_unregister(fake_devices[i]);
+}
+
+module_init(calculator_fake_init);
+module_exit(calculator_fake_exit);
+
+MODULE_LICENSE("GPL");
+MODULE_AUTHOR("Calculator IP Integration");
+MODULE_DESCRIPTION("RAM-backed calculator platform devices for testing calculator_kmod");
@@ -0,0 +1,90 @@
+// ============================================================================
+// Calculator Kernel Driver - User-Space Interface
+// ============================================================================
+// Shared by calculator_kmod.c and user space (/dev/calculatorN)
+//
+//   mmap()   offset 0, one page: the register page (fast path, no syscalls)
+//   ioctl()  CALC_IOC_BATCH: run an array of operations in one syscall
+//   poll()   readable after the IP signals completion (interrupt, or the
+//            driver's STATUS poll timer where no interrupt is wired)
+//   read()   one struct calculator_event per wakeup
+//
+// Floats cross the boundary as IEEE-754 bit patterns in __u32 fields; the
+// kernel never does floating-point arithmetic.
+// ============================================================================
+
+#ifndef CALCULATOR_IOCTL_H
+#define CALCULATOR_IOCTL_H
+
+#include <linux/types.h>
+#include <linux/ioctl.h>
+
+#define CALCULATOR_DEVICE_PREFIX  "/dev/calculator"
+
+// ============================================================================
+// Batch Operations
+// ============================================================================
+
+// op values: a calculator_operation_t (0-14) or one of the buffer commands
+// below, so a batch can load the price buffer and run window operations
+#define CALC_KOP_BUFFER_WRITE   0x100   // Append operand_a to the price buffer
+#define CALC_KOP_SET_WINDOW     0x101   // Window size = operand_a (integer, 1-65535)
+#define CALC_KOP_BUFFER_RESET   0x102   // Clear the price buffer, keep the window
+#define CALC_KOP_SET_ALPHA      0x103   // EMA alpha = operand_a (float bits)
+
+// Per-operation status (filled in by the driver)
+#define CALC_KOP_OK             0
+#define CALC_KOP_IP_ERROR       1       // STATUS.error set; see error_code
+#define CALC_KOP_INVALID        2       // Unknown op, nothing written
+#define CALC_KOP_TIMEOUT        3       // IP stayed busy; the batch stops here
+
+struct calculator_kop {
+    __u32 op;
+    __u32 operand_a;        // Float bits (integer for CALC_KOP_SET_WINDOW)
+    __u32 operand_b;        // Float bits (window length for window operations)
+    __u32 result;           // Float bits, out
+    __u32 status;           // CALC_KOP_*, out
+    __u32 error_code;       // CALC_REG_ERROR_CODE on CALC_KOP_IP_ERROR, out
+};
+
+// Batch flags
+#define CALC_BATCH_STOP_ON_ERROR  (1U << 0)   // Stop at the first IP error or invalid op
+
+#define CALC_BATCH_MAX            4096        // Operations per ioctl
+
+struct calculator_batch {
+    __u64 ops;              // User pointer to struct calculator_kop[count]
+    __u32 count;
+    __u32 flags;            // CALC_BATCH_*
+    __u32 timeout_us;       // Per operation, 0 = driver default
+    __u32 completed;        // Entries executed, out; the rest were not run
+};
+
+// ============================================================================
+// Completion Events (read)
+// ============================================================================
+// Completions are counted, not queued: a reader that falls behind gets the
+// latest state with sequence advanced by the number it missed.
+struct calculator_event {
+    __u64 sequence;         // Completions since the device was probed
+    __u64 timestamp_ns;     // CLOCK_MONOTONIC of the latest completion
+    __u32 status;           // STATUS at read time
+    __u32 result;           // RESULT at read time (float bits)
+};
+
+// ============================================================================
+// RAM-Backed (Fake) Devices
+// ============================================================================
+// calculator_fake.ko devices have a page of RAM for registers. Whatever plays
+// the IP clears CONTROL.start, writes RESULT/ERROR_CODE and then STATUS, and
+// raises the "interrupt" by incrementing this word (outside the IP's 32
+// registers, in the same page); the driver's poll timer picks it up.
+#define CALC_FAKE_REG_IRQ_COUNT   0x80
+
+// ============================================================================
+// ioctl Numbers
+// ============================================================================
+#define CALC_IOC_MAGIC   'k'
+#define CALC_IOC_BATCH   _IOWR(CALC_IOC_MAGIC, 1, struct calculator_batch)
+
+#endif // CALCULATOR_IOCTL_H
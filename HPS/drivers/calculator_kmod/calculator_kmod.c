@@ -0,0 +1,783 @@
+// ============================================================================
+// Calculator Kernel Driver
+// ============================================================================
+// Platform driver for the calculator IP on the LW bridge. Each device gets
+// a /dev/calculatorN misc node with:
+//
+//   mmap   the register page, for callers that drive the IP themselves
+//   ioctl  CALC_IOC_BATCH, an array of operations in one syscall
+//   poll   wakes on completion: the IP's interrupt, or a STATUS poll timer
+//          when the device tree gives no interrupt
+//   sysfs  per-device statistics under /sys/class/misc/calculatorN/
+//
+// Devices come from the device tree ("altr,calculator-1.1") or, for
+// testing without an FPGA, from calculator_fake.ko with RAM-backed
+// registers (see calculator_kmod.h).
+// ============================================================================
+
+#include <linux/module.h>
+#include <linux/kernel.h>
+#include <linux/init.h>
+#include <linux/io.h>
+#include <linux/mm.h>
+#include <linux/fs.h>
+#include <linux/of.h>
+#include <linux/idr.h>
+#include <linux/poll.h>
+#include <linux/slab.h>
+#include <linux/delay.h>
+#include <linux/mutex.h>
+#include <linux/ktime.h>
+#include <linux/hrtimer.h>
+#include <linux/uaccess.h>
+#include <linux/interrupt.h>
+#include <linux/miscdevice.h>
+#include <linux/platform_device.h>
+#include <linux/version.h>
+#include "calculator_ioctl.h"
+#include "calculator_kmod.h"
+
+#define CALCULATOR_VERSION "2.0"
+
+// ============================================================================
+// Register Map (mirrors HPS/drivers/calculator/calculator_driver.h)
+// ============================================================================
+#define CALC_REG_CONTROL       0x00
+#define CALC_REG_OPERAND_A     0x04
+#define CALC_REG_OPERAND_B     0x08
+#define CALC_REG_RESULT        0x0C
+#define CALC_REG_STATUS        0x10
+#define CALC_REG_INT_ENABLE    0x14
+#define CALC_REG_BUFFER_CTRL   0x18
+#define CALC_REG_BUFFER_WRITE  0x1C
+#define CALC_REG_EMA_ALPHA     0x24
+#define CALC_REG_ERROR_CODE    0x2C
+#define CALC_REG_VERSION       0x3C
+#define CALC_REG_SPAN          0x80
+
+#define CALC_CTRL_START        BIT(31)
+#define CALC_CTRL_OP_MASK      0xF
+#define CALC_OP_LAST           15          // CALC_OP_ALL
+
+#define CALC_STATUS_BUSY       0x01
+#define CALC_STATUS_ERROR      0x02
+#define CALC_STATUS_DONE       0x04
+
+#define CALC_BUFFER_WINDOW_MASK  0xFFFF
+#define CALC_BUFFER_RESET        BIT(16)
+
+// RAM-backed reset values (match the RTL)
+#define CALC_RESET_WINDOW      20
+#define CALC_RESET_ALPHA       0x3E4CCCCD  // 0.2f
+
+// ============================================================================
+// Module Parameters
+// ============================================================================
+static unsigned int timeout_us = 1000;
+module_param(timeout_us, uint, 0644);
+MODULE_PARM_DESC(timeout_us, "Default per-operation timeout in microseconds (default: 1000)");
+
+static unsigned int spin_us = 20;
+module_param(spin_us, uint, 0644);
+MODULE_PARM_DESC(spin_us, "Busy-poll STATUS this long before sleeping between polls (default: 20)");
+
+static unsigned int poll_interval_us = 50;
+module_param(poll_interval_us, uint, 0644);
+MODULE_PARM_DESC(poll_interval_us, "STATUS poll timer period without an interrupt (default: 50)");
+
+// Operations copied from user space at a time
+#define CALC_BATCH_CHUNK  64
+
+// ============================================================================
+// Device State
+// ============================================================================
+struct calculator_stats {
+    u64 ops;                // Operations executed through CALC_IOC_BATCH
+    u64 batches;
+    u64 batch_max;          // Largest batch
+    u64 ip_errors;          // STATUS.error after an operation
+    u64 invalid_ops;
+    u64 timeouts;
+    u64 spin_polls;         // STATUS reads while spinning
+    u64 sleep_polls;        // STATUS reads after sleeping
+    u32 last_error_code;
+};
+
+struct calculator_dev {
+    struct device *dev;
+    struct miscdevice misc;
+    char name[24];
+    int id;
+
+    // Registers: MMIO, or one page of RAM for a fake device
+    void __iomem *regs;
+    phys_addr_t regs_phys;
+    struct page *ram_page;
+    u32 *ram_regs;
+
+    // Serializes register sequences (batches) and the stats below
+    struct mutex lock;
+    struct calculator_kop *kops;
+    struct calculator_stats stats;
+
+    // Completion notification
+    int irq;                        // < 0: poll timer instead
+    wait_queue_head_t wait;
+    atomic64_t completions;
+    atomic64_t irqs;
+    u64 last_completion_ns;
+    struct hrtimer poll_timer;
+    u32 poll_last_status;           // STATUS, or the fake interrupt count
+    int open_count;                 // Under lock; the poll timer runs while > 0
+};
+
+struct calculator_file {
+    struct calculator_dev *calc;
+    u64 seen;                       // Completions already reported to this file
+};
+
+static DEFINE_IDA(calculator_ida);
+
+// ============================================================================
+// Register Access
+// ============================================================================
+
+static inline u32 calc_read(struct calculator_dev *calc, u32 offset)
+{
+    if (calc->ram_regs)
+        return READ_ONCE(calc->ram_regs[offset / 4]);
+    return readl(calc->regs + offset);
+}
+
+static inline void calc_write(struct calculator_dev *calc, u32 offset, u32 value)
+{
+    if (calc->ram_regs) {
+        // Ordered like MMIO writes, so the responder sees operands before start
+        smp_wmb();
+        WRITE_ONCE(calc->ram_regs[offset / 4], value);
+        return;
+    }
+    writel(value, calc->regs + offset);
+}
+
+// ============================================================================
+// Completion Notification
+// ============================================================================
+
+static void calculator_signal_completion(struct calculator_dev *calc, u32 count)
+{
+    WRITE_ONCE(calc->last_completion_ns, ktime_get_ns());
+    atomic64_add(count, &calc->completions);
+    wake_up_interruptible(&calc->wait);
+}
+
+// The IP pulses its interrupt on the rising edge of STATUS.done
+static irqreturn_t calculator_irq(int irq, void *data)
+{
+    struct calculator_dev *calc = data;
+
+    atomic64_inc(&calc->irqs);
+    calculator_signal_completion(calc, 1);
+    return IRQ_HANDLED;
+}
+
+// Without an interrupt line, every poll_interval_us: a RAM-backed device
+// counts its emulated interrupts in CALC_FAKE_REG_IRQ_COUNT; on hardware,
+// look for the rising edge of STATUS.done (an operation that starts and
+// finishes within one period is missed, so wire the interrupt for poll())
+static enum hrtimer_restart calculator_poll_timer(struct hrtimer *timer)
+{
+    struct calculator_dev *calc = container_of(timer, struct calculator_dev, poll_timer);
+
+    if (calc->ram_regs) {
+        u32 count = calc_read(calc, CALC_FAKE_REG_IRQ_COUNT);
+
+        if (count != calc->poll_last_status)
+            calculator_signal_completion(calc, count - calc->poll_last_status);
+        calc->poll_last_status = count;
+    } else {
+        u32 status = calc_read(calc, CALC_REG_STATUS);
+
+        if ((status & CALC_STATUS_DONE) && !(calc->poll_last_status & CALC_STATUS_DONE))
+            calculator_signal_completion(calc, 1);
+        calc->poll_last_status = status;
+    }
+
+    hrtimer_forward_now(timer, us_to_ktime(max(poll_interval_us, 10U)));
+    return HRTIMER_RESTART;
+}
+
+static void calculator_poll_timer_init(struct calculator_dev *calc)
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 13, 0)
+    hrtimer_setup(&calc->poll_timer, calculator_poll_timer, CLOCK_MONOTONIC, HRTIMER_MODE_REL);
+#else
+    hrtimer_init(&calc->poll_timer, CLOCK_MONOTONIC, HRTIMER_MODE_REL);
+    calc->poll_timer.function = calculator_poll_timer;
+#endif
+}
+
+// ============================================================================
+// Operation Execution
+// ============================================================================
+
+/**
+ * Wait for STATUS.busy to clear: spin for spin_us (operations take well
+ * under a microsecond on the IP), then sleep between polls up to the timeout
+ *
+ * Returns: 0 with *status set, -ETIMEDOUT
+ */
+static int calculator_wait_idle(struct calculator_dev *calc, u32 op_timeout_us, u32 *status)
+{
+    ktime_t start = ktime_get();
+    ktime_t spin_end = ktime_add_us(start, spin_us);
+    ktime_t deadline = ktime_add_us(start, op_timeout_us);
+
+    for (;;) {
+        ktime_t now;
+
+        *status = calc_read(calc, CALC_REG_STATUS);
+        if (!(*status & CALC_STATUS_BUSY))
+            return 0;
+
+        now = ktime_get();
+        if (ktime_after(now, deadline))
+            return -ETIMEDOUT;
+        if (ktime_before(now, spin_end)) {
+            calc->stats.spin_polls++;
+            cpu_relax();
+        } else {
+            calc->stats.sleep_polls++;
+            usleep_range(10, 20);
+        }
+    }
+}
+
+/**
+ * Run one batch entry (lock held)
+ *
+ * Returns: 0 when the batch may continue (kop->status says how the entry
+ *          went), -ETIMEDOUT when the IP is stuck
+ */
+static int calculator_run_kop(struct calculator_dev *calc, struct calculator_kop *kop, u32 op_timeout_us)
+{
+    u32 status;
+    u32 buffer_ctrl;
+
+    kop->result = 0;
+    kop->error_code = 0;
+    kop->status = CALC_KOP_OK;
+
+    switch (kop->op) {
+    case CALC_KOP_BUFFER_WRITE:
+        calc_write(calc, CALC_REG_BUFFER_WRITE, kop->operand_a);
+        return 0;
+    case CALC_KOP_SET_WINDOW:
+        if (kop->operand_a == 0 || kop->operand_a > CALC_BUFFER_WINDOW_MASK) {
+            kop->status = CALC_KOP_INVALID;
+            calc->stats.invalid_ops++;
+            return 0;
+        }
+        calc_write(calc, CALC_REG_BUFFER_CTRL, kop->operand_a);
+        return 0;
+    case CALC_KOP_BUFFER_RESET:
+        // Keep the window while pulsing the self-clearing reset bit
+        buffer_ctrl = calc_read(calc, CALC_REG_BUFFER_CTRL) & CALC_BUFFER_WINDOW_MASK;
+        calc_write(calc, CALC_REG_BUFFER_CTRL, buffer_ctrl | CALC_BUFFER_RESET);
+        return 0;
+    case CALC_KOP_SET_ALPHA:
+        calc_write(calc, CALC_REG_EMA_ALPHA, kop->operand_a);
+        return 0;
+    default:
+        if (kop->op > CALC_OP_LAST) {
+            kop->status = CALC_KOP_INVALID;
+            calc->stats.invalid_ops++;
+            return 0;
+        }
+        break;
+    }
+
+    if (calculator_wait_idle(calc, op_timeout_us, &status) != 0)
+        goto timeout;
+
+    calc_write(calc, CALC_REG_OPERAND_A, kop->operand_a);
+    calc_write(calc, CALC_REG_OPERAND_B, kop->operand_b);
+    // RAM has no logic to raise busy on start; do it for the responder
+    if (calc->ram_regs)
+        calc_write(calc, CALC_REG_STATUS, CALC_STATUS_BUSY);
+    calc_write(calc, CALC_REG_CONTROL, CALC_CTRL_START | (kop->op & CALC_CTRL_OP_MASK));
+
+    if (calculator_wait_idle(calc, op_timeout_us, &status) != 0)
+        goto timeout;
+
+    calc->stats.ops++;
+    kop->result = calc_read(calc, CALC_REG_RESULT);
+    if (status & CALC_STATUS_ERROR) {
+        kop->status = CALC_KOP_IP_ERROR;
+        kop->error_code = calc_read(calc, CALC_REG_ERROR_CODE);
+        calc->stats.ip_errors++;
+        calc->stats.last_error_code = kop->error_code;
+    }
+    return 0;
+
+timeout:
+    kop->status = CALC_KOP_TIMEOUT;
+    calc->stats.timeouts++;
+    dev_warn_ratelimited(calc->dev, "op %u timed out (STATUS 0x%08x)\n", kop->op, status);
+    return -ETIMEDOUT;
+}
+
+static long calculator_ioctl_batch(struct calculator_dev *calc, struct calculator_batch __user *ubatch)
+{
+    struct calculator_batch batch;
+    struct calculator_kop __user *uops;
+    u32 op_timeout_us;
+    u32 completed = 0;
+    bool stop = false;
+    int ret = 0;
+
+    if (copy_from_user(&batch, ubatch, sizeof(batch)))
+        return -EFAULT;
+    if (batch.count == 0 || batch.count > CALC_BATCH_MAX || (batch.flags & ~CALC_BATCH_STOP_ON_ERROR))
+        return -EINVAL;
+
+    uops = u64_to_user_ptr(batch.ops);
+    op_timeout_us = batch.timeout_us ? batch.timeout_us : timeout_us;
+
+    if (mutex_lock_interruptible(&calc->lock))
+        return -ERESTARTSYS;
+
+    while (completed < batch.count && !stop) {
+        u32 chunk = min_t(u32, batch.count - completed, CALC_BATCH_CHUNK);
+        u32 run = 0;
+
+        if (copy_from_user(calc->kops, uops + completed, chunk * sizeof(*calc->kops))) {
+            ret = -EFAULT;
+            break;
+        }
+
+        while (run < chunk && !stop) {
+            struct calculator_kop *kop = &calc->kops[run++];
+
+            if (calculator_run_kop(calc, kop, op_timeout_us) != 0) {
+                ret = -ETIMEDOUT;
+                stop = true;
+            } else if (kop->status != CALC_KOP_OK && (batch.flags & CALC_BATCH_STOP_ON_ERROR)) {
+                stop = true;
+            }
+        }
+
+        if (copy_to_user(uops + completed, calc->kops, run * sizeof(*calc->kops))) {
+            ret = -EFAULT;
+            break;
+        }
+        completed += run;
+    }
+
+    calc->stats.batches++;
+    if (batch.count > calc->stats.batch_max)
+        calc->stats.batch_max = batch.count;
+    mutex_unlock(&calc->lock);
+
+    if (put_user(completed, &ubatch->completed))
+        return -EFAULT;
+    return ret;
+}
+
+// ============================================================================
+// File Operations
+// ============================================================================
+
+static int calculator_open(struct inode *inode, struct file *file)
+{
+    struct miscdevice *misc = file->private_data;
+    struct calculator_dev *calc = container_of(misc, struct calculator_dev, misc);
+    struct calculator_file *cfile;
+
+    cfile = kzalloc(sizeof(*cfile), GFP_KERNEL);
+    if (!cfile)
+        return -ENOMEM;
+    cfile->calc = calc;
+    cfile->seen = atomic64_read(&calc->completions);
+
+    mutex_lock(&calc->lock);
+    if (calc->open_count++ == 0 && calc->irq < 0) {
+        calc->poll_last_status = calc_read(calc, calc->ram_regs ? CALC_FAKE_REG_IRQ_COUNT : CALC_REG_STATUS);
+        hrtimer_start(&calc->poll_timer, us_to_ktime(max(poll_interval_us, 10U)), HRTIMER_MODE_REL);
+    }
+    mutex_unlock(&calc->lock);
+
+    file->private_data = cfile;
+    return nonseekable_open(inode, file);
+}
+
+static int calculator_release(struct inode *inode, struct file *file)
+{
+    struct calculator_file *cfile = file->private_data;
+    struct calculator_dev *calc = cfile->calc;
+
+    mutex_lock(&calc->lock);
+    if (--calc->open_count == 0 && calc->irq < 0)
+        hrtimer_cancel(&calc->poll_timer);
+    mutex_unlock(&calc->lock);
+
+    kfree(cfile);
+    return 0;
+}
+
+static ssize_t calculator_read(struct file *file, char __user *buf, size_t count, loff_t *ppos)
+{
+    struct calculator_file *cfile = file->private_data;
+    struct calculator_dev *calc = cfile->calc;
+    struct calculator_event event;
+    int ret;
+
+    if (count < sizeof(event))
+        return -EINVAL;
+
+    if (atomic64_read(&calc->completions) == cfile->seen) {
+        if (file->f_flags & O_NONBLOCK)
+            return -EAGAIN;
+        ret = wait_event_interruptible(calc->wait, atomic64_read(&calc->completions) != cfile->seen);
+        if (ret)
+            return ret;
+    }
+
+    event.sequence = atomic64_read(&calc->completions);
+    event.timestamp_ns = READ_ONCE(calc->last_completion_ns);
+    event.status = calc_read(calc, CALC_REG_STATUS);
+    event.result = calc_read(calc, CALC_REG_RESULT);
+    cfile->seen = event.sequence;
+
+    if (copy_to_user(buf, &event, sizeof(event)))
+        return -EFAULT;
+    return sizeof(event);
+}
+
+static __poll_t calculator_poll(struct file *file, poll_table *wait)
+{
+    struct calculator_file *cfile = file->private_data;
+    struct calculator_dev *calc = cfile->calc;
+
+    poll_wait(file, &calc->wait, wait);
+    if (atomic64_read(&calc->completions) != cfile->seen)
+        return EPOLLIN | EPOLLRDNORM;
+    return 0;
+}
+
+static long calculator_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
+{
+    struct calculator_file *cfile = file->private_data;
+
+    switch (cmd) {
+    case CALC_IOC_BATCH:
+        return calculator_ioctl_batch(cfile->calc, (struct calculator_batch __user *)arg);
+    default:
+        return -ENOTTY;
+    }
+}
+
+// One page at offset 0: the registers, uncached (or the RAM page of a fake device)
+static int calculator_mmap(struct file *file, struct vm_area_struct *vma)
+{
+    struct calculator_file *cfile = file->private_data;
+    struct calculator_dev *calc = cfile->calc;
+    unsigned long size = vma->vm_end - vma->vm_start;
+
+    if (vma->vm_pgoff != 0 || size > PAGE_SIZE)
+        return -EINVAL;
+
+    if (calc->ram_page)
+        return vm_insert_page(vma, vma->vm_start, calc->ram_page);
+
+    vma->vm_page_prot = pgprot_noncached(vma->vm_page_prot);
+    return vm_iomap_memory(vma, calc->regs_phys, PAGE_SIZE);
+}
+
+static const struct file_operations calculator_fops = {
+    .owner = THIS_MODULE,
+    .open = calculator_open,
+    .release = calculator_release,
+    .read = calculator_read,
+    .poll = calculator_poll,
+    .unlocked_ioctl = calculator_ioctl,
+    .compat_ioctl = compat_ptr_ioctl,
+    .mmap = calculator_mmap,
+};
+
+// ============================================================================
+// sysfs Statistics
+// ============================================================================
+
+static struct calculator_dev *calculator_from_device(struct device *dev)
+{
+    struct miscdevice *misc = dev_get_drvdata(dev);
+
+    return container_of(misc, struct calculator_dev, misc);
+}
+
+// Batch counters change under the device lock; take it so 64-bit values
+// never tear on the A9
+#define CALCULATOR_STAT_ATTR(field)                                             \
+static ssize_t field##_show(struct device *dev, struct device_attribute *attr,  \
+                            char *buf)                                          \
+{                                                                               \
+    struct calculator_dev *calc = calculator_from_device(dev);                  \
+    u64 value;                                                                  \
+                                                                                \
+    mutex_lock(&calc->lock);                                                    \
+    value = calc->stats.field;                                                  \
+    mutex_unlock(&calc->lock);                                                  \
+    return sysfs_emit(buf, "%llu\n", (unsigned long long)value);                \
+}                                                                               \
+static DEVICE_ATTR_RO(field)
+
+CALCULATOR_STAT_ATTR(ops);
+CALCULATOR_STAT_ATTR(batches);
+CALCULATOR_STAT_ATTR(batch_max);
+CALCULATOR_STAT_ATTR(ip_errors);
+CALCULATOR_STAT_ATTR(invalid_ops);
+CALCULATOR_STAT_ATTR(timeouts);
+CALCULATOR_STAT_ATTR(spin_polls);
+CALCULATOR_STAT_ATTR(sleep_polls);
+
+static ssize_t last_error_code_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct calculator_dev *calc = calculator_from_device(dev);
+
+    return sysfs_emit(buf, "0x%08x\n", READ_ONCE(calc->stats.last_error_code));
+}
+static DEVICE_ATTR_RO(last_error_code);
+
+static ssize_t completions_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct calculator_dev *calc = calculator_from_device(dev);
+
+    return sysfs_emit(buf, "%lld\n", (long long)atomic64_read(&calc->completions));
+}
+static DEVICE_ATTR_RO(completions);
+
+static ssize_t irqs_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct calculator_dev *calc = calculator_from_device(dev);
+
+    return sysfs_emit(buf, "%lld\n", (long long)atomic64_read(&calc->irqs));
+}
+static DEVICE_ATTR_RO(irqs);
+
+static ssize_t version_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct calculator_dev *calc = calculator_from_device(dev);
+
+    return sysfs_emit(buf, "0x%08x\n", calc_read(calc, CALC_REG_VERSION));
+}
+static DEVICE_ATTR_RO(version);
+
+static ssize_t backend_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct calculator_dev *calc = calculator_from_device(dev);
+
+    return sysfs_emit(buf, "%s\n", calc->ram_regs ? "ram" : "hardware");
+}
+static DEVICE_ATTR_RO(backend);
+
+static ssize_t completion_source_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+    struct calculator_dev *calc = calculator_from_device(dev);
+
+    if (calc->irq >= 0)
+        return sysfs_emit(buf, "irq %d\n", calc->irq);
+    return sysfs_emit(buf, "poll timer %u us\n", max(poll_interval_us, 10U));
+}
+static DEVICE_ATTR_RO(completion_source);
+
+static ssize_t stats_reset_store(struct device *dev, struct device_attribute *attr,
+                                 const char *buf, size_t count)
+{
+    struct calculator_dev *calc = calculator_from_device(dev);
+
+    mutex_lock(&calc->lock);
+    memset(&calc->stats, 0, sizeof(calc->stats));
+    mutex_unlock(&calc->lock);
+    atomic64_set(&calc->irqs, 0);
+    return count;
+}
+static DEVICE_ATTR_WO(stats_reset);
+
+static struct attribute *calculator_attrs[] = {
+    &dev_attr_ops.attr,
+    &dev_attr_batches.attr,
+    &dev_attr_batch_max.attr,
+    &dev_attr_ip_errors.attr,
+    &dev_attr_invalid_ops.attr,
+    &dev_attr_timeouts.attr,
+    &dev_attr_spin_polls.attr,
+    &dev_attr_sleep_polls.attr,
+    &dev_attr_last_error_code.attr,
+    &dev_attr_completions.attr,
+    &dev_attr_irqs.attr,
+    &dev_attr_version.attr,
+    &dev_attr_backend.attr,
+    &dev_attr_completion_source.attr,
+    &dev_attr_stats_reset.attr,
+    NULL,
+};
+ATTRIBUTE_GROUPS(calculator);
+
+// ============================================================================
+// Platform Driver
+// ============================================================================
+
+static int calculator_map_registers(struct platform_device *pdev, struct calculator_dev *calc)
+{
+    struct calculator_platform_data *pdata = dev_get_platdata(&pdev->dev);
+    struct resource *res;
+
+    if (pdata && pdata->ram_backed) {
+        calc->ram_page = alloc_page(GFP_KERNEL | __GFP_ZERO);
+        if (!calc->ram_page)
+            return -ENOMEM;
+        calc->ram_regs = page_address(calc->ram_page);
+        calc->ram_regs[CALC_REG_VERSION / 4] = pdata->version;
+        calc->ram_regs[CALC_REG_BUFFER_CTRL / 4] = CALC_RESET_WINDOW;
+        calc->ram_regs[CALC_REG_EMA_ALPHA / 4] = CALC_RESET_ALPHA;
+        return 0;
+    }
+
+    calc->regs = devm_platform_get_and_ioremap_resource(pdev, 0, &res);
+    if (IS_ERR(calc->regs))
+        return PTR_ERR(calc->regs);
+    if (resource_size(res) < CALC_REG_SPAN || !PAGE_ALIGNED(res->start)) {
+        dev_err(&pdev->dev, "register window %pR must span 0x%x bytes from a page boundary\n",
+                res, CALC_REG_SPAN);
+        return -EINVAL;
+    }
+    calc->regs_phys = res->start;
+    return 0;
+}
+
+static int calculator_probe(struct platform_device *pdev)
+{
+    struct calculator_dev *calc;
+    int ret;
+
+    calc = devm_kzalloc(&pdev->dev, sizeof(*calc), GFP_KERNEL);
+    if (!calc)
+        return -ENOMEM;
+    calc->kops = devm_kcalloc(&pdev->dev, CALC_BATCH_CHUNK, sizeof(*calc->kops), GFP_KERNEL);
+    if (!calc->kops)
+        return -ENOMEM;
+
+    calc->dev = &pdev->dev;
+    mutex_init(&calc->lock);
+    init_waitqueue_head(&calc->wait);
+    calculator_poll_timer_init(calc);
+
+    ret = calculator_map_registers(pdev, calc);
+    if (ret)
+        return ret;
+
+    // Fake devices have no interrupt; a missing one on hardware is not fatal
+    calc->irq = calc->ram_regs ? -ENXIO : platform_get_irq_optional(pdev, 0);
+    if (calc->irq >= 0) {
+        ret = devm_request_irq(&pdev->dev, calc->irq, calculator_irq, 0, dev_name(&pdev->dev), calc);
+        if (ret) {
+            dev_err(&pdev->dev, "request_irq %d: %d\n", calc->irq, ret);
+            goto err_free_page;
+        }
+        calc_write(calc, CALC_REG_INT_ENABLE, 1);
+    } else if (calc->irq == -EPROBE_DEFER) {
+        ret = -EPROBE_DEFER;
+        goto err_free_page;
+    }
+
+    calc->id = ida_alloc(&calculator_ida, GFP_KERNEL);
+    if (calc->id < 0) {
+        ret = calc->id;
+        goto err_disable_irq;
+    }
+    snprintf(calc->name, sizeof(calc->name), "calculator%d", calc->id);
+
+    calc->misc.minor = MISC_DYNAMIC_MINOR;
+    calc->misc.name = calc->name;
+    calc->misc.fops = &calculator_fops;
+    calc->misc.parent = &pdev->dev;
+    calc->misc.groups = calculator_groups;
+    ret = misc_register(&calc->misc);
+    if (ret) {
+        dev_err(&pdev->dev, "misc_register: %d\n", ret);
+        goto err_free_id;
+    }
+
+    platform_set_drvdata(pdev, calc);
+    dev_info(&pdev->dev, "/dev/%s: version 0x%08x, %s registers, completion by %s\n",
+             calc->name, calc_read(calc, CALC_REG_VERSION), calc->ram_regs ? "RAM" : "MMIO",
+             calc->irq >= 0 ? "interrupt" : "poll timer");
+    return 0;
+
+err_free_id:
+    ida_free(&calculator_ida, calc->id);
+err_disable_irq:
+    if (calc->irq >= 0)
+        calc_write(calc, CALC_REG_INT_ENABLE, 0);
+err_free_page:
+    if (calc->ram_page)
+        __free_page(calc->ram_page);
+    return ret;
+}
+
+static void calculator_remove_device(struct platform_device *pdev)
+{
+    struct calculator_dev *calc = platform_get_drvdata(pdev);
+
+    misc_deregister(&calc->misc);
+    hrtimer_cancel(&calc->poll_timer);
+    if (calc->irq >= 0)
+        calc_write(calc, CALC_REG_INT_ENABLE, 0);
+    ida_free(&calculator_ida, calc->id);
+    if (calc->ram_page)
+        __free_page(calc->ram_page);
+}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 11, 0)
+static void calculator_remove(struct platform_device *pdev)
+{
+    calculator_remove_device(pdev);
+}
+#else
+static int calculator_remove(struct platform_device *pdev)
+{
+    calculator_remove_device(pdev);
+    return 0;
+}
+#endif
+
+static const struct of_device_id calculator_of_match[] = {
+    { .compatible = "altr,calculator-1.1" },
+    { }
+};
+MODULE_DEVICE_TABLE(of, calculator_of_match);
+
+// Devices registered by name (calculator_fake.ko)
+static const struct platform_device_id calculator_id_table[] = {
+    { CALCULATOR_DRIVER_NAME, 0 },
+    { }
+};
+MODULE_DEVICE_TABLE(platform, calculator_id_table);
+
+static struct platform_driver calculator_driver = {
+    .probe = calculator_probe,
+    .remove = calculator_remove,
+    .id_table = calculator_id_table,
+    .driver = {
+        .name = CALCULATOR_DRIVER_NAME,
+        .of_match_table = calculator_of_match,
+    },
+};
+
+module_platform_driver(calculator_driver);
+
+MODULE_LICENSE("GPL");
+MODULE_AUTHOR("Calculator IP Integration");
+MODULE_DESCRIPTION("Hardware calculator IP driver: mmap, batch ioctl, poll, sysfs statistics");
+MODULE_VERSION(CALCULATOR_VERSION);
@@ -0,0 +1,29 @@
+// ============================================================================
+// Calculator Kernel Driver - Platform Data
+// ============================================================================
+// Kernel-internal: lets calculator_fake.c register devices without an FPGA
+// ============================================================================
+
+#ifndef CALCULATOR_KMOD_H
+#define CALCULATOR_KMOD_H
+
+#include <linux/types.h>
+
+#define CALCULATOR_DRIVER_NAME  "calculator"
+
+/**
+ * Optional platform data
+ *
+ * ram_backed: the registers are a zeroed page of RAM allocated by the
+ *             driver instead of a MEM resource. Nothing computes behind
+ *             them; whatever plays the IP (e.g. calculator_kmod_test's
+ *             responder thread) mmap()s the page, watches CONTROL.start and
+ *             writes RESULT and STATUS back.
+ * version:    initial VERSION register of a RAM-backed device
+ */
+struct calculator_platform_data {
+    bool ram_backed;
+    u32 version;
+};
+
+#endif // CALCULATOR_KMOD_H
@@ -0,0 +1,378 @@
+// ============================================================================
+// Calculator Kernel Driver Test (calculator_kmod_test)
+// ============================================================================
+// Exercises /dev/calculatorN end to end:
+//
+//   1. batch ioctl   arithmetic operations checked against the host FPU,
+//                    timed as one batch and as one ioctl per operation
+//   2. mmap + poll   operations started through the mapped register page,
+//                    completion awaited with poll() and read()
+//   3. sysfs         the device's statistics after the run
+//
+// On a RAM-backed device (calculator_fake.ko) a responder thread plays the
+// IP: it watches CONTROL.start in the mapped page, runs the operation on
+// the software model (calculator_model.c) and writes RESULT and STATUS
+// back. Window operations are not tested there: RAM cannot see each write
+// to BUFFER_WRITE, so the price buffer only works on hardware.
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include "calculator_driver.h"
+#include "calculator_model.h"
+#include "calculator_ioctl.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define DEFAULT_DEVICE       "/dev/calculator0"
+#define DEFAULT_OPS          4096
+#define DEFAULT_BATCH        64
+#define MMAP_OPS             100
+#define POLL_TIMEOUT_MS      100
+#define REGS_PAGE            4096
+
+// ============================================================================
+// Global Variables
+// ============================================================================
+static volatile uint32_t *regs;
+static volatile int responder_running;
+static uint32_t op_timeout_us;              // 0 = driver default
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t float_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bits_float(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// ============================================================================
+// Responder (plays the IP on a RAM-backed device)
+// ============================================================================
+
+static void *responder_thread(void *arg) {
+    (void)arg;
+
+    calculator_model_reset();
+    while (__atomic_load_n(&responder_running, __ATOMIC_ACQUIRE)) {
+        uint32_t control = __atomic_load_n(&regs[CALC_REG_CONTROL / 4], __ATOMIC_ACQUIRE);
+        if (!(control & CALC_CTRL_START)) {
+            sched_yield();      // Lets the kernel side run on a single CPU
+            continue;
+        }
+
+        calculator_model_write(CALC_REG_OPERAND_A, regs[CALC_REG_OPERAND_A / 4]);
+        calculator_model_write(CALC_REG_OPERAND_B, regs[CALC_REG_OPERAND_B / 4]);
+        calculator_model_write(CALC_REG_CONTROL, control);
+
+        // Clear start before publishing STATUS: once STATUS says idle the
+        // driver may write the next operation's start bit
+        __atomic_store_n(&regs[CALC_REG_CONTROL / 4], control & ~CALC_CTRL_START, __ATOMIC_RELAXED);
+        regs[CALC_REG_RESULT / 4] = calculator_model_read(CALC_REG_RESULT);
+        regs[CALC_REG_ERROR_CODE / 4] = calculator_model_read(CALC_REG_ERROR_CODE);
+        for (uint32_t i = 0; i < CALC_STATS_COUNT; i++) {
+            regs[CALC_REG_STATS_SMA / 4 + i] = calculator_model_read(CALC_REG_STATS_SMA + 4 * i);
+        }
+        __atomic_store_n(&regs[CALC_REG_STATUS / 4], calculator_model_read(CALC_REG_STATUS), __ATOMIC_RELEASE);
+        __atomic_add_fetch(&regs[CALC_FAKE_REG_IRQ_COUNT / 4], 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void prepare_ops(struct calculator_kop *ops, float *expected, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        float a = (float)(rand() % 20000) / 100.0f - 100.0f;
+        float b = (float)(rand() % 20000 + 1) / 100.0f;
+
+        ops[i].op = i % 4;                   // ADD, SUB, MUL, DIV
+        ops[i].operand_a = float_bits(a);
+        ops[i].operand_b = float_bits(b);
+        switch (ops[i].op) {
+        case CALC_OP_ADD: expected[i] = a + b; break;
+        case CALC_OP_SUB: expected[i] = a - b; break;
+        case CALC_OP_MUL: expected[i] = a * b; break;
+        default:          expected[i] = a / b; break;
+        }
+    }
+}
+
+static int run_batches(int fd, struct calculator_kop *ops, uint32_t count, uint32_t batch_size,
+                       uint64_t *elapsed_ns) {
+    uint64_t start = now_ns();
+
+    for (uint32_t done = 0; done < count; done += batch_size) {
+        struct calculator_batch batch;
+        memset(&batch, 0, sizeof(batch));
+        batch.ops = (uint64_t)(uintptr_t)&ops[done];
+        batch.count = count - done < batch_size ? count - done : batch_size;
+        batch.timeout_us = op_timeout_us;
+
+        if (ioctl(fd, CALC_IOC_BATCH, &batch) != 0) {
+            fprintf(stderr, "CALC_IOC_BATCH: %s (%u of %u done)\n", strerror(errno),
+                    batch.completed, batch.count);
+            return -1;
+        }
+    }
+    *elapsed_ns = now_ns() - start;
+    return 0;
+}
+
+static int check_results(const struct calculator_kop *ops, const float *expected, uint32_t count) {
+    uint32_t failures = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (ops[i].status != CALC_KOP_OK || bits_float(ops[i].result) != expected[i]) {
+            if (failures++ < 5) {
+                fprintf(stderr, "  op %u (code %u): status %u, result %g, expected %g\n", i,
+                        ops[i].op, ops[i].status, bits_float(ops[i].result), expected[i]);
+            }
+        }
+    }
+    return failures == 0 ? 0 : -1;
+}
+
+static int test_batch(int fd, uint32_t count, uint32_t batch_size) {
+    struct calculator_kop *ops = calloc(count, sizeof(*ops));
+    float *expected = calloc(count, sizeof(*expected));
+    uint64_t batched_ns = 0;
+    uint64_t single_ns = 0;
+    int ret = -1;
+
+    if (ops == NULL || expected == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        goto out;
+    }
+
+    prepare_ops(ops, expected, count);
+    if (run_batches(fd, ops, count, batch_size, &batched_ns) != 0 ||
+        check_results(ops, expected, count) != 0) {
+        goto out;
+    }
+    if (run_batches(fd, ops, count, 1, &single_ns) != 0 ||
+        check_results(ops, expected, count) != 0) {
+        goto out;
+    }
+
+    printf("Batch ioctl: %u operations correct\n", count);
+    printf("  batches of %-4u %8.0f ns per operation\n", batch_size, (double)batched_ns / count);
+    printf("  one per ioctl   %8.0f ns per operation\n", (double)single_ns / count);
+    ret = 0;
+
+out:
+    free(ops);
+    free(expected);
+    return ret;
+}
+
+// Consume completion events left over from earlier operations
+static void drain_events(int fd) {
+    struct calculator_event event;
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+    while (poll(&pfd, 1, 0) > 0 && read(fd, &event, sizeof(event)) == (ssize_t)sizeof(event)) {
+    }
+}
+
+static int test_mmap_poll(int fd, bool ram_backed) {
+    uint32_t failures = 0;
+    uint64_t wait_ns = 0;
+
+    // Let a poll timer period pass so the batch test's completions are counted
+    usleep(10000);
+    drain_events(fd);
+
+    for (uint32_t i = 0; i < MMAP_OPS; i++) {
+        float a = (float)i + 0.5f;
+        float b = 2.0f;
+        struct calculator_event event;
+        struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+        regs[CALC_REG_OPERAND_A / 4] = float_bits(a);
+        regs[CALC_REG_OPERAND_B / 4] = float_bits(b);
+        if (ram_backed) {
+            regs[CALC_REG_STATUS / 4] = CALC_STATUS_BUSY;   // What the IP does on start
+        }
+        __atomic_store_n(&regs[CALC_REG_CONTROL / 4], CALC_CTRL_START | CALC_OP_MUL, __ATOMIC_RELEASE);
+
+        uint64_t start = now_ns();
+        int ready = poll(&pfd, 1, POLL_TIMEOUT_MS);
+        if (ready <= 0 || read(fd, &event, sizeof(event)) != (ssize_t)sizeof(event)) {
+            fprintf(stderr, "  op %u: no completion within %d ms\n", i, POLL_TIMEOUT_MS);
+            failures++;
+            continue;
+        }
+        wait_ns += now_ns() - start;
+
+        // The event carries the RESULT seen at read time
+        if (bits_float(event.result) != a * b) {
+            fprintf(stderr, "  op %u: result %g, expected %g\n", i, bits_float(event.result), a * b);
+            failures++;
+        }
+    }
+
+    printf("mmap + poll: %u/%u operations completed correctly, %.0f ns mean wait\n",
+           MMAP_OPS - failures, MMAP_OPS, (double)wait_ns / MMAP_OPS);
+    return failures == 0 ? 0 : -1;
+}
+
+static void print_sysfs_stats(const char *device) {
+    static const char *attributes[] = {
+        "backend", "completion_source", "version", "ops", "batches", "batch_max",
+        "ip_errors", "invalid_ops", "timeouts", "spin_polls", "sleep_polls", "completions", "irqs",
+    };
+    const char *name = strrchr(device, '/');
+    char path[256];
+    char value[64];
+
+    printf("sysfs (/sys/class/misc/%s):\n", name ? name + 1 : device);
+    for (size_t i = 0; i < sizeof(attributes) / sizeof(attributes[0]); i++) {
+        snprintf(path, sizeof(path), "/sys/class/misc/%s/%s", name ? name + 1 : device, attributes[i]);
+        FILE *file = fopen(path, "r");
+        if (file == NULL) {
+            continue;
+        }
+        if (fgets(value, sizeof(value), file) != NULL) {
+            value[strcspn(value, "\n")] = '\0';
+            printf("  %-18s %s\n", attributes[i], value);
+        }
+        fclose(file);
+    }
+}
+
+static bool device_is_ram_backed(const char *device) {
+    const char *name = strrchr(device, '/');
+    char path[256];
+    char value[16] = "";
+
+    snprintf(path, sizeof(path), "/sys/class/misc/%s/backend", name ? name + 1 : device);
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+    if (fgets(value, sizeof(value), file) == NULL) {
+        value[0] = '\0';
+    }
+    fclose(file);
+    return strncmp(value, "ram", 3) == 0;
+}
+
+// ============================================================================
+// Usage
+// ============================================================================
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options]\n", program_name);
+    printf("\n");
+    printf("Tests /dev/calculatorN: batch ioctl, mmap + poll, sysfs statistics.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  -h, --help          Show this help message\n");
+    printf("  --device PATH       Device node (default: %s)\n", DEFAULT_DEVICE);
+    printf("  -n N                Operations in the batch test (default: %d)\n", DEFAULT_OPS);
+    printf("  --batch N           Operations per ioctl (1-%d, default: %d)\n", CALC_BATCH_MAX, DEFAULT_BATCH);
+    printf("\n");
+    printf("Without an FPGA: insmod calculator_kmod.ko && insmod calculator_fake.ko\n");
+}
+
+// ============================================================================
+// Main Function
+// ============================================================================
+int main(int argc, char *argv[]) {
+    const char *device = DEFAULT_DEVICE;
+    uint32_t count = DEFAULT_OPS;
+    uint32_t batch_size = DEFAULT_BATCH;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--device") == 0 && i + 1 < argc) {
+            device = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch_size = (uint32_t)strtoul(argv[++i], NULL, 0);
+            if (batch_size == 0 || batch_size > CALC_BATCH_MAX) {
+                fprintf(stderr, "Invalid batch: %s (1-%d)\n", argv[i], CALC_BATCH_MAX);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    int fd = open(device, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        fprintf(stderr, "Could not open %s: %s\n", device, strerror(errno));
+        fprintf(stderr, "Hint: insmod calculator_kmod.ko (and calculator_fake.ko without an FPGA)\n");
+        return 1;
+    }
+
+    void *page = mmap(NULL, REGS_PAGE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (page == MAP_FAILED) {
+        fprintf(stderr, "mmap %s: %s\n", device, strerror(errno));
+        close(fd);
+        return 1;
+    }
+    regs = (volatile uint32_t *)page;
+
+    bool ram_backed = device_is_ram_backed(device);
+    pthread_t responder;
+    if (ram_backed) {
+        // The responder is a user thread, not logic: allow it a scheduling delay
+        op_timeout_us = 100000;
+        responder_running = 1;
+        if (pthread_create(&responder, NULL, responder_thread, NULL) != 0) {
+            fprintf(stderr, "pthread_create failed\n");
+            return 1;
+        }
+    }
+
+    printf("%s: version 0x%08X, %s\n", device, regs[CALC_REG_VERSION / 4],
+           ram_backed ? "RAM-backed (responder thread plays the IP)" : "hardware");
+
+    srand(1);
+    int ret = test_batch(fd, count, batch_size);
+    if (test_mmap_poll(fd, ram_backed) != 0) {
+        ret = -1;
+    }
+
+    if (ram_backed) {
+        __atomic_store_n(&responder_running, 0, __ATOMIC_RELEASE);
+        pthread_join(responder, NULL);
+    }
+    print_sysfs_stats(device);
+    printf("%s\n", ret == 0 ? "PASSED" : "FAILED");
+
+    munmap(page, REGS_PAGE);
+    close(fd);
+    return ret == 0 ? 0 : 1;
+}
@@ -22,6 +22,14 @@ int fpga_uio_write32(fpga_uio_dev_t* dev, size_t offset, uint32_t value);
 // Read 32-bit value from specified offset
 int fpga_uio_read32(fpga_uio_dev_t* dev, size_t offset, uint32_t* value);
 
+// Copy 'len' bytes into the device at 'offset' (offset and len multiples of 4).
+// Uses 128-bit/64-bit NEON stores where available so the bridge can burst;
+// plain memcpy on hosts without NEON (RAM-backed mock targets)
+int fpga_uio_write_block(fpga_uio_dev_t* dev, size_t offset, const void* src, size_t len);
+
+// Copy 'len' bytes out of the device at 'offset' (offset and len multiples of 4)
+int fpga_uio_read_block(fpga_uio_dev_t* dev, size_t offset, void* dst, size_t len);
+
 // Cleanup UIO device
 void fpga_uio_cleanup(fpga_uio_dev_t* dev);
 
@@ -0,0 +1,75 @@
+#ifndef FPGA_UIO_INLINE_H
+#define FPGA_UIO_INLINE_H
+
+// Unchecked inline register accessors for datapath code.
+//
+// fpga_uio_read32()/fpga_uio_write32() are out-of-line and validate the
+// device and offset on every access. Here the validation happens once, when
+// a register handle is created with fpga_uio_reg8/16/32/64(); every access
+// after that is a single volatile load or store with no checks.
+//
+// Plain accessors impose no ordering beyond what the mapping gives. The
+// _ordered variants add a barrier:
+//   fpga_regN_write_ordered: earlier stores reach the device before this one
+//                            (e.g. operands before the control/start write)
+//   fpga_regN_read_ordered:  the load completes before any later access
+//                            (e.g. status before reading the result)
+//
+// 64-bit accesses on 32-bit ARM may be split into two bus transactions.
+
+#include "fpga_uio.h"
+
+#if defined(__arm__) || defined(__aarch64__)
+#define fpga_uio_mb()   __asm__ __volatile__("dmb sy" ::: "memory")
+#define fpga_uio_wmb()  __asm__ __volatile__("dmb st" ::: "memory")
+#define fpga_uio_rmb()  __asm__ __volatile__("dmb sy" ::: "memory")
+#else
+#define fpga_uio_mb()   __sync_synchronize()
+#define fpga_uio_wmb()  __asm__ __volatile__("" ::: "memory")
+#define fpga_uio_rmb()  __asm__ __volatile__("" ::: "memory")
+#endif
+
+// Register handles (validated address inside a UIO mapping)
+typedef struct { volatile uint8_t*  addr; } fpga_reg8_t;
+typedef struct { volatile uint16_t* addr; } fpga_reg16_t;
+typedef struct { volatile uint32_t* addr; } fpga_reg32_t;
+typedef struct { volatile uint64_t* addr; } fpga_reg64_t;
+
+// Resolve a register of 'width' bytes at 'offset'; checks that the device is
+// initialized, the register lies inside the mapping and is naturally aligned.
+// Returns 0 on success, -1 with errno = EINVAL otherwise
+int fpga_uio_reg(fpga_uio_dev_t* dev, size_t offset, size_t width, volatile void** addr);
+
+#define FPGA_UIO_DEFINE_REG(bits)                                                        \
+static inline int fpga_uio_reg##bits(fpga_uio_dev_t* dev, size_t offset,                 \
+                                     fpga_reg##bits##_t* reg) {                          \
+    volatile void* addr = NULL;                                                          \
+    int ret = fpga_uio_reg(dev, offset, sizeof(uint##bits##_t), &addr);                  \
+    reg->addr = (volatile uint##bits##_t*)addr;                                          \
+    return ret;                                                                          \
+}                                                                                        \
+static inline uint##bits##_t fpga_reg##bits##_read(fpga_reg##bits##_t reg) {             \
+    return *reg.addr;                                                                    \
+}                                                                                        \
+static inline void fpga_reg##bits##_write(fpga_reg##bits##_t reg, uint##bits##_t value) { \
+    *reg.addr = value;                                                                   \
+}                                                                                        \
+static inline uint##bits##_t fpga_reg##bits##_read_ordered(fpga_reg##bits##_t reg) {     \
+    uint##bits##_t value = *reg.addr;                                                    \
+    fpga_uio_rmb();                                                                      \
+    return value;                                                                        \
+}                                                                                        \
+static inline void fpga_reg##bits##_write_ordered(fpga_reg##bits##_t reg,                \
+                                                  uint##bits##_t value) {                \
+    fpga_uio_wmb();                                                                      \
+    *reg.addr = value;                                                                   \
+}
+
+FPGA_UIO_DEFINE_REG(8)
+FPGA_UIO_DEFINE_REG(16)
+FPGA_UIO_DEFINE_REG(32)
+FPGA_UIO_DEFINE_REG(64)
+
+#undef FPGA_UIO_DEFINE_REG
+
+#endif // FPGA_UIO_INLINE_H
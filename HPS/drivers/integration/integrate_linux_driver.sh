@@ -253,7 +253,7 @@ integrate_kernel() {
 
 // Base address (will be set from device tree)
 static void __iomem *calculator_base = NULL;
-static resource_size_t calculator_size = 64;  // 64 bytes
+static resource_size_t calculator_size = 128;  // 128 bytes
 
 // Device tree compatible string
 static const struct of_device_id calculator_of_match[] = {
@@ -434,7 +434,7 @@ create_device_tree() {
 &h2f_lw_bus {
     calculator_0: calculator@${BASE_ADDRESS} {
         compatible = "altr,calculator-1.1";
-        reg = <${BASE_ADDRESS} 0x40>;  // 64 bytes (16 registers)
+        reg = <${BASE_ADDRESS} 0x80>;  // 128 bytes (32 registers)
         status = "okay";
     };
 };
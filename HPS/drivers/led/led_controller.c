@@ -1,61 +1,111 @@
 #include "led_controller.h"
-#include "config.h"
 #include <stdio.h>
 #include <unistd.h>
 #include <errno.h>
 
+// Step delay for led_controller_run_animation (override with -DANIMATION_DELAY_MS=...)
+#ifndef ANIMATION_DELAY_MS
+#define ANIMATION_DELAY_MS 100
+#endif
+
+static uint32_t led_controller_bits(const led_controller_t* ctrl) {
+    return (ctrl->num_leds >= 32) ? 0xFFFFFFFFU : ((1U << ctrl->num_leds) - 1);
+}
+
 int led_controller_init(led_controller_t* ctrl, fpga_uio_dev_t* uio_dev, 
                        size_t led_offset, int num_leds, bool active_low) {
-    if (!ctrl || !uio_dev || num_leds <= 0) {
+    if (!ctrl || !uio_dev || num_leds <= 0 || num_leds > 32) {
         errno = EINVAL;
         return -1;
     }
 
+    if (fpga_uio_reg32(uio_dev, led_offset, &ctrl->led_reg) != 0) {
+        return -1;
+    }
+
     ctrl->uio_dev = uio_dev;
     ctrl->led_offset = led_offset;
     ctrl->num_leds = num_leds;
     ctrl->active_low = active_low;
     ctrl->should_stop = false;
 
-    // Initialize all LEDs to off
-    return led_controller_set_mask(ctrl, ctrl->active_low ? 0xFFFFFFFF : 0);
+    // Initialize all LEDs to off (forces a write regardless of the shadow)
+    ctrl->shadow = ~0U;
+    return led_controller_set_mask(ctrl, 0);
 }
 
-int led_controller_set_led(led_controller_t* ctrl, int led_index, bool state) {
+int led_controller_stage_led(led_controller_t* ctrl, int led_index, bool state) {
     if (!ctrl || led_index < 0 || led_index >= ctrl->num_leds) {
         errno = EINVAL;
         return -1;
     }
 
-    uint32_t current_mask;
-    if (fpga_uio_read32(ctrl->uio_dev, ctrl->led_offset, &current_mask) != 0) {
+    if (state) {
+        ctrl->staged |= (1U << led_index);
+    } else {
+        ctrl->staged &= ~(1U << led_index);
+    }
+    return 0;
+}
+
+int led_controller_stage_mask(led_controller_t* ctrl, uint32_t mask) {
+    if (!ctrl) {
+        errno = EINVAL;
         return -1;
     }
 
-    if (state ^ ctrl->active_low) {
-        current_mask |= (1 << led_index);
-    } else {
-        current_mask &= ~(1 << led_index);
+    ctrl->staged = mask & led_controller_bits(ctrl);
+    return 0;
+}
+
+int led_controller_commit(led_controller_t* ctrl) {
+    if (!ctrl || !ctrl->uio_dev) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (ctrl->staged == ctrl->shadow) {
+        return 0;
     }
 
-    return fpga_uio_write32(ctrl->uio_dev, ctrl->led_offset, current_mask);
+    // If active low, invert the mask; only the bits we need based on num_leds
+    uint32_t value = ctrl->active_low ? ~ctrl->staged : ctrl->staged;
+    fpga_reg32_write(ctrl->led_reg, value & led_controller_bits(ctrl));
+    ctrl->shadow = ctrl->staged;
+    return 0;
+}
+
+int led_controller_set_led(led_controller_t* ctrl, int led_index, bool state) {
+    if (led_controller_stage_led(ctrl, led_index, state) != 0) {
+        return -1;
+    }
+    return led_controller_commit(ctrl);
 }
 
 int led_controller_set_mask(led_controller_t* ctrl, uint32_t mask) {
-    if (!ctrl) {
+    if (led_controller_stage_mask(ctrl, mask) != 0) {
+        return -1;
+    }
+    return led_controller_commit(ctrl);
+}
+
+uint32_t led_controller_get_mask(const led_controller_t* ctrl) {
+    return ctrl ? ctrl->shadow : 0;
+}
+
+int led_controller_resync(led_controller_t* ctrl) {
+    if (!ctrl || !ctrl->uio_dev) {
         errno = EINVAL;
         return -1;
     }
 
-    // If active low, invert the mask
+    uint32_t value = fpga_reg32_read(ctrl->led_reg);
     if (ctrl->active_low) {
-        mask = ~mask;
+        value = ~value;
     }
-
-    // Only use the bits we need based on num_leds
-    mask &= ((1 << ctrl->num_leds) - 1);
-
-    return fpga_uio_write32(ctrl->uio_dev, ctrl->led_offset, mask);
+    ctrl->shadow = value & led_controller_bits(ctrl);
+    ctrl->staged = ctrl->shadow;
+    return 0;
 }
 
 int led_controller_run_animation(led_controller_t* ctrl, int num_cycles) {
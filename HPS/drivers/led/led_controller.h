@@ -2,14 +2,21 @@
 #define LED_CONTROLLER_H
 
 #include "fpga_uio.h"
+#include "fpga_uio_inline.h"
 #include <stdbool.h>
 #include <stddef.h>  // For size_t
 
+// The controller never reads the PIO register on the update path: the
+// current state lives in a shadow, changes are staged there and written
+// with a single store by led_controller_commit().
 typedef struct {
     fpga_uio_dev_t* uio_dev;
+    fpga_reg32_t led_reg;     // Validated once at init
     size_t led_offset;
     int num_leds;
     bool active_low;
+    uint32_t shadow;          // Logical mask (bit set = LED on) last written
+    uint32_t staged;          // Logical mask to write on the next commit
     volatile bool should_stop;
 } led_controller_t;
 
@@ -17,12 +24,28 @@ typedef struct {
 int led_controller_init(led_controller_t* ctrl, fpga_uio_dev_t* uio_dev, 
                        size_t led_offset, int num_leds, bool active_low);
 
-// Set specific LED state
+// Set specific LED state (stage + commit: one bus write, no read)
 int led_controller_set_led(led_controller_t* ctrl, int led_index, bool state);
 
-// Set all LEDs at once using a bit mask
+// Set all LEDs at once using a bit mask (stage + commit)
 int led_controller_set_mask(led_controller_t* ctrl, uint32_t mask);
 
+// Stage a single LED change in the shadow; no bus access
+int led_controller_stage_led(led_controller_t* ctrl, int led_index, bool state);
+
+// Stage a full mask in the shadow; no bus access
+int led_controller_stage_mask(led_controller_t* ctrl, uint32_t mask);
+
+// Write all staged changes with one bus write (none if nothing changed)
+int led_controller_commit(led_controller_t* ctrl);
+
+// Get the current logical mask from the shadow (bit set = LED on)
+uint32_t led_controller_get_mask(const led_controller_t* ctrl);
+
+// Re-read the hardware register into the shadow (only needed if something
+// else writes the PIO)
+int led_controller_resync(led_controller_t* ctrl);
+
 // Run the LED animation
 int led_controller_run_animation(led_controller_t* ctrl, int num_cycles);
 
@@ -0,0 +1,583 @@
+// ============================================================================
+// MMIO Emulation Shim - Implementation
+// ============================================================================
+// LD_PRELOAD library that lets unmodified /dev/mem programs run on an x86
+// host. open("/dev/mem") returns a placeholder descriptor. mmap() of a
+// window that covers the lightweight HPS-to-FPGA bridge returns ordinary
+// memory with the bridge part protected (PROT_NONE).
+//
+// Each load or store to the bridge faults. The SIGSEGV handler finds the
+// slave and register from the fault address, and the page-fault error code
+// says whether the access is a read or a write:
+//   read   the slave model is read and the value placed in the page, which
+//          is opened read-only
+//   write  the page is opened read-write and snapshotted
+// The handler then sets the trap flag, and the SIGTRAP taken after the
+// instruction forwards the words it stored to the slave and re-protects
+// the page. Every access is counted per register; the table is printed at
+// exit.
+//
+// Slaves (offsets in the bridge, overridable from the environment):
+//   calculator  CALCULATOR_0_BASE   calculator_model.c, or the Verilator
+//                                   co-simulation in COSIM=1 builds
+//   led_pio     0x00000             PIO register file (DATA, DIRECTION, ...)
+// Other offsets behave as plain memory and are counted as unmapped.
+//
+// Environment:
+//   MMIO_SHIM_CALCULATOR=0xNNNNN  calculator offset in the bridge
+//   MMIO_SHIM_LED_PIO=0xNNNNN     LED PIO offset (0x3000 for the GHRD examples)
+//   MMIO_SHIM_TRACE=1             print every access to stderr
+//   MMIO_SHIM_REPORT=path         write the access table to a file (stderr
+//                                 by default)
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "calculator_driver.h"
+#include "calculator_model.h"
+
+#if !defined(__x86_64__)
+#error "mmio_shim single-steps with the x86-64 trap flag"
+#endif
+
+// Only the interposed libc entry points are exported (-fvisibility=hidden)
+#define SHIM_EXPORT __attribute__((visibility("default")))
+
+// ============================================================================
+// Constants
+// ============================================================================
+#define SHIM_BRIDGE_BASE     0xFF200000ULL  // Lightweight HPS-to-FPGA bridge
+#define SHIM_BRIDGE_SPAN     0x00200000ULL
+#define SHIM_MAX_FDS         8
+#define SHIM_MAX_REGIONS     8
+#define SHIM_MAX_PAGE_SIZE   16384
+#define SHIM_UNMAPPED_SLOTS  64
+#define SHIM_MAX_SLAVE_REGS  32
+
+#define X86_EFLAGS_TF        0x100          // Trap after the next instruction
+#define X86_PF_WRITE         0x2            // Page-fault error code: write access
+
+// ============================================================================
+// Slaves
+// ============================================================================
+typedef struct {
+    const char *name;
+    uint32_t base;                          // Offset in the bridge
+    uint32_t span;                          // Bytes (at most 32 registers)
+    const char *const *reg_names;
+    uint32_t (*read)(uint32_t offset);
+    void (*write)(uint32_t offset, uint32_t value);
+    uint64_t reads[SHIM_MAX_SLAVE_REGS];
+    uint64_t writes[SHIM_MAX_SLAVE_REGS];
+} shim_slave_t;
+
+static const char *const calculator_reg_names[SHIM_MAX_SLAVE_REGS] = {
+    "CONTROL", "OPERAND_A", "OPERAND_B", "RESULT", "STATUS", "INT_ENABLE",
+    "BUFFER_CTRL", "BUFFER_WRITE", "BUFFER_COUNT", "EMA_ALPHA", "CONFIG_FLAGS",
+    "ERROR_CODE", "FIFO_STATUS", "FIFO_TAG", "FIFO_DATA", "VERSION",
+    "STATS_SMA", "STATS_STD_DEV", "STATS_MIN", "STATS_MAX", "STATS_BOLL_UP",
+    "STATS_BOLL_DN", "RESERVED", "RESERVED", "RESERVED", "RESERVED", "RESERVED",
+    "RESERVED", "RESERVED", "RESERVED", "RESERVED", "RESERVED"
+};
+
+static const char *const pio_reg_names[SHIM_MAX_SLAVE_REGS] = {
+    "DATA", "DIRECTION", "IRQ_MASK", "EDGE_CAPTURE"
+};
+
+// Avalon PIO: DATA drives the outputs, EDGE_CAPTURE is write-to-clear
+static uint32_t led_pio_regs[4];
+
+static uint32_t led_pio_read(uint32_t offset) {
+    return led_pio_regs[offset / 4];
+}
+
+static void led_pio_write(uint32_t offset, uint32_t value) {
+    if (offset == 0xC) {
+        led_pio_regs[3] &= ~value;
+    } else {
+        led_pio_regs[offset / 4] = value;
+    }
+}
+
+static shim_slave_t slaves[] = {
+    { "calculator", CALCULATOR_0_BASE, CALC_REG_SPAN, calculator_reg_names,
+      calculator_model_read, calculator_model_write, {0}, {0} },
+    { "led_pio", 0x00000, 0x10, pio_reg_names,
+      led_pio_read, led_pio_write, {0}, {0} },
+};
+
+#define NUM_SLAVES (sizeof(slaves) / sizeof(slaves[0]))
+
+// Offsets no slave claims: counted, served from the page like RAM
+typedef struct {
+    uint32_t offset;
+    uint64_t reads;
+    uint64_t writes;
+} shim_unmapped_t;
+
+static shim_unmapped_t unmapped[SHIM_UNMAPPED_SLOTS];
+static unsigned unmapped_used;
+static uint64_t unmapped_overflow;
+
+// ============================================================================
+// Mappings
+// ============================================================================
+typedef struct {
+    uint8_t *base;                          // What mmap() returned
+    size_t length;
+    uint8_t *bridge;                        // First emulated byte
+    size_t bridge_length;
+    uint32_t bridge_offset;                 // Its offset in the bridge
+} shim_region_t;
+
+static int devmem_fds[SHIM_MAX_FDS];
+static unsigned devmem_fd_count;
+static shim_region_t regions[SHIM_MAX_REGIONS];
+static size_t page_size;
+static bool initialized;
+static bool trace_accesses;
+
+// The access in flight between the SIGSEGV and the SIGTRAP; one at a time
+static int access_lock;
+static struct {
+    bool active;
+    bool write;
+    uint8_t *page;
+    uint32_t page_offset;                   // Bridge offset of the page
+    uint32_t word_offset;                   // Bridge offset of the faulting word
+    uint32_t snapshot[SHIM_MAX_PAGE_SIZE / 4];
+} pending;
+
+static struct sigaction previous_segv;
+static struct sigaction previous_trap;
+
+// ============================================================================
+// Real libc Entry Points
+// ============================================================================
+static int (*real_open)(const char *path, int flags, ...);
+static int (*real_openat)(int dirfd, const char *path, int flags, ...);
+static int (*real_close)(int fd);
+static void *(*real_mmap)(void *addr, size_t length, int prot, int flags, int fd, off_t offset);
+static int (*real_munmap)(void *addr, size_t length);
+
+static void shim_resolve(void) {
+    if (real_mmap != NULL) {
+        return;
+    }
+    real_open = dlsym(RTLD_NEXT, "open");
+    real_openat = dlsym(RTLD_NEXT, "openat");
+    real_close = dlsym(RTLD_NEXT, "close");
+    real_munmap = dlsym(RTLD_NEXT, "munmap");
+    real_mmap = dlsym(RTLD_NEXT, "mmap");
+}
+
+// ============================================================================
+// Register Dispatch
+// ============================================================================
+
+static shim_slave_t *shim_find_slave(uint32_t offset) {
+    for (size_t i = 0; i < NUM_SLAVES; i++) {
+        if (offset >= slaves[i].base && offset < slaves[i].base + slaves[i].span) {
+            return &slaves[i];
+        }
+    }
+    return NULL;
+}
+
+static shim_unmapped_t *shim_find_unmapped(uint32_t offset) {
+    for (unsigned i = 0; i < unmapped_used; i++) {
+        if (unmapped[i].offset == offset) {
+            return &unmapped[i];
+        }
+    }
+    if (unmapped_used == SHIM_UNMAPPED_SLOTS) {
+        unmapped_overflow++;
+        return NULL;
+    }
+    unmapped[unmapped_used].offset = offset;
+    return &unmapped[unmapped_used++];
+}
+
+static void shim_trace(char direction, uint32_t offset, uint32_t value) {
+    if (!trace_accesses) {
+        return;
+    }
+
+    shim_slave_t *slave = shim_find_slave(offset);
+    if (slave != NULL) {
+        fprintf(stderr, "mmio_shim: %c %s.%s = 0x%08X\n", direction, slave->name,
+                slave->reg_names[(offset - slave->base) / 4], value);
+    } else {
+        fprintf(stderr, "mmio_shim: %c 0x%05X = 0x%08X\n", direction, offset, value);
+    }
+}
+
+// Returns true when a slave supplied *value; false leaves the page content
+static bool shim_bus_read(uint32_t offset, uint32_t *value) {
+    shim_slave_t *slave = shim_find_slave(offset);
+
+    if (slave == NULL) {
+        shim_unmapped_t *entry = shim_find_unmapped(offset);
+        if (entry != NULL) {
+            entry->reads++;
+        }
+        return false;
+    }
+
+    uint32_t reg = offset - slave->base;
+    slave->reads[reg / 4]++;
+    *value = slave->read(reg);
+    return true;
+}
+
+static void shim_bus_write(uint32_t offset, uint32_t value) {
+    shim_slave_t *slave = shim_find_slave(offset);
+
+    shim_trace('W', offset, value);
+    if (slave == NULL) {
+        shim_unmapped_t *entry = shim_find_unmapped(offset);
+        if (entry != NULL) {
+            entry->writes++;
+        }
+        return;
+    }
+
+    uint32_t reg = offset - slave->base;
+    slave->writes[reg / 4]++;
+    slave->write(reg, value);
+}
+
+// ============================================================================
+// Fault Handling
+// ============================================================================
+
+static shim_region_t *shim_find_region(const uint8_t *address) {
+    for (int i = 0; i < SHIM_MAX_REGIONS; i++) {
+        shim_region_t *region = &regions[i];
+        if (region->bridge != NULL && address >= region->bridge &&
+            address < region->bridge + region->bridge_length) {
+            return region;
+        }
+    }
+    return NULL;
+}
+
+// Not ours: put the previous handler back and let the access fault again
+static void shim_pass_on(int signal, const struct sigaction *previous) {
+    sigaction(signal, previous, NULL);
+}
+
+static void shim_segv_handler(int signal, siginfo_t *info, void *context) {
+    ucontext_t *uc = context;
+    uint8_t *address = info->si_addr;
+    shim_region_t *region = shim_find_region(address);
+
+    if (region == NULL) {
+        shim_pass_on(signal, &previous_segv);
+        return;
+    }
+
+    while (__atomic_exchange_n(&access_lock, 1, __ATOMIC_ACQUIRE)) {
+        // Another thread is between its fault and its trap
+    }
+
+    uint8_t *page = (uint8_t *)((uintptr_t)address & ~(uintptr_t)(page_size - 1));
+    uint32_t page_offset = region->bridge_offset + (uint32_t)(page - region->bridge);
+    uint32_t word_offset = (region->bridge_offset + (uint32_t)(address - region->bridge)) & ~3u;
+    volatile uint32_t *word = (volatile uint32_t *)(page + (word_offset - page_offset));
+
+    pending.active = true;
+    pending.write = (uc->uc_mcontext.gregs[REG_ERR] & X86_PF_WRITE) != 0;
+    pending.page = page;
+    pending.page_offset = page_offset;
+    pending.word_offset = word_offset;
+
+    mprotect(page, page_size, PROT_READ | PROT_WRITE);
+    if (pending.write) {
+        memcpy(pending.snapshot, page, page_size);
+    } else {
+        uint32_t value;
+        if (shim_bus_read(word_offset, &value)) {
+            *word = value;
+        }
+        shim_trace('R', word_offset, *word);
+        mprotect(page, page_size, PROT_READ);
+    }
+
+    uc->uc_mcontext.gregs[REG_EFL] |= X86_EFLAGS_TF;
+}
+
+static void shim_trap_handler(int signal, siginfo_t *info, void *context) {
+    ucontext_t *uc = context;
+
+    if (!pending.active) {
+        shim_pass_on(signal, &previous_trap);
+        (void)info;
+        return;
+    }
+
+    uc->uc_mcontext.gregs[REG_EFL] &= ~X86_EFLAGS_TF;
+
+    if (pending.write) {
+        // Forward the faulting word (even if rewritten with the same value)
+        // and anything else the instruction stored, e.g. a vector store
+        const uint32_t *now = (const uint32_t *)pending.page;
+        for (size_t i = 0; i < page_size / 4; i++) {
+            uint32_t offset = pending.page_offset + (uint32_t)(i * 4);
+            if (now[i] != pending.snapshot[i] || offset == pending.word_offset) {
+                shim_bus_write(offset, now[i]);
+            }
+        }
+    }
+
+    mprotect(pending.page, page_size, PROT_NONE);
+    pending.active = false;
+    __atomic_store_n(&access_lock, 0, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// Setup and Report
+// ============================================================================
+
+static void shim_report(void);
+
+static uint32_t shim_env_offset(const char *name, uint32_t fallback) {
+    const char *value = getenv(name);
+    return value != NULL ? (uint32_t)strtoul(value, NULL, 0) : fallback;
+}
+
+static void shim_init(void) {
+    if (initialized) {
+        return;
+    }
+    initialized = true;
+
+    page_size = (size_t)sysconf(_SC_PAGESIZE);
+    if (page_size > SHIM_MAX_PAGE_SIZE) {
+        fprintf(stderr, "mmio_shim: page size %zu not supported\n", page_size);
+        abort();
+    }
+    trace_accesses = getenv("MMIO_SHIM_TRACE") != NULL;
+    slaves[0].base = shim_env_offset("MMIO_SHIM_CALCULATOR", slaves[0].base);
+    slaves[1].base = shim_env_offset("MMIO_SHIM_LED_PIO", slaves[1].base);
+
+    calculator_model_reset();
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    action.sa_sigaction = shim_segv_handler;
+    sigaction(SIGSEGV, &action, &previous_segv);
+    action.sa_sigaction = shim_trap_handler;
+    sigaction(SIGTRAP, &action, &previous_trap);
+
+    atexit(shim_report);
+}
+
+static void shim_report(void) {
+    const char *path = getenv("MMIO_SHIM_REPORT");
+    FILE *out = path != NULL ? fopen(path, "w") : NULL;
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+
+    if (out == NULL) {
+        out = stderr;
+    }
+
+    for (size_t i = 0; i < NUM_SLAVES; i++) {
+        for (int r = 0; r < SHIM_MAX_SLAVE_REGS; r++) {
+            reads += slaves[i].reads[r];
+            writes += slaves[i].writes[r];
+        }
+    }
+    for (unsigned i = 0; i < unmapped_used; i++) {
+        reads += unmapped[i].reads;
+        writes += unmapped[i].writes;
+    }
+
+    fprintf(out, "\nmmio_shim: %llu reads, %llu writes on the lightweight bridge\n",
+            (unsigned long long)reads, (unsigned long long)writes);
+    fprintf(out, "  %-12s %8s  %-14s %10s %10s\n", "slave", "offset", "register", "reads", "writes");
+
+    for (size_t i = 0; i < NUM_SLAVES; i++) {
+        const shim_slave_t *slave = &slaves[i];
+        for (uint32_t r = 0; r < slave->span / 4; r++) {
+            if (slave->reads[r] == 0 && slave->writes[r] == 0) {
+                continue;
+            }
+            fprintf(out, "  %-12s 0x%06X  %-14s %10llu %10llu\n", slave->name, slave->base + r * 4,
+                    slave->reg_names[r], (unsigned long long)slave->reads[r],
+                    (unsigned long long)slave->writes[r]);
+        }
+    }
+    for (unsigned i = 0; i < unmapped_used; i++) {
+        fprintf(out, "  %-12s 0x%06X  %-14s %10llu %10llu\n", "(unmapped)", unmapped[i].offset, "",
+                (unsigned long long)unmapped[i].reads, (unsigned long long)unmapped[i].writes);
+    }
+    if (unmapped_overflow != 0) {
+        fprintf(out, "  %llu more unmapped accesses not itemised\n", (unsigned long long)unmapped_overflow);
+    }
+
+    if (out != stderr) {
+        fclose(out);
+    }
+}
+
+// ============================================================================
+// /dev/mem Descriptors
+// ============================================================================
+
+static bool shim_is_devmem_fd(int fd) {
+    for (unsigned i = 0; i < devmem_fd_count; i++) {
+        if (devmem_fds[i] == fd) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// A real descriptor (on /dev/null) so close(), fcntl() and dup() behave
+static int shim_open_devmem(int flags) {
+    shim_resolve();
+    if (devmem_fd_count == SHIM_MAX_FDS) {
+        errno = EMFILE;
+        return -1;
+    }
+
+    int fd = real_open("/dev/null", O_RDWR | (flags & O_CLOEXEC));
+    if (fd >= 0) {
+        devmem_fds[devmem_fd_count++] = fd;
+    }
+    return fd;
+}
+
+static int shim_open_common(const char *path, int flags, mode_t mode, int dirfd, bool at) {
+    shim_resolve();
+    if (path != NULL && strcmp(path, "/dev/mem") == 0) {
+        return shim_open_devmem(flags);
+    }
+    return at ? real_openat(dirfd, path, flags, mode) : real_open(path, flags, mode);
+}
+
+static mode_t shim_open_mode(int flags, va_list args) {
+    return (flags & (O_CREAT | O_TMPFILE)) != 0 ? (mode_t)va_arg(args, int) : 0;
+}
+
+SHIM_EXPORT int open(const char *path, int flags, ...) {
+    va_list args;
+    va_start(args, flags);
+    mode_t mode = shim_open_mode(flags, args);
+    va_end(args);
+    return shim_open_common(path, flags, mode, AT_FDCWD, false);
+}
+
+SHIM_EXPORT int open64(const char *path, int flags, ...) {
+    va_list args;
+    va_start(args, flags);
+    mode_t mode = shim_open_mode(flags, args);
+    va_end(args);
+    return shim_open_common(path, flags, mode, AT_FDCWD, false);
+}
+
+SHIM_EXPORT int openat(int dirfd, const char *path, int flags, ...) {
+    va_list args;
+    va_start(args, flags);
+    mode_t mode = shim_open_mode(flags, args);
+    va_end(args);
+    return shim_open_common(path, flags, mode, dirfd, true);
+}
+
+// _FORTIFY_SOURCE builds call these when the flags are not constant
+SHIM_EXPORT int __open_2(const char *path, int flags) {
+    return shim_open_common(path, flags, 0, AT_FDCWD, false);
+}
+
+SHIM_EXPORT int __open64_2(const char *path, int flags) {
+    return shim_open_common(path, flags, 0, AT_FDCWD, false);
+}
+
+SHIM_EXPORT int close(int fd) {
+    shim_resolve();
+    for (unsigned i = 0; i < devmem_fd_count; i++) {
+        if (devmem_fds[i] == fd) {
+            devmem_fds[i] = devmem_fds[--devmem_fd_count];
+            break;
+        }
+    }
+    return real_close(fd);
+}
+
+// ============================================================================
+// Mapping
+// ============================================================================
+
+// Anonymous memory for the whole window; the part over the bridge traps
+static void *shim_map_devmem(size_t length, off_t offset) {
+    uint64_t start = (uint64_t)offset;
+    uint64_t end = start + length;
+    uint64_t overlap_start = start > SHIM_BRIDGE_BASE ? start : SHIM_BRIDGE_BASE;
+    uint64_t overlap_end = end < SHIM_BRIDGE_BASE + SHIM_BRIDGE_SPAN ? end : SHIM_BRIDGE_BASE + SHIM_BRIDGE_SPAN;
+
+    uint8_t *base = real_mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED || overlap_start >= overlap_end) {
+        return base;   // Nothing emulated (e.g. the full HPS-to-FPGA bridge)
+    }
+
+    shim_init();
+
+    shim_region_t *region = NULL;
+    for (int i = 0; i < SHIM_MAX_REGIONS; i++) {
+        if (regions[i].base == NULL) {
+            region = &regions[i];
+            break;
+        }
+    }
+    if (region == NULL) {
+        real_munmap(base, length);
+        errno = ENOMEM;
+        return MAP_FAILED;
+    }
+
+    region->base = base;
+    region->length = length;
+    region->bridge = base + (overlap_start - start);
+    region->bridge_length = overlap_end - overlap_start;
+    region->bridge_offset = (uint32_t)(overlap_start - SHIM_BRIDGE_BASE);
+    mprotect(region->bridge, region->bridge_length, PROT_NONE);
+    return base;
+}
+
+SHIM_EXPORT void *mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset) {
+    shim_resolve();
+    if (!shim_is_devmem_fd(fd)) {
+        return real_mmap(addr, length, prot, flags, fd, offset);
+    }
+    return shim_map_devmem(length, offset);
+}
+
+SHIM_EXPORT void *mmap64(void *addr, size_t length, int prot, int flags, int fd, off_t offset) {
+    return mmap(addr, length, prot, flags, fd, offset);
+}
+
+SHIM_EXPORT int munmap(void *addr, size_t length) {
+    shim_resolve();
+    for (int i = 0; i < SHIM_MAX_REGIONS; i++) {
+        if (regions[i].base == addr) {
+            memset(&regions[i], 0, sizeof(regions[i]));
+            break;
+        }
+    }
+    return real_munmap(addr, length);
+}
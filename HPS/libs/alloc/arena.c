@@ -0,0 +1,48 @@
+// ============================================================================
+// Per-Batch Bump Arena - Implementation
+// ============================================================================
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "arena.h"
+
+int arena_init(arena_t *arena, const char *name, size_t size) {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    memset(arena, 0, sizeof(*arena));
+    arena->name = name;
+    arena->size = (size + page_size - 1) & ~(page_size - 1);
+    if (arena->size == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    void *base = mmap(NULL, arena->size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "arena %s: mmap %zu bytes: %s\n", name, arena->size, strerror(errno));
+        return -1;
+    }
+    arena->base = base;
+    return 0;
+}
+
+void arena_destroy(arena_t *arena) {
+    if (arena->base != NULL) {
+        munmap(arena->base, arena->size);
+    }
+    memset(arena, 0, sizeof(*arena));
+}
+
+void arena_print_stats(const arena_t *arena, FILE *output) {
+    size_t high_water = arena->offset > arena->high_water ? arena->offset : arena->high_water;
+
+    fprintf(output, "arena %-11s %zu B, high water %zu B, %llu batches, %llu allocs "
+            "(%.1f per batch), %llu failed\n",
+            arena->name, arena->size, high_water, (unsigned long long)arena->resets,
+            (unsigned long long)arena->allocs,
+            arena->resets ? (double)arena->allocs / (double)arena->resets : 0.0,
+            (unsigned long long)arena->failures);
+}
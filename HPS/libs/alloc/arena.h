@@ -0,0 +1,102 @@
+// ============================================================================
+// Per-Batch Bump Arena - Header
+// ============================================================================
+// Scratch memory for everything a pipeline stage creates while handling one
+// batch (decoded ticks, derived events), released all at once at the end
+// of the batch
+//
+// Allocation is an add and a compare. There is no per-object free:
+// arena_reset() rewinds the offset, so a batch's objects cost nothing to
+// release. The buffer is mmap()ed and pre-faulted once at init.
+// One arena belongs to one thread.
+// ============================================================================
+
+#ifndef HPS_ARENA_H
+#define HPS_ARENA_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define ARENA_DEFAULT_ALIGN  16
+
+// ============================================================================
+// Arena
+// ============================================================================
+typedef struct {
+    const char *name;
+    uint8_t *base;
+    size_t size;
+    size_t offset;           // Bytes handed out since the last reset
+    size_t high_water;       // Largest offset ever reached
+    uint64_t allocs;         // Allocation-rate counters
+    uint64_t bytes;
+    uint64_t resets;         // Batches
+    uint64_t failures;       // Allocations that did not fit
+} arena_t;
+
+/**
+ * Map and pre-fault an arena of size bytes (rounded up to whole pages)
+ *
+ * @param arena Arena to initialize
+ * @param name  Label for reports (must stay valid)
+ * @param size  Capacity in bytes; size it for the largest batch
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int arena_init(arena_t *arena, const char *name, size_t size);
+
+/**
+ * Unmap the arena
+ */
+void arena_destroy(arena_t *arena);
+
+/**
+ * Print capacity, high water and the allocation counters
+ */
+void arena_print_stats(const arena_t *arena, FILE *output);
+
+// ============================================================================
+// Hot Path (inline)
+// ============================================================================
+
+/**
+ * Allocate size bytes aligned to align (a power of two, at most a page)
+ *
+ * Returns: Pointer, or NULL if the batch outgrew the arena
+ */
+static inline void *arena_alloc_aligned(arena_t *arena, size_t size, size_t align) {
+    size_t start = (arena->offset + align - 1) & ~(align - 1);
+
+    if (__builtin_expect(start + size > arena->size, 0)) {
+        arena->failures++;
+        return NULL;
+    }
+    arena->offset = start + size;
+    arena->allocs++;
+    arena->bytes += size;
+    return arena->base + start;
+}
+
+/**
+ * Allocate size bytes aligned to ARENA_DEFAULT_ALIGN
+ */
+static inline void *arena_alloc(arena_t *arena, size_t size) {
+    return arena_alloc_aligned(arena, size, ARENA_DEFAULT_ALIGN);
+}
+
+/**
+ * Release everything allocated since the last reset (end of batch)
+ */
+static inline void arena_reset(arena_t *arena) {
+    if (arena->offset > arena->high_water) {
+        arena->high_water = arena->offset;
+    }
+    arena->offset = 0;
+    arena->resets++;
+}
+
+#endif // HPS_ARENA_H
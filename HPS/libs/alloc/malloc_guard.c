@@ -0,0 +1,145 @@
+// ============================================================================
+// System Allocator Guard - Implementation
+// ============================================================================
+// Interposes the glibc allocator entry points and forwards them to the
+// __libc_* implementations; only linked into MALLOC_GUARD builds
+// ============================================================================
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include "malloc_guard.h"
+
+#ifdef MALLOC_GUARD
+
+// glibc's own entry points (exported for exactly this purpose)
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *ptr);
+
+// ============================================================================
+// State
+// ============================================================================
+static __thread int guard_armed;
+static uint64_t guard_violations;
+static int guard_fatal;
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+// Async-signal-safe and allocation-free: formats with write() only
+static void guard_write_hex(char *buffer, uintptr_t value) {
+    static const char digits[] = "0123456789abcdef";
+
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    for (int i = 0; i < (int)(2 * sizeof(value)); i++) {
+        buffer[2 + i] = digits[(value >> (4 * (2 * sizeof(value) - 1 - i))) & 0xF];
+    }
+    buffer[2 + 2 * sizeof(value)] = '\0';
+}
+
+static void guard_violation(const char *function, void *caller) {
+    uint64_t count = __atomic_add_fetch(&guard_violations, 1, __ATOMIC_RELAXED);
+
+    if (count == 1 || guard_fatal) {
+        char address[2 + 2 * sizeof(uintptr_t) + 1];
+        guard_write_hex(address, (uintptr_t)caller);
+
+        // Best effort: a short write only shortens the message
+        int saved_errno = errno;
+        ssize_t written = write(STDERR_FILENO, "malloc_guard: ", 14);
+        written += write(STDERR_FILENO, function, strlen(function));
+        written += write(STDERR_FILENO, "() on an armed hot path, called from ", 37);
+        written += write(STDERR_FILENO, address, strlen(address));
+        written += write(STDERR_FILENO, "\n", 1);
+        (void)written;
+        errno = saved_errno;
+    }
+    if (guard_fatal) {
+        guard_armed = 0;
+        abort();
+    }
+}
+
+#define GUARD_CHECK(function)                                   \
+    do {                                                        \
+        if (__builtin_expect(guard_armed, 0)) {                 \
+            guard_violation(function, __builtin_return_address(0)); \
+        }                                                       \
+    } while (0)
+
+// ============================================================================
+// Control
+// ============================================================================
+
+void malloc_guard_arm(void) {
+    guard_armed = 1;
+}
+
+void malloc_guard_disarm(void) {
+    guard_armed = 0;
+}
+
+void malloc_guard_set_fatal(bool fatal) {
+    __atomic_store_n(&guard_fatal, fatal ? 1 : 0, __ATOMIC_RELAXED);
+}
+
+uint64_t malloc_guard_violations(void) {
+    return __atomic_load_n(&guard_violations, __ATOMIC_RELAXED);
+}
+
+// ============================================================================
+// Interposed Allocator
+// ============================================================================
+
+void *malloc(size_t size) {
+    GUARD_CHECK("malloc");
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    GUARD_CHECK("calloc");
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    GUARD_CHECK("realloc");
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    if (ptr != NULL) {
+        GUARD_CHECK("free");
+    }
+    __libc_free(ptr);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    GUARD_CHECK("memalign");
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    GUARD_CHECK("aligned_alloc");
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size) {
+    GUARD_CHECK("posix_memalign");
+    if (alignment < sizeof(void *) || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void *result = __libc_memalign(alignment, size);
+    if (result == NULL) {
+        return ENOMEM;
+    }
+    *ptr = result;
+    return 0;
+}
+
+#endif // MALLOC_GUARD
@@ -0,0 +1,63 @@
+// ============================================================================
+// System Allocator Guard - Header
+// ============================================================================
+// Test mode that catches the hot path calling malloc/free
+//
+// Built with -DMALLOC_GUARD and malloc_guard.o linked in, the program's
+// malloc, calloc, realloc, free and the aligned variants are interposed.
+// They still forward to glibc, but a call made while the calling thread
+// is armed counts as a violation. The first violation is reported with
+// its caller's address (resolve it with addr2line), and in fatal mode the
+// program aborts there so the core dump shows the whole stack.
+//
+// Without MALLOC_GUARD every function below is an empty inline stub, so
+// release builds carry no interposer and pay nothing.
+// ============================================================================
+
+#ifndef HPS_MALLOC_GUARD_H
+#define HPS_MALLOC_GUARD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef MALLOC_GUARD
+
+/**
+ * Treat every system allocator call by the calling thread as a violation
+ * (enter the hot path)
+ */
+void malloc_guard_arm(void);
+
+/**
+ * Stop checking the calling thread (leave the hot path)
+ */
+void malloc_guard_disarm(void);
+
+/**
+ * abort() at the first violation instead of only counting it
+ */
+void malloc_guard_set_fatal(bool fatal);
+
+/**
+ * Violations so far, all threads
+ */
+uint64_t malloc_guard_violations(void);
+
+/**
+ * true when the guard is compiled in
+ */
+static inline bool malloc_guard_enabled(void) {
+    return true;
+}
+
+#else
+
+static inline void malloc_guard_arm(void) {}
+static inline void malloc_guard_disarm(void) {}
+static inline void malloc_guard_set_fatal(bool fatal) { (void)fatal; }
+static inline uint64_t malloc_guard_violations(void) { return 0; }
+static inline bool malloc_guard_enabled(void) { return false; }
+
+#endif // MALLOC_GUARD
+
+#endif // HPS_MALLOC_GUARD_H
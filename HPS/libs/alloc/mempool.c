@@ -0,0 +1,183 @@
+// ============================================================================
+// Fixed-Size Object Pool - Implementation
+// ============================================================================
+// mmap()ed slab, shared free list under a spinlock, per-thread caches
+// ============================================================================
+
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include "mempool.h"
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static inline void cpu_relax(void) {
+#if defined(__arm__) || defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+// Held only while moving one batch of pointers, so spinning is cheaper
+// than a futex round trip
+static void pool_lock(mempool_t *pool) {
+    while (__atomic_exchange_n(&pool->lock, 1, __ATOMIC_ACQUIRE) != 0) {
+        while (__atomic_load_n(&pool->lock, __ATOMIC_RELAXED) != 0) {
+            cpu_relax();
+        }
+    }
+}
+
+static void pool_unlock(mempool_t *pool) {
+    __atomic_store_n(&pool->lock, 0, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// Pool
+// ============================================================================
+
+int mempool_init(mempool_t *pool, const char *name, size_t object_size, uint32_t capacity) {
+    memset(pool, 0, sizeof(*pool));
+    if (object_size == 0 || capacity == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    pool->name = name;
+    pool->object_size = (object_size + MEMPOOL_CACHE_LINE - 1) & ~(size_t)(MEMPOOL_CACHE_LINE - 1);
+    pool->capacity = capacity;
+    pool->slab_size = pool->object_size * capacity;
+
+    // Page-aligned, so every object starts on a cache line
+    void *slab = mmap(NULL, pool->slab_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (slab == MAP_FAILED) {
+        fprintf(stderr, "mempool %s: mmap %zu bytes: %s\n", name, pool->slab_size, strerror(errno));
+        return -1;
+    }
+    pool->slab = slab;
+
+    // Thread the free list in address order so a fresh cache hands out
+    // neighbouring objects
+    for (uint32_t i = capacity; i > 0; i--) {
+        mempool_object_t *object = (mempool_object_t *)(pool->slab + (size_t)(i - 1) * pool->object_size);
+        object->next = pool->free_list;
+        pool->free_list = object;
+    }
+    pool->free_count = capacity;
+    pool->low_water = capacity;
+    return 0;
+}
+
+void mempool_destroy(mempool_t *pool) {
+    if (pool->slab != NULL) {
+        munmap(pool->slab, pool->slab_size);
+    }
+    memset(pool, 0, sizeof(*pool));
+}
+
+bool mempool_owns(const mempool_t *pool, const void *ptr) {
+    const uint8_t *p = (const uint8_t *)ptr;
+
+    return p >= pool->slab && p < pool->slab + pool->slab_size &&
+           (size_t)(p - pool->slab) % pool->object_size == 0;
+}
+
+// ============================================================================
+// Per-Thread Cache
+// ============================================================================
+
+void mempool_cache_init(mempool_cache_t *cache, mempool_t *pool) {
+    memset(cache, 0, sizeof(*cache));
+    cache->pool = pool;
+}
+
+int mempool_cache_refill(mempool_cache_t *cache) {
+    mempool_t *pool = cache->pool;
+    mempool_object_t *head;
+    mempool_object_t *tail;
+    uint32_t taken = 0;
+
+    pool_lock(pool);
+    head = pool->free_list;
+    tail = NULL;
+    for (mempool_object_t *object = head; object != NULL && taken < MEMPOOL_BATCH; object = object->next) {
+        tail = object;
+        taken++;
+    }
+    if (taken > 0) {
+        pool->free_list = tail->next;
+        pool->free_count -= taken;
+        if (pool->free_count < pool->low_water) {
+            pool->low_water = pool->free_count;
+        }
+    }
+    pool_unlock(pool);
+
+    if (taken == 0) {
+        return -1;
+    }
+    tail->next = cache->free_list;
+    cache->free_list = head;
+    cache->count += taken;
+    cache->refills++;
+    return 0;
+}
+
+void mempool_cache_drain(mempool_cache_t *cache) {
+    mempool_t *pool = cache->pool;
+    mempool_object_t *head = cache->free_list;
+    mempool_object_t *tail = head;
+    uint32_t moved = 1;
+
+    if (head == NULL) {
+        return;
+    }
+    // Detach the first MEMPOOL_BATCH objects outside the lock
+    while (moved < MEMPOOL_BATCH && tail->next != NULL) {
+        tail = tail->next;
+        moved++;
+    }
+    cache->free_list = tail->next;
+    cache->count -= moved;
+    cache->drains++;
+
+    pool_lock(pool);
+    tail->next = pool->free_list;
+    pool->free_list = head;
+    pool->free_count += moved;
+    pool_unlock(pool);
+}
+
+void mempool_cache_flush(mempool_cache_t *cache) {
+    mempool_t *pool = cache->pool;
+
+    while (cache->free_list != NULL) {
+        mempool_cache_drain(cache);
+    }
+
+    pool_lock(pool);
+    pool->allocs += cache->allocs;
+    pool->frees += cache->frees;
+    pool->failures += cache->failures;
+    pool_unlock(pool);
+
+    cache->allocs = cache->frees = cache->failures = 0;
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+void mempool_print_stats(const mempool_t *pool, FILE *output) {
+    fprintf(output, "pool %-12s %u x %zu B, %u free, low water %u, "
+            "%llu allocs, %llu frees, %llu failed\n",
+            pool->name, pool->capacity, pool->object_size, pool->free_count, pool->low_water,
+            (unsigned long long)pool->allocs, (unsigned long long)pool->frees,
+            (unsigned long long)pool->failures);
+}
@@ -0,0 +1,162 @@
+// ============================================================================
+// Fixed-Size Object Pool - Header
+// ============================================================================
+// Preallocated, cache-line-aligned slabs of equal-sized objects for per-tick
+// data (decoded messages, book updates, signal events)
+//
+// glibc malloc takes an arena lock on every call and fragments under
+// mixed sizes; on the A9 both show up as multi-microsecond outliers.
+// A pool is one mmap()ed slab carved into objects at creation time. Each
+// thread allocates and frees through its own mempool_cache_t, a plain
+// singly linked free list with no atomics. Only when a cache runs empty or
+// grows past twice MEMPOOL_BATCH does it move MEMPOOL_BATCH objects to or
+// from the shared list, under a spinlock. Objects may be freed on a
+// different thread from the one that allocated them (decode thread
+// allocates, strategy thread frees); they simply migrate between caches.
+// ============================================================================
+
+#ifndef HPS_MEMPOOL_H
+#define HPS_MEMPOOL_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define MEMPOOL_CACHE_LINE   64
+#define MEMPOOL_BATCH        32      // Objects moved between a cache and the pool at once
+
+// ============================================================================
+// Pool and Per-Thread Cache
+// ============================================================================
+typedef struct mempool_object {
+    struct mempool_object *next;
+} mempool_object_t;
+
+typedef struct {
+    const char *name;
+    size_t object_size;              // Requested size rounded up to MEMPOOL_CACHE_LINE
+    uint32_t capacity;               // Objects in the slab
+    uint8_t *slab;
+    size_t slab_size;
+
+    // Shared free list (refills and drains only)
+    int lock;
+    mempool_object_t *free_list;
+    uint32_t free_count;
+    uint32_t low_water;              // Fewest objects ever left on the shared list
+
+    // Totals folded in from caches by mempool_cache_flush()
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t failures;
+} mempool_t;
+
+typedef struct {
+    mempool_t *pool;
+    mempool_object_t *free_list;
+    uint32_t count;                  // Objects on free_list
+    uint64_t allocs;                 // Allocation-rate counters (owner thread only)
+    uint64_t frees;
+    uint64_t failures;               // Pool exhausted
+    uint64_t refills;                // Batches taken from the shared list
+    uint64_t drains;                 // Batches returned to it
+} mempool_cache_t;
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+/**
+ * Create a pool of capacity objects of object_size bytes
+ *
+ * The slab is mmap()ed and pre-faulted; nothing goes through malloc.
+ *
+ * @param pool        Pool to initialize
+ * @param name        Label for reports (must stay valid)
+ * @param object_size Bytes per object (rounded up to a cache line)
+ * @param capacity    Number of objects
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int mempool_init(mempool_t *pool, const char *name, size_t object_size, uint32_t capacity);
+
+/**
+ * Unmap the slab (all caches must have been flushed)
+ */
+void mempool_destroy(mempool_t *pool);
+
+/**
+ * Attach a per-thread cache to a pool (the cache starts empty)
+ */
+void mempool_cache_init(mempool_cache_t *cache, mempool_t *pool);
+
+/**
+ * Move up to MEMPOOL_BATCH objects from the shared list into the cache
+ *
+ * Returns: 0 on success, -1 if the pool is exhausted
+ */
+int mempool_cache_refill(mempool_cache_t *cache);
+
+/**
+ * Return MEMPOOL_BATCH objects from the cache to the shared list
+ */
+void mempool_cache_drain(mempool_cache_t *cache);
+
+/**
+ * Return every cached object to the pool and fold the cache's counters
+ * into the pool totals (call when the thread is done)
+ */
+void mempool_cache_flush(mempool_cache_t *cache);
+
+/**
+ * true if ptr is an object of this pool
+ */
+bool mempool_owns(const mempool_t *pool, const void *ptr);
+
+/**
+ * Print capacity, objects in use, low water and the flushed totals
+ */
+void mempool_print_stats(const mempool_t *pool, FILE *output);
+
+// ============================================================================
+// Hot Path (inline)
+// ============================================================================
+
+/**
+ * Take one object (cache-line aligned, contents undefined)
+ *
+ * Returns: Object, or NULL if the pool is exhausted
+ */
+static inline void *mempool_alloc(mempool_cache_t *cache) {
+    if (__builtin_expect(cache->free_list == NULL, 0) && mempool_cache_refill(cache) != 0) {
+        cache->failures++;
+        return NULL;
+    }
+
+    mempool_object_t *object = cache->free_list;
+    cache->free_list = object->next;
+    cache->count--;
+    cache->allocs++;
+    return object;
+}
+
+/**
+ * Give an object back (any thread's cache, as long as it is the same pool)
+ */
+static inline void mempool_free(mempool_cache_t *cache, void *ptr) {
+    mempool_object_t *object = (mempool_object_t *)ptr;
+
+    object->next = cache->free_list;
+    cache->free_list = object;
+    cache->count++;
+    cache->frees++;
+    if (__builtin_expect(cache->count > 2 * MEMPOOL_BATCH, 0)) {
+        mempool_cache_drain(cache);
+    }
+}
+
+#endif // HPS_MEMPOOL_H
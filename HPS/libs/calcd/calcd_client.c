@@ -0,0 +1,231 @@
+// ============================================================================
+// Calculator Broker Client - Implementation
+// ============================================================================
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "calcd_client.h"
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static inline void cpu_relax(void) {
+#if defined(__arm__) || defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+static uint64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
+}
+
+static bool daemon_alive(const calcd_client_t *client) {
+    pid_t pid = (pid_t)__atomic_load_n(&client->shm->header.daemon_pid, __ATOMIC_RELAXED);
+    return __atomic_load_n(&client->shm->header.magic, __ATOMIC_ACQUIRE) == CALCD_MAGIC &&
+           (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+// Spin-wait helper: true while the deadline has not passed and the daemon
+// is alive (both checked only every 1024 spins to keep syscalls rare; the
+// yield matters only when the client shares a core with the daemon)
+static bool keep_waiting(const calcd_client_t *client, uint32_t *spins, uint64_t deadline_ms) {
+    cpu_relax();
+    if ((++*spins & 1023) != 0) {
+        return true;
+    }
+    sched_yield();
+    if (now_ms() >= deadline_ms) {
+        errno = ETIMEDOUT;
+        return false;
+    }
+    if (!daemon_alive(client)) {
+        errno = EPIPE;
+        return false;
+    }
+    return true;
+}
+
+// Submit, retrying while the ring is full
+static int submit_blocking(calcd_client_t *client, calcd_request_t *request) {
+    uint64_t deadline_ms = now_ms() + client->timeout_ms;
+    uint32_t spins = 0;
+
+    while (calcd_client_submit(client, request) != 0) {
+        if (!keep_waiting(client, &spins, deadline_ms)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// Connection
+// ============================================================================
+int calcd_client_open(calcd_client_t *client, const char *name) {
+    memset(client, 0, sizeof(*client));
+    client->timeout_ms = CALCD_DEFAULT_TIMEOUT_MS;
+    if (name == NULL) {
+        name = CALCD_DEFAULT_NAME;
+    }
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        fprintf(stderr, "calcd_client: %s: %s (is calcd running?)\n", name, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(calcd_shm_t)) {
+        fprintf(stderr, "calcd_client: %s: segment too small\n", name);
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, sizeof(calcd_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "calcd_client: mmap: %s\n", strerror(errno));
+        return -1;
+    }
+    client->shm = (calcd_shm_t *)map;
+
+    if (!daemon_alive(client) || client->shm->header.version != CALCD_VERSION) {
+        fprintf(stderr, "calcd_client: %s: daemon not running or version mismatch\n", name);
+        calcd_client_close(client);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < CALCD_MAX_CLIENTS; i++) {
+        calcd_slot_t *slot = &client->shm->slots[i];
+        uint32_t expected = CALCD_SLOT_FREE;
+
+        if (!__atomic_compare_exchange_n(&slot->control.state, &expected, CALCD_SLOT_CLAIMED,
+                                         false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            continue;
+        }
+
+        // The daemon ignores CLAIMED slots, so the rings are ours to reset
+        calcd_request_reset(&slot->requests);
+        calcd_response_reset(&slot->responses);
+        slot->control.pid = (uint32_t)getpid();
+        slot->control.generation++;
+        __atomic_store_n(&slot->control.state, CALCD_SLOT_ACTIVE, __ATOMIC_RELEASE);
+
+        client->slot = slot;
+        return 0;
+    }
+
+    fprintf(stderr, "calcd_client: all %d client slots are in use\n", CALCD_MAX_CLIENTS);
+    calcd_client_close(client);
+    return -1;
+}
+
+void calcd_client_close(calcd_client_t *client) {
+    if (client->slot != NULL) {
+        __atomic_store_n(&client->slot->control.state, CALCD_SLOT_CLOSING, __ATOMIC_RELEASE);
+        client->slot = NULL;
+    }
+    if (client->shm != NULL) {
+        munmap(client->shm, sizeof(calcd_shm_t));
+        client->shm = NULL;
+    }
+}
+
+// ============================================================================
+// Asynchronous Interface
+// ============================================================================
+int calcd_client_submit(calcd_client_t *client, calcd_request_t *request) {
+    request->tag = client->next_tag;
+    if (!calcd_request_push(&client->slot->requests, request)) {
+        errno = EAGAIN;
+        return -1;
+    }
+    client->next_tag++;
+    return 0;
+}
+
+int calcd_client_poll(calcd_client_t *client, calcd_response_t *response) {
+    return calcd_response_pop(&client->slot->responses, response) ? 1 : 0;
+}
+
+// ============================================================================
+// Blocking Interface
+// ============================================================================
+int calcd_perform_operation(calcd_client_t *client, calculator_operation_t op,
+                            float operand_a, float operand_b, float *result) {
+    calcd_request_t request;
+    calcd_response_t response;
+
+    memset(&request, 0, sizeof(request));
+    request.type = CALCD_REQ_OPERATION;
+    request.op = (uint32_t)op;
+    request.operand_a = operand_a;
+    request.operand_b = operand_b;
+    if (submit_blocking(client, &request) != 0) {
+        return -1;
+    }
+
+    uint64_t deadline_ms = now_ms() + client->timeout_ms;
+    uint32_t spins = 0;
+    for (;;) {
+        if (calcd_client_poll(client, &response)) {
+            if (response.tag == request.tag) {
+                break;
+            }
+            // Anything else is a failed posted request
+            client->posted_errors++;
+            client->last_error_code = response.error_code;
+            continue;
+        }
+        if (!keep_waiting(client, &spins, deadline_ms)) {
+            return -1;
+        }
+    }
+
+    if (response.status != 0) {
+        client->last_error_code = response.error_code;
+        return -1;
+    }
+    *result = response.result;
+    return 0;
+}
+
+int calcd_buffer_reset(calcd_client_t *client, uint16_t window_size) {
+    calcd_request_t request;
+
+    memset(&request, 0, sizeof(request));
+    request.type = CALCD_REQ_BUFFER_RESET;
+    request.operand_b = (float)window_size;
+    request.flags = CALCD_FLAG_POSTED;
+    return submit_blocking(client, &request);
+}
+
+int calcd_buffer_write_price(calcd_client_t *client, float price) {
+    calcd_request_t request;
+
+    memset(&request, 0, sizeof(request));
+    request.type = CALCD_REQ_BUFFER_PRICE;
+    request.operand_a = price;
+    request.flags = CALCD_FLAG_POSTED;
+    return submit_blocking(client, &request);
+}
+
+int calcd_ema(calcd_client_t *client, float price, float alpha, float *result) {
+    // The daemon appends the price and runs the EMA update, as calculator_ema() does
+    return calcd_perform_operation(client, CALC_OP_EMA, price, alpha, result);
+}
@@ -0,0 +1,111 @@
+// ============================================================================
+// Calculator Broker Client - Header
+// ============================================================================
+// Client side of calcd: submit calculator requests through a shared-memory
+// ring instead of mapping /dev/mem
+//
+// Each client owns a private price buffer inside the daemon, so several
+// processes can run window operations without disturbing each other.
+// A client handle is single-threaded: one thread submits and polls.
+// ============================================================================
+
+#ifndef CALCD_CLIENT_H
+#define CALCD_CLIENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "calcd_protocol.h"
+#include "calculator_driver.h"
+
+// ============================================================================
+// Client Handle
+// ============================================================================
+typedef struct {
+    calcd_shm_t *shm;          // Mapped daemon segment
+    calcd_slot_t *slot;        // Slot claimed by this client
+    uint64_t next_tag;         // Tag for the next request
+    uint64_t posted_errors;    // Posted requests the daemon reported as failed
+    uint32_t last_error_code;  // ERROR_CODE of the latest failure
+    uint32_t timeout_ms;       // Blocking-call timeout
+} calcd_client_t;
+
+#define CALCD_DEFAULT_TIMEOUT_MS  1000
+
+// ============================================================================
+// Connection
+// ============================================================================
+
+/**
+ * Attach to a running calcd and claim a client slot
+ *
+ * @param client Handle to initialize
+ * @param name   Shared memory name (NULL for CALCD_DEFAULT_NAME)
+ *
+ * Returns: 0 on success, -1 on error (daemon not running, no free slot)
+ */
+int calcd_client_open(calcd_client_t *client, const char *name);
+
+/**
+ * Release the slot and unmap the segment
+ */
+void calcd_client_close(calcd_client_t *client);
+
+// ============================================================================
+// Asynchronous Interface
+// ============================================================================
+
+/**
+ * Queue a request (non-blocking)
+ *
+ * @param client  Client handle
+ * @param request Request; its tag is assigned here and also written back
+ *
+ * Returns: 0 on success, -1 if the request ring is full (errno = EAGAIN)
+ */
+int calcd_client_submit(calcd_client_t *client, calcd_request_t *request);
+
+/**
+ * Fetch one response (non-blocking)
+ *
+ * Returns: 1 if a response was stored, 0 if none is ready
+ */
+int calcd_client_poll(calcd_client_t *client, calcd_response_t *response);
+
+// ============================================================================
+// Blocking Interface (mirrors the calculator driver)
+// ============================================================================
+
+/**
+ * Perform one operation and wait for its result
+ *
+ * @param client    Client handle
+ * @param op        Operation (window ops use operand_b as the window size)
+ * @param operand_a First operand
+ * @param operand_b Second operand
+ * @param result    Result output
+ *
+ * Returns: 0 on success, -1 on failure or timeout
+ */
+int calcd_perform_operation(calcd_client_t *client, calculator_operation_t op,
+                            float operand_a, float operand_b, float *result);
+
+/**
+ * Reset this client's price buffer and set its window size (posted)
+ *
+ * Returns: 0 if queued, -1 if the ring stayed full until the timeout
+ */
+int calcd_buffer_reset(calcd_client_t *client, uint16_t window_size);
+
+/**
+ * Append a price to this client's price buffer (posted)
+ *
+ * Returns: 0 if queued, -1 if the ring stayed full until the timeout
+ */
+int calcd_buffer_write_price(calcd_client_t *client, float price);
+
+/**
+ * Update this client's EMA with a new price (like calculator_ema())
+ */
+int calcd_ema(calcd_client_t *client, float price, float alpha, float *result);
+
+#endif // CALCD_CLIENT_H
@@ -0,0 +1,174 @@
+// ============================================================================
+// Calculator Broker Protocol - Header
+// ============================================================================
+// Shared-memory layout between calcd (the only process that touches the
+// calculator IP) and its clients
+//
+// The daemon creates one POSIX shared memory segment with a fixed number of
+// client slots. Each slot holds two single-producer/single-consumer rings:
+//   requests:  client -> daemon
+//   responses: daemon -> client
+// Ring indices are free-running 32-bit counters. Producer and consumer each
+// own one cache line (their index plus a cached copy of the other side's),
+// so in steady state neither side reads a line the other is writing.
+// ============================================================================
+
+#ifndef CALCD_PROTOCOL_H
+#define CALCD_PROTOCOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define CALCD_DEFAULT_NAME   "/hps_calcd"
+#define CALCD_MAGIC          0x44434C43  // "CLCD"
+#define CALCD_VERSION        1
+#define CALCD_MAX_CLIENTS    8
+#define CALCD_RING_SIZE      256         // Entries per ring (power of 2)
+#define CALCD_CACHE_LINE     64
+
+// ============================================================================
+// Requests and Responses
+// ============================================================================
+typedef enum {
+    CALCD_REQ_OPERATION = 0,     // op(operand_a, operand_b) -> result
+    CALCD_REQ_BUFFER_RESET = 1,  // Clear the client's price buffer, operand_b = window
+    CALCD_REQ_BUFFER_PRICE = 2   // Append operand_a to the client's price buffer
+} calcd_request_type_t;
+
+// Posted requests are answered only if they fail
+#define CALCD_FLAG_POSTED    0x1
+
+typedef struct {
+    uint64_t tag;          // Echoed in the response
+    uint32_t type;         // calcd_request_type_t
+    uint32_t op;           // calculator_operation_t for CALCD_REQ_OPERATION
+    float    operand_a;
+    float    operand_b;    // Window size for window operations, alpha for EMA
+    uint32_t flags;        // CALCD_FLAG_*
+    uint32_t reserved;
+} calcd_request_t;         // 32 bytes
+
+typedef struct {
+    uint64_t tag;          // Tag of the request this answers
+    int32_t  status;       // 0 = success, -1 = failed
+    uint32_t error_code;   // ERROR_CODE register on failure
+    float    result;
+    uint32_t reserved[3];
+} calcd_response_t;        // 32 bytes
+
+// ============================================================================
+// SPSC Rings
+// ============================================================================
+typedef struct {
+    uint32_t head;         // Next slot to write (producer)
+    uint32_t cached_tail;  // Producer's last view of tail
+} __attribute__((aligned(CALCD_CACHE_LINE))) calcd_producer_line_t;
+
+typedef struct {
+    uint32_t tail;         // Next slot to read (consumer)
+    uint32_t cached_head;  // Consumer's last view of head
+} __attribute__((aligned(CALCD_CACHE_LINE))) calcd_consumer_line_t;
+
+// CALCD_DEFINE_RING(name, type) defines calcd_<name>_ring_t and:
+//   calcd_<name>_push(ring, entry)  producer; false if the ring is full
+//   calcd_<name>_pop(ring, entry)   consumer; false if the ring is empty
+//   calcd_<name>_free(ring)         producer; free entries (may underestimate)
+//   calcd_<name>_reset(ring)        only while neither side is using the ring
+#define CALCD_DEFINE_RING(name, type)                                                    \
+typedef struct {                                                                         \
+    calcd_producer_line_t producer;                                                      \
+    calcd_consumer_line_t consumer;                                                      \
+    type entries[CALCD_RING_SIZE];                                                       \
+} calcd_##name##_ring_t;                                                                 \
+static inline bool calcd_##name##_push(calcd_##name##_ring_t *ring, const type *entry) { \
+    uint32_t head = ring->producer.head;                                                 \
+    if (head - ring->producer.cached_tail >= CALCD_RING_SIZE) {                          \
+        ring->producer.cached_tail =                                                     \
+            __atomic_load_n(&ring->consumer.tail, __ATOMIC_ACQUIRE);                     \
+        if (head - ring->producer.cached_tail >= CALCD_RING_SIZE) {                      \
+            return false;                                                                \
+        }                                                                                \
+    }                                                                                    \
+    ring->entries[head & (CALCD_RING_SIZE - 1)] = *entry;                                \
+    __atomic_store_n(&ring->producer.head, head + 1, __ATOMIC_RELEASE);                  \
+    return true;                                                                         \
+}                                                                                        \
+static inline bool calcd_##name##_pop(calcd_##name##_ring_t *ring, type *entry) {        \
+    uint32_t tail = ring->consumer.tail;                                                 \
+    if (tail == ring->consumer.cached_head) {                                            \
+        ring->consumer.cached_head =                                                     \
+            __atomic_load_n(&ring->producer.head, __ATOMIC_ACQUIRE);                     \
+        if (tail == ring->consumer.cached_head) {                                        \
+            return false;                                                                \
+        }                                                                                \
+    }                                                                                    \
+    *entry = ring->entries[tail & (CALCD_RING_SIZE - 1)];                                \
+    __atomic_store_n(&ring->consumer.tail, tail + 1, __ATOMIC_RELEASE);                  \
+    return true;                                                                         \
+}                                                                                        \
+static inline uint32_t calcd_##name##_free(calcd_##name##_ring_t *ring) {                \
+    uint32_t used = ring->producer.head - ring->producer.cached_tail;                    \
+    if (used >= CALCD_RING_SIZE) {                                                       \
+        ring->producer.cached_tail =                                                     \
+            __atomic_load_n(&ring->consumer.tail, __ATOMIC_ACQUIRE);                     \
+        used = ring->producer.head - ring->producer.cached_tail;                         \
+    }                                                                                    \
+    return CALCD_RING_SIZE - used;                                                       \
+}                                                                                        \
+static inline void calcd_##name##_reset(calcd_##name##_ring_t *ring) {                   \
+    ring->producer.head = 0;                                                             \
+    ring->producer.cached_tail = 0;                                                      \
+    ring->consumer.tail = 0;                                                             \
+    ring->consumer.cached_head = 0;                                                      \
+}
+
+CALCD_DEFINE_RING(request, calcd_request_t)
+CALCD_DEFINE_RING(response, calcd_response_t)
+
+#undef CALCD_DEFINE_RING
+
+// ============================================================================
+// Shared Segment
+// ============================================================================
+// Slot life cycle (the daemon is the only one to free a slot, so it never
+// frees one it is still serving):
+//   FREE -> CLAIMED   client, compare-and-swap; resets the rings
+//   CLAIMED -> ACTIVE client, after pid and rings are set up
+//   ACTIVE -> CLOSING client detaches
+//   CLOSING -> FREE   daemon, also ACTIVE -> FREE when the client pid is gone
+typedef enum {
+    CALCD_SLOT_FREE = 0,
+    CALCD_SLOT_CLAIMED = 1,
+    CALCD_SLOT_ACTIVE = 2,
+    CALCD_SLOT_CLOSING = 3
+} calcd_slot_state_t;
+
+typedef struct {
+    uint32_t state;        // calcd_slot_state_t
+    uint32_t pid;          // Client process
+    uint32_t generation;   // Bumped on every claim
+} __attribute__((aligned(CALCD_CACHE_LINE))) calcd_slot_control_t;
+
+typedef struct {
+    calcd_slot_control_t control;
+    calcd_request_ring_t requests;
+    calcd_response_ring_t responses;
+} calcd_slot_t;
+
+typedef struct {
+    uint32_t magic;        // CALCD_MAGIC once the daemon is serving
+    uint32_t version;      // CALCD_VERSION
+    uint32_t daemon_pid;
+    uint32_t max_clients;  // CALCD_MAX_CLIENTS
+    uint32_t model;        // 1 = software model backend
+} __attribute__((aligned(CALCD_CACHE_LINE))) calcd_header_t;
+
+typedef struct {
+    calcd_header_t header;
+    calcd_slot_t slots[CALCD_MAX_CLIENTS];
+} calcd_shm_t;
+
+#endif // CALCD_PROTOCOL_H
@@ -0,0 +1,240 @@
+// ============================================================================
+// Flight Recorder Library - Implementation
+// ============================================================================
+// Crash-surviving event ring in a memory-mapped file
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "flight_recorder.h"
+#include "logger_ticks.h"
+
+// Records must stay one cache line so a record is never split across lines
+typedef char fr_record_size_check[(sizeof(fr_record_t) == 64) ? 1 : -1];
+typedef char fr_header_size_check[(sizeof(fr_header_t) <= FR_HEADER_SIZE) ? 1 : -1];
+
+// ============================================================================
+// Static Variables
+// ============================================================================
+static fr_header_t *recorder_header = NULL;
+static fr_record_t *recorder_records = NULL;
+static uint64_t recorder_mask = 0;
+static size_t recorder_size = 0;
+static int recorder_fd = -1;
+
+static __thread uint32_t thread_id = 0;   // Cached so recording stays syscall-free
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static uint32_t flight_recorder_round_capacity(uint32_t capacity) {
+    uint32_t rounded = 1;
+
+    if (capacity == 0) {
+        return FR_DEFAULT_CAPACITY;
+    }
+    while (rounded < capacity && rounded < (1U << 24)) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+// ============================================================================
+// Open Recorder File
+// ============================================================================
+int flight_recorder_open(const char *path, uint32_t capacity) {
+    if (recorder_header != NULL || path == NULL) {
+        return -1;
+    }
+
+    capacity = flight_recorder_round_capacity(capacity);
+    size_t size = FR_HEADER_SIZE + (size_t)capacity * sizeof(fr_record_t);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror("flight_recorder: open");
+        return -1;
+    }
+
+    if (ftruncate(fd, (off_t)size) != 0) {
+        perror("flight_recorder: ftruncate");
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        perror("flight_recorder: mmap");
+        close(fd);
+        return -1;
+    }
+
+    // Touch every page now so recording never faults
+    memset(map, 0, size);
+
+    fr_header_t *header = (fr_header_t *)map;
+    memcpy(header->magic, FR_FILE_MAGIC, sizeof(FR_FILE_MAGIC));
+    header->version = FR_FILE_VERSION;
+    header->record_size = sizeof(fr_record_t);
+    header->capacity = capacity;
+    header->header_size = FR_HEADER_SIZE;
+    header->head = 0;
+    header->pid = (uint32_t)getpid();
+
+    // Anchor the tick calibration; a short sleep gives a first rate estimate
+    logger_ticks_init();
+    header->start_ticks = logger_ticks_read();
+    header->start_monotonic_ns = logger_ticks_clock_ns(CLOCK_MONOTONIC);
+    header->start_realtime_ns = logger_ticks_clock_ns(CLOCK_REALTIME);
+    header->ticks_per_sec = 1e9;
+    if (!logger_ticks_are_ns()) {
+        struct timespec delay = { 0, 10 * 1000 * 1000 };
+        nanosleep(&delay, NULL);
+        double ticks_per_sec = logger_ticks_rate(header->start_ticks, header->start_monotonic_ns);
+        if (ticks_per_sec > 0.0) {
+            header->ticks_per_sec = ticks_per_sec;
+        }
+    }
+
+    FILE *comm = fopen("/proc/self/comm", "r");
+    if (comm != NULL) {
+        if (fgets(header->process, sizeof(header->process), comm) != NULL) {
+            header->process[strcspn(header->process, "\n")] = '\0';
+        }
+        fclose(comm);
+    }
+
+    recorder_records = (fr_record_t *)((uint8_t *)map + FR_HEADER_SIZE);
+    recorder_mask = capacity - 1;
+    recorder_size = size;
+    recorder_fd = fd;
+    __atomic_store_n(&recorder_header, header, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+// ============================================================================
+// Calibrate / Close Recorder File
+// ============================================================================
+void flight_recorder_calibrate(void) {
+    fr_header_t *header = __atomic_load_n(&recorder_header, __ATOMIC_ACQUIRE);
+
+    if (header == NULL || logger_ticks_are_ns()) {
+        return;
+    }
+
+    double ticks_per_sec = logger_ticks_rate(header->start_ticks, header->start_monotonic_ns);
+    if (ticks_per_sec > 0.0) {
+        header->ticks_per_sec = ticks_per_sec;
+    }
+}
+
+void flight_recorder_close(void) {
+    fr_header_t *header = recorder_header;
+
+    if (header == NULL) {
+        return;
+    }
+
+    flight_recorder_calibrate();
+    __atomic_store_n(&recorder_header, NULL, __ATOMIC_RELEASE);
+    msync(header, recorder_size, MS_SYNC);
+    munmap(header, recorder_size);
+    close(recorder_fd);
+
+    recorder_records = NULL;
+    recorder_fd = -1;
+}
+
+bool flight_recorder_active(void) {
+    return __atomic_load_n(&recorder_header, __ATOMIC_ACQUIRE) != NULL;
+}
+
+// ============================================================================
+// Record Event
+// ============================================================================
+void flight_recorder_record(uint16_t type, uint16_t source, uint32_t code,
+                            const uint32_t *data, uint32_t count) {
+    fr_header_t *header = __atomic_load_n(&recorder_header, __ATOMIC_ACQUIRE);
+
+    if (header == NULL) {
+        return;
+    }
+
+    if (thread_id == 0) {
+        thread_id = (uint32_t)syscall(SYS_gettid);
+    }
+    if (count > FR_RECORD_WORDS) {
+        count = FR_RECORD_WORDS;
+    }
+
+    uint64_t sequence = __atomic_fetch_add(&header->head, 1, __ATOMIC_RELAXED);
+    fr_record_t *record = &recorder_records[sequence & recorder_mask];
+
+    // Invalidate first so a crash mid-write leaves a detectably torn record
+    __atomic_store_n(&record->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    record->timestamp = logger_ticks_read();
+    record->type = type;
+    record->source = source;
+    record->thread = thread_id;
+    record->code = code;
+    record->count = count;
+    if (count > 0) {
+        memcpy(record->data, data, count * sizeof(uint32_t));
+    }
+
+    __atomic_store_n(&record->sequence, sequence + 1, __ATOMIC_RELEASE);
+}
+
+void flight_recorder_snapshot(uint16_t source, const volatile uint32_t *regs, uint32_t count) {
+    uint32_t words[FR_RECORD_WORDS];
+    uint32_t first;
+
+    if (regs == NULL || !flight_recorder_active()) {
+        return;
+    }
+    flight_recorder_calibrate();
+
+    for (first = 0; first < count; first += FR_RECORD_WORDS) {
+        uint32_t chunk = (count - first < FR_RECORD_WORDS) ? count - first : FR_RECORD_WORDS;
+        for (uint32_t i = 0; i < chunk; i++) {
+            words[i] = regs[first + i];
+        }
+        flight_recorder_record(FR_EVENT_REG_SNAPSHOT, source, first * 4, words, chunk);
+    }
+}
+
+void flight_recorder_log(int level, const char *file, int line, const char *format) {
+    uint32_t words[FR_RECORD_WORDS] = {0};
+    size_t max_text = (FR_RECORD_WORDS - 1) * sizeof(uint32_t);
+
+    (void)file;
+    words[0] = (uint32_t)line;
+    memcpy(&words[1], format, strnlen(format, max_text));
+    flight_recorder_record(FR_EVENT_LOG, 0, (uint32_t)level, words, FR_RECORD_WORDS);
+}
+
+// ============================================================================
+// Event Names
+// ============================================================================
+const char *flight_recorder_event_name(uint16_t type) {
+    switch (type) {
+        case FR_EVENT_OP_ISSUED:    return "OP_ISSUED";
+        case FR_EVENT_OP_COMPLETED: return "OP_COMPLETED";
+        case FR_EVENT_OP_ERROR:     return "OP_ERROR";
+        case FR_EVENT_TIMEOUT:      return "TIMEOUT";
+        case FR_EVENT_REG_SNAPSHOT: return "REG_SNAPSHOT";
+        case FR_EVENT_LOG:          return "LOG";
+        case FR_EVENT_MARK:         return "MARK";
+        default:                    return "UNKNOWN";
+    }
+}
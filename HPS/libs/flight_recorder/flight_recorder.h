@@ -0,0 +1,146 @@
+// ============================================================================
+// Flight Recorder Library - Header
+// ============================================================================
+// Crash-surviving event ring in a memory-mapped file
+//
+// Every event is one 64-byte record written with plain stores into a
+// MAP_SHARED file mapping: no locks, no syscalls, no formatting. Timestamps
+// are raw ticks from the logger tick source (logger_ticks.h); the header
+// holds the calibration fr_dump converts them with. The pages
+// belong to the kernel page cache, so the last 'capacity' events are still in
+// the file after the process crashes, hangs or is killed. fr_dump prints them.
+// ============================================================================
+
+#ifndef HPS_FLIGHT_RECORDER_H
+#define HPS_FLIGHT_RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define FR_DEFAULT_CAPACITY   65536        // Records (4MB file)
+#define FR_RECORD_WORDS       8            // 32-bit payload words per record
+#define FR_FILE_MAGIC         "HPSFLTR"
+#define FR_FILE_VERSION       2            // 2: raw tick timestamps + calibration
+#define FR_HEADER_SIZE        4096         // Records start on the second page
+
+// ============================================================================
+// Event Types
+// ============================================================================
+typedef enum {
+    FR_EVENT_OP_ISSUED = 1,      // code=op, data={operand_a bits, operand_b bits}
+    FR_EVENT_OP_COMPLETED = 2,   // code=op, data={result bits}
+    FR_EVENT_OP_ERROR = 3,       // code=error code register, data={op, status}
+    FR_EVENT_TIMEOUT = 4,        // code=control register, data={status, polls}
+    FR_EVENT_REG_SNAPSHOT = 5,   // code=first register offset, data=register values
+    FR_EVENT_LOG = 6,            // code=level, data={line, first 28 bytes of format}
+    FR_EVENT_MARK = 7            // code/data defined by the application
+} fr_event_type_t;
+
+// ============================================================================
+// File Layout
+// ============================================================================
+typedef struct {
+    uint64_t sequence;                 // Event number + 1, stored last (0 = empty/torn)
+    uint64_t timestamp;                // Raw ticks (logger_ticks_read())
+    uint16_t type;                     // fr_event_type_t
+    uint16_t source;                   // Module that recorded it (log_module_t)
+    uint32_t thread;                   // Kernel thread id
+    uint32_t code;                     // Event-specific code
+    uint32_t count;                    // Valid words in data[]
+    uint32_t data[FR_RECORD_WORDS];    // Event-specific payload
+} fr_record_t;
+
+typedef struct {
+    char magic[8];                     // FR_FILE_MAGIC, NUL-padded
+    uint32_t version;                  // FR_FILE_VERSION
+    uint32_t record_size;              // sizeof(fr_record_t)
+    uint32_t capacity;                 // Number of records (power of two)
+    uint32_t header_size;              // FR_HEADER_SIZE
+    uint64_t head;                     // Next event number (atomically incremented)
+    uint64_t start_ticks;              // Tick value when the file was opened
+    uint64_t start_monotonic_ns;       // CLOCK_MONOTONIC at the same instant
+    uint64_t start_realtime_ns;        // CLOCK_REALTIME at the same instant
+    double ticks_per_sec;              // Tick rate, refined by flight_recorder_calibrate()
+    uint32_t pid;                      // Recording process
+    char process[32];                  // Recording process name
+} fr_header_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+/**
+ * Create (or truncate) the recorder file and map it
+ *
+ * All pages are touched up front so recording never takes a page fault.
+ *
+ * @param path     File to record into (e.g. /var/run/calculator.fr)
+ * @param capacity Number of records, rounded up to a power of two
+ *                 (0 for FR_DEFAULT_CAPACITY)
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int flight_recorder_open(const char *path, uint32_t capacity);
+
+/**
+ * Re-measure the tick rate over everything since the file was opened
+ *
+ * flight_recorder_open() stores a 10 ms estimate; the longer the baseline,
+ * the closer events far from the start land on the wall clock. Called from
+ * flight_recorder_snapshot() and flight_recorder_close(); long-running
+ * processes may also call it from a housekeeping path. One clock_gettime().
+ */
+void flight_recorder_calibrate(void);
+
+/**
+ * Flush the mapping to disk and unmap it
+ */
+void flight_recorder_close(void);
+
+/**
+ * Check whether a recorder file is open
+ */
+bool flight_recorder_active(void);
+
+/**
+ * Record one event (no-op if no recorder is open)
+ *
+ * @param type   fr_event_type_t
+ * @param source Recording module
+ * @param code   Event-specific code
+ * @param data   Payload words (may be NULL if count is 0)
+ * @param count  Number of payload words (at most FR_RECORD_WORDS)
+ */
+void flight_recorder_record(uint16_t type, uint16_t source, uint32_t code,
+                            const uint32_t *data, uint32_t count);
+
+/**
+ * Record a register snapshot (FR_RECORD_WORDS registers per record)
+ *
+ * Snapshots mark the events worth reading after a crash, so the tick
+ * calibration is refreshed first.
+ *
+ * @param source Recording module
+ * @param regs   Register block to copy
+ * @param count  Number of 32-bit registers
+ */
+void flight_recorder_snapshot(uint16_t source, const volatile uint32_t *regs, uint32_t count);
+
+/**
+ * Record a log message template (suitable as a logger event hook)
+ *
+ * Only the level, line and the start of the format string are kept; the
+ * arguments are not formatted.
+ */
+void flight_recorder_log(int level, const char *file, int line, const char *format);
+
+/**
+ * Get the name of an event type
+ */
+const char *flight_recorder_event_name(uint16_t type);
+
+#endif // HPS_FLIGHT_RECORDER_H
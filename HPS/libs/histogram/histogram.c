@@ -0,0 +1,187 @@
+// ============================================================================
+// Latency Histogram Library - Implementation
+// ============================================================================
+// Fixed-size log-linear histogram for nanosecond latency measurements
+// ============================================================================
+
+#include <string.h>
+#include "histogram.h"
+
+// Width of the ASCII bars in histogram_print()
+#define HISTOGRAM_BAR_WIDTH 50
+
+// ============================================================================
+// Bucket Index Helpers
+// ============================================================================
+
+static unsigned int histogram_bucket_index(uint64_t value) {
+    if (value < HISTOGRAM_SUB_BUCKETS) {
+        return (unsigned int)value;
+    }
+
+    // Position of the most significant bit selects the magnitude, the next
+    // HISTOGRAM_SUB_BUCKET_BITS bits select the linear sub-bucket
+    unsigned int msb = 63U - (unsigned int)__builtin_clzll(value);
+    unsigned int shift = msb - HISTOGRAM_SUB_BUCKET_BITS;
+    unsigned int magnitude = shift + 1U;
+    unsigned int sub = (unsigned int)(value >> shift) & (HISTOGRAM_SUB_BUCKETS - 1U);
+
+    return magnitude * HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+static uint64_t histogram_bucket_upper_bound(unsigned int index) {
+    if (index < HISTOGRAM_SUB_BUCKETS) {
+        return index;
+    }
+
+    unsigned int magnitude = index / HISTOGRAM_SUB_BUCKETS;
+    unsigned int sub = index % HISTOGRAM_SUB_BUCKETS;
+    unsigned int shift = magnitude - 1U;
+    uint64_t lower = ((uint64_t)(HISTOGRAM_SUB_BUCKETS + sub)) << shift;
+
+    return lower + ((1ULL << shift) - 1ULL);
+}
+
+// ============================================================================
+// Initialize Histogram
+// ============================================================================
+void histogram_init(histogram_t *hist, const char *label) {
+    memset(hist, 0, sizeof(*hist));
+    hist->label = label;
+    hist->min = UINT64_MAX;
+}
+
+// ============================================================================
+// Record Sample
+// ============================================================================
+void histogram_record(histogram_t *hist, uint64_t value) {
+    hist->buckets[histogram_bucket_index(value)]++;
+    hist->count++;
+    hist->sum += value;
+    if (value < hist->min) {
+        hist->min = value;
+    }
+    if (value > hist->max) {
+        hist->max = value;
+    }
+}
+
+// ============================================================================
+// Merge Histograms
+// ============================================================================
+void histogram_merge(histogram_t *dest, const histogram_t *src) {
+    if (src->count == 0) {
+        return;
+    }
+
+    for (unsigned int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        dest->buckets[i] += src->buckets[i];
+    }
+    dest->count += src->count;
+    dest->sum += src->sum;
+    if (src->min < dest->min) {
+        dest->min = src->min;
+    }
+    if (src->max > dest->max) {
+        dest->max = src->max;
+    }
+}
+
+// ============================================================================
+// Percentile Query
+// ============================================================================
+uint64_t histogram_percentile(const histogram_t *hist, double percentile) {
+    if (hist->count == 0) {
+        return 0;
+    }
+
+    if (percentile <= 0.0) {
+        return hist->min;
+    }
+    if (percentile >= 100.0) {
+        return hist->max;
+    }
+
+    uint64_t target = (uint64_t)((percentile / 100.0) * (double)hist->count + 0.5);
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for (unsigned int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= target) {
+            uint64_t bound = histogram_bucket_upper_bound(i);
+            return (bound > hist->max) ? hist->max : bound;
+        }
+    }
+
+    return hist->max;
+}
+
+// ============================================================================
+// Mean
+// ============================================================================
+double histogram_mean(const histogram_t *hist) {
+    if (hist->count == 0) {
+        return 0.0;
+    }
+    return (double)hist->sum / (double)hist->count;
+}
+
+// ============================================================================
+// Print Summary
+// ============================================================================
+void histogram_print_summary(const histogram_t *hist, FILE *output) {
+    FILE *out = (output != NULL) ? output : stdout;
+
+    if (hist->count == 0) {
+        fprintf(out, "%-24s  no samples\n", hist->label ? hist->label : "histogram");
+        return;
+    }
+
+    fprintf(out, "%-24s  n=%-9llu min=%-7llu mean=%-9.1f p50=%-7llu p90=%-7llu "
+                 "p99=%-7llu p99.9=%-7llu max=%llu\n",
+            hist->label ? hist->label : "histogram",
+            (unsigned long long)hist->count,
+            (unsigned long long)hist->min,
+            histogram_mean(hist),
+            (unsigned long long)histogram_percentile(hist, 50.0),
+            (unsigned long long)histogram_percentile(hist, 90.0),
+            (unsigned long long)histogram_percentile(hist, 99.0),
+            (unsigned long long)histogram_percentile(hist, 99.9),
+            (unsigned long long)hist->max);
+}
+
+// ============================================================================
+// Print Full Histogram
+// ============================================================================
+void histogram_print(const histogram_t *hist, FILE *output) {
+    FILE *out = (output != NULL) ? output : stdout;
+    uint64_t peak = 0;
+
+    histogram_print_summary(hist, out);
+    if (hist->count == 0) {
+        return;
+    }
+
+    for (unsigned int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        if (hist->buckets[i] > peak) {
+            peak = hist->buckets[i];
+        }
+    }
+
+    for (unsigned int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        if (hist->buckets[i] == 0) {
+            continue;
+        }
+
+        int bar = (int)((hist->buckets[i] * HISTOGRAM_BAR_WIDTH + peak - 1) / peak);
+        fprintf(out, "  <= %10llu | %10llu | %6.2f%% | %.*s\n",
+                (unsigned long long)histogram_bucket_upper_bound(i),
+                (unsigned long long)hist->buckets[i],
+                100.0 * (double)hist->buckets[i] / (double)hist->count,
+                bar,
+                "##################################################");
+    }
+}
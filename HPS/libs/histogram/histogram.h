@@ -0,0 +1,117 @@
+// ============================================================================
+// Latency Histogram Library - Header
+// ============================================================================
+// Fixed-size log-linear histogram for nanosecond latency measurements
+// Recording is O(1), allocation-free and safe to call from a hot loop
+// Reusable across all HPS benchmarks and measurement tools
+// ============================================================================
+
+#ifndef HPS_HISTOGRAM_H
+#define HPS_HISTOGRAM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+// ============================================================================
+// Bucket Layout
+// ============================================================================
+// Values below HISTOGRAM_SUB_BUCKETS are stored exactly. Above that, every
+// power of two is split into HISTOGRAM_SUB_BUCKETS linear sub-buckets, which
+// bounds the relative error of any reported percentile to 1/16 (6.25%).
+#define HISTOGRAM_SUB_BUCKET_BITS  4
+#define HISTOGRAM_SUB_BUCKETS      (1U << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_MAGNITUDES       (64 - HISTOGRAM_SUB_BUCKET_BITS + 1)
+#define HISTOGRAM_BUCKETS          (HISTOGRAM_MAGNITUDES * HISTOGRAM_SUB_BUCKETS)
+
+// ============================================================================
+// Histogram Structure
+// ============================================================================
+typedef struct {
+    const char *label;                    // Name printed in reports
+    uint64_t count;                       // Number of recorded samples
+    uint64_t sum;                         // Sum of all samples (for mean)
+    uint64_t min;                         // Smallest recorded sample
+    uint64_t max;                         // Largest recorded sample
+    uint64_t buckets[HISTOGRAM_BUCKETS];  // Per-bucket sample counts
+} histogram_t;
+
+// ============================================================================
+// Time Source
+// ============================================================================
+
+/**
+ * Read the monotonic clock in nanoseconds
+ *
+ * Returns: Current CLOCK_MONOTONIC time in nanoseconds
+ */
+static inline uint64_t histogram_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+/**
+ * Initialize (or clear) a histogram
+ *
+ * @param hist  Histogram to initialize
+ * @param label Name used in printed reports (must outlive the histogram)
+ */
+void histogram_init(histogram_t *hist, const char *label);
+
+/**
+ * Record a single sample
+ *
+ * @param hist  Histogram to update
+ * @param value Sample value (typically nanoseconds)
+ */
+void histogram_record(histogram_t *hist, uint64_t value);
+
+/**
+ * Merge all samples of one histogram into another
+ *
+ * @param dest Destination histogram
+ * @param src  Source histogram (unchanged)
+ */
+void histogram_merge(histogram_t *dest, const histogram_t *src);
+
+/**
+ * Get the value at a given percentile
+ *
+ * @param hist       Histogram to query
+ * @param percentile Percentile in the range 0.0 - 100.0
+ *
+ * Returns: Upper bound of the bucket holding the requested percentile,
+ *          clamped to the recorded maximum (0 if the histogram is empty)
+ */
+uint64_t histogram_percentile(const histogram_t *hist, double percentile);
+
+/**
+ * Get the arithmetic mean of all samples
+ *
+ * Returns: Mean value (0.0 if the histogram is empty)
+ */
+double histogram_mean(const histogram_t *hist);
+
+/**
+ * Print a one-line summary (count, min, mean, p50/p90/p99/p99.9, max)
+ *
+ * @param hist   Histogram to print
+ * @param output Output stream (NULL for stdout)
+ */
+void histogram_print_summary(const histogram_t *hist, FILE *output);
+
+/**
+ * Print the summary followed by an ASCII bar chart of populated buckets
+ *
+ * @param hist   Histogram to print
+ * @param output Output stream (NULL for stdout)
+ */
+void histogram_print(const histogram_t *hist, FILE *output);
+
+#endif // HPS_HISTOGRAM_H
@@ -0,0 +1,159 @@
+// ============================================================================
+// Indicator Publication Library - Implementation
+// ============================================================================
+// Segment setup and the symbol table; publish and read are inline in the
+// header
+// ============================================================================
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "indicator_shm.h"
+
+// ============================================================================
+// Setup
+// ============================================================================
+int indicator_shm_open_writer(indicator_shm_t *shm, const char *name) {
+    memset(shm, 0, sizeof(*shm));
+    if (name == NULL) {
+        name = INDICATOR_SHM_DEFAULT_NAME;
+    }
+
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "indicator_shm: shm_open %s: %s\n", name, strerror(errno));
+        return -1;
+    }
+
+    if (ftruncate(fd, sizeof(indicator_shm_segment_t)) != 0) {
+        fprintf(stderr, "indicator_shm: ftruncate: %s\n", strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, sizeof(indicator_shm_segment_t), PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "indicator_shm: mmap: %s\n", strerror(errno));
+        return -1;
+    }
+
+    // Readers still mapping a previous writer's segment see the magic drop
+    // first, then empty slots, then the new magic
+    indicator_shm_segment_t *segment = (indicator_shm_segment_t *)map;
+    __atomic_store_n(&segment->header.magic, 0, __ATOMIC_RELEASE);
+    memset((uint8_t *)segment + sizeof(segment->header), 0,
+           sizeof(*segment) - sizeof(segment->header));
+    segment->header.version = INDICATOR_SHM_VERSION;
+    segment->header.writer_pid = (uint32_t)getpid();
+    segment->header.max_symbols = INDICATOR_SHM_MAX_SYMBOLS;
+    segment->header.max_indicators = INDICATOR_SHM_MAX_INDICATORS;
+    segment->header.symbol_count = 0;
+    __atomic_store_n(&segment->header.magic, INDICATOR_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    shm->segment = segment;
+    shm->writer = true;
+    return 0;
+}
+
+int indicator_shm_open_reader(indicator_shm_t *shm, const char *name) {
+    memset(shm, 0, sizeof(*shm));
+    if (name == NULL) {
+        name = INDICATOR_SHM_DEFAULT_NAME;
+    }
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(indicator_shm_segment_t)) {
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, sizeof(indicator_shm_segment_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    indicator_shm_segment_t *segment = (indicator_shm_segment_t *)map;
+    if (__atomic_load_n(&segment->header.magic, __ATOMIC_ACQUIRE) != INDICATOR_SHM_MAGIC ||
+        segment->header.version != INDICATOR_SHM_VERSION ||
+        segment->header.max_symbols != INDICATOR_SHM_MAX_SYMBOLS ||
+        segment->header.max_indicators != INDICATOR_SHM_MAX_INDICATORS) {
+        munmap(map, sizeof(indicator_shm_segment_t));
+        return -1;
+    }
+
+    shm->segment = segment;
+    shm->writer = false;
+    return 0;
+}
+
+void indicator_shm_close(indicator_shm_t *shm) {
+    if (shm->segment == NULL) {
+        return;
+    }
+
+    munmap(shm->segment, sizeof(indicator_shm_segment_t));
+    shm->segment = NULL;
+}
+
+// ============================================================================
+// Symbol Table
+// ============================================================================
+int indicator_shm_add_symbol(indicator_shm_t *shm, const char *name) {
+    if (!shm->writer) {
+        return -1;
+    }
+
+    int existing = indicator_shm_find_symbol(shm, name);
+    if (existing >= 0) {
+        return existing;
+    }
+
+    uint32_t count = shm->segment->header.symbol_count;
+    if (count >= INDICATOR_SHM_MAX_SYMBOLS) {
+        return -1;
+    }
+
+    // Name first, then the count that makes it visible
+    strncpy(shm->segment->symbols[count], name, INDICATOR_SHM_SYMBOL_LEN - 1);
+    shm->segment->symbols[count][INDICATOR_SHM_SYMBOL_LEN - 1] = '\0';
+    __atomic_store_n(&shm->segment->header.symbol_count, count + 1, __ATOMIC_RELEASE);
+    return (int)count;
+}
+
+int indicator_shm_find_symbol(const indicator_shm_t *shm, const char *name) {
+    uint32_t count = indicator_shm_symbol_count(shm);
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (strncmp(shm->segment->symbols[i], name, INDICATOR_SHM_SYMBOL_LEN - 1) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+uint32_t indicator_shm_symbol_count(const indicator_shm_t *shm) {
+    return __atomic_load_n(&shm->segment->header.symbol_count, __ATOMIC_ACQUIRE);
+}
+
+bool indicator_shm_writer_alive(const indicator_shm_t *shm) {
+    pid_t pid = (pid_t)shm->segment->header.writer_pid;
+
+    if (__atomic_load_n(&shm->segment->header.magic, __ATOMIC_ACQUIRE) != INDICATOR_SHM_MAGIC ||
+        pid <= 0) {
+        return false;
+    }
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
@@ -0,0 +1,232 @@
+// ============================================================================
+// Indicator Publication Library - Header
+// ============================================================================
+// Latest indicator values in POSIX shared memory, one seqlock slot per
+// (symbol, indicator)
+//
+// The compute process (single writer) publishes every result it wants other
+// processes to see; strategy, risk, GUI and monitor processes map the same
+// segment read-only and copy consistent snapshots out of it. Neither side
+// makes a syscall or takes a lock on the hot path:
+//
+//   writer: seq -> odd, store the value words, seq -> even
+//   reader: read seq, copy the words, re-read seq; retry if it was odd or
+//           changed in between
+//
+// Every slot is one cache line, so publishing one indicator never
+// invalidates a line a reader of another indicator is polling.
+// ============================================================================
+
+#ifndef HPS_INDICATOR_SHM_H
+#define HPS_INDICATOR_SHM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define INDICATOR_SHM_DEFAULT_NAME     "/hps_indicators"
+#define INDICATOR_SHM_MAGIC            0x494E4453  // "INDS"
+#define INDICATOR_SHM_VERSION          1
+#define INDICATOR_SHM_MAX_SYMBOLS      64
+#define INDICATOR_SHM_MAX_INDICATORS   16          // Indexed by calculator_operation_t
+#define INDICATOR_SHM_SYMBOL_LEN       16          // Including the terminating NUL
+#define INDICATOR_SHM_CACHE_LINE       64
+#define INDICATOR_SHM_READ_RETRIES     1024        // Give up on a slot whose writer died mid-update
+
+// ============================================================================
+// Shared Segment Layout
+// ============================================================================
+
+// One published value (what readers get back)
+typedef struct {
+    float    value;          // Indicator result
+    uint32_t window;         // Window size it was computed over (0 if none)
+    uint64_t timestamp_ns;   // CLOCK_MONOTONIC when the writer published it
+    uint64_t source_seq;     // Writer-defined input sequence (e.g. tick number)
+} indicator_value_t;
+
+#define INDICATOR_VALUE_WORDS  (sizeof(indicator_value_t) / sizeof(uint32_t))
+
+// The value is copied as 32-bit words with relaxed atomic accesses: every
+// access is single-copy atomic on ARMv7 and the copy is never a data race
+typedef union {
+    indicator_value_t value;
+    uint32_t words[INDICATOR_VALUE_WORDS];
+} indicator_words_t;
+
+typedef struct {
+    uint32_t seq;            // Odd while an update is in progress; 0 = never published
+    uint32_t reserved;
+    indicator_words_t data;
+} __attribute__((aligned(INDICATOR_SHM_CACHE_LINE))) indicator_slot_t;
+
+typedef struct {
+    uint32_t magic;          // INDICATOR_SHM_MAGIC once the writer is ready
+    uint32_t version;        // INDICATOR_SHM_VERSION
+    uint32_t writer_pid;     // Publishing process
+    uint32_t max_symbols;    // INDICATOR_SHM_MAX_SYMBOLS
+    uint32_t max_indicators; // INDICATOR_SHM_MAX_INDICATORS
+    uint32_t symbol_count;   // Registered symbols (names are valid below this)
+} __attribute__((aligned(INDICATOR_SHM_CACHE_LINE))) indicator_shm_header_t;
+
+typedef struct {
+    indicator_shm_header_t header;
+    char symbols[INDICATOR_SHM_MAX_SYMBOLS][INDICATOR_SHM_SYMBOL_LEN];
+    indicator_slot_t slots[INDICATOR_SHM_MAX_SYMBOLS][INDICATOR_SHM_MAX_INDICATORS];
+} indicator_shm_segment_t;
+
+// Handle for either side
+typedef struct {
+    indicator_shm_segment_t *segment;
+    bool writer;
+} indicator_shm_t;
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+/**
+ * Create (or reset) the segment and become its only writer
+ *
+ * @param shm  Handle to initialize
+ * @param name POSIX shared memory name (NULL for INDICATOR_SHM_DEFAULT_NAME)
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int indicator_shm_open_writer(indicator_shm_t *shm, const char *name);
+
+/**
+ * Map an existing segment read-only
+ *
+ * @param shm  Handle to initialize
+ * @param name POSIX shared memory name (NULL for INDICATOR_SHM_DEFAULT_NAME)
+ *
+ * Returns: 0 on success, -1 if the segment does not exist (yet) or is invalid
+ */
+int indicator_shm_open_reader(indicator_shm_t *shm, const char *name);
+
+/**
+ * Unmap the segment (it stays in /dev/shm for readers)
+ */
+void indicator_shm_close(indicator_shm_t *shm);
+
+/**
+ * Register a symbol name (writer only)
+ *
+ * @param shm  Writer handle
+ * @param name Symbol name (truncated to INDICATOR_SHM_SYMBOL_LEN - 1 characters)
+ *
+ * Returns: Symbol index (existing index if already registered), -1 if full
+ */
+int indicator_shm_add_symbol(indicator_shm_t *shm, const char *name);
+
+/**
+ * Look up a symbol registered by the writer
+ *
+ * Returns: Symbol index, -1 if not registered
+ */
+int indicator_shm_find_symbol(const indicator_shm_t *shm, const char *name);
+
+/**
+ * Number of registered symbols
+ */
+uint32_t indicator_shm_symbol_count(const indicator_shm_t *shm);
+
+/**
+ * Check whether the writing process is still alive
+ */
+bool indicator_shm_writer_alive(const indicator_shm_t *shm);
+
+// ============================================================================
+// Hot Path (inline)
+// ============================================================================
+
+static inline indicator_slot_t *indicator_shm_slot(const indicator_shm_t *shm,
+                                                   uint32_t symbol, uint32_t indicator) {
+    return &shm->segment->slots[symbol][indicator];
+}
+
+/**
+ * Publish one value (writer only, no bounds checks)
+ *
+ * @param shm       Writer handle
+ * @param symbol    Index from indicator_shm_add_symbol()
+ * @param indicator Indicator index, usually a calculator_operation_t
+ * @param value     Value to publish
+ */
+static inline void indicator_shm_publish(indicator_shm_t *shm, uint32_t symbol,
+                                         uint32_t indicator, const indicator_value_t *value) {
+    indicator_slot_t *slot = indicator_shm_slot(shm, symbol, indicator);
+    indicator_words_t data = { .value = *value };
+    uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+    uint32_t next = (seq + 2 != 0) ? seq + 2 : 2;   // 0 means "never published"
+
+    __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);   // Odd seq visible before any new word
+    for (uint32_t i = 0; i < INDICATOR_VALUE_WORDS; i++) {
+        __atomic_store_n(&slot->data.words[i], data.words[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&slot->seq, next, __ATOMIC_RELEASE);
+}
+
+/**
+ * Sequence number of a slot (changes on every publish)
+ *
+ * Cheap change detection for pollers: a single load, no copy.
+ */
+static inline uint32_t indicator_shm_seq(const indicator_shm_t *shm,
+                                         uint32_t symbol, uint32_t indicator) {
+    return __atomic_load_n(&indicator_shm_slot(shm, symbol, indicator)->seq, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Copy a consistent snapshot of one slot
+ *
+ * @param shm       Reader (or writer) handle
+ * @param symbol    Symbol index
+ * @param indicator Indicator index
+ * @param value     Snapshot output
+ * @param seq_out   Sequence number of the snapshot (optional, may be NULL)
+ *
+ * Returns: 0 on success,
+ *          -1 if never published (errno = ENOENT) or the slot stayed
+ *          mid-update for INDICATOR_SHM_READ_RETRIES tries (errno = EAGAIN)
+ */
+static inline int indicator_shm_read(const indicator_shm_t *shm, uint32_t symbol,
+                                     uint32_t indicator, indicator_value_t *value,
+                                     uint32_t *seq_out) {
+    const indicator_slot_t *slot = indicator_shm_slot(shm, symbol, indicator);
+    indicator_words_t data;
+
+    for (uint32_t attempt = 0; attempt < INDICATOR_SHM_READ_RETRIES; attempt++) {
+        uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq == 0) {
+            errno = ENOENT;
+            return -1;
+        }
+        if (seq & 1) {
+            continue;   // Writer is mid-update
+        }
+
+        for (uint32_t i = 0; i < INDICATOR_VALUE_WORDS; i++) {
+            data.words[i] = __atomic_load_n(&slot->data.words[i], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);   // Words read before the re-check
+
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq) {
+            *value = data.value;
+            if (seq_out != NULL) {
+                *seq_out = seq;
+            }
+            return 0;
+        }
+    }
+
+    errno = EAGAIN;
+    return -1;
+}
+
+#endif // HPS_INDICATOR_SHM_H
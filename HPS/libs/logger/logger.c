@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
 #include <sys/time.h>
 #include "logger.h"
@@ -19,6 +20,21 @@
 static log_level_t current_level = LOG_DEFAULT_LEVEL;
 static FILE *log_output = NULL;  // Initialized to NULL, set to stderr in logger_init
 static bool logging_enabled = true;
+static logger_event_hook_t event_hook = NULL;
+
+// Per-module overrides (-1 = follow the global level)
+static int8_t module_overrides[LOG_MODULE_COUNT] = { [0 ... LOG_MODULE_COUNT - 1] = -1 };
+
+// Effective levels read inline by LOG_ENABLED()
+uint8_t logger_module_levels[LOG_MODULE_COUNT] = { [0 ... LOG_MODULE_COUNT - 1] = LOG_DEFAULT_LEVEL };
+
+static const char *const module_names[LOG_MODULE_COUNT] = {
+    [LOG_MODULE_DEFAULT]    = "default",
+    [LOG_MODULE_CALCULATOR] = "calculator",
+    [LOG_MODULE_FPGA_UIO]   = "fpga_uio",
+    [LOG_MODULE_LED]        = "led",
+    [LOG_MODULE_APP]        = "app",
+};
 
 // Color codes for terminal output
 #define COLOR_RESET   "\033[0m"
@@ -28,6 +44,16 @@ static bool logging_enabled = true;
 #define COLOR_DEBUG   "\033[36m"  // Cyan
 #define COLOR_TRACE   "\033[35m"  // Magenta
 
+// ============================================================================
+// Recompute Effective Module Levels
+// ============================================================================
+static void logger_update_module_levels(void) {
+    for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+        int level = (module_overrides[i] >= 0) ? module_overrides[i] : (int)current_level;
+        logger_module_levels[i] = logging_enabled ? (uint8_t)level : LOG_LEVEL_NONE;
+    }
+}
+
 // ============================================================================
 // Initialize Logging System
 // ============================================================================
@@ -35,6 +61,7 @@ void logger_init(log_level_t level, FILE *output_file) {
     current_level = level;
     log_output = (output_file != NULL) ? output_file : stderr;
     logging_enabled = true;
+    logger_update_module_levels();
     
     // Note: Can't use LOG_INFO here as it would cause recursion
     // Logging will be available after this function returns
@@ -46,6 +73,7 @@ void logger_init(log_level_t level, FILE *output_file) {
 void logger_set_level(log_level_t level) {
     log_level_t old_level = current_level;
     current_level = level;
+    logger_update_module_levels();
     LOG_INFO("Log level changed: %s -> %s", logger_level_name(old_level), logger_level_name(level));
 }
 
@@ -61,11 +89,73 @@ log_level_t logger_get_level(void) {
 // ============================================================================
 void logger_enable(bool enable) {
     logging_enabled = enable;
+    logger_update_module_levels();
     if (enable) {
         LOG_INFO("Logging enabled");
     }
 }
 
+// ============================================================================
+// Module Levels
+// ============================================================================
+const char *logger_module_name(log_module_t module) {
+    if ((unsigned int)module >= LOG_MODULE_COUNT) {
+        return "unknown";
+    }
+    return module_names[module];
+}
+
+int logger_set_module_level(log_module_t module, int level) {
+    if ((unsigned int)module >= LOG_MODULE_COUNT || level < -1 || level > LOG_LEVEL_TRACE) {
+        return -1;
+    }
+
+    module_overrides[module] = (int8_t)level;
+    logger_update_module_levels();
+    return 0;
+}
+
+int logger_configure_modules(const char *spec) {
+    char buffer[256];
+    char *saveptr = NULL;
+    char *entry;
+    int ret = 0;
+
+    if (spec == NULL || strlen(spec) >= sizeof(buffer)) {
+        return -1;
+    }
+    strcpy(buffer, spec);
+
+    for (entry = strtok_r(buffer, ",", &saveptr); entry != NULL; entry = strtok_r(NULL, ",", &saveptr)) {
+        char *value = strchr(entry, '=');
+        int module = -1;
+        int level = -1;
+
+        if (value == NULL) {
+            ret = -1;
+            continue;
+        }
+        *value++ = '\0';
+
+        for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+            if (strcasecmp(entry, module_names[i]) == 0) {
+                module = i;
+            }
+        }
+        for (int l = LOG_LEVEL_NONE; l <= LOG_LEVEL_TRACE; l++) {
+            if (strcasecmp(value, logger_level_name((log_level_t)l)) == 0) {
+                level = l;
+            }
+        }
+
+        if (module < 0 || level < 0 || logger_set_module_level((log_module_t)module, level) != 0) {
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
+
 // ============================================================================
 // Set Output File
 // ============================================================================
@@ -130,15 +220,12 @@ static const char *logger_level_color(log_level_t level) {
 // ============================================================================
 // Main Logging Function
 // ============================================================================
-void logger_log(log_level_t level, const char *file, int line, const char *format, ...) {
-    if (!logging_enabled || level > current_level) {
-        return;
-    }
-    
+static void logger_vwrite(log_level_t level, const char *file, int line, const char *format, va_list args) {
+    logger_notify_event(level, file, line, format);
+
     // Ensure log_output is initialized (default to stderr if not set)
     FILE *output = (log_output != NULL) ? log_output : stderr;
     
-    va_list args;
     char timestamp[64] = "";
     char file_line[128] = "";
     
@@ -181,14 +268,51 @@ void logger_log(log_level_t level, const char *file, int line, const char *forma
     }
     
     // Print log message
-    va_start(args, format);
     vfprintf(output, format, args);
-    va_end(args);
     
     fprintf(output, "\n");
     fflush(output);
 }
 
+void logger_log(log_level_t level, const char *file, int line, const char *format, ...) {
+    if (!logging_enabled || level > current_level) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    logger_vwrite(level, file, line, format, args);
+    va_end(args);
+}
+
+// ============================================================================
+// Unchecked Write (LOG_* macros have already checked the module level)
+// ============================================================================
+void logger_write(log_level_t level, const char *file, int line, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    logger_vwrite(level, file, line, format, args);
+    va_end(args);
+}
+
+// ============================================================================
+// Event Hook
+// ============================================================================
+void logger_set_event_hook(logger_event_hook_t hook) {
+    __atomic_store_n(&event_hook, hook, __ATOMIC_RELEASE);
+}
+
+void logger_notify_event(log_level_t level, const char *file, int line, const char *format) {
+    if (level > LOG_LEVEL_WARN) {
+        return;
+    }
+
+    logger_event_hook_t hook = __atomic_load_n(&event_hook, __ATOMIC_ACQUIRE);
+    if (hook != NULL) {
+        hook((int)level, file, line, format);
+    }
+}
+
 // ============================================================================
 // Hex Dump
 // ============================================================================
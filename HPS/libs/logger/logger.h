@@ -34,14 +34,67 @@ typedef enum {
 #define LOG_ENABLE_FILE_LINE 1
 #define LOG_ENABLE_COLOR 1
 
+// Compile-time ceiling: calls above this level compile to nothing and their
+// arguments are never evaluated. Release builds use
+// -DLOG_COMPILE_LEVEL=LOG_LEVEL_WARN.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_TRACE
+#endif
+
+// ============================================================================
+// Log Modules
+// ============================================================================
+// Each translation unit may define LOG_MODULE before including logger.h to
+// get its own runtime level (see logger_set_module_level)
+typedef enum {
+    LOG_MODULE_DEFAULT = 0,
+    LOG_MODULE_CALCULATOR = 1,
+    LOG_MODULE_FPGA_UIO = 2,
+    LOG_MODULE_LED = 3,
+    LOG_MODULE_APP = 4,
+    LOG_MODULE_COUNT
+} log_module_t;
+
+#ifndef LOG_MODULE
+#define LOG_MODULE LOG_MODULE_DEFAULT
+#endif
+
+// Effective level per module: global level, module override and the enable
+// switch folded into one byte, recomputed whenever any of them changes
+extern uint8_t logger_module_levels[LOG_MODULE_COUNT];
+
+// True if a message at this level would be printed from the current module.
+// Constant-folds to 0 above LOG_COMPILE_LEVEL.
+#define LOG_ENABLED(level) \
+    ((level) <= LOG_COMPILE_LEVEL && (level) <= logger_module_levels[LOG_MODULE])
+
 // ============================================================================
 // Log Macros
 // ============================================================================
-#define LOG_ERROR(fmt, ...)   logger_log(LOG_LEVEL_ERROR, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_WARN(fmt, ...)    logger_log(LOG_LEVEL_WARN, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_INFO(fmt, ...)    logger_log(LOG_LEVEL_INFO, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_DEBUG(fmt, ...)   logger_log(LOG_LEVEL_DEBUG, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_TRACE(fmt, ...)   logger_log(LOG_LEVEL_TRACE, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
+// The level check is inline and happens before any argument is evaluated.
+// Build with -DLOGGER_ASYNC to route the LOG_* macros through the lock-free
+// asynchronous logger (logger_async.h); logger_async_init() must then be
+// called instead of (or in addition to) logger_init()
+#ifdef LOGGER_ASYNC
+#include "logger_async.h"
+#define LOG_AT(level, fmt, ...) do {                                    \
+    if (LOG_ENABLED(level)) {                                           \
+        ALOG_WRITE(level, fmt, ##__VA_ARGS__);                          \
+    }                                                                   \
+} while (0)
+#else
+#define LOG_AT(level, fmt, ...) do {                                    \
+    if (LOG_ENABLED(level)) {                                           \
+        logger_write(level, __FILE__, __LINE__, fmt, ##__VA_ARGS__);    \
+    }                                                                   \
+} while (0)
+#endif
+
+#define LOG_ERROR(fmt, ...)   LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...)    LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...)    LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...)   LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#define LOG_TRACE(fmt, ...)   LOG_AT(LOG_LEVEL_TRACE, fmt, ##__VA_ARGS__)
 
 // Specialized logging macros for register operations
 #define LOG_REG_READ(offset, value)   LOG_DEBUG("REG READ:  offset=0x%02X, value=0x%08X", offset, value)
@@ -55,6 +108,10 @@ typedef enum {
 #define LOG_OP_ERROR(op, error_code) \
     LOG_ERROR("OP ERROR:  operation=0x%X, error_code=0x%08X", op, error_code)
 
+// Called with the message template for every WARN/ERROR message, before it
+// is formatted (e.g. flight_recorder_log)
+typedef void (*logger_event_hook_t)(int level, const char *file, int line, const char *format);
+
 // ============================================================================
 // Function Prototypes
 // ============================================================================
@@ -74,8 +131,29 @@ void logger_enable(bool enable);
 // Set output file (NULL for stderr)
 void logger_set_output(FILE *output_file);
 
-// Main logging function
-void logger_log(log_level_t level, const char *file, int line, const char *format, ...);
+// Main logging function (filtered against the global level)
+void logger_log(log_level_t level, const char *file, int line, const char *format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+// Emit without a level check (used by LOG_* after the inline module check)
+void logger_write(log_level_t level, const char *file, int line, const char *format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+// Set a module's runtime level (-1 to follow the global level again)
+int logger_set_module_level(log_module_t module, int level);
+
+// Apply module levels from a spec such as "calculator=debug,app=warn"
+// Returns 0 on success, -1 if any entry names an unknown module or level
+int logger_configure_modules(const char *spec);
+
+// Get module name
+const char *logger_module_name(log_module_t module);
+
+// Install a WARN/ERROR event hook (NULL to remove)
+void logger_set_event_hook(logger_event_hook_t hook);
+
+// Pass a WARN/ERROR message template to the event hook, if any
+void logger_notify_event(log_level_t level, const char *file, int line, const char *format);
 
 // Log raw data (hex dump)
 void logger_hex_dump(log_level_t level, const char *label, const void *data, size_t len);
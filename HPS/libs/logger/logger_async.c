@@ -0,0 +1,702 @@
+// ============================================================================
+// Asynchronous Logger - Implementation
+// ============================================================================
+// Lock-free binary logger with deferred formatting
+// Per-thread SPSC rings are drained by a single background writer thread
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include "logger_async.h"
+
+// ============================================================================
+// Internal Definitions
+// ============================================================================
+#define ALOG_ALIGN(n)            (((n) + 7U) & ~(size_t)7U)
+#define ALOG_CACHE_LINE          64
+#define ALOG_DRAIN_BATCH         4096   // Records per writer pass before re-checking state
+#define ALOG_OUTPUT_BUFFER       (1 << 20)
+
+#if (ALOG_RING_BYTES & (ALOG_RING_BYTES - 1)) != 0
+#error "ALOG_RING_BYTES must be a power of two"
+#endif
+
+// Per-thread ring. Producer and consumer fields live on separate cache lines
+// so the hot path never shares a line the writer thread stores to.
+typedef struct alog_ring {
+    // Producer (logging thread)
+    uint64_t head __attribute__((aligned(ALOG_CACHE_LINE)));
+    uint64_t cached_tail;
+    uint64_t dropped;
+    uint32_t thread;
+
+    // Consumer (writer thread)
+    uint64_t tail __attribute__((aligned(ALOG_CACHE_LINE)));
+    uint64_t cached_head;
+    uint64_t reported_dropped;
+    int abandoned;                 // Set when the owning thread exits
+    struct alog_ring *next;
+
+    uint8_t buffer[ALOG_RING_BYTES] __attribute__((aligned(ALOG_CACHE_LINE)));
+} alog_ring_t;
+
+// ============================================================================
+// Static Variables
+// ============================================================================
+volatile int logger_async_level = LOG_LEVEL_NONE;   // Nothing is queued before init
+
+static __thread alog_ring_t *thread_ring = NULL;
+static pthread_key_t ring_key;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT;
+
+static pthread_mutex_t rings_lock = PTHREAD_MUTEX_INITIALIZER;
+static alog_ring_t *rings = NULL;
+static uint32_t next_thread_id = 1;
+static uint64_t reclaimed_dropped = 0;   // Drops of rings already freed
+
+static pthread_t writer_thread;
+static volatile int writer_running = 0;
+static FILE *text_output = NULL;
+static FILE *binary_output = NULL;
+static char *binary_buffer = NULL;
+static uint32_t next_site_id = 1;
+static uint32_t site_generation = 0;     // Bumped per init so every file defines its sites
+
+static alog_calibration_t calibration;   // Current tick -> wall-clock mapping
+static uint64_t base_ticks = 0;          // Tick value at init
+static uint64_t base_mono_ns = 0;        // CLOCK_MONOTONIC at init
+
+// ============================================================================
+// Clock Helpers
+// ============================================================================
+
+static uint64_t logger_async_clock_ns(clockid_t clock) {
+    return logger_ticks_clock_ns(clock);
+}
+
+// Anchor the calibration at the current time, measuring the tick rate over
+// everything since init (the longer the baseline, the better the estimate)
+static void logger_async_calibrate(void) {
+    double ticks_per_sec = logger_ticks_rate(base_ticks, base_mono_ns);
+
+    calibration.ticks = logger_async_ticks();
+    calibration.realtime_ns = logger_async_clock_ns(CLOCK_REALTIME);
+    if (ticks_per_sec > 0.0) {
+        calibration.ticks_per_sec = ticks_per_sec;
+    }
+}
+
+// Initial rate estimate over a short sleep so early messages convert sensibly.
+// Nanosecond ticks (no hardware counter) need no measurement.
+static void logger_async_calibrate_initial(void) {
+    logger_ticks_init();
+    base_ticks = logger_async_ticks();
+    base_mono_ns = logger_async_clock_ns(CLOCK_MONOTONIC);
+    calibration.ticks_per_sec = 1e9;
+
+    if (!logger_ticks_are_ns()) {
+        struct timespec delay = { 0, 10 * 1000 * 1000 };
+        nanosleep(&delay, NULL);
+    }
+    logger_async_calibrate();
+}
+
+// ============================================================================
+// Thread Rings
+// ============================================================================
+
+static void logger_async_thread_exit(void *arg) {
+    alog_ring_t *ring = (alog_ring_t *)arg;
+    __atomic_store_n(&ring->abandoned, 1, __ATOMIC_RELEASE);
+}
+
+static void logger_async_make_key(void) {
+    pthread_key_create(&ring_key, logger_async_thread_exit);
+}
+
+int logger_async_thread_init(void) {
+    if (thread_ring != NULL) {
+        return 0;
+    }
+
+    pthread_once(&ring_key_once, logger_async_make_key);
+
+    void *memory = NULL;
+    if (posix_memalign(&memory, ALOG_CACHE_LINE, sizeof(alog_ring_t)) != 0) {
+        return -1;
+    }
+
+    // Zeroing the whole ring also pre-faults its pages
+    alog_ring_t *ring = (alog_ring_t *)memory;
+    memset(ring, 0, sizeof(*ring));
+
+    pthread_mutex_lock(&rings_lock);
+    ring->thread = next_thread_id++;
+    ring->next = rings;
+    rings = ring;
+    pthread_mutex_unlock(&rings_lock);
+
+    pthread_setspecific(ring_key, ring);
+    thread_ring = ring;
+    return 0;
+}
+
+// ============================================================================
+// Hot Path
+// ============================================================================
+void logger_async_write(alog_site_t *site, const alog_arg_t *args, unsigned int nargs) {
+    uint64_t timestamp = logger_async_ticks();
+    alog_ring_t *ring = thread_ring;
+    size_t lengths[ALOG_MAX_ARGS];
+    size_t string_bytes = 0;
+    unsigned int i;
+
+    logger_notify_event(site->level, site->file, site->line, site->format);
+
+    if (ring == NULL) {
+        if (logger_async_thread_init() != 0) {
+            return;
+        }
+        ring = thread_ring;
+    }
+
+    if (nargs > ALOG_MAX_ARGS) {
+        nargs = ALOG_MAX_ARGS;
+    }
+
+    for (i = 0; i < nargs; i++) {
+        if (args[i].type == ALOG_ARG_STRING) {
+            lengths[i] = (args[i].string != NULL) ? strnlen(args[i].string, ALOG_MAX_STRING_LEN) : 6;
+            string_bytes += lengths[i];
+        }
+    }
+
+    uint32_t size = (uint32_t)ALOG_ALIGN(sizeof(alog_record_t) + nargs * sizeof(uint64_t) + string_bytes);
+    uint64_t head = ring->head;
+    uint32_t offset = (uint32_t)(head & (ALOG_RING_BYTES - 1));
+    uint32_t contiguous = ALOG_RING_BYTES - offset;
+    uint32_t needed = (contiguous < size) ? contiguous + size : size;
+
+    // Only touch the consumer's cache line when the cached view says full
+    if (head + needed - ring->cached_tail > ALOG_RING_BYTES) {
+        ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head + needed - ring->cached_tail > ALOG_RING_BYTES) {
+            __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+
+    // Records never wrap: pad out the tail of the ring and start at offset 0
+    if (contiguous < size) {
+        alog_record_t *pad = (alog_record_t *)(ring->buffer + offset);
+        pad->size = contiguous;
+        pad->type = ALOG_RECORD_PAD;
+        head += contiguous;
+        offset = 0;
+    }
+
+    alog_record_t *record = (alog_record_t *)(ring->buffer + offset);
+    uint64_t *values = (uint64_t *)(record + 1);
+    char *strings = (char *)(values + nargs);
+
+    record->size = size;
+    record->type = ALOG_RECORD_MESSAGE;
+    record->nargs = (uint8_t)nargs;
+    record->level = (uint8_t)site->level;
+    record->thread = ring->thread;
+    record->reserved = 0;
+    record->timestamp = timestamp;
+    record->site = (uint64_t)(uintptr_t)site;
+    memset(record->arg_types, 0, sizeof(record->arg_types));
+
+    for (i = 0; i < nargs; i++) {
+        record->arg_types[i] = args[i].type;
+        if (args[i].type == ALOG_ARG_STRING) {
+            memcpy(strings, (args[i].string != NULL) ? args[i].string : "(null)", lengths[i]);
+            strings += lengths[i];
+            values[i] = lengths[i];
+        } else {
+            values[i] = args[i].value;
+        }
+    }
+
+    __atomic_store_n(&ring->head, head + size, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// Message Formatting
+// ============================================================================
+
+static void logger_async_append(char *buffer, size_t size, size_t *pos, const char *text, size_t len) {
+    if (*pos + 1 >= size) {
+        return;
+    }
+    if (len > size - 1 - *pos) {
+        len = size - 1 - *pos;
+    }
+    memcpy(buffer + *pos, text, len);
+    *pos += len;
+    buffer[*pos] = '\0';
+}
+
+static void logger_async_append_spec(size_t size, size_t *pos, int written) {
+    if (written < 0) {
+        return;
+    }
+    size_t room = size - 1 - *pos;
+    *pos += ((size_t)written < room) ? (size_t)written : room;
+}
+
+static double logger_async_arg_double(uint8_t type, uint64_t value) {
+    double d;
+    switch (type) {
+        case ALOG_ARG_DOUBLE: memcpy(&d, &value, sizeof(d)); return d;
+        case ALOG_ARG_I32:    return (double)(int32_t)value;
+        case ALOG_ARG_U32:    return (double)(uint32_t)value;
+        case ALOG_ARG_I64:    return (double)(int64_t)value;
+        default:              return (double)value;
+    }
+}
+
+size_t logger_async_format(char *buffer, size_t size, const char *format, const alog_record_t *record) {
+    unsigned int nargs = (record->nargs <= ALOG_MAX_ARGS) ? record->nargs : ALOG_MAX_ARGS;
+    const uint64_t *values = (const uint64_t *)(record + 1);
+    const char *strings = (const char *)(values + nargs);
+    const char *strings_end = (const char *)record + record->size;
+    unsigned int arg = 0;
+    size_t pos = 0;
+    const char *p;
+
+    if (size == 0) {
+        return 0;
+    }
+    buffer[0] = '\0';
+
+    for (p = format; *p != '\0'; p++) {
+        if (*p != '%') {
+            const char *end = strchr(p, '%');
+            size_t len = (end != NULL) ? (size_t)(end - p) : strlen(p);
+            logger_async_append(buffer, size, &pos, p, len);
+            p += len - 1;
+            continue;
+        }
+
+        if (p[1] == '%') {
+            logger_async_append(buffer, size, &pos, "%", 1);
+            p++;
+            continue;
+        }
+
+        // Rebuild the conversion with a length modifier matching the stored type
+        const char *start = p;
+        char spec[32];
+        size_t n = 0;
+        spec[n++] = '%';
+        for (p++; *p != '\0' && strchr("-+ #0123456789.", *p) != NULL; p++) {
+            if (n < sizeof(spec) - 4) {
+                spec[n++] = *p;
+            }
+        }
+        while (*p != '\0' && strchr("hljztLq", *p) != NULL) {
+            p++;
+        }
+        if (*p == '\0') {
+            logger_async_append(buffer, size, &pos, start, strlen(start));
+            break;
+        }
+
+        char conversion = *p;
+        if (arg >= nargs || strchr("diouxXcfFeEgGaAsp", conversion) == NULL) {
+            logger_async_append(buffer, size, &pos, start, (size_t)(p - start + 1));
+            continue;
+        }
+
+        uint8_t type = record->arg_types[arg];
+        uint64_t value = values[arg];
+        arg++;
+
+        // String bytes are consumed whatever the conversion, to stay in step
+        char text[ALOG_MAX_STRING_LEN + 1];
+        if (type == ALOG_ARG_STRING) {
+            size_t len = (size_t)value;
+            if (len > ALOG_MAX_STRING_LEN || len > (size_t)(strings_end - strings)) {
+                len = 0;
+            }
+            memcpy(text, strings, len);
+            text[len] = '\0';
+            strings += len;
+        }
+
+        char *out = buffer + pos;
+        size_t room = size - pos;
+        int written;
+
+        switch (conversion) {
+            case 'd':
+            case 'i': {
+                long long v;
+                if (type == ALOG_ARG_I32) {
+                    v = (int32_t)value;
+                } else if (type == ALOG_ARG_U32) {
+                    v = (uint32_t)value;
+                } else if (type == ALOG_ARG_DOUBLE) {
+                    v = (long long)logger_async_arg_double(type, value);
+                } else {
+                    v = (long long)value;
+                }
+                spec[n++] = 'l';
+                spec[n++] = 'l';
+                spec[n++] = conversion;
+                spec[n] = '\0';
+                written = snprintf(out, room, spec, v);
+                break;
+            }
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'c': {
+                unsigned long long v;
+                if (type == ALOG_ARG_I32 || type == ALOG_ARG_U32) {
+                    v = (uint32_t)value;
+                } else if (type == ALOG_ARG_DOUBLE) {
+                    v = (unsigned long long)logger_async_arg_double(type, value);
+                } else {
+                    v = value;
+                }
+                if (conversion == 'c') {
+                    spec[n++] = 'c';
+                    spec[n] = '\0';
+                    written = snprintf(out, room, spec, (int)v);
+                } else {
+                    spec[n++] = 'l';
+                    spec[n++] = 'l';
+                    spec[n++] = conversion;
+                    spec[n] = '\0';
+                    written = snprintf(out, room, spec, v);
+                }
+                break;
+            }
+            case 's':
+                spec[n++] = 's';
+                spec[n] = '\0';
+                written = snprintf(out, room, spec, (type == ALOG_ARG_STRING) ? text : "(?)");
+                break;
+            case 'p':
+                spec[n++] = 'p';
+                spec[n] = '\0';
+                written = snprintf(out, room, spec, (void *)(uintptr_t)value);
+                break;
+            default:
+                spec[n++] = conversion;
+                spec[n] = '\0';
+                written = snprintf(out, room, spec, logger_async_arg_double(type, value));
+                break;
+        }
+
+        logger_async_append_spec(size, &pos, written);
+    }
+
+    return pos;
+}
+
+void logger_async_print(FILE *output, const alog_record_t *record,
+                        const alog_site_t *site, const alog_calibration_t *cal) {
+    char message[1024];
+    char timestamp[64];
+    struct tm tm_info;
+
+    // Signed delta: records queued before the latest calibration are older
+    int64_t delta_ticks = (int64_t)(record->timestamp - cal->ticks);
+    int64_t realtime_ns = (int64_t)cal->realtime_ns + (int64_t)((double)delta_ticks * 1e9 / cal->ticks_per_sec);
+    time_t seconds = (time_t)(realtime_ns / 1000000000LL);
+
+    localtime_r(&seconds, &tm_info);
+    snprintf(timestamp, sizeof(timestamp), "%04d-%02d-%02d %02d:%02d:%02d.%06lld",
+             tm_info.tm_year + 1900, tm_info.tm_mon + 1, tm_info.tm_mday,
+             tm_info.tm_hour, tm_info.tm_min, tm_info.tm_sec,
+             (long long)((realtime_ns % 1000000000LL) / 1000));
+
+    const char *filename = strrchr(site->file, '/');
+    filename = (filename != NULL) ? filename + 1 : site->file;
+
+    logger_async_format(message, sizeof(message), site->format, record);
+    fprintf(output, "[%s] [T%u] [%s:%d] %-5s %s\n",
+            timestamp, record->thread, filename, site->line,
+            logger_level_name((log_level_t)record->level), message);
+}
+
+// ============================================================================
+// Writer Thread - Output
+// ============================================================================
+
+static void logger_async_emit_calibration(void) {
+    if (binary_output == NULL) {
+        return;
+    }
+
+    struct {
+        alog_record_t header;
+        uint64_t realtime_ns;
+        double ticks_per_sec;
+    } entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.header.size = sizeof(entry);
+    entry.header.type = ALOG_RECORD_CALIBRATION;
+    entry.header.timestamp = calibration.ticks;
+    entry.realtime_ns = calibration.realtime_ns;
+    entry.ticks_per_sec = calibration.ticks_per_sec;
+    fwrite(&entry, sizeof(entry), 1, binary_output);
+}
+
+static void logger_async_emit_site(alog_site_t *site) {
+    size_t file_len = strlen(site->file) + 1;
+    size_t format_len = strlen(site->format) + 1;
+    size_t size = ALOG_ALIGN(sizeof(alog_record_t) + sizeof(uint32_t) + file_len + format_len);
+    uint8_t *entry = calloc(1, size);
+
+    site->id = next_site_id++;
+    site->generation = site_generation;
+    if (entry == NULL) {
+        return;
+    }
+
+    alog_record_t *header = (alog_record_t *)entry;
+    uint32_t line = (uint32_t)site->line;
+    header->size = (uint32_t)size;
+    header->type = ALOG_RECORD_SITE;
+    header->level = (uint8_t)site->level;
+    header->site = site->id;
+    memcpy(entry + sizeof(*header), &line, sizeof(line));
+    memcpy(entry + sizeof(*header) + sizeof(line), site->file, file_len);
+    memcpy(entry + sizeof(*header) + sizeof(line) + file_len, site->format, format_len);
+
+    fwrite(entry, size, 1, binary_output);
+    free(entry);
+}
+
+static void logger_async_emit_dropped(const alog_ring_t *ring, uint64_t count) {
+    if (binary_output == NULL) {
+        fprintf(text_output, "[logger_async] [T%u] dropped %llu messages (ring full)\n",
+                ring->thread, (unsigned long long)count);
+        return;
+    }
+
+    struct {
+        alog_record_t header;
+        uint64_t count;
+    } entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.header.size = sizeof(entry);
+    entry.header.type = ALOG_RECORD_DROPPED;
+    entry.header.thread = ring->thread;
+    entry.count = count;
+    fwrite(&entry, sizeof(entry), 1, binary_output);
+}
+
+static void logger_async_emit(const alog_record_t *record) {
+    alog_site_t *site = (alog_site_t *)(uintptr_t)record->site;
+
+    if (binary_output == NULL) {
+        logger_async_print(text_output, record, site, &calibration);
+        return;
+    }
+
+    if (site->generation != site_generation) {
+        logger_async_emit_site(site);
+    }
+
+    alog_record_t header = *record;
+    header.site = site->id;
+    fwrite(&header, sizeof(header), 1, binary_output);
+    fwrite(record + 1, record->size - sizeof(header), 1, binary_output);
+}
+
+// ============================================================================
+// Writer Thread - Draining
+// ============================================================================
+
+// Next unread message of a ring (skipping padding), or NULL if empty
+static alog_record_t *logger_async_peek(alog_ring_t *ring) {
+    for (;;) {
+        if (ring->tail == ring->cached_head) {
+            ring->cached_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+            if (ring->tail == ring->cached_head) {
+                return NULL;
+            }
+        }
+
+        alog_record_t *record = (alog_record_t *)(ring->buffer + (ring->tail & (ALOG_RING_BYTES - 1)));
+        if (record->type != ALOG_RECORD_PAD) {
+            return record;
+        }
+        __atomic_store_n(&ring->tail, ring->tail + record->size, __ATOMIC_RELEASE);
+    }
+}
+
+// Merge all rings in timestamp order, reclaim rings of exited threads
+static size_t logger_async_drain(void) {
+    size_t processed = 0;
+    alog_ring_t **link;
+    alog_ring_t *ring;
+
+    pthread_mutex_lock(&rings_lock);
+
+    while (processed < ALOG_DRAIN_BATCH) {
+        alog_ring_t *oldest_ring = NULL;
+        alog_record_t *oldest = NULL;
+
+        for (ring = rings; ring != NULL; ring = ring->next) {
+            alog_record_t *record = logger_async_peek(ring);
+            if (record != NULL && (oldest == NULL || (int64_t)(record->timestamp - oldest->timestamp) < 0)) {
+                oldest = record;
+                oldest_ring = ring;
+            }
+        }
+
+        if (oldest == NULL) {
+            break;
+        }
+
+        logger_async_emit(oldest);
+        __atomic_store_n(&oldest_ring->tail, oldest_ring->tail + oldest->size, __ATOMIC_RELEASE);
+        processed++;
+    }
+
+    link = &rings;
+    while ((ring = *link) != NULL) {
+        uint64_t dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+        if (dropped != ring->reported_dropped) {
+            logger_async_emit_dropped(ring, dropped - ring->reported_dropped);
+            ring->reported_dropped = dropped;
+        }
+
+        if (__atomic_load_n(&ring->abandoned, __ATOMIC_ACQUIRE) && logger_async_peek(ring) == NULL) {
+            *link = ring->next;
+            reclaimed_dropped += dropped;
+            free(ring);
+            continue;
+        }
+        link = &ring->next;
+    }
+
+    pthread_mutex_unlock(&rings_lock);
+    return processed;
+}
+
+static void *logger_async_writer(void *arg) {
+    (void)arg;
+    uint64_t last_calibration_ns = logger_async_clock_ns(CLOCK_MONOTONIC);
+    FILE *output = (binary_output != NULL) ? binary_output : text_output;
+
+    while (__atomic_load_n(&writer_running, __ATOMIC_ACQUIRE)) {
+        uint64_t now_ns = logger_async_clock_ns(CLOCK_MONOTONIC);
+        if (now_ns - last_calibration_ns >= (uint64_t)ALOG_CALIBRATE_MS * 1000000ULL) {
+            logger_async_calibrate();
+            logger_async_emit_calibration();
+            last_calibration_ns = now_ns;
+        }
+
+        if (logger_async_drain() == 0) {
+            fflush(output);
+            usleep(ALOG_IDLE_SLEEP_US);
+        }
+    }
+
+    // Final drain after producers have been stopped
+    while (logger_async_drain() != 0) {
+    }
+    fflush(output);
+    return NULL;
+}
+
+// ============================================================================
+// Initialize / Shutdown
+// ============================================================================
+int logger_async_init(log_level_t level, FILE *output_file, const char *binary_path) {
+    if (writer_running) {
+        return -1;
+    }
+
+    text_output = (output_file != NULL) ? output_file : stderr;
+    binary_output = NULL;
+    next_site_id = 1;
+    site_generation++;
+
+    if (binary_path != NULL) {
+        binary_output = fopen(binary_path, "wb");
+        if (binary_output == NULL) {
+            return -1;
+        }
+        binary_buffer = malloc(ALOG_OUTPUT_BUFFER);
+        if (binary_buffer != NULL) {
+            setvbuf(binary_output, binary_buffer, _IOFBF, ALOG_OUTPUT_BUFFER);
+        }
+
+        alog_file_header_t header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, ALOG_FILE_MAGIC, sizeof(ALOG_FILE_MAGIC));
+        header.version = ALOG_FILE_VERSION;
+        header.header_size = sizeof(header);
+        fwrite(&header, sizeof(header), 1, binary_output);
+    }
+
+    logger_async_calibrate_initial();
+    logger_async_emit_calibration();
+
+    __atomic_store_n(&writer_running, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&writer_thread, NULL, logger_async_writer, NULL) != 0) {
+        writer_running = 0;
+        if (binary_output != NULL) {
+            fclose(binary_output);
+            binary_output = NULL;
+        }
+        return -1;
+    }
+
+    // Pre-allocate the calling thread's ring so its first message is cheap
+    logger_async_thread_init();
+    logger_async_level = level;
+    return 0;
+}
+
+void logger_async_shutdown(void) {
+    if (!writer_running) {
+        return;
+    }
+
+    logger_async_level = LOG_LEVEL_NONE;
+    __atomic_store_n(&writer_running, 0, __ATOMIC_RELEASE);
+    pthread_join(writer_thread, NULL);
+
+    if (binary_output != NULL) {
+        fclose(binary_output);
+        binary_output = NULL;
+        free(binary_buffer);
+        binary_buffer = NULL;
+    }
+}
+
+void logger_async_set_level(log_level_t level) {
+    logger_async_level = level;
+}
+
+uint64_t logger_async_dropped(void) {
+    uint64_t total;
+    alog_ring_t *ring;
+
+    pthread_mutex_lock(&rings_lock);
+    total = reclaimed_dropped;
+    for (ring = rings; ring != NULL; ring = ring->next) {
+        total += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&rings_lock);
+
+    return total;
+}
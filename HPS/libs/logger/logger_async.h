@@ -0,0 +1,331 @@
+// ============================================================================
+// Asynchronous Logger - Header
+// ============================================================================
+// Lock-free binary logger with deferred formatting
+//
+// The calling thread only copies a static call-site pointer, a raw timestamp
+// and the arguments into its own single-producer/single-consumer ring. A
+// background writer thread drains every ring and either formats the text
+// (same layout as logger_log) or writes the binary records to a file that
+// log_decode turns back into text offline.
+//
+// No locks, no syscalls and no formatting on the logging thread. The only
+// exception is the first message of a thread, which allocates its ring;
+// call logger_async_thread_init() at thread start to move that off the hot
+// path.
+// ============================================================================
+
+#ifndef HPS_LOGGER_ASYNC_H
+#define HPS_LOGGER_ASYNC_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+#include "logger.h"
+#include "logger_ticks.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define ALOG_MAX_ARGS        8        // Arguments captured per message
+#define ALOG_MAX_STRING_LEN  128      // Longer string arguments are truncated
+#define ALOG_RING_BYTES      65536    // Per-thread ring size (power of two)
+#define ALOG_IDLE_SLEEP_US   1000     // Writer poll interval when all rings are empty
+#define ALOG_CALIBRATE_MS    1000     // Writer re-calibrates the tick rate this often
+
+// ============================================================================
+// Argument Type Tags
+// ============================================================================
+// Integers keep their width so %x of a negative int prints 32 bits, as printf
+// would. Floats are promoted to double exactly like a variadic call.
+typedef enum {
+    ALOG_ARG_I32 = 1,
+    ALOG_ARG_U32 = 2,
+    ALOG_ARG_I64 = 3,
+    ALOG_ARG_U64 = 4,
+    ALOG_ARG_DOUBLE = 5,
+    ALOG_ARG_STRING = 6,   // Copied into the record, value holds the length
+    ALOG_ARG_POINTER = 7
+} alog_arg_type_t;
+
+typedef struct {
+    uint8_t type;          // alog_arg_type_t
+    const char *string;    // ALOG_ARG_STRING only (copied before return)
+    uint64_t value;        // Raw bits (doubles stored bit-for-bit)
+} alog_arg_t;
+
+// ============================================================================
+// Record Types
+// ============================================================================
+typedef enum {
+    ALOG_RECORD_PAD = 0,          // Ring only: skip to the start of the ring
+    ALOG_RECORD_MESSAGE = 1,      // Log message
+    ALOG_RECORD_SITE = 2,         // File only: call-site definition
+    ALOG_RECORD_CALIBRATION = 3,  // File only: tick to wall-clock mapping
+    ALOG_RECORD_DROPPED = 4       // File only: messages lost to a full ring
+} alog_record_type_t;
+
+// ============================================================================
+// Record Layout
+// ============================================================================
+// Every record (in a ring and in a binary file) starts with this header and
+// is padded to a multiple of 8 bytes. Message records are followed by nargs
+// 64-bit values, then the bytes of each string argument in order.
+typedef struct {
+    uint32_t size;                      // Total record size in bytes
+    uint16_t type;                      // alog_record_type_t
+    uint8_t  nargs;                     // Number of captured arguments
+    uint8_t  level;                     // log_level_t of the message
+    uint32_t thread;                    // Writer-assigned thread number (files)
+    uint32_t reserved;
+    uint64_t timestamp;                 // Raw ticks from logger_async_ticks()
+    uint64_t site;                      // Site pointer (ring) or site id (file)
+    uint8_t  arg_types[ALOG_MAX_ARGS];  // alog_arg_type_t per argument
+} alog_record_t;
+
+// Static per-call-site data, emitted once per site into binary files
+typedef struct {
+    const char *format;
+    const char *file;
+    int line;
+    log_level_t level;
+    uint32_t id;                        // Assigned by the writer thread
+    uint32_t generation;                // Writer session the id belongs to
+} alog_site_t;
+
+// Maps raw ticks to wall-clock time
+typedef struct {
+    uint64_t ticks;                     // Tick value at the anchor
+    uint64_t realtime_ns;               // CLOCK_REALTIME at the anchor
+    double ticks_per_sec;               // Tick rate
+} alog_calibration_t;
+
+// ============================================================================
+// Binary File Format
+// ============================================================================
+// File header, then a stream of records. Sites and calibrations always
+// appear before the first message that needs them.
+#define ALOG_FILE_MAGIC    "HPSALOG"
+#define ALOG_FILE_VERSION  1
+
+typedef struct {
+    char magic[8];                      // ALOG_FILE_MAGIC, NUL-padded
+    uint32_t version;                   // ALOG_FILE_VERSION
+    uint32_t header_size;               // sizeof(alog_file_header_t)
+} alog_file_header_t;
+
+// ============================================================================
+// Time Source
+// ============================================================================
+
+/**
+ * Read the raw logger tick counter
+ *
+ * See logger_ticks.h: TSC on x86, the virtual counter on AArch64 and the
+ * Cortex-A9 global timer on ARMv7 once logger_async_init() has mapped it.
+ * Without that mapping the ticks are CLOCK_MONOTONIC nanoseconds, which on
+ * the A9 costs a syscall per message.
+ *
+ * Returns: Monotonic tick count (rate recorded in the calibration)
+ */
+static inline uint64_t logger_async_ticks(void) {
+    return logger_ticks_read();
+}
+
+// ============================================================================
+// Argument Capture
+// ============================================================================
+// Type dispatch happens at compile time through _Generic; each helper is a
+// couple of stores. Anything that is not an integer, float or char pointer
+// is captured as a pointer.
+
+static inline alog_arg_t alog_arg_i32(int32_t v) {
+    alog_arg_t a = { ALOG_ARG_I32, NULL, (uint64_t)(int64_t)v };
+    return a;
+}
+
+static inline alog_arg_t alog_arg_u32(uint32_t v) {
+    alog_arg_t a = { ALOG_ARG_U32, NULL, v };
+    return a;
+}
+
+static inline alog_arg_t alog_arg_i64(int64_t v) {
+    alog_arg_t a = { ALOG_ARG_I64, NULL, (uint64_t)v };
+    return a;
+}
+
+static inline alog_arg_t alog_arg_u64(uint64_t v) {
+    alog_arg_t a = { ALOG_ARG_U64, NULL, v };
+    return a;
+}
+
+static inline alog_arg_t alog_arg_double(double v) {
+    alog_arg_t a = { ALOG_ARG_DOUBLE, NULL, 0 };
+    __builtin_memcpy(&a.value, &v, sizeof(v));
+    return a;
+}
+
+static inline alog_arg_t alog_arg_string(const char *s) {
+    alog_arg_t a = { ALOG_ARG_STRING, s, 0 };
+    return a;
+}
+
+static inline alog_arg_t alog_arg_pointer(const volatile void *p) {
+    alog_arg_t a = { ALOG_ARG_POINTER, NULL, (uint64_t)(uintptr_t)p };
+    return a;
+}
+
+// long follows the ABI width so %lx prints like printf on ILP32 (ARM) too
+#if __SIZEOF_LONG__ == 4
+#define ALOG_ARG_LONG   alog_arg_i32
+#define ALOG_ARG_ULONG  alog_arg_u32
+#else
+#define ALOG_ARG_LONG   alog_arg_i64
+#define ALOG_ARG_ULONG  alog_arg_u64
+#endif
+
+#define ALOG_ARG(x) _Generic((x),                          \
+    _Bool: alog_arg_u32,                                   \
+    char: alog_arg_i32,                                    \
+    signed char: alog_arg_i32,                             \
+    unsigned char: alog_arg_u32,                           \
+    short: alog_arg_i32,                                   \
+    unsigned short: alog_arg_u32,                          \
+    int: alog_arg_i32,                                     \
+    unsigned int: alog_arg_u32,                            \
+    long: ALOG_ARG_LONG,                                   \
+    unsigned long: ALOG_ARG_ULONG,                         \
+    long long: alog_arg_i64,                               \
+    unsigned long long: alog_arg_u64,                      \
+    float: alog_arg_double,                                \
+    double: alog_arg_double,                               \
+    char *: alog_arg_string,                               \
+    const char *: alog_arg_string,                         \
+    default: alog_arg_pointer)(x)
+
+// Argument counting / mapping (0 to ALOG_MAX_ARGS arguments)
+#define ALOG_NARGS(...) ALOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define ALOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+
+#define ALOG_CAT(a, b)  ALOG_CAT_(a, b)
+#define ALOG_CAT_(a, b) a##b
+
+#define ALOG_MAP_0()
+#define ALOG_MAP_1(a)                      ALOG_ARG(a),
+#define ALOG_MAP_2(a, b)                   ALOG_ARG(a), ALOG_MAP_1(b)
+#define ALOG_MAP_3(a, b, c)                ALOG_ARG(a), ALOG_MAP_2(b, c)
+#define ALOG_MAP_4(a, b, c, d)             ALOG_ARG(a), ALOG_MAP_3(b, c, d)
+#define ALOG_MAP_5(a, b, c, d, e)          ALOG_ARG(a), ALOG_MAP_4(b, c, d, e)
+#define ALOG_MAP_6(a, b, c, d, e, f)       ALOG_ARG(a), ALOG_MAP_5(b, c, d, e, f)
+#define ALOG_MAP_7(a, b, c, d, e, f, g)    ALOG_ARG(a), ALOG_MAP_6(b, c, d, e, f, g)
+#define ALOG_MAP_8(a, b, c, d, e, f, g, h) ALOG_ARG(a), ALOG_MAP_7(b, c, d, e, f, g, h)
+
+// ============================================================================
+// Log Macros
+// ============================================================================
+// Each call site owns a static alog_site_t; only its address is queued
+
+extern volatile int logger_async_level;
+
+#define ALOG_WRITE(lvl, fmt, ...) do {                                              \
+    static alog_site_t alog_site_ = { fmt, __FILE__, __LINE__, lvl, 0, 0 };        \
+    alog_arg_t alog_args_[ALOG_NARGS(__VA_ARGS__) + 1] = {                          \
+        ALOG_CAT(ALOG_MAP_, ALOG_NARGS(__VA_ARGS__))(__VA_ARGS__)                   \
+    };                                                                              \
+    logger_async_write(&alog_site_, alog_args_, ALOG_NARGS(__VA_ARGS__));           \
+} while (0)
+
+#define ALOG(lvl, fmt, ...) do {                                                    \
+    if ((int)(lvl) <= logger_async_level) {                                         \
+        ALOG_WRITE(lvl, fmt, ##__VA_ARGS__);                                        \
+    }                                                                               \
+} while (0)
+
+#define ALOG_ERROR(fmt, ...)  ALOG(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define ALOG_WARN(fmt, ...)   ALOG(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define ALOG_INFO(fmt, ...)   ALOG(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define ALOG_DEBUG(fmt, ...)  ALOG(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#define ALOG_TRACE(fmt, ...)  ALOG(LOG_LEVEL_TRACE, fmt, ##__VA_ARGS__)
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+/**
+ * Start the asynchronous logger and its writer thread
+ *
+ * @param level        Maximum level that is queued
+ * @param text_output  Stream for formatted text (NULL for stderr), used when
+ *                     binary_path is NULL
+ * @param binary_path  If non-NULL, write binary records to this file instead
+ *                     of formatting them (decode with log_decode)
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int logger_async_init(log_level_t level, FILE *text_output, const char *binary_path);
+
+/**
+ * Drain every ring, stop the writer thread and close the output
+ */
+void logger_async_shutdown(void);
+
+/**
+ * Allocate the calling thread's ring ahead of its first message
+ *
+ * Returns: 0 on success, -1 on allocation failure
+ */
+int logger_async_thread_init(void);
+
+/**
+ * Set the maximum level that is queued
+ */
+void logger_async_set_level(log_level_t level);
+
+/**
+ * Queue one message (called by the ALOG macros)
+ *
+ * Never blocks: if the thread's ring is full the message is dropped and
+ * counted. The writer reports drops in the output stream.
+ *
+ * @param site  Static call-site data
+ * @param args  Captured arguments
+ * @param nargs Number of arguments (at most ALOG_MAX_ARGS)
+ */
+void logger_async_write(alog_site_t *site, const alog_arg_t *args, unsigned int nargs);
+
+/**
+ * Get the total number of messages dropped across all threads
+ */
+uint64_t logger_async_dropped(void);
+
+/**
+ * Format a message record's arguments with its printf-style format
+ *
+ * Shared by the writer thread and log_decode. Conversions are matched to the
+ * captured argument types; '*' widths and %n are not supported.
+ *
+ * @param buffer Output buffer
+ * @param size   Output buffer size
+ * @param format Call-site format string
+ * @param record Message record (header followed by its payload)
+ *
+ * Returns: Number of characters written (excluding the terminator)
+ */
+size_t logger_async_format(char *buffer, size_t size, const char *format, const alog_record_t *record);
+
+/**
+ * Print a message record as one text line
+ *
+ * Layout matches logger_log: [timestamp] [T<thread>] [file:line] LEVEL message
+ *
+ * @param output Output stream
+ * @param record Message record
+ * @param site   Call-site data for the record
+ * @param cal    Calibration used to convert the timestamp
+ */
+void logger_async_print(FILE *output, const alog_record_t *record,
+                        const alog_site_t *site, const alog_calibration_t *cal);
+
+#endif // HPS_LOGGER_ASYNC_H
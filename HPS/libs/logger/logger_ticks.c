@@ -0,0 +1,82 @@
+// ============================================================================
+// Logger Tick Source - Implementation
+// ============================================================================
+// Cheap raw timestamp counter for hot-path event stamping
+// ============================================================================
+
+#include <stdio.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "logger_ticks.h"
+
+// ============================================================================
+// Static Variables
+// ============================================================================
+volatile const uint32_t *logger_ticks_gtimer = NULL;
+
+static bool ticks_initialized = false;
+static bool ticks_ns = true;
+
+// ============================================================================
+// Initialize
+// ============================================================================
+int logger_ticks_init(void) {
+    if (ticks_initialized) {
+        return ticks_ns ? -1 : 0;
+    }
+    ticks_initialized = true;
+
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+    ticks_ns = false;
+#elif defined(__arm__)
+    // The mapping is kept for the life of the process; the fd is not needed
+    int fd = open("/dev/mem", O_RDONLY | O_SYNC);
+    if (fd >= 0) {
+        void *page = mmap(NULL, (size_t)sysconf(_SC_PAGESIZE), PROT_READ, MAP_SHARED,
+                          fd, LOGGER_TICKS_PRIVATE_BASE);
+        close(fd);
+
+        if (page != MAP_FAILED) {
+            volatile const uint32_t *gtimer =
+                (volatile const uint32_t *)((const char *)page + LOGGER_TICKS_GTIMER_OFFSET);
+            if (gtimer[2] & LOGGER_TICKS_GTIMER_ENABLE) {
+                logger_ticks_gtimer = gtimer;
+                ticks_ns = false;
+            } else {
+                munmap(page, (size_t)sysconf(_SC_PAGESIZE));
+            }
+        }
+    }
+#endif
+
+    return ticks_ns ? -1 : 0;
+}
+
+bool logger_ticks_are_ns(void) {
+    return ticks_ns;
+}
+
+// ============================================================================
+// Calibration
+// ============================================================================
+uint64_t logger_ticks_clock_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+double logger_ticks_rate(uint64_t base_ticks, uint64_t base_mono_ns) {
+    if (ticks_ns) {
+        return 1e9;
+    }
+
+    uint64_t ticks = logger_ticks_read();
+    uint64_t mono_ns = logger_ticks_clock_ns(CLOCK_MONOTONIC);
+    if (mono_ns <= base_mono_ns) {
+        return 0.0;
+    }
+    return (double)(ticks - base_ticks) * 1e9 / (double)(mono_ns - base_mono_ns);
+}
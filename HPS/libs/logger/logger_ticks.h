@@ -0,0 +1,108 @@
+// ============================================================================
+// Logger Tick Source - Header
+// ============================================================================
+// Cheap raw timestamp counter for hot-path event stamping
+//
+// Shared by the asynchronous logger and the flight recorder. Reading it never
+// enters the kernel. Ticks are converted to time later, from a rate measured
+// against CLOCK_MONOTONIC.
+//
+//   x86      TSC (rdtsc)
+//   AArch64  Virtual counter (cntvct_el0)
+//   ARMv7    Cortex-A9 MPCore global timer, mapped from /dev/mem by
+//            logger_ticks_init(). The A9 has no user-readable 64-bit counter
+//            (PMCCNTR is per core and user access needs a kernel module). The
+//            global timer runs at PERIPHCLK and is shared by both cores.
+//
+// Without a mapped global timer (no root, timer disabled, other 32-bit
+// targets) the ticks are CLOCK_MONOTONIC nanoseconds. On the A9 that is a
+// real syscall: the 32-bit ARM vDSO only serves clock_gettime() from the
+// architected generic timer, which the A9 does not have.
+// ============================================================================
+
+#ifndef HPS_LOGGER_TICKS_H
+#define HPS_LOGGER_TICKS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define LOGGER_TICKS_PRIVATE_BASE   0xFFFEC000U   // Cortex-A9 MPCore private peripherals
+#define LOGGER_TICKS_GTIMER_OFFSET  0x200U        // Global timer within that page
+#define LOGGER_TICKS_GTIMER_ENABLE  0x1U          // Control register: timer enable
+
+// Global timer mapping (ARMv7 only): counter low, counter high, control.
+// NULL until logger_ticks_init() maps an enabled timer.
+extern volatile const uint32_t *logger_ticks_gtimer;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+/**
+ * Select the tick source
+ *
+ * On ARMv7 maps the global timer once (needs read access to /dev/mem, which
+ * the calculator driver already requires). Call before starting threads that
+ * read ticks. Safe to call more than once.
+ *
+ * Returns: 0 if ticks come from a hardware counter, -1 if they are
+ *          CLOCK_MONOTONIC nanoseconds
+ */
+int logger_ticks_init(void);
+
+/**
+ * Check whether ticks are CLOCK_MONOTONIC nanoseconds (no calibration needed)
+ */
+bool logger_ticks_are_ns(void);
+
+/**
+ * Measure the tick rate since a reference point
+ *
+ * @param base_ticks    Tick value at the reference point
+ * @param base_mono_ns  CLOCK_MONOTONIC (ns) at the same instant
+ *
+ * Returns: Ticks per second, or 0 if no time has passed
+ */
+double logger_ticks_rate(uint64_t base_ticks, uint64_t base_mono_ns);
+
+/**
+ * Read CLOCK_MONOTONIC or CLOCK_REALTIME in nanoseconds
+ */
+uint64_t logger_ticks_clock_ns(clockid_t clock);
+
+/**
+ * Read the raw tick counter
+ *
+ * Returns: Monotonic tick count (rate from logger_ticks_rate())
+ */
+static inline uint64_t logger_ticks_read(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+#if defined(__arm__)
+    volatile const uint32_t *gtimer = logger_ticks_gtimer;
+    if (gtimer != NULL) {
+        // High, low, high: retry if the low word wrapped between the reads
+        uint32_t hi, lo;
+        do {
+            hi = gtimer[1];
+            lo = gtimer[0];
+        } while (gtimer[1] != hi);
+        return ((uint64_t)hi << 32) | lo;
+    }
+#endif
+    return logger_ticks_clock_ns(CLOCK_MONOTONIC);
+#endif
+}
+
+#endif // HPS_LOGGER_TICKS_H
@@ -0,0 +1,94 @@
+// ============================================================================
+// Market Data - Common Definitions
+// ============================================================================
+// Wire format of the test feed and the interface between the receive stage
+// (socket or packet ring) and the decode stage
+//
+// A receiver hands the decode stage an array of md_packet_t descriptors that
+// point straight into its receive buffers; nothing is copied. The payload is
+// valid until the handler returns.
+// ============================================================================
+
+#ifndef HPS_MARKET_DATA_H
+#define HPS_MARKET_DATA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define MD_DEFAULT_GROUP       "239.1.1.1"
+#define MD_DEFAULT_PORT        31001
+#define MD_MAX_DATAGRAM        2048     // Receive buffer slot size (fits a 1500 MTU frame)
+#define MD_MAX_BATCH           64       // Datagrams per receive call
+
+// ============================================================================
+// Wire Format (little-endian, both ends are ARM or x86)
+// ============================================================================
+#define MD_MAGIC               0x444D   // "MD"
+#define MD_VERSION             1
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;        // MD_MAGIC
+    uint8_t  version;      // MD_VERSION
+    uint8_t  line;         // Feed line the sender put it on (0 = A, 1 = B)
+    uint16_t tick_count;   // md_tick_t records following the header
+    uint16_t reserved;
+    uint64_t sequence;     // Per-feed datagram sequence number, starts at 1
+    uint64_t send_ns;      // CLOCK_REALTIME at the sender
+} md_packet_header_t;      // 24 bytes
+
+typedef struct __attribute__((packed)) {
+    char  symbol[8];       // NUL-padded
+    float price;
+    float volume;
+} md_tick_t;               // 16 bytes
+
+// ============================================================================
+// Receive -> Decode Interface
+// ============================================================================
+typedef struct {
+    const uint8_t *data;   // UDP payload, inside the receiver's buffer
+    uint32_t length;       // Payload bytes
+    uint32_t line;         // Receiver-assigned line index
+    uint64_t rx_ns;        // CLOCK_REALTIME receive time (kernel timestamp when enabled)
+} md_packet_t;
+
+/**
+ * Decode-stage callback
+ *
+ * @param packets Batch of received datagrams (valid until return)
+ * @param count   Number of entries in packets
+ * @param context Caller context given to the receiver
+ */
+typedef void (*md_packet_handler_t)(const md_packet_t *packets, uint32_t count, void *context);
+
+/**
+ * Validate a datagram and locate its header and ticks in place
+ *
+ * @param packet Received datagram
+ * @param header Header output (points into the datagram)
+ * @param ticks  Tick array output (points into the datagram, unaligned)
+ *
+ * Returns: Number of ticks, or -1 if the datagram is not a valid feed packet
+ */
+static inline int md_decode(const md_packet_t *packet, const md_packet_header_t **header,
+                            const md_tick_t **ticks) {
+    if (packet->length < sizeof(md_packet_header_t)) {
+        return -1;
+    }
+
+    const md_packet_header_t *h = (const md_packet_header_t *)packet->data;
+    if (h->magic != MD_MAGIC || h->version != MD_VERSION || h->sequence == 0 ||
+        packet->length < sizeof(*h) + (size_t)h->tick_count * sizeof(md_tick_t)) {
+        return -1;
+    }
+
+    *header = h;
+    *ticks = (const md_tick_t *)(packet->data + sizeof(*h));
+    return h->tick_count;
+}
+
+#endif // HPS_MARKET_DATA_H
@@ -0,0 +1,160 @@
+// ============================================================================
+// Market Data A/B Line Arbiter - Implementation
+// ============================================================================
+// First-copy-wins arbitration over a sliding bitset window
+// ============================================================================
+
+#include <string.h>
+#include "md_arbiter.h"
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static inline bool seen_test(const md_arbiter_t *arb, uint64_t index) {
+    return (arb->seen[index >> 6] >> (index & 63)) & 1;
+}
+
+// Move the window start to new_base; sequence numbers that leave the window
+// without having been seen are lost on both lines
+static void window_slide(md_arbiter_t *arb, uint64_t new_base) {
+    uint64_t distance = new_base - arb->base;
+
+    if (distance >= MD_ARB_WINDOW) {
+        uint64_t seen = 0;
+        for (uint32_t w = 0; w < MD_ARB_WORDS; w++) {
+            seen += (uint64_t)__builtin_popcountll(arb->seen[w]);
+            arb->seen[w] = 0;
+        }
+        arb->lost += MD_ARB_WINDOW - seen + (distance - MD_ARB_WINDOW);
+        arb->base = new_base;
+        return;
+    }
+
+    while (arb->base < new_base) {
+        uint64_t index = arb->base & (MD_ARB_WINDOW - 1);
+
+        if ((index & 63) == 0 && new_base - arb->base >= 64) {
+            // Whole word leaves at once
+            arb->lost += 64 - (uint64_t)__builtin_popcountll(arb->seen[index >> 6]);
+            arb->seen[index >> 6] = 0;
+            arb->base += 64;
+        } else {
+            if (!seen_test(arb, index)) {
+                arb->lost++;
+            }
+            arb->seen[index >> 6] &= ~(1ULL << (index & 63));
+            arb->base++;
+        }
+    }
+}
+
+// Count the sequence numbers still missing up to highest as lost and empty
+// the window
+static void window_flush(md_arbiter_t *arb) {
+    for (uint64_t sequence = arb->base; sequence <= arb->highest; sequence++) {
+        if (!seen_test(arb, sequence & (MD_ARB_WINDOW - 1))) {
+            arb->lost++;
+        }
+    }
+    memset(arb->seen, 0, sizeof(arb->seen));
+}
+
+// Far from the stream in either direction: corrupt, foreign or a restart
+static bool out_of_range(const md_arbiter_t *arb, uint64_t sequence) {
+    uint64_t newest = arb->highest > arb->base ? arb->highest : arb->base;
+
+    return (sequence > newest && sequence - newest > MD_ARB_RESYNC_GAP) ||
+           (sequence < arb->base && arb->base - sequence > MD_ARB_RESYNC_GAP);
+}
+
+// ============================================================================
+// Arbiter
+// ============================================================================
+void md_arbiter_init(md_arbiter_t *arb) {
+    memset(arb, 0, sizeof(*arb));
+    histogram_init(&arb->lines[0].lag, "line A lag behind B");
+    histogram_init(&arb->lines[1].lag, "line B lag behind A");
+}
+
+bool md_arbiter_accept(md_arbiter_t *arb, uint32_t line, uint64_t sequence, uint64_t rx_ns) {
+    md_arb_line_stats_t *stats = &arb->lines[line & 1];
+
+    stats->received++;
+    if (!arb->started) {
+        arb->started = true;
+        arb->base = sequence;
+    } else if (out_of_range(arb, sequence)) {
+        uint64_t candidate = arb->resync_candidate;
+
+        arb->resync_candidate = sequence;
+        if (candidate == 0 || sequence <= candidate || sequence - candidate >= MD_ARB_WINDOW) {
+            stats->out_of_range++;
+            return false;
+        }
+
+        // Two distinct sequence numbers agree: restart the window at the
+        // first of them (which was dropped, so it counts as lost)
+        window_flush(arb);
+        arb->base = candidate;
+        arb->highest = candidate;
+        arb->resyncs++;
+        arb->resync_candidate = 0;
+    }
+
+    if (sequence < arb->base) {
+        stats->stale++;
+        return false;
+    }
+    if (sequence >= arb->base + MD_ARB_WINDOW) {
+        window_slide(arb, sequence - MD_ARB_WINDOW + 1);
+    }
+
+    uint64_t index = sequence & (MD_ARB_WINDOW - 1);
+    if (seen_test(arb, index)) {
+        stats->late++;
+        if (arb->first_line[index] != (line & 1) && rx_ns >= arb->first_rx_ns[index]) {
+            histogram_record(&stats->lag, rx_ns - arb->first_rx_ns[index]);
+        }
+        return false;
+    }
+
+    arb->seen[index >> 6] |= 1ULL << (index & 63);
+    arb->first_rx_ns[index] = rx_ns;
+    arb->first_line[index] = (uint8_t)(line & 1);
+    stats->wins++;
+    arb->forwarded++;
+    if (sequence > arb->highest) {
+        arb->highest = sequence;
+    }
+    return true;
+}
+
+void md_arbiter_finish(md_arbiter_t *arb) {
+    if (!arb->started) {
+        return;
+    }
+    // Everything up to highest is now accounted for
+    window_flush(arb);
+    arb->base = arb->highest + 1;
+}
+
+void md_arbiter_print(const md_arbiter_t *arb, FILE *output) {
+    static const char *names[MD_ARB_LINES] = { "A", "B" };
+
+    fprintf(output, "  arbiter: %llu forwarded, %llu lost on both lines, %llu resyncs\n",
+            (unsigned long long)arb->forwarded, (unsigned long long)arb->lost,
+            (unsigned long long)arb->resyncs);
+    for (uint32_t l = 0; l < MD_ARB_LINES; l++) {
+        const md_arb_line_stats_t *stats = &arb->lines[l];
+
+        fprintf(output, "  line %s: %llu received, %llu wins (%.1f%%), %llu late, %llu stale, "
+                "%llu out of range, lag p50 %llu ns, p99 %llu ns\n",
+                names[l], (unsigned long long)stats->received, (unsigned long long)stats->wins,
+                arb->forwarded ? 100.0 * (double)stats->wins / (double)arb->forwarded : 0.0,
+                (unsigned long long)stats->late, (unsigned long long)stats->stale,
+                (unsigned long long)stats->out_of_range,
+                (unsigned long long)histogram_percentile(&stats->lag, 50.0),
+                (unsigned long long)histogram_percentile(&stats->lag, 99.0));
+    }
+}
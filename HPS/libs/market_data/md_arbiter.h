@@ -0,0 +1,96 @@
+// ============================================================================
+// Market Data A/B Line Arbiter - Header
+// ============================================================================
+// Exchanges publish the same feed on two lines (A and B). The arbiter takes
+// datagrams from both and forwards each sequence number exactly once, from
+// whichever line delivered it first, so every packet gets the earlier of
+// its two copies and a loss on one line is covered by the other.
+//
+// Seen sequence numbers are tracked in a fixed sliding bitset window: no
+// allocation and no hashing per message. A sequence number that slides out
+// of the window without arriving on either line is counted as lost. Copies
+// older than the window are dropped.
+//
+// A sequence number more than MD_ARB_RESYNC_GAP away from the stream is not
+// taken as a jump on its own: a single corrupt or foreign datagram would
+// otherwise push the window past every genuine packet. It is dropped and
+// remembered; a second, different one within MD_ARB_WINDOW after it
+// confirms a feed restart or jump, and the window resynchronises there
+// (counted in resyncs rather than as loss).
+// ============================================================================
+
+#ifndef HPS_MD_ARBITER_H
+#define HPS_MD_ARBITER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "histogram.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define MD_ARB_LINES          2
+#define MD_ARB_WINDOW         4096     // Sequence numbers tracked (power of 2)
+#define MD_ARB_WORDS          (MD_ARB_WINDOW / 64)
+#define MD_ARB_RESYNC_GAP     (16 * MD_ARB_WINDOW)  // Larger jumps need confirming
+
+// ============================================================================
+// Arbiter State
+// ============================================================================
+typedef struct {
+    uint64_t received;       // Valid datagrams from this line
+    uint64_t wins;           // Sequence numbers this line delivered first
+    uint64_t late;           // Copies that arrived after the other line's
+    uint64_t stale;          // Copies older than the window
+    uint64_t out_of_range;   // More than MD_ARB_RESYNC_GAP from the stream
+    histogram_t lag;         // How far behind the winning copy this line's copies were (ns)
+} md_arb_line_stats_t;
+
+typedef struct {
+    bool started;                         // A sequence number has been seen
+    uint64_t base;                        // Oldest sequence in the window
+    uint64_t highest;                     // Highest sequence forwarded
+    uint64_t seen[MD_ARB_WORDS];          // Bit per sequence in [base, base + MD_ARB_WINDOW)
+    uint64_t first_rx_ns[MD_ARB_WINDOW];  // Receive time of the winning copy
+    uint8_t first_line[MD_ARB_WINDOW];    // Line of the winning copy
+    uint64_t forwarded;                   // Sequence numbers forwarded
+    uint64_t lost;                        // Sequence numbers missing on both lines
+    uint64_t resyncs;                     // Confirmed restarts or jumps
+    uint64_t resync_candidate;            // Last out-of-range sequence (0 = none)
+    md_arb_line_stats_t lines[MD_ARB_LINES];
+} md_arbiter_t;
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+/**
+ * Initialize (or clear) an arbiter
+ */
+void md_arbiter_init(md_arbiter_t *arb);
+
+/**
+ * Decide whether a datagram is the first copy of its sequence number
+ *
+ * @param arb      Arbiter
+ * @param line     Line it arrived on (0 = A, 1 = B)
+ * @param sequence Datagram sequence number (>= 1)
+ * @param rx_ns    Receive timestamp (used for the lag histograms)
+ *
+ * Returns: true to forward it, false if it is a duplicate or too old
+ */
+bool md_arbiter_accept(md_arbiter_t *arb, uint32_t line, uint64_t sequence, uint64_t rx_ns);
+
+/**
+ * Count the sequence numbers still missing below the highest one forwarded
+ * as lost (call once at end of stream, before reading arb->lost)
+ */
+void md_arbiter_finish(md_arbiter_t *arb);
+
+/**
+ * Print per-line win rate, late/stale copies and lag percentiles
+ */
+void md_arbiter_print(const md_arbiter_t *arb, FILE *output);
+
+#endif // HPS_MD_ARBITER_H
@@ -0,0 +1,344 @@
+// ============================================================================
+// Market Data Packet Ring Receiver - Implementation
+// ============================================================================
+// AF_PACKET TPACKET_V3 receive with an attached BPF filter
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/filter.h>
+#include "md_packet_ring.h"
+
+#define MD_RING_FRAME_SIZE     2048
+#define MD_RING_POLL_MS        100
+#define ETH_HEADER_LEN         14
+#define IP_MIN_HEADER_LEN      20
+#define UDP_HEADER_LEN         8
+
+// ============================================================================
+// BPF Filter
+// ============================================================================
+// Offsets are for an Ethernet frame (also what lo delivers):
+//   [12] ethertype, [14] IPv4 header (ihl in the low nibble),
+//   [20] flags/fragment offset, [23] protocol, [30] destination address,
+//   [14 + ihl*4 + 2] UDP destination port
+static int build_filter(const md_ring_config_t *config, uint32_t group_addrs[],
+                        struct sock_filter *code, unsigned *length) {
+    uint32_t groups = config->group_count;
+    unsigned port_check = 6 + (groups > 0 ? 1 + groups : 0);
+    unsigned accept = port_check + 3;
+    unsigned drop = accept + 1;
+    unsigned i = 0;
+
+// Jump offsets are relative to the next instruction
+#define REL(target) ((uint8_t)((target) - i - 1))
+
+    code[i] = (struct sock_filter)BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12); i++;
+    code[i] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, ETH_P_IP, 0, REL(drop)); i++;
+    code[i] = (struct sock_filter)BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 23); i++;
+    code[i] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, REL(drop)); i++;
+    code[i] = (struct sock_filter)BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 20); i++;
+    code[i] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x1FFF, REL(drop), 0); i++;
+
+    if (groups > 0) {
+        code[i] = (struct sock_filter)BPF_STMT(BPF_LD | BPF_W | BPF_ABS, 30); i++;
+        for (uint32_t g = 0; g < groups; g++) {
+            // Last group: fall through to drop
+            uint8_t miss = (g + 1 == groups) ? REL(drop) : 0;
+            code[i] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, group_addrs[g],
+                                                   REL(port_check), miss);
+            i++;
+        }
+    }
+
+    code[i] = (struct sock_filter)BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, ETH_HEADER_LEN); i++;
+    code[i] = (struct sock_filter)BPF_STMT(BPF_LD | BPF_H | BPF_IND, ETH_HEADER_LEN + 2); i++;
+    code[i] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, config->port, 0, REL(drop)); i++;
+    code[i] = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, 0x40000); i++;
+    code[i] = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, 0); i++;
+
+#undef REL
+
+    *length = i;
+    return 0;
+}
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+// Hold IGMP memberships on the interface so the NIC and switch deliver the
+// groups (AF_PACKET itself does not join anything)
+static int join_groups(md_ring_receiver_t *rx, const uint32_t group_addrs[], unsigned ifindex) {
+    rx->join_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (rx->join_fd < 0) {
+        fprintf(stderr, "md_ring: socket: %s\n", strerror(errno));
+        return -1;
+    }
+
+    for (uint32_t g = 0; g < rx->config.group_count; g++) {
+        struct ip_mreqn mreq;
+
+        if (!IN_MULTICAST(group_addrs[g])) {
+            continue;
+        }
+        memset(&mreq, 0, sizeof(mreq));
+        mreq.imr_multiaddr.s_addr = htonl(group_addrs[g]);
+        mreq.imr_ifindex = (int)ifindex;
+        if (setsockopt(rx->join_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+            fprintf(stderr, "md_ring: join %s: %s\n", rx->config.groups[g], strerror(errno));
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Locate the UDP payload of one frame in place
+static bool parse_frame(const struct tpacket3_hdr *ppd, const uint8_t **payload, uint32_t *length) {
+    const uint8_t *frame = (const uint8_t *)ppd + ppd->tp_mac;
+    uint32_t snaplen = ppd->tp_snaplen;
+
+    if (snaplen < ETH_HEADER_LEN + IP_MIN_HEADER_LEN + UDP_HEADER_LEN) {
+        return false;
+    }
+
+    const uint8_t *ip = frame + ETH_HEADER_LEN;
+    uint32_t ihl = (uint32_t)(ip[0] & 0x0F) * 4;
+    if ((ip[0] >> 4) != 4 || ihl < IP_MIN_HEADER_LEN ||
+        ETH_HEADER_LEN + ihl + UDP_HEADER_LEN > snaplen) {
+        return false;
+    }
+
+    const uint8_t *udp = ip + ihl;
+    uint32_t udp_length = ((uint32_t)udp[4] << 8) | udp[5];
+    uint32_t available = snaplen - ETH_HEADER_LEN - ihl - UDP_HEADER_LEN;
+    if (udp_length < UDP_HEADER_LEN) {
+        return false;
+    }
+
+    *payload = udp + UDP_HEADER_LEN;
+    *length = udp_length - UDP_HEADER_LEN;
+    if (*length > available) {
+        *length = available;   // Truncated by the snap length
+    }
+    return true;
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+void md_ring_default_config(md_ring_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->ifname = "eth0";
+    config->groups[0] = MD_DEFAULT_GROUP;
+    config->group_count = 1;
+    config->port = MD_DEFAULT_PORT;
+    config->block_size = MD_RING_DEFAULT_BLOCK_SIZE;
+    config->block_count = MD_RING_DEFAULT_BLOCKS;
+    config->block_timeout_ms = MD_RING_DEFAULT_TIMEOUT_MS;
+    config->join = true;
+}
+
+// ============================================================================
+// Receiver
+// ============================================================================
+int md_ring_open(md_ring_receiver_t *rx, const md_ring_config_t *config) {
+    struct sock_filter code[16 + MD_RING_MAX_GROUPS];
+    uint32_t group_addrs[MD_RING_MAX_GROUPS];
+    unsigned code_length;
+
+    memset(rx, 0, sizeof(*rx));
+    rx->fd = -1;
+    rx->join_fd = -1;
+    rx->config = *config;
+
+    if (config->group_count > MD_RING_MAX_GROUPS) {
+        fprintf(stderr, "md_ring: at most %d groups\n", MD_RING_MAX_GROUPS);
+        return -1;
+    }
+    for (uint32_t g = 0; g < config->group_count; g++) {
+        struct in_addr addr;
+        if (!inet_aton(config->groups[g], &addr)) {
+            fprintf(stderr, "md_ring: invalid address %s\n", config->groups[g]);
+            return -1;
+        }
+        group_addrs[g] = ntohl(addr.s_addr);
+    }
+
+    unsigned ifindex = if_nametoindex(config->ifname);
+    if (ifindex == 0) {
+        fprintf(stderr, "md_ring: interface %s: %s\n", config->ifname, strerror(errno));
+        return -1;
+    }
+
+    // Protocol 0: nothing enters the ring until the filter is attached and
+    // the socket is bound below
+    rx->fd = socket(AF_PACKET, SOCK_RAW, 0);
+    if (rx->fd < 0) {
+        fprintf(stderr, "md_ring: socket: %s (needs CAP_NET_RAW)\n", strerror(errno));
+        return -1;
+    }
+
+    build_filter(config, group_addrs, code, &code_length);
+    struct sock_fprog program = { .len = (unsigned short)code_length, .filter = code };
+    if (setsockopt(rx->fd, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) != 0) {
+        fprintf(stderr, "md_ring: SO_ATTACH_FILTER: %s\n", strerror(errno));
+        md_ring_close(rx);
+        return -1;
+    }
+
+    int version = TPACKET_V3;
+    if (setsockopt(rx->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0) {
+        fprintf(stderr, "md_ring: PACKET_VERSION: %s\n", strerror(errno));
+        md_ring_close(rx);
+        return -1;
+    }
+
+    struct tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = config->block_size;
+    req.tp_block_nr = config->block_count;
+    req.tp_frame_size = MD_RING_FRAME_SIZE;
+    req.tp_frame_nr = (config->block_size / MD_RING_FRAME_SIZE) * config->block_count;
+    req.tp_retire_blk_tov = config->block_timeout_ms;
+    if (setsockopt(rx->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) != 0) {
+        fprintf(stderr, "md_ring: PACKET_RX_RING: %s\n", strerror(errno));
+        md_ring_close(rx);
+        return -1;
+    }
+
+    rx->map_size = (size_t)config->block_size * config->block_count;
+    void *map = mmap(NULL, rx->map_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, rx->fd, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "md_ring: mmap: %s\n", strerror(errno));
+        rx->map_size = 0;
+        md_ring_close(rx);
+        return -1;
+    }
+    rx->map = (uint8_t *)map;
+    mlock(rx->map, rx->map_size);   // Best effort
+
+    rx->blocks = calloc(config->block_count, sizeof(*rx->blocks));
+    if (rx->blocks == NULL) {
+        md_ring_close(rx);
+        return -1;
+    }
+    for (uint32_t b = 0; b < config->block_count; b++) {
+        rx->blocks[b].iov_base = rx->map + (size_t)b * config->block_size;
+        rx->blocks[b].iov_len = config->block_size;
+    }
+    for (uint32_t i = 0; i < MD_MAX_BATCH; i++) {
+        rx->packets[i].line = config->line;
+    }
+
+    struct sockaddr_ll addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_IP);
+    addr.sll_ifindex = (int)ifindex;
+    if (bind(rx->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "md_ring: bind %s: %s\n", config->ifname, strerror(errno));
+        md_ring_close(rx);
+        return -1;
+    }
+
+    if (config->join && join_groups(rx, group_addrs, ifindex) != 0) {
+        md_ring_close(rx);
+        return -1;
+    }
+    return 0;
+}
+
+int md_ring_receive(md_ring_receiver_t *rx, md_packet_handler_t handler, void *context) {
+    struct tpacket_block_desc *desc = (struct tpacket_block_desc *)rx->blocks[rx->current].iov_base;
+
+    if ((__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+        if (rx->config.spin) {
+            return 0;
+        }
+        struct pollfd pfd = { .fd = rx->fd, .events = POLLIN | POLLERR, .revents = 0 };
+        if (poll(&pfd, 1, MD_RING_POLL_MS) < 0 && errno != EINTR) {
+            fprintf(stderr, "md_ring: poll: %s\n", strerror(errno));
+            return -1;
+        }
+        if ((__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+            return 0;
+        }
+    }
+
+    uint32_t frames = desc->hdr.bh1.num_pkts;
+    const uint8_t *frame = (const uint8_t *)desc + desc->hdr.bh1.offset_to_first_pkt;
+    uint32_t batched = 0;
+    int handled = 0;
+
+    for (uint32_t f = 0; f < frames; f++) {
+        const struct tpacket3_hdr *ppd = (const struct tpacket3_hdr *)frame;
+        const struct sockaddr_ll *sll = (const struct sockaddr_ll *)
+            (frame + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+        md_packet_t *packet = &rx->packets[batched];
+
+        // On lo every frame is seen twice: once leaving, once arriving
+        if (sll->sll_pkttype != PACKET_OUTGOING &&
+            parse_frame(ppd, &packet->data, &packet->length)) {
+            packet->rx_ns = (uint64_t)ppd->tp_sec * 1000000000ULL + ppd->tp_nsec;
+            if (++batched == MD_MAX_BATCH) {
+                handler(rx->packets, batched, context);
+                handled += (int)batched;
+                batched = 0;
+            }
+        } else {
+            rx->stats.skipped++;
+        }
+        frame += ppd->tp_next_offset;
+    }
+    if (batched > 0) {
+        handler(rx->packets, batched, context);
+        handled += (int)batched;
+    }
+
+    // Payload pointers die here: give the block back to the kernel
+    __atomic_store_n(&desc->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    rx->current = (rx->current + 1) % rx->config.block_count;
+    rx->stats.blocks++;
+    rx->stats.datagrams += (uint64_t)handled;
+    return handled;
+}
+
+void md_ring_update_stats(md_ring_receiver_t *rx) {
+    struct tpacket_stats_v3 kstats;
+    socklen_t length = sizeof(kstats);
+
+    if (rx->fd >= 0 && getsockopt(rx->fd, SOL_PACKET, PACKET_STATISTICS, &kstats, &length) == 0) {
+        rx->stats.kernel_drops += kstats.tp_drops;
+        rx->stats.kernel_freezes += kstats.tp_freeze_q_cnt;
+    }
+}
+
+void md_ring_close(md_ring_receiver_t *rx) {
+    if (rx->map != NULL) {
+        munmap(rx->map, rx->map_size);
+        rx->map = NULL;
+    }
+    free(rx->blocks);
+    rx->blocks = NULL;
+    if (rx->fd >= 0) {
+        close(rx->fd);
+        rx->fd = -1;
+    }
+    if (rx->join_fd >= 0) {
+        close(rx->join_fd);
+        rx->join_fd = -1;
+    }
+}
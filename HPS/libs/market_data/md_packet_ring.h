@@ -0,0 +1,113 @@
+// ============================================================================
+// Market Data Packet Ring Receiver - Header
+// ============================================================================
+// AF_PACKET TPACKET_V3 receive: the kernel writes frames straight into a
+// ring of blocks mapped into this process
+//
+// The socket receiver costs one syscall per batch and one kernel-to-user
+// copy per datagram; on the Cortex-A9 both are expensive. Here the kernel
+// fills whole blocks of frames, user space walks them in place and hands
+// the UDP payloads to the same decode stage (md_packet_t) without a copy.
+// A block is returned to the kernel when it is full or its timeout
+// (retire_blk_tov) expires, whichever comes first, so the timeout bounds
+// how long a lone packet waits at low rates.
+//
+// A classic BPF filter attached to the socket keeps everything except our
+// UDP port and multicast groups out of the ring.
+// ============================================================================
+
+#ifndef HPS_MD_PACKET_RING_H
+#define HPS_MD_PACKET_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/uio.h>
+#include "market_data.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define MD_RING_MAX_GROUPS         8
+#define MD_RING_DEFAULT_BLOCK_SIZE (1U << 18)   // 256 KB per block
+#define MD_RING_DEFAULT_BLOCKS     8
+#define MD_RING_DEFAULT_TIMEOUT_MS 1            // Block retire timeout
+
+typedef struct {
+    const char *ifname;                         // Interface name ("eth0", "lo")
+    const char *groups[MD_RING_MAX_GROUPS];     // Destination addresses to accept
+    uint32_t group_count;                       // 0 = any destination
+    uint16_t port;                              // UDP destination port
+    uint32_t line;                              // Copied into md_packet_t.line
+    uint32_t block_size;                        // Bytes per block (multiple of the page size)
+    uint32_t block_count;                       // Blocks in the ring
+    uint32_t block_timeout_ms;                  // retire_blk_tov
+    bool spin;                                  // Never sleep in poll(); the caller loops
+    bool join;                                  // IGMP-join multicast groups on ifname
+} md_ring_config_t;
+
+/**
+ * Fill a configuration with defaults (eth0, MD_DEFAULT_GROUP:MD_DEFAULT_PORT,
+ * 8 x 256 KB blocks, 1 ms block timeout, join on)
+ */
+void md_ring_default_config(md_ring_config_t *config);
+
+// ============================================================================
+// Receiver
+// ============================================================================
+typedef struct {
+    uint64_t datagrams;      // Datagrams delivered to the handler
+    uint64_t blocks;         // Blocks consumed
+    uint64_t skipped;        // Frames dropped in user space (outgoing copies, bad headers)
+    uint64_t kernel_drops;   // Ring-full drops reported by the kernel
+    uint64_t kernel_freezes; // Times the kernel found the ring full
+} md_ring_stats_t;
+
+typedef struct {
+    int fd;
+    int join_fd;                         // UDP socket holding the IGMP memberships
+    md_ring_config_t config;
+    uint8_t *map;                        // Mapped ring
+    size_t map_size;
+    struct iovec *blocks;                // One entry per block
+    uint32_t current;                    // Next block to read
+    md_packet_t packets[MD_MAX_BATCH];   // Descriptors handed to the decode stage
+    md_ring_stats_t stats;
+} md_ring_receiver_t;
+
+/**
+ * Create the socket, attach the filter, map the ring and bind to ifname
+ *
+ * Needs CAP_NET_RAW.
+ *
+ * @param rx     Receiver to initialize
+ * @param config Configuration (copied; group strings must stay valid)
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int md_ring_open(md_ring_receiver_t *rx, const md_ring_config_t *config);
+
+/**
+ * Consume one retired block and pass its UDP payloads to the decode stage
+ *
+ * The handler is called once per MD_MAX_BATCH datagrams in the block. In
+ * blocking mode waits up to 100 ms for a block.
+ *
+ * @param rx      Receiver
+ * @param handler Decode-stage callback
+ * @param context Passed to the handler
+ *
+ * Returns: Number of datagrams handled (0 if none), -1 on error
+ */
+int md_ring_receive(md_ring_receiver_t *rx, md_packet_handler_t handler, void *context);
+
+/**
+ * Add the kernel's drop counters to rx->stats (reading resets them)
+ */
+void md_ring_update_stats(md_ring_receiver_t *rx);
+
+/**
+ * Unmap the ring and close the sockets
+ */
+void md_ring_close(md_ring_receiver_t *rx);
+
+#endif // HPS_MD_PACKET_RING_H
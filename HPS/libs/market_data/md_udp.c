@@ -0,0 +1,250 @@
+// ============================================================================
+// Market Data UDP Receiver - Implementation
+// ============================================================================
+// Multicast UDP receive with recvmmsg()
+// ============================================================================
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "md_udp.h"
+
+// SO_BUSY_POLL is missing from older libc headers
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL 46
+#endif
+
+#define MD_HUGE_PAGE_SIZE   (2U * 1024U * 1024U)
+#define MD_BLOCK_TIMEOUT_US 100000   // Blocking receive wakes up every 100ms
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static uint64_t realtime_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Map the receive buffers: one huge page if possible, else normal pages,
+// populated and locked so the first batch does not fault
+static int buffers_alloc(md_udp_receiver_t *rx) {
+    size_t size = (size_t)rx->config.batch * MD_MAX_DATAGRAM;
+    void *map = MAP_FAILED;
+
+    if (rx->config.hugepages) {
+        size_t huge_size = (size + MD_HUGE_PAGE_SIZE - 1) & ~((size_t)MD_HUGE_PAGE_SIZE - 1);
+        map = mmap(NULL, huge_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+        if (map != MAP_FAILED) {
+            rx->buffers_size = huge_size;
+            rx->buffers_huge = true;
+        }
+    }
+
+    if (map == MAP_FAILED) {
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "md_udp: mmap: %s\n", strerror(errno));
+            return -1;
+        }
+        rx->buffers_size = size;
+        rx->buffers_huge = false;
+    }
+
+    // Best effort: without CAP_IPC_LOCK the pages are still populated
+    mlock(map, rx->buffers_size);
+    rx->buffers = (uint8_t *)map;
+    return 0;
+}
+
+// Describe every buffer slot once; recvmmsg() only needs msg_len reset
+static void buffers_register(md_udp_receiver_t *rx) {
+    memset(rx->msgs, 0, sizeof(rx->msgs));
+    for (uint32_t i = 0; i < rx->config.batch; i++) {
+        rx->iovecs[i].iov_base = rx->buffers + (size_t)i * MD_MAX_DATAGRAM;
+        rx->iovecs[i].iov_len = MD_MAX_DATAGRAM;
+        rx->msgs[i].msg_hdr.msg_iov = &rx->iovecs[i];
+        rx->msgs[i].msg_hdr.msg_iovlen = 1;
+        rx->packets[i].data = rx->buffers + (size_t)i * MD_MAX_DATAGRAM;
+        rx->packets[i].line = rx->config.line;
+    }
+}
+
+static uint64_t kernel_timestamp(struct msghdr *hdr) {
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            struct timespec ts;
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+void md_udp_default_config(md_udp_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->group = MD_DEFAULT_GROUP;
+    config->port = MD_DEFAULT_PORT;
+    config->batch = MD_MAX_BATCH;
+    config->kernel_timestamps = true;
+    config->hugepages = true;
+}
+
+// ============================================================================
+// Receiver
+// ============================================================================
+int md_udp_open(md_udp_receiver_t *rx, const md_udp_config_t *config) {
+    memset(rx, 0, sizeof(*rx));
+    rx->fd = -1;
+    rx->config = *config;
+    if (rx->config.batch == 0 || rx->config.batch > MD_MAX_BATCH) {
+        rx->config.batch = MD_MAX_BATCH;
+    }
+
+    rx->fd = socket(AF_INET, SOCK_DGRAM | (config->spin ? SOCK_NONBLOCK : 0), 0);
+    if (rx->fd < 0) {
+        fprintf(stderr, "md_udp: socket: %s\n", strerror(errno));
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(rx->fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if (config->rcvbuf > 0 &&
+        setsockopt(rx->fd, SOL_SOCKET, SO_RCVBUF, &config->rcvbuf, sizeof(config->rcvbuf)) != 0) {
+        fprintf(stderr, "md_udp: SO_RCVBUF: %s\n", strerror(errno));
+    }
+
+    if (!config->spin) {
+        struct timeval tv = { .tv_sec = 0, .tv_usec = MD_BLOCK_TIMEOUT_US };
+        setsockopt(rx->fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+
+    if (config->busy_poll_us > 0) {
+        int busy = (int)config->busy_poll_us;
+        if (setsockopt(rx->fd, SOL_SOCKET, SO_BUSY_POLL, &busy, sizeof(busy)) != 0) {
+            fprintf(stderr, "md_udp: SO_BUSY_POLL: %s (needs CAP_NET_ADMIN above net.core.busy_read)\n",
+                    strerror(errno));
+        }
+    }
+
+    if (config->kernel_timestamps &&
+        setsockopt(rx->fd, SOL_SOCKET, SO_TIMESTAMPNS, &one, sizeof(one)) != 0) {
+        fprintf(stderr, "md_udp: SO_TIMESTAMPNS: %s\n", strerror(errno));
+        rx->config.kernel_timestamps = false;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config->port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    struct in_addr group;
+    bool multicast = config->group != NULL && inet_aton(config->group, &group) &&
+                     IN_MULTICAST(ntohl(group.s_addr));
+    if (multicast) {
+        // Bind to the group so other groups on the same port are not delivered here
+        addr.sin_addr = group;
+    }
+
+    if (bind(rx->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "md_udp: bind port %u: %s\n", config->port, strerror(errno));
+        md_udp_close(rx);
+        return -1;
+    }
+
+    if (multicast) {
+        struct ip_mreq mreq;
+        memset(&mreq, 0, sizeof(mreq));
+        mreq.imr_multiaddr = group;
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (config->interface != NULL && !inet_aton(config->interface, &mreq.imr_interface)) {
+            fprintf(stderr, "md_udp: invalid interface address %s\n", config->interface);
+            md_udp_close(rx);
+            return -1;
+        }
+        if (setsockopt(rx->fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+            fprintf(stderr, "md_udp: join %s: %s\n", config->group, strerror(errno));
+            md_udp_close(rx);
+            return -1;
+        }
+    }
+
+    if (buffers_alloc(rx) != 0) {
+        md_udp_close(rx);
+        return -1;
+    }
+    buffers_register(rx);
+    return 0;
+}
+
+int md_udp_receive(md_udp_receiver_t *rx, md_packet_handler_t handler, void *context) {
+    uint32_t batch = rx->config.batch;
+
+    for (uint32_t i = 0; i < batch; i++) {
+        if (rx->config.kernel_timestamps) {
+            rx->msgs[i].msg_hdr.msg_control = rx->control[i];
+            rx->msgs[i].msg_hdr.msg_controllen = sizeof(rx->control[i]);
+        }
+        rx->msgs[i].msg_hdr.msg_flags = 0;
+    }
+
+    int flags = rx->config.spin ? MSG_DONTWAIT : MSG_WAITFORONE;
+    int n = recvmmsg(rx->fd, rx->msgs, batch, flags, NULL);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            rx->stats.empty_calls++;
+            return 0;
+        }
+        fprintf(stderr, "md_udp: recvmmsg: %s\n", strerror(errno));
+        return -1;
+    }
+    if (n == 0) {
+        rx->stats.empty_calls++;
+        return 0;
+    }
+
+    uint64_t user_ns = rx->config.kernel_timestamps ? 0 : realtime_ns();
+    for (int i = 0; i < n; i++) {
+        md_packet_t *packet = &rx->packets[i];
+
+        packet->length = rx->msgs[i].msg_len;
+        if (rx->msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+            rx->stats.truncated++;
+        }
+        packet->rx_ns = rx->config.kernel_timestamps ? kernel_timestamp(&rx->msgs[i].msg_hdr) : user_ns;
+    }
+
+    rx->stats.calls++;
+    rx->stats.datagrams += (uint64_t)n;
+    if ((uint32_t)n > rx->stats.max_batch) {
+        rx->stats.max_batch = (uint32_t)n;
+    }
+
+    handler(rx->packets, (uint32_t)n, context);
+    return n;
+}
+
+void md_udp_close(md_udp_receiver_t *rx) {
+    if (rx->fd >= 0) {
+        close(rx->fd);
+        rx->fd = -1;
+    }
+    if (rx->buffers != NULL) {
+        munmap(rx->buffers, rx->buffers_size);
+        rx->buffers = NULL;
+    }
+}
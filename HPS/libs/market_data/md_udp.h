@@ -0,0 +1,97 @@
+// ============================================================================
+// Market Data UDP Receiver - Header
+// ============================================================================
+// Multicast (or unicast) UDP receive with recvmmsg()
+//
+// One recvmmsg() call drains up to MD_MAX_BATCH datagrams into receive
+// buffers that are allocated and described (iovecs, control buffers) once at
+// open time, preferably from a huge page so the whole batch sits behind one
+// TLB entry. The decode stage gets descriptors that point into those
+// buffers: no copy between the kernel and the handler.
+// ============================================================================
+
+#ifndef HPS_MD_UDP_H
+#define HPS_MD_UDP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "market_data.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+typedef struct {
+    const char *group;       // Multicast group (NULL or unicast address: no join)
+    const char *interface;   // Local interface address for the join (NULL = any)
+    uint16_t port;           // UDP port
+    uint32_t line;           // Copied into md_packet_t.line
+    uint32_t batch;          // Datagrams per recvmmsg() (1..MD_MAX_BATCH)
+    uint32_t busy_poll_us;   // SO_BUSY_POLL budget (0 = off; needs driver support)
+    bool kernel_timestamps;  // SO_TIMESTAMPNS receive timestamps
+    bool spin;               // Non-blocking receive; the caller polls in a loop
+    bool hugepages;          // Back the buffers with a huge page if available
+    int rcvbuf;              // SO_RCVBUF bytes (0 = system default)
+} md_udp_config_t;
+
+/**
+ * Fill a configuration with defaults (MD_DEFAULT_GROUP:MD_DEFAULT_PORT,
+ * batch MD_MAX_BATCH, kernel timestamps and huge pages on)
+ */
+void md_udp_default_config(md_udp_config_t *config);
+
+// ============================================================================
+// Receiver
+// ============================================================================
+typedef struct {
+    uint64_t datagrams;      // Datagrams delivered to the handler
+    uint64_t calls;          // recvmmsg() calls that returned data
+    uint64_t empty_calls;    // recvmmsg() calls that returned nothing (spin mode)
+    uint64_t truncated;      // Datagrams larger than MD_MAX_DATAGRAM
+    uint32_t max_batch;      // Largest batch returned by one call
+} md_udp_stats_t;
+
+typedef struct {
+    int fd;
+    md_udp_config_t config;
+    uint8_t *buffers;                         // batch * MD_MAX_DATAGRAM bytes
+    size_t buffers_size;                      // Mapped size
+    bool buffers_huge;                        // Mapped with MAP_HUGETLB
+    struct mmsghdr msgs[MD_MAX_BATCH];
+    struct iovec iovecs[MD_MAX_BATCH];
+    uint8_t control[MD_MAX_BATCH][64];        // cmsg space for SCM_TIMESTAMPNS
+    md_packet_t packets[MD_MAX_BATCH];        // Descriptors handed to the decode stage
+    md_udp_stats_t stats;
+} md_udp_receiver_t;
+
+/**
+ * Open the socket, join the group and set up the receive buffers
+ *
+ * @param rx     Receiver to initialize
+ * @param config Configuration (copied)
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int md_udp_open(md_udp_receiver_t *rx, const md_udp_config_t *config);
+
+/**
+ * Receive one batch and pass it to the decode stage
+ *
+ * Blocking mode waits up to 100 ms for the first datagram, then returns
+ * whatever else is already queued (MSG_WAITFORONE). Spin mode never waits.
+ *
+ * @param rx      Receiver
+ * @param handler Decode-stage callback
+ * @param context Passed to the handler
+ *
+ * Returns: Number of datagrams handled (0 if none), -1 on socket error
+ */
+int md_udp_receive(md_udp_receiver_t *rx, md_packet_handler_t handler, void *context);
+
+/**
+ * Close the socket and release the buffers
+ */
+void md_udp_close(md_udp_receiver_t *rx);
+
+#endif // HPS_MD_UDP_H
@@ -0,0 +1,336 @@
+// ============================================================================
+// Real-Time Runtime Setup - Implementation
+// ============================================================================
+// Core pinning, SCHED_FIFO, locked and pre-faulted memory, THP off
+// ============================================================================
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sched.h>
+#include <malloc.h>
+#include <alloca.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include "rt_setup.h"
+
+static const char *const step_names[RT_STEP_COUNT] = {
+    "affinity", "priority", "mlock", "prefault", "thp"
+};
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static void set_status(rt_report_t *report, rt_step_t step, int result) {
+    if (result == 0) {
+        report->status[step] = RT_APPLIED;
+        report->error[step] = 0;
+    } else {
+        report->status[step] = RT_FAILED;
+        report->error[step] = errno;
+    }
+}
+
+// Touch one byte per page so every page is faulted in (and, after
+// mlockall, pinned) before the hot path needs it
+static void touch_pages(volatile uint8_t *buffer, size_t size) {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    for (size_t offset = 0; offset < size; offset += page_size) {
+        buffer[offset] = 0;
+    }
+}
+
+// Runs in its own frame so the alloca() region sits below the caller's
+// stack, i.e. where the hot loop's deeper calls will land
+static __attribute__((noinline)) void prefault_stack(size_t size) {
+    touch_pages(alloca(size), size);
+}
+
+static int prefault_heap(size_t size) {
+    // Keep freed memory in the process: no trimming back to the kernel and
+    // no per-allocation mmap(), so later malloc() calls reuse these pages
+    if (mallopt(M_TRIM_THRESHOLD, -1) == 0 || mallopt(M_MMAP_MAX, 0) == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    uint8_t *buffer = malloc(size);
+    if (buffer == NULL) {
+        return -1;
+    }
+    touch_pages(buffer, size);
+    free(buffer);
+    return 0;
+}
+
+static int lock_memory(void) {
+    struct rlimit limit;
+
+    // With a finite RLIMIT_MEMLOCK, MCL_FUTURE makes every later mmap() or
+    // heap growth past the limit fail. Refuse rather than break the program
+    // later; root (CAP_IPC_LOCK) is not bound by the limit.
+    if (geteuid() != 0 && getrlimit(RLIMIT_MEMLOCK, &limit) == 0 &&
+        limit.rlim_cur != RLIM_INFINITY) {
+        errno = EPERM;
+        return -1;
+    }
+    return mlockall(MCL_CURRENT | MCL_FUTURE);
+}
+
+// Value of a "Key:   N kB" line in /proc/self/status (-1 if absent)
+static long read_status_kb(const char *key) {
+    FILE *status = fopen("/proc/self/status", "r");
+    char line[128];
+    size_t key_length = strlen(key);
+    long value = -1;
+
+    if (status == NULL) {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), status) != NULL) {
+        if (strncmp(line, key, key_length) == 0 && line[key_length] == ':') {
+            value = strtol(line + key_length + 1, NULL, 10);
+            break;
+        }
+    }
+    fclose(status);
+    return value;
+}
+
+static long read_sysctl_long(const char *path, long fallback) {
+    FILE *file = fopen(path, "r");
+    long value = fallback;
+
+    if (file != NULL) {
+        if (fscanf(file, "%ld", &value) != 1) {
+            value = fallback;
+        }
+        fclose(file);
+    }
+    return value;
+}
+
+// The active mode of a sysfs selector such as "always defer [madvise] never"
+static void read_sysfs_choice(const char *path, char *choice, size_t size) {
+    FILE *file = fopen(path, "r");
+    char line[128];
+
+    choice[0] = '\0';
+    if (file == NULL) {
+        return;
+    }
+    if (fgets(line, sizeof(line), file) != NULL) {
+        char *start = strchr(line, '[');
+        char *end = start ? strchr(start, ']') : NULL;
+        if (start != NULL && end != NULL && (size_t)(end - start - 1) < size) {
+            memcpy(choice, start + 1, (size_t)(end - start - 1));
+            choice[end - start - 1] = '\0';
+        }
+    }
+    fclose(file);
+}
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+void rt_default_config(rt_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->cpu = -1;
+    config->priority = 0;
+    config->lock_memory = true;
+    config->stack_prefault = RT_DEFAULT_STACK_PREFAULT;
+    config->heap_prefault = RT_DEFAULT_HEAP_PREFAULT;
+    config->disable_thp = true;
+}
+
+int rt_setup_process(const rt_config_t *config, rt_report_t *report) {
+    memset(report, 0, sizeof(*report));
+    report->config = *config;
+    report->rt_runtime_us = -1;
+
+    // THP first: pages faulted in below must not be collapsed later
+    if (config->disable_thp) {
+        set_status(report, RT_STEP_THP, prctl(PR_SET_THP_DISABLE, 1, 0, 0, 0));
+    }
+    if (config->lock_memory) {
+        set_status(report, RT_STEP_MLOCK, lock_memory());
+    }
+    if (config->heap_prefault > 0) {
+        set_status(report, RT_STEP_PREFAULT, prefault_heap(config->heap_prefault));
+    }
+
+    for (int step = 0; step < RT_STEP_COUNT; step++) {
+        if (report->status[step] == RT_FAILED) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int rt_setup_thread(const rt_config_t *config, rt_report_t *report) {
+    int ret = 0;
+
+    // pid 0 is the calling thread for both calls below
+    if (config->cpu >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(config->cpu, &cpu_set);
+        set_status(report, RT_STEP_AFFINITY, sched_setaffinity(0, sizeof(cpu_set), &cpu_set));
+        ret |= report->status[RT_STEP_AFFINITY] == RT_FAILED;
+    }
+    if (config->priority > 0) {
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = config->priority;
+        set_status(report, RT_STEP_PRIORITY, sched_setscheduler(0, SCHED_FIFO, &param));
+        ret |= report->status[RT_STEP_PRIORITY] == RT_FAILED;
+    }
+
+    if (config->stack_prefault > 0) {
+        prefault_stack(config->stack_prefault);
+        if (report->status[RT_STEP_PREFAULT] == RT_SKIPPED) {
+            report->status[RT_STEP_PREFAULT] = RT_APPLIED;
+        }
+    }
+
+    return ret ? -1 : 0;
+}
+
+int rt_setup(const rt_config_t *config, rt_report_t *report) {
+    int ret = 0;
+
+    ret |= rt_setup_process(config, report);
+    ret |= rt_setup_thread(config, report);
+    ret |= rt_verify(report);
+    return ret ? -1 : 0;
+}
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+int rt_verify(rt_report_t *report) {
+    const rt_config_t *config = &report->config;
+    int ret = 0;
+
+    memset(report->verified, 0, sizeof(report->verified));
+    report->online_cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    report->locked_kb = read_status_kb("VmLck");
+    report->resident_kb = read_status_kb("VmRSS");
+    report->rt_runtime_us = read_sysctl_long("/proc/sys/kernel/sched_rt_runtime_us", -1);
+    read_sysfs_choice("/sys/kernel/mm/transparent_hugepage/defrag",
+                      report->thp_defrag, sizeof(report->thp_defrag));
+
+    if (report->status[RT_STEP_AFFINITY] == RT_APPLIED) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        report->verified[RT_STEP_AFFINITY] =
+            sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0 &&
+            CPU_COUNT(&cpu_set) == 1 && CPU_ISSET(config->cpu, &cpu_set);
+    }
+    if (report->status[RT_STEP_PRIORITY] == RT_APPLIED) {
+        struct sched_param param;
+        report->verified[RT_STEP_PRIORITY] =
+            sched_getscheduler(0) == SCHED_FIFO &&
+            sched_getparam(0, &param) == 0 && param.sched_priority == config->priority;
+    }
+    if (report->status[RT_STEP_MLOCK] == RT_APPLIED) {
+        report->verified[RT_STEP_MLOCK] = report->locked_kb > 0;
+    }
+    if (report->status[RT_STEP_PREFAULT] == RT_APPLIED) {
+        // Nothing to read back; locked memory keeps the pages resident
+        report->verified[RT_STEP_PREFAULT] = true;
+    }
+    if (report->status[RT_STEP_THP] == RT_APPLIED) {
+        report->verified[RT_STEP_THP] = prctl(PR_GET_THP_DISABLE, 0, 0, 0, 0) == 1;
+    }
+
+    for (int step = 0; step < RT_STEP_COUNT; step++) {
+        if (report->status[step] == RT_FAILED ||
+            (report->status[step] == RT_APPLIED && !report->verified[step])) {
+            ret = -1;
+        }
+    }
+
+    report->faults = rt_thread_faults();
+    return ret;
+}
+
+uint64_t rt_thread_faults(void) {
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_THREAD, &usage) != 0) {
+        return 0;
+    }
+    return (uint64_t)usage.ru_minflt + (uint64_t)usage.ru_majflt;
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+void rt_print_report(const rt_report_t *report, FILE *output) {
+    const rt_config_t *config = &report->config;
+    char request[64];
+
+    for (int step = 0; step < RT_STEP_COUNT; step++) {
+        switch (step) {
+            case RT_STEP_AFFINITY:
+                snprintf(request, sizeof(request), "cpu %d", config->cpu);
+                break;
+            case RT_STEP_PRIORITY:
+                snprintf(request, sizeof(request), "SCHED_FIFO %d", config->priority);
+                break;
+            case RT_STEP_MLOCK:
+                snprintf(request, sizeof(request), "current + future");
+                break;
+            case RT_STEP_PREFAULT:
+                snprintf(request, sizeof(request), "%zu KB stack, %zu KB heap",
+                         config->stack_prefault / 1024, config->heap_prefault / 1024);
+                break;
+            default:
+                snprintf(request, sizeof(request), "disabled");
+                break;
+        }
+
+        fprintf(output, "rt: %-9s %-28s ", step_names[step],
+                report->status[step] == RT_SKIPPED ? "-" : request);
+        if (report->status[step] == RT_SKIPPED) {
+            fprintf(output, "skipped\n");
+        } else if (report->status[step] == RT_FAILED) {
+            fprintf(output, "FAILED: %s\n", strerror(report->error[step]));
+        } else if (!report->verified[step]) {
+            fprintf(output, "applied, NOT verified\n");
+        } else if (step == RT_STEP_MLOCK) {
+            fprintf(output, "ok (VmLck %ld kB, VmRSS %ld kB)\n",
+                    report->locked_kb, report->resident_kb);
+        } else {
+            fprintf(output, "ok\n");
+        }
+    }
+
+    // System settings that undo part of the setup
+    if (report->status[RT_STEP_MLOCK] == RT_FAILED && report->error[RT_STEP_MLOCK] == EPERM) {
+        fprintf(output, "rt: warning: locking memory needs root or an unlimited RLIMIT_MEMLOCK\n");
+    }
+    if (config->priority > 0 && report->rt_runtime_us >= 0) {
+        fprintf(output, "rt: warning: RT throttling is on (kernel.sched_rt_runtime_us = %ld); "
+                "a busy SCHED_FIFO loop is stopped for the rest of every period\n",
+                report->rt_runtime_us);
+    }
+    if (config->cpu == 0 && report->online_cpus > 1) {
+        fprintf(output, "rt: warning: CPU 0 handles most interrupts on the HPS; prefer CPU 1\n");
+    }
+    if (config->cpu >= report->online_cpus && report->online_cpus > 0) {
+        fprintf(output, "rt: warning: only %d CPUs online\n", report->online_cpus);
+    }
+    if (strcmp(report->thp_defrag, "always") == 0) {
+        fprintf(output, "rt: warning: transparent_hugepage/defrag is 'always'; other processes "
+                "stall in direct compaction (set 'defer' or 'madvise')\n");
+    }
+}
@@ -0,0 +1,138 @@
+// ============================================================================
+// Real-Time Runtime Setup - Header
+// ============================================================================
+// Startup configuration for hot-path threads: core pinning, SCHED_FIFO,
+// locked and pre-faulted memory, no transparent huge pages
+//
+// A page fault or a migration to the other A9 core in the middle of a price
+// update costs far more than the update itself. Each trading binary calls
+// rt_setup_process() once from main() before it allocates its working set,
+// then rt_setup_thread() on every hot thread (rt_setup() does both for a
+// single-threaded program). Every step is best effort: a step that fails
+// is recorded in the report and the rest still run. rt_verify() reads the
+// resulting state back from the kernel, and rt_print_report() shows what
+// was asked for, what took effect and which system settings work against it.
+// ============================================================================
+
+#ifndef HPS_RT_SETUP_H
+#define HPS_RT_SETUP_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define RT_DEFAULT_STACK_PREFAULT  (256 * 1024)    // Bytes of stack touched per thread
+#define RT_DEFAULT_HEAP_PREFAULT   (1024 * 1024)   // Bytes of heap touched and kept
+
+typedef struct {
+    int cpu;                 // Core to pin to (-1 = leave affinity alone)
+    int priority;            // SCHED_FIFO priority 1-99 (0 = stay SCHED_OTHER)
+    bool lock_memory;        // mlockall(MCL_CURRENT | MCL_FUTURE)
+    size_t stack_prefault;   // Stack bytes to fault in on each hot thread
+    size_t heap_prefault;    // Heap bytes to fault in; malloc keeps them afterwards
+    bool disable_thp;        // PR_SET_THP_DISABLE for this process
+} rt_config_t;
+
+/**
+ * Fill a configuration with defaults: no pinning, SCHED_OTHER, memory
+ * locked, 256 KB stack and 1 MB heap pre-faulted, THP disabled
+ */
+void rt_default_config(rt_config_t *config);
+
+// ============================================================================
+// Report
+// ============================================================================
+typedef enum {
+    RT_STEP_AFFINITY = 0,
+    RT_STEP_PRIORITY,
+    RT_STEP_MLOCK,
+    RT_STEP_PREFAULT,
+    RT_STEP_THP,
+    RT_STEP_COUNT
+} rt_step_t;
+
+typedef enum {
+    RT_SKIPPED = 0,          // Not requested
+    RT_APPLIED,              // Call succeeded
+    RT_FAILED                // Call failed (see error)
+} rt_status_t;
+
+typedef struct {
+    rt_config_t config;                 // What was asked for
+    rt_status_t status[RT_STEP_COUNT];
+    int error[RT_STEP_COUNT];           // errno of failed steps
+    bool verified[RT_STEP_COUNT];       // Read back from the kernel by rt_verify()
+
+    // Filled in by rt_verify()
+    int online_cpus;
+    long locked_kb;                     // VmLck
+    long resident_kb;                   // VmRSS
+    long rt_runtime_us;                 // kernel.sched_rt_runtime_us (-1 = no RT throttling)
+    char thp_defrag[16];                // Active transparent_hugepage/defrag mode
+    uint64_t faults;                    // rt_thread_faults() at verification (hot-loop baseline)
+} rt_report_t;
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+/**
+ * Process-wide steps: lock memory, keep freed heap in the process, fault
+ * in the heap, disable transparent huge pages
+ *
+ * Call once from main() before creating threads.
+ *
+ * @param config Configuration
+ * @param report Report to initialize and fill in
+ *
+ * Returns: 0 if every requested step succeeded, -1 otherwise
+ */
+int rt_setup_process(const rt_config_t *config, rt_report_t *report);
+
+/**
+ * Per-thread steps for the calling thread: pin, SCHED_FIFO, fault in the stack
+ *
+ * @param config Configuration
+ * @param report Report filled in by rt_setup_process()
+ *
+ * Returns: 0 if every requested step succeeded, -1 otherwise
+ */
+int rt_setup_thread(const rt_config_t *config, rt_report_t *report);
+
+/**
+ * rt_setup_process() followed by rt_setup_thread() and rt_verify(), for
+ * single-threaded programs
+ *
+ * Returns: 0 if every requested step succeeded and verified, -1 otherwise
+ */
+int rt_setup(const rt_config_t *config, rt_report_t *report);
+
+/**
+ * Read back affinity, policy, locked memory and THP state for the calling
+ * thread and collect the system settings that affect them
+ *
+ * Returns: 0 if every applied step verified, -1 otherwise
+ */
+int rt_verify(rt_report_t *report);
+
+/**
+ * Print one line per step plus warnings about the system configuration
+ *
+ * @param report Report
+ * @param output Output stream
+ */
+void rt_print_report(const rt_report_t *report, FILE *output);
+
+/**
+ * Page faults (minor + major) taken so far by the calling thread
+ *
+ * Sample it around the hot loop: any increase after setup means the
+ * working set was not fully locked or pre-faulted.
+ */
+uint64_t rt_thread_faults(void);
+
+#endif // HPS_RT_SETUP_H
@@ -0,0 +1,162 @@
+// ============================================================================
+// Telemetry Library - Implementation
+// ============================================================================
+// Calculator and driver health counters in POSIX shared memory
+// ============================================================================
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "telemetry.h"
+
+// ============================================================================
+// Static Variables
+// ============================================================================
+static telemetry_block_t *writer_block = NULL;
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static void telemetry_add(uint32_t *field, uint32_t value) {
+    // Single writer: a relaxed load/store pair avoids a locked RMW
+    __atomic_store_n(field, __atomic_load_n(field, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+// ============================================================================
+// Writer
+// ============================================================================
+int telemetry_open_writer(const char *name) {
+    if (writer_block != NULL) {
+        return -1;
+    }
+    if (name == NULL) {
+        name = TELEMETRY_DEFAULT_NAME;
+    }
+
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "telemetry: shm_open %s: %s\n", name, strerror(errno));
+        return -1;
+    }
+
+    if (ftruncate(fd, sizeof(telemetry_block_t)) != 0) {
+        fprintf(stderr, "telemetry: ftruncate: %s\n", strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, sizeof(telemetry_block_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "telemetry: mmap: %s\n", strerror(errno));
+        return -1;
+    }
+
+    // Reset, then publish the magic last so readers never see a half-built block
+    telemetry_block_t *block = (telemetry_block_t *)map;
+    __atomic_store_n(&block->magic, 0, __ATOMIC_RELAXED);
+    memset((uint8_t *)block + sizeof(block->magic), 0, sizeof(*block) - sizeof(block->magic));
+    block->version = TELEMETRY_VERSION;
+    block->writer_pid = (uint32_t)getpid();
+    __atomic_store_n(&block->magic, TELEMETRY_MAGIC, __ATOMIC_RELEASE);
+
+    writer_block = block;
+    return 0;
+}
+
+void telemetry_close_writer(void) {
+    if (writer_block == NULL) {
+        return;
+    }
+
+    munmap(writer_block, sizeof(telemetry_block_t));
+    writer_block = NULL;
+}
+
+void telemetry_count_op(void) {
+    if (writer_block != NULL) {
+        telemetry_add(&writer_block->ops, 1);
+    }
+}
+
+void telemetry_count_error(uint32_t error_code, bool timeout) {
+    if (writer_block == NULL) {
+        return;
+    }
+
+    __atomic_store_n(&writer_block->last_error_code, error_code, __ATOMIC_RELAXED);
+    if (timeout) {
+        telemetry_add(&writer_block->timeouts, 1);
+    }
+    telemetry_add(&writer_block->errors, 1);
+}
+
+void telemetry_set_latency(uint64_t p99_ns, uint64_t budget_ns) {
+    if (writer_block == NULL) {
+        return;
+    }
+
+    __atomic_store_n(&writer_block->latency_p99_ns,
+                     (p99_ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)p99_ns, __ATOMIC_RELAXED);
+    __atomic_store_n(&writer_block->latency_budget_ns,
+                     (budget_ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)budget_ns, __ATOMIC_RELAXED);
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+const telemetry_block_t *telemetry_open_reader(const char *name) {
+    if (name == NULL) {
+        name = TELEMETRY_DEFAULT_NAME;
+    }
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(telemetry_block_t)) {
+        close(fd);
+        return NULL;
+    }
+
+    void *map = mmap(NULL, sizeof(telemetry_block_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    return (const telemetry_block_t *)map;
+}
+
+void telemetry_close_reader(const telemetry_block_t *block) {
+    if (block != NULL) {
+        munmap((void *)block, sizeof(telemetry_block_t));
+    }
+}
+
+void telemetry_snapshot(const telemetry_block_t *block, telemetry_block_t *snapshot) {
+    snapshot->magic = __atomic_load_n(&block->magic, __ATOMIC_ACQUIRE);
+    snapshot->version = __atomic_load_n(&block->version, __ATOMIC_RELAXED);
+    snapshot->writer_pid = __atomic_load_n(&block->writer_pid, __ATOMIC_RELAXED);
+    snapshot->ops = __atomic_load_n(&block->ops, __ATOMIC_RELAXED);
+    snapshot->errors = __atomic_load_n(&block->errors, __ATOMIC_RELAXED);
+    snapshot->timeouts = __atomic_load_n(&block->timeouts, __ATOMIC_RELAXED);
+    snapshot->last_error_code = __atomic_load_n(&block->last_error_code, __ATOMIC_RELAXED);
+    snapshot->latency_p99_ns = __atomic_load_n(&block->latency_p99_ns, __ATOMIC_RELAXED);
+    snapshot->latency_budget_ns = __atomic_load_n(&block->latency_budget_ns, __ATOMIC_RELAXED);
+}
+
+bool telemetry_writer_alive(const telemetry_block_t *snapshot) {
+    if (snapshot->magic != TELEMETRY_MAGIC || snapshot->writer_pid == 0) {
+        return false;
+    }
+    return kill((pid_t)snapshot->writer_pid, 0) == 0 || errno == EPERM;
+}
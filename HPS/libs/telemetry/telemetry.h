@@ -0,0 +1,106 @@
+// ============================================================================
+// Telemetry Library - Header
+// ============================================================================
+// Calculator and driver health counters in POSIX shared memory
+//
+// The trading process (single writer) bumps counters with relaxed atomic
+// stores into a shared-memory block; monitors such as boot_led map the same
+// block read-only and sample it at their own low rate. Publishing costs a
+// few cached stores and never touches the FPGA bridge.
+// ============================================================================
+
+#ifndef HPS_TELEMETRY_H
+#define HPS_TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+#define TELEMETRY_DEFAULT_NAME    "/hps_calculator_telemetry"
+#define TELEMETRY_MAGIC           0x544C4D59  // "TLMY"
+#define TELEMETRY_VERSION         1
+
+// ============================================================================
+// Shared Block Layout
+// ============================================================================
+// All fields are 32-bit so every load and store is single-copy atomic on
+// ARMv7. Counters wrap; readers only use differences between samples.
+typedef struct {
+    uint32_t magic;              // TELEMETRY_MAGIC once the writer is ready
+    uint32_t version;            // TELEMETRY_VERSION
+    uint32_t writer_pid;         // Publishing process
+    uint32_t ops;                // Completed operations
+    uint32_t errors;             // Operations that failed (error status or timeout)
+    uint32_t timeouts;           // Subset of errors that timed out
+    uint32_t last_error_code;    // ERROR_CODE register of the latest failure
+    uint32_t latency_p99_ns;     // Latest published p99 operation latency
+    uint32_t latency_budget_ns;  // p99 budget (0 = no budget)
+} telemetry_block_t;
+
+// ============================================================================
+// Writer API (trading process)
+// ============================================================================
+
+/**
+ * Create (or reuse) the shared block and become its writer
+ *
+ * @param name POSIX shared memory name (NULL for TELEMETRY_DEFAULT_NAME)
+ *
+ * Returns: 0 on success, -1 on error
+ */
+int telemetry_open_writer(const char *name);
+
+/**
+ * Unmap the block (it stays in /dev/shm for monitors)
+ */
+void telemetry_close_writer(void);
+
+/**
+ * Count one completed operation (no-op if no writer block is open)
+ */
+void telemetry_count_op(void);
+
+/**
+ * Count one failed operation
+ *
+ * @param error_code Value of the ERROR_CODE register
+ * @param timeout    true if the operation timed out
+ */
+void telemetry_count_error(uint32_t error_code, bool timeout);
+
+/**
+ * Publish the latest p99 latency and its budget (nanoseconds)
+ */
+void telemetry_set_latency(uint64_t p99_ns, uint64_t budget_ns);
+
+// ============================================================================
+// Reader API (monitors)
+// ============================================================================
+
+/**
+ * Map an existing block read-only
+ *
+ * @param name POSIX shared memory name (NULL for TELEMETRY_DEFAULT_NAME)
+ *
+ * Returns: Block pointer, or NULL if it does not exist (yet)
+ */
+const telemetry_block_t *telemetry_open_reader(const char *name);
+
+/**
+ * Unmap a block returned by telemetry_open_reader()
+ */
+void telemetry_close_reader(const telemetry_block_t *block);
+
+/**
+ * Take a consistent-enough copy of every field (relaxed 32-bit loads)
+ */
+void telemetry_snapshot(const telemetry_block_t *block, telemetry_block_t *snapshot);
+
+/**
+ * Check whether the writing process is still alive
+ */
+bool telemetry_writer_alive(const telemetry_block_t *snapshot);
+
+#endif // HPS_TELEMETRY_H